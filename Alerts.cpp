@@ -0,0 +1,445 @@
+//
+// Alerts.cpp - Library for on-device alerting.  Readings are checked
+//              against threshold and rate rules on every sensor poll and
+//              changes of state are pushed to a webhook right away, apart
+//              from the regular DB sends.
+//
+
+#include <ESP8266WiFi.h>
+#include <ESP8266HTTPClient.h>
+
+#include "Alerts.h"
+#include "Config.h"
+#include "Sensor.h"
+#include "Clock.h"
+#include "Network.h"
+#include "Log.h"
+
+// Indexed by ALERT_CH_*
+static const char _channel_names[ ALERT_CHANNELS ][3] = { "", "t", "h", "hi", "dp", "p" };
+
+
+static bool same_rule( const alert_rule &a, const alert_rule &b ) {
+  return a.channel == b.channel && a.type == b.type && a.threshold == b.threshold &&
+         a.hysteresis == b.hysteresis && a.duration == b.duration;
+}
+
+
+static void format_rule( const alert_rule &rule, String &spec ) {
+  char buf[16];
+
+  spec += _channel_names[ rule.channel ];
+  spec += rule.type;
+  spec += Sensor::format_fixed( rule.threshold, buf );
+  if ( rule.hysteresis ) {
+    spec += '/';  spec += Sensor::format_fixed( rule.hysteresis, buf );
+  }
+  if ( rule.duration ) {
+    spec += '@';  spec += rule.duration;
+  }
+}
+
+
+void Alerts::begin( Config *config, Sensor *sensor, Clock *clock, Network *net ) {
+  // Keep a reference to the config, sensor, clock & network
+  _config = config;
+  _sensor = sensor;
+  _clock  = clock;
+  _net    = net;
+
+  _boot_id = ESP.random() & 0xffffff;
+  reset();
+
+  LOG_INFO( LOG_ALERTS, "Rules: %s", format( _config->conf.alert_rules ).c_str() );
+
+  // Rules that are kept carry on where they were
+  _config->onChange( std::bind( &Alerts::configChanged, this, std::placeholders::_1 ) );
+}
+
+
+void Alerts::loop() {
+  // Checked on every poll, so an alert is never more than one poll
+  // interval behind the reading that set it off
+  uint32_t reads = _sensor->get_health().reads;
+  if ( reads != _reads ) {
+    _reads = reads;
+    evaluate();
+  }
+
+  if ( _queue_count > 0 && millis() > _next_try )
+    send();
+}
+
+
+void Alerts::configChanged( uint64_t changed ) {
+  if ( changed & CONFIG_BIT(CONFIG_ALERT_RULES) ) {
+    rules_changed();
+    LOG_INFO( LOG_ALERTS, "Rules: %s", format( _config->conf.alert_rules ).c_str() );
+  }
+
+  // A new URL gets the waiting events straight away
+  if ( changed & CONFIG_BIT(CONFIG_ALERT_URL) ) {
+    _retry_delay = ALERT_RETRY_MIN;
+    _next_try    = 0;
+  }
+}
+
+
+void Alerts::reset() {
+  memset( _state, 0, sizeof(_state) );
+  memcpy( _rules, _config->conf.alert_rules, sizeof(_rules) );
+}
+
+
+// A rule that's still there keeps where it stands, wherever it moved
+// to, and a new one starts from nothing.  One that's gone while active
+// is cleared, or the webhook would be left waiting for a clear that
+// never comes.
+void Alerts::rules_changed() {
+  const alert_rule *rules = _config->conf.alert_rules;
+  alert_state       state[ ALERT_RULES ];
+  byte              kept = 0;             // Bit per new rule
+  memset( state, 0, sizeof(state) );
+
+  for ( byte i = 0; i < ALERT_RULES; i++ ) {
+    if ( _rules[i].channel == ALERT_CH_NONE ) continue;
+
+    byte j = 0;
+    while ( j < ALERT_RULES && ( ( kept & ( 1 << j ) ) || !same_rule( rules[j], _rules[i] ) ) ) j++;
+
+    if ( j < ALERT_RULES ) {
+      state[j] = _state[i];
+      kept |= 1 << j;
+    } else if ( _state[i].active ) {
+      queue( _rules[i], false, _state[i].value );
+    }
+  }
+
+  memcpy( _state, state, sizeof(_state) );
+  memcpy( _rules, rules, sizeof(_rules) );
+}
+
+
+// Current value of a channel in hundredths, false if there isn't one
+bool Alerts::channel_value( byte channel, int32_t &value ) {
+  const sensor_sample &sample = _sensor->get_sample();
+
+  switch ( channel ) {
+    case ALERT_CH_TEMP:      value = sample.temp;      return sample.valid;
+    case ALERT_CH_HUMIDITY:  value = sample.humidity;  return sample.valid;
+    case ALERT_CH_HINDEX:    value = sample.hindex;    return sample.valid && ( sample.derived & DERIVED_HINDEX );
+    case ALERT_CH_DEWPOINT:  value = sample.dewpoint;  return sample.valid && ( sample.derived & DERIVED_DEWPOINT );
+    case ALERT_CH_PRESSURE:  value = sample.pressure;  return sample.analog_valid;
+  }
+  return false;
+}
+
+
+// Every channel goes into the history at most once per ALERT_RATE_STEP
+void Alerts::record( unsigned long now ) {
+  if ( _history_count > 0 ) {
+    byte last = ( _history_head + ALERT_RATE_SLOTS - 1 ) % ALERT_RATE_SLOTS;
+    if ( now - _history_at[ last ] < ALERT_RATE_STEP * 1000UL ) return;
+  }
+
+  _history_at[ _history_head ]    = now;
+  _history_valid[ _history_head ] = 0;
+  for ( byte ch = ALERT_CH_TEMP; ch < ALERT_CHANNELS; ch++ ) {
+    if ( channel_value( ch, _history[ _history_head ][ ch ] ) )
+      _history_valid[ _history_head ] |= 1 << ch;
+  }
+
+  _history_head = ( _history_head + 1 ) % ALERT_RATE_SLOTS;
+  if ( _history_count < ALERT_RATE_SLOTS ) _history_count++;
+}
+
+
+// Change per minute against the oldest entry within the last minute
+// or so.  Less than ALERT_RATE_MIN of history is too noisy to go on.
+bool Alerts::rate( byte channel, unsigned long now, int32_t current, int32_t &per_minute ) {
+  const unsigned long window = ALERT_RATE_SLOTS * ALERT_RATE_STEP * 1000UL;
+
+  for ( byte n = _history_count; n > 0; n-- ) {
+    byte slot = ( _history_head + ALERT_RATE_SLOTS - n ) % ALERT_RATE_SLOTS;
+    unsigned long age = now - _history_at[ slot ];
+
+    if ( age > window || !( _history_valid[ slot ] & ( 1 << channel ) ) ) continue;
+    if ( age < ALERT_RATE_MIN * 1000UL ) return false;
+
+    per_minute = (int64_t)( current - _history[ slot ][ channel ] ) * 60000 / (int32_t)age;
+    return true;
+  }
+  return false;
+}
+
+
+// Whether the rule's condition holds.  Once active it holds until the
+// value is back past the threshold by the hysteresis, so a reading
+// sitting on the threshold doesn't fire over and over.
+bool Alerts::met( const alert_rule &rule, int32_t value, bool active ) {
+  int32_t band = active ? rule.hysteresis : 0;
+
+  switch ( rule.type ) {
+    case ALERT_ABOVE:  return value >  rule.threshold - band;
+    case ALERT_BELOW:  return value <  rule.threshold + band;
+    case ALERT_RISE:   return value >  rule.threshold - band;
+    case ALERT_FALL:   return value < -rule.threshold + band;
+  }
+  return false;
+}
+
+
+// Only changes of state are queued, a condition that holds for an
+// hour is one alert and one clear
+void Alerts::evaluate() {
+  unsigned long now = millis();
+  record( now );
+
+  for ( byte i = 0; i < ALERT_RULES; i++ ) {
+    const alert_rule &rule  = _config->conf.alert_rules[i];
+    alert_state      &state = _state[i];
+
+    if ( rule.channel == ALERT_CH_NONE || rule.channel >= ALERT_CHANNELS ) continue;
+
+    // No reading, the rule stays as it was until there is one
+    int32_t value;
+    state.known = channel_value( rule.channel, value );
+    if ( state.known && ( rule.type == ALERT_RISE || rule.type == ALERT_FALL ) )
+      state.known = rate( rule.channel, now, value, value );
+    if ( !state.known ) continue;
+
+    state.value = value;
+
+    if ( !met( rule, value, state.active ) ) {
+      state.pending = false;
+      if ( state.active ) {
+        state.active = false;
+        queue( rule, false, value );
+      }
+      continue;
+    }
+
+    if ( state.active ) continue;
+
+    if ( !state.pending ) {
+      state.pending = true;
+      state.since   = now;
+    }
+
+    if ( now - state.since >= rule.duration * 1000UL ) {
+      state.pending = false;
+      state.active  = true;
+      state.fired++;
+      queue( rule, true, value );
+    }
+  }
+}
+
+
+void Alerts::queue( const alert_rule &rule, bool active, int32_t value ) {
+  char buf[16];
+  String spec;
+  format_rule( rule, spec );
+  LOG_INFO( LOG_ALERTS, "%s %s at %s", spec.c_str(), active ? "fired" : "cleared",
+            Sensor::format_fixed( value, buf ) );
+
+  if ( strlen( _config->conf.alert_url ) == 0 ) return;
+
+  if ( _queue_count == ALERT_QUEUE ) {
+    _queue_head = ( _queue_head + 1 ) % ALERT_QUEUE;
+    _queue_count--;
+    _dropped++;
+  }
+
+  // Nothing waiting means nothing failing, so no reason to hold it back
+  if ( _queue_count == 0 ) {
+    _retry_delay = ALERT_RETRY_MIN;
+    _next_try    = 0;
+  }
+
+  alert_event &event = _queue[ ( _queue_head + _queue_count ) % ALERT_QUEUE ];
+  event.id        = _next_id++;
+  event.timestamp = ( _clock && _clock->valid() ) ? _clock->now() : 0;
+  event.queued    = millis();
+  event.rule      = rule;
+  event.active    = active;
+  event.value     = value;
+  event.tries     = 0;
+  _queue_count++;
+}
+
+
+// POST the oldest event.  On failure it stays at the front and is
+// tried again after a growing wait; the id is the same every time,
+// so a receiver that did get it can drop the repeat.
+void Alerts::send() {
+  if ( WiFi.status() != WL_CONNECTED ) return;
+
+  alert_event &event = _queue[ _queue_head ];
+  event.tries++;
+
+  // Straight out, not waiting for a beacon wake
+  _net->wake( ALERT_WAKE_HOLD );
+
+  WiFiClient client;
+  HTTPClient http;
+  http.setTimeout( ALERT_TIMEOUT );
+
+  int code = 0;
+  if ( http.begin( client, _config->conf.alert_url ) ) {
+    http.addHeader( "Content-Type", "application/json" );
+    code = http.POST( eventJSON( event ) );
+    http.end();
+  }
+  _last_code = code;
+
+  if ( code >= 200 && code < 300 ) {
+    _sent++;
+    _last_latency = millis() - event.queued;
+    LOG_DEBUG( LOG_ALERTS, "Event %u sent in %lums", event.id, _last_latency );
+
+    _queue_head = ( _queue_head + 1 ) % ALERT_QUEUE;
+    _queue_count--;
+    _retry_delay = ALERT_RETRY_MIN;
+    _next_try    = 0;
+
+  } else {
+    _failed++;
+    LOG_WARN( LOG_ALERTS, "Webhook failed (%d), retrying in %lus", code, _retry_delay / 1000 );
+
+    _next_try    = millis() + _retry_delay;
+    _retry_delay *= 2;
+    if ( _retry_delay > ALERT_RETRY_MAX ) _retry_delay = ALERT_RETRY_MAX;
+  }
+}
+
+
+String Alerts::eventJSON( const alert_event &event ) {
+  const alert_rule &rule = event.rule;
+  char   buf[24];
+  String json, spec;
+  json.reserve( 256 );
+
+  snprintf( buf, sizeof(buf), "-%06x-%u", _boot_id, event.id );
+  format_rule( rule, spec );
+
+  json += "{\"id\": \"";          Config::json_text( json, _config->conf.hostname );  json += buf;
+  json += "\", \"host\": \"";     Config::json_text( json, _config->conf.hostname );
+  json += "\", \"location\": \""; Config::json_text( json, _config->conf.location );
+  json += "\", \"rule\": \"";     Config::json_text( json, spec.c_str() );
+  json += "\", \"channel\": \"";  json += _channel_names[ rule.channel ];
+  json += "\", \"state\": \"";    json += event.active ? "firing" : "cleared";
+  json += "\", \"value\": ";      json += Sensor::format_fixed( event.value, buf );
+  json += ", \"time\": ";         json += event.timestamp;
+  json += ", \"try\": ";          json += event.tries;
+  json += '}';
+
+  return json;
+}
+
+
+// Rule specs, comma separated.  All or nothing: a bad one anywhere
+// leaves the rules as they were.
+bool Alerts::parse( const char *spec, alert_rule *rules ) {
+  alert_rule parsed[ ALERT_RULES ];
+  memset( parsed, 0, sizeof(parsed) );
+
+  const char *p = spec;
+  byte        n = 0;
+
+  while ( true ) {
+    while ( *p == ' ' ) p++;
+    if ( *p == '\0' ) break;
+    if ( n == ALERT_RULES ) return false;
+
+    alert_rule &rule = parsed[ n++ ];
+
+    char name[3];
+    byte len = 0;
+    while ( isalpha( *p ) && len < 2 ) name[ len++ ] = tolower( *p++ );
+    name[ len ] = '\0';
+
+    for ( byte ch = ALERT_CH_TEMP; ch < ALERT_CHANNELS; ch++ )
+      if ( strcmp( name, _channel_names[ch] ) == 0 ) rule.channel = ch;
+    if ( rule.channel == ALERT_CH_NONE ) return false;
+
+    if ( *p != ALERT_ABOVE && *p != ALERT_BELOW && *p != ALERT_RISE && *p != ALERT_FALL ) return false;
+    rule.type = *p++;
+
+    if ( !Sensor::parse_fixed( p, rule.threshold ) ) return false;
+    if ( ( rule.type == ALERT_RISE || rule.type == ALERT_FALL ) && rule.threshold <= 0 ) return false;
+
+    int32_t value;
+    if ( *p == '/' ) {
+      p++;
+      if ( !Sensor::parse_fixed( p, value ) || value < 0 || value > 0xffff ) return false;
+      rule.hysteresis = value;
+    }
+
+    if ( *p == '@' ) {
+      p++;
+      char *end;
+      long secs = strtol( p, &end, 10 );
+      if ( end == p || secs < 0 || secs > 0xffff ) return false;
+      rule.duration = secs;
+      p = end;
+    }
+
+    while ( *p == ' ' ) p++;
+    if ( *p == ',' ) p++;
+    else if ( *p != '\0' ) return false;
+  }
+
+  memcpy( rules, parsed, sizeof(parsed) );
+  return true;
+}
+
+
+String Alerts::format( const alert_rule *rules ) {
+  String spec;
+
+  for ( byte i = 0; i < ALERT_RULES; i++ ) {
+    if ( rules[i].channel == ALERT_CH_NONE ) continue;
+    if ( spec.length() > 0 ) spec += ',';
+    format_rule( rules[i], spec );
+  }
+  return spec;
+}
+
+
+// GET /alerts
+// Rules with where each stands, and how the webhook is doing
+String Alerts::JSON() {
+  char   buf[16];
+  String json;
+  json.reserve( 512 );
+
+  json += "{\"webhook\": ";      json += strlen( _config->conf.alert_url ) > 0 ? "true" : "false";
+  json += ", \"rules\": [";
+
+  bool first = true;
+  for ( byte i = 0; i < ALERT_RULES; i++ ) {
+    const alert_rule  &rule  = _config->conf.alert_rules[i];
+    const alert_state &state = _state[i];
+    if ( rule.channel == ALERT_CH_NONE ) continue;
+
+    if ( !first ) json += ", ";
+    first = false;
+
+    json += "{\"rule\": \"";      format_rule( rule, json );
+    json += "\", \"state\": \"";  json += state.active ? "active" : state.pending ? "pending" : state.known ? "ok" : "unknown";
+    json += "\", \"value\": ";    json += state.known ? Sensor::format_fixed( state.value, buf ) : "null";
+    json += ", \"fired\": ";      json += state.fired;
+    json += '}';
+  }
+
+  json += "], \"queued\": ";     json += _queue_count;
+  json += ", \"sent\": ";        json += _sent;
+  json += ", \"failed\": ";      json += _failed;
+  json += ", \"dropped\": ";     json += _dropped;
+  json += ", \"last_code\": ";   json += _last_code;
+  json += ", \"latency_ms\": ";  json += _last_latency;
+  json += '}';
+
+  return json;
+}
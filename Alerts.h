@@ -0,0 +1,143 @@
+//
+// Alerts.h - Library for on-device alerting.  Readings are checked
+//            against threshold and rate rules on every sensor poll and
+//            changes of state are pushed to a webhook right away, apart
+//            from the regular DB sends.
+//
+
+#ifndef Alerts_h
+#define Alerts_h
+
+#include "Arduino.h"
+
+class Config;
+class Sensor;
+class Clock;
+class Network;
+
+// Reading a rule watches, and its name in a rule spec
+#define ALERT_CH_NONE       0     // Unused rule slot
+#define ALERT_CH_TEMP       1     // "t", F
+#define ALERT_CH_HUMIDITY   2     // "h", %
+#define ALERT_CH_HINDEX     3     // "hi", F
+#define ALERT_CH_DEWPOINT   4     // "dp", F
+#define ALERT_CH_PRESSURE   5     // "p"
+#define ALERT_CHANNELS      6
+
+// How the reading is compared with the threshold
+#define ALERT_ABOVE         '>'
+#define ALERT_BELOW         '<'
+#define ALERT_RISE          '+'   // Rising faster than threshold per minute
+#define ALERT_FALL          '-'   // Falling faster than threshold per minute
+
+#define ALERT_RULES         4     // Rules kept in Config
+#define MAX_ALERT_URL       96
+
+#define ALERT_QUEUE         8     // Events waiting to go out, oldest dropped past this
+#define ALERT_RATE_STEP     5     // Seconds between rate history entries..
+#define ALERT_RATE_SLOTS    13    // ..enough for a minute of them
+#define ALERT_RATE_MIN      20    // Seconds of history before rates are checked
+#define ALERT_RETRY_MIN     5000  // ms before resending after a failure, doubling..
+#define ALERT_RETRY_MAX     300000 // ..up to this
+#define ALERT_TIMEOUT       2000  // ms a webhook POST may take
+#define ALERT_WAKE_HOLD     3000  // ms the radio is kept awake for it
+
+
+//
+// One rule, stored in Config.  Written as a spec string in the
+// settings and /config:
+//   <channel><type><threshold>[/<hysteresis>][@<seconds>]
+// e.g. "t>95/1@120" - temperature above 95 F for two minutes, clears
+// below 94 F.  "h+10" - humidity rising more than 10 % a minute.
+struct alert_rule {
+  byte     channel;        // ALERT_CH_*, ALERT_CH_NONE - unused
+  char     type;           // ALERT_ABOVE, ALERT_BELOW, ALERT_RISE or ALERT_FALL
+  int32_t  threshold;      // Hundredths (per minute for rates)
+  uint16_t hysteresis;     // Hundredths back past the threshold before it clears
+  uint16_t duration;       // Seconds the condition has to hold before it fires
+};
+
+//
+// Where each rule stands, for /alerts
+struct alert_state {
+  bool          known;     // value is current
+  bool          active;    // Fired and not cleared yet
+  bool          pending;   // Condition met, waiting out the duration
+  unsigned long since;     // millis() the condition was first met
+  int32_t       value;     // Reading, or rate per minute
+  uint32_t      fired;     // Times fired since boot
+};
+
+//
+// A change of state waiting to be pushed
+struct alert_event {
+  uint32_t      id;        // Per-boot counter, sent with the boot's tag
+  uint32_t      timestamp; // Unix time, 0 if the clock isn't set
+  unsigned long queued;    // millis() when it happened
+  alert_rule    rule;      // As it was, the rules may have changed since
+  bool          active;    // Fired or cleared
+  int32_t       value;
+  uint16_t      tries;
+};
+
+
+//
+// Alerts Library Class
+class Alerts
+{
+  public:
+    void begin( Config *config, Sensor *sensor, Clock *clock, Network *net );
+    void loop();
+    String JSON();
+
+    // Rule specs, comma separated, to and from the config rules.
+    // parse() leaves rules alone and returns false on a bad spec.
+    static bool   parse( const char *spec, alert_rule *rules );
+    static String format( const alert_rule *rules );
+
+  private:
+    Config  *_config;
+    Sensor  *_sensor;
+    Clock   *_clock;
+    Network *_net;
+
+    alert_rule  _rules[ ALERT_RULES ];  // The rules _state is for
+    alert_state _state[ ALERT_RULES ];
+    uint32_t    _reads = 0;             // Sensor polls seen
+
+    // Rate history, one entry per ALERT_RATE_STEP
+    int32_t       _history[ ALERT_RATE_SLOTS ][ ALERT_CHANNELS ];
+    byte          _history_valid[ ALERT_RATE_SLOTS ];   // Bit per channel
+    unsigned long _history_at[ ALERT_RATE_SLOTS ];
+    byte          _history_head  = 0;
+    byte          _history_count = 0;
+
+    alert_event   _queue[ ALERT_QUEUE ];
+    byte          _queue_head    = 0;
+    byte          _queue_count   = 0;
+    uint32_t      _next_id       = 1;
+    uint32_t      _boot_id       = 0;  // Random, so ids don't repeat across reboots
+    unsigned long _retry_delay   = ALERT_RETRY_MIN;
+    unsigned long _next_try      = 0;
+
+    // Since boot, for /alerts
+    uint32_t      _sent          = 0;
+    uint32_t      _failed        = 0;
+    uint32_t      _dropped       = 0;
+    int           _last_code     = 0;
+    unsigned long _last_latency  = 0;  // ms from the change to the webhook taking it
+
+    void evaluate();
+    void record( unsigned long now );
+    bool channel_value( byte channel, int32_t &value );
+    bool rate( byte channel, unsigned long now, int32_t current, int32_t &per_minute );
+    bool met( const alert_rule &rule, int32_t value, bool active );
+    void queue( const alert_rule &rule, bool active, int32_t value );
+    void send();
+    String eventJSON( const alert_event &event );
+    void reset();
+    void rules_changed();
+    void configChanged( uint64_t changed );
+};
+
+#endif
@@ -0,0 +1,412 @@
+//
+// Archive.cpp - Library for keeping a round-robin history of readings
+//               on SPIFFS at three resolutions (raw, per minute, hourly)
+//
+
+#include <FS.h>
+
+#include "Archive.h"
+#include "Log.h"
+
+// Sized for a day of raw readings, a week of minutes and a year of hours
+// at the DHT22's resolution (about 100 raw or minute samples and 27
+// hourly samples per block).  140 KB of SPIFFS in total.
+static const archive_tier _tiers[ ARCHIVE_TIERS ] = {
+  { ARCHIVE_DIR "raw",    96,  0,    2 },
+  { ARCHIVE_DIR "minute", 112, 60,   2 },
+  { ARCHIVE_DIR "hour",   352, 3600, 6 },
+};
+
+
+Archive::Archive() {
+}
+
+
+void Archive::begin( Sensor *sensor ) {
+  _sensor     = sensor;
+  _next_flush = millis() + ARCHIVE_FLUSH_INTERVAL * 1000UL;
+
+  for ( byte tier = 0; tier < ARCHIVE_TIERS; tier++ )
+    open_tier( tier );
+
+  // Pick up the minute/hour in progress before a restart
+  if ( ESP.rtcUserMemoryRead( ARCHIVE_RTC_BLOCK, (uint32_t *)&_agg, sizeof(_agg) ) &&
+       _agg.magic == ARCHIVE_RTC_MAGIC && _agg.check == rtc_check( _agg ) ) {
+    LOG_INFO( LOG_ARCHIVE, "Restored aggregates from RTC memory" );
+  } else {
+    memset( &_agg, 0, sizeof(_agg) );
+  }
+
+  // Only good for one boot, like the clock
+  archive_rtc clear;
+  memset( &clear, 0, sizeof(clear) );
+  ESP.rtcUserMemoryWrite( ARCHIVE_RTC_BLOCK, (uint32_t *)&clear, sizeof(clear) );
+}
+
+
+void Archive::loop() {
+  const sensor_sample &sample = _sensor->get_sample();
+
+  // One archive sample per new reading, once it can be placed in time
+  if ( sample.seq != _last_seq ) {
+    _last_seq = sample.seq;
+    if ( sample.valid && sample.timestamp != 0 )
+      add( sample.timestamp, sample.temp, sample.humidity );
+  }
+
+  if ( millis() > _next_flush ) {
+    _next_flush = millis() + ARCHIVE_FLUSH_INTERVAL * 1000UL;
+    flush();
+  }
+}
+
+
+// Save everything in RAM ahead of an ESP.restart()
+void Archive::save() {
+  flush();
+
+  _agg.magic = ARCHIVE_RTC_MAGIC;
+  _agg.check = rtc_check( _agg );
+  ESP.rtcUserMemoryWrite( ARCHIVE_RTC_BLOCK, (uint32_t *)&_agg, sizeof(_agg) );
+}
+
+
+uint32_t Archive::rtc_check( const archive_rtc &rtc ) {
+  const uint32_t *words = (const uint32_t *)&rtc;
+  uint32_t check = 0;
+
+  for ( size_t i = 0; i < sizeof(rtc) / 4 - 1; i++ )
+    check ^= words[i];
+  return check;
+}
+
+
+static int32_t mean( int32_t sum, uint32_t count ) {
+  int32_t half = count / 2;
+  return ( sum >= 0 ? sum + half : sum - half ) / (int32_t)count;
+}
+
+
+// Record a reading, rolling it into the minute and hour aggregates
+void Archive::add( uint32_t timestamp, int32_t temp, int32_t humidity ) {
+  int32_t reading[2] = { temp, humidity };
+
+  encode( ARCHIVE_TIER_RAW, timestamp, reading );
+
+  // A new minute closes the previous one
+  uint32_t minute = timestamp - timestamp % 60;
+  if ( _agg.min_count > 0 && minute != _agg.minute ) {
+    int32_t values[2] = { mean( _agg.min_sum[0], _agg.min_count ), mean( _agg.min_sum[1], _agg.min_count ) };
+    encode( ARCHIVE_TIER_MINUTE, _agg.minute, values );
+    _agg.min_count = 0;
+  }
+
+  if ( _agg.min_count == 0 ) {
+    _agg.minute     = minute;
+    _agg.min_sum[0] = 0;
+    _agg.min_sum[1] = 0;
+  }
+  _agg.min_sum[0] += temp;
+  _agg.min_sum[1] += humidity;
+  _agg.min_count++;
+
+  // Same for the hour, with the extremes
+  uint32_t hour = timestamp - timestamp % 3600;
+  if ( _agg.hour_count > 0 && hour != _agg.hour ) {
+    int32_t values[6] = {
+      _agg.hour_min[0], _agg.hour_max[0], mean( _agg.hour_sum[0], _agg.hour_count ),
+      _agg.hour_min[1], _agg.hour_max[1], mean( _agg.hour_sum[1], _agg.hour_count ),
+    };
+    encode( ARCHIVE_TIER_HOUR, _agg.hour, values );
+    _agg.hour_count = 0;
+  }
+
+  for ( byte i = 0; i < 2; i++ ) {
+    if ( _agg.hour_count == 0 ) {
+      _agg.hour_min[i] = reading[i];
+      _agg.hour_max[i] = reading[i];
+      _agg.hour_sum[i] = 0;
+    }
+    if ( reading[i] < _agg.hour_min[i] ) _agg.hour_min[i] = reading[i];
+    if ( reading[i] > _agg.hour_max[i] ) _agg.hour_max[i] = reading[i];
+    _agg.hour_sum[i] += reading[i];
+  }
+  _agg.hour  = hour;
+  _agg.hour_count++;
+}
+
+
+// Bits put_dod() uses for a value
+static uint8_t dod_bits( int32_t value ) {
+  if ( value == 0 )                           return 1;
+  if ( value >= -64 && value <= 63 )          return 2 + 7;
+  if ( value >= -2048 && value <= 2047 )      return 3 + 12;
+  if ( value >= -524288 && value <= 524287 )  return 4 + 20;
+  return 4 + 32;
+}
+
+
+// Append a sample to a tier's block.  A full block is written out and
+// the next slot started, so this is at most one flash write.
+void Archive::encode( byte tier, uint32_t timestamp, const int32_t *values ) {
+  archive_state  &st     = _state[tier];
+  archive_header *hdr    = header( tier );
+  uint8_t         fields = _tiers[tier].fields;
+
+  // Exact size of this sample, so blocks are filled to the last bit
+  uint16_t need = 0;
+  if ( hdr->count == 0 ) {
+    need = 32 * fields;
+  } else {
+    need = dod_bits( (int32_t)( timestamp - st.last_ts ) - st.ts_delta );
+    for ( byte i = 0; i < fields; i++ )
+      need += dod_bits( ( values[i] - st.last[i] ) - st.delta[i] );
+  }
+
+  if ( hdr->count > 0 && hdr->bits + need > ARCHIVE_DATA_BITS ) {
+    write_block( tier );
+    new_block( tier, hdr->seq + 1 );
+    st.slot = ( st.slot + 1 ) % _tiers[tier].blocks;
+    return encode( tier, timestamp, values );
+  }
+
+  if ( hdr->count == 0 ) {
+    hdr->start = timestamp;
+    for ( byte i = 0; i < fields; i++ ) {
+      put_bits( tier, values[i], 32 );
+      st.delta[i] = 0;
+    }
+    st.ts_delta = hdr->interval;
+
+  } else {
+    int32_t ts_delta = timestamp - st.last_ts;
+    put_dod( tier, ts_delta - st.ts_delta );
+    st.ts_delta = ts_delta;
+
+    for ( byte i = 0; i < fields; i++ ) {
+      int32_t delta = values[i] - st.last[i];
+      put_dod( tier, delta - st.delta[i] );
+      st.delta[i] = delta;
+    }
+  }
+
+  for ( byte i = 0; i < fields; i++ )
+    st.last[i] = values[i];
+  st.last_ts = timestamp;
+  st.dirty   = true;
+  hdr->count++;
+}
+
+
+void Archive::put_bits( byte tier, uint32_t value, uint8_t count ) {
+  archive_header *hdr  = header( tier );
+  uint8_t        *data = _state[tier].block + sizeof(archive_header);
+
+  while ( count-- ) {
+    uint16_t pos = hdr->bits++;
+    if ( ( value >> count ) & 1 )
+      data[ pos / 8 ] |= 0x80 >> ( pos % 8 );
+  }
+}
+
+
+void Archive::put_dod( byte tier, int32_t value ) {
+  switch ( dod_bits( value ) ) {
+    case 1:      put_bits( tier, 0x0, 1 ); break;
+    case 2 + 7:  put_bits( tier, 0x2, 2 ); put_bits( tier, value & 0x7F, 7 ); break;
+    case 3 + 12: put_bits( tier, 0x6, 3 ); put_bits( tier, value & 0xFFF, 12 ); break;
+    case 4 + 20: put_bits( tier, 0xE, 4 ); put_bits( tier, value & 0xFFFFF, 20 ); break;
+    default:     put_bits( tier, 0xF, 4 ); put_bits( tier, value, 32 ); break;
+  }
+}
+
+
+uint32_t Archive::get_bits( const uint8_t *data, uint16_t &pos, uint8_t count ) {
+  uint32_t value = 0;
+
+  while ( count-- ) {
+    value = ( value << 1 ) | ( ( data[ pos / 8 ] >> ( 7 - pos % 8 ) ) & 1 );
+    pos++;
+  }
+  return value;
+}
+
+
+// Read back a put_dod() value, sign extending the short forms
+int32_t Archive::get_dod( const uint8_t *data, uint16_t &pos ) {
+  uint8_t prefix = 0;
+  while ( prefix < 4 && get_bits( data, pos, 1 ) ) prefix++;
+
+  static const uint8_t widths[] = { 0, 7, 12, 20, 32 };
+  uint8_t  width = widths[ prefix ];
+  if ( width == 0 ) return 0;
+
+  uint32_t value = get_bits( data, pos, width );
+  if ( width < 32 && ( value & ( 1UL << ( width - 1 ) ) ) )
+    value |= ~0UL << width;
+  return (int32_t)value;
+}
+
+
+void Archive::new_block( byte tier, uint32_t seq ) {
+  archive_state  &st  = _state[tier];
+  archive_header *hdr = header( tier );
+
+  memset( st.block, 0, sizeof(st.block) );
+  hdr->seq      = seq;
+  hdr->tier     = tier;
+  hdr->fields   = _tiers[tier].fields;
+  hdr->interval = _tiers[tier].interval ? _tiers[tier].interval : SENSOR_POLL_INTERVAL;
+  st.dirty      = false;
+}
+
+
+// Find the newest block of a tier and carry on filling it
+void Archive::open_tier( byte tier ) {
+  archive_state &st   = _state[tier];
+  uint32_t       best = 0;
+
+  st.slot = 0;
+
+  File f = SPIFFS.open( _tiers[tier].path, "r" );
+  if ( f ) {
+    uint16_t       blocks = f.size() / ARCHIVE_BLOCK_SIZE;
+    archive_header hdr;
+
+    for ( uint16_t i = 0; i < blocks && i < _tiers[tier].blocks; i++ ) {
+      f.seek( i * ARCHIVE_BLOCK_SIZE, SeekSet );
+      if ( f.read( (uint8_t *)&hdr, sizeof(hdr) ) != sizeof(hdr) ) break;
+
+      if ( hdr.tier == tier && hdr.seq != 0xFFFFFFFF && hdr.seq > best ) {
+        best    = hdr.seq;
+        st.slot = i;
+      }
+    }
+
+    if ( best > 0 ) {
+      f.seek( st.slot * ARCHIVE_BLOCK_SIZE, SeekSet );
+      f.read( st.block, ARCHIVE_BLOCK_SIZE );
+    }
+    f.close();
+
+  } else {
+    // SPIFFS can only seek within a file that exists
+    f = SPIFFS.open( _tiers[tier].path, "w" );
+    f.close();
+  }
+
+  if ( best == 0 || !resume( tier ) ) {
+    // Nothing to append to, start the slot after the newest
+    if ( best > 0 ) st.slot = ( st.slot + 1 ) % _tiers[tier].blocks;
+    new_block( tier, best + 1 );
+  }
+
+  LOG_INFO( LOG_ARCHIVE, "%s: block %u slot %u, %u samples", _tiers[tier].path,
+            header( tier )->seq, st.slot, header( tier )->count );
+}
+
+
+// Replay a block from flash to rebuild the encoder state
+bool Archive::resume( byte tier ) {
+  archive_state  &st     = _state[tier];
+  archive_header *hdr    = header( tier );
+  const uint8_t  *data   = st.block + sizeof(archive_header);
+  uint8_t         fields = _tiers[tier].fields;
+  uint16_t        pos    = 0;
+
+  if ( hdr->fields != fields || hdr->count == 0 || hdr->bits > ARCHIVE_DATA_BITS ) return false;
+
+  for ( uint16_t n = 0; n < hdr->count; n++ ) {
+    if ( n == 0 ) {
+      st.last_ts  = hdr->start;
+      st.ts_delta = hdr->interval;
+      for ( byte i = 0; i < fields; i++ ) {
+        st.last[i]  = get_bits( data, pos, 32 );
+        st.delta[i] = 0;
+      }
+      continue;
+    }
+
+    st.ts_delta += get_dod( data, pos );
+    st.last_ts  += st.ts_delta;
+    for ( byte i = 0; i < fields; i++ ) {
+      st.delta[i] += get_dod( data, pos );
+      st.last[i]  += st.delta[i];
+    }
+  }
+
+  st.dirty = false;
+  return pos == hdr->bits;
+}
+
+
+// Write the block being filled to its slot
+void Archive::write_block( byte tier ) {
+  archive_state &st = _state[tier];
+
+  File f = SPIFFS.open( _tiers[tier].path, "r+" );
+  if ( !f ) {
+    LOG_ERROR( LOG_ARCHIVE, "Can't open %s", _tiers[tier].path );
+    return;
+  }
+
+  // Slots are filled in order, so the file is never shorter than this
+  f.seek( st.slot * ARCHIVE_BLOCK_SIZE, SeekSet );
+  if ( f.write( st.block, ARCHIVE_BLOCK_SIZE ) != ARCHIVE_BLOCK_SIZE )
+    LOG_ERROR( LOG_ARCHIVE, "Write failed: %s", _tiers[tier].path );
+  f.close();
+
+  st.dirty = false;
+}
+
+
+// Save partly filled blocks
+void Archive::flush() {
+  for ( byte tier = 0; tier < ARCHIVE_TIERS; tier++ )
+    if ( _state[tier].dirty ) write_block( tier );
+}
+
+
+// Export size: the file, or up to the end of the block in RAM if that
+// slot hasn't been written yet
+size_t Archive::size( byte tier ) {
+  if ( tier >= ARCHIVE_TIERS ) return 0;
+
+  size_t total = 0;
+  File   f     = SPIFFS.open( _tiers[tier].path, "r" );
+  if ( f ) {
+    total = f.size();
+    f.close();
+  }
+
+  size_t ram_end = ( _state[tier].slot + 1 ) * ARCHIVE_BLOCK_SIZE;
+  return ( header( tier )->count > 0 && ram_end > total ) ? ram_end : total;
+}
+
+
+// Export read: the block being filled comes from RAM, the rest from flash
+size_t Archive::read( byte tier, uint8_t *buf, size_t len, size_t index ) {
+  size_t total = size( tier );
+  if ( index >= total ) return 0;
+  if ( len > total - index ) len = total - index;
+
+  size_t ram_start = _state[tier].slot * ARCHIVE_BLOCK_SIZE;
+  size_t ram_end   = ram_start + ARCHIVE_BLOCK_SIZE;
+
+  if ( index >= ram_start && index < ram_end ) {
+    if ( len > ram_end - index ) len = ram_end - index;
+    memcpy( buf, _state[tier].block + ( index - ram_start ), len );
+    return len;
+  }
+
+  // Stop at the RAM block
+  if ( index < ram_start && len > ram_start - index ) len = ram_start - index;
+
+  File f = SPIFFS.open( _tiers[tier].path, "r" );
+  if ( !f ) return 0;
+  f.seek( index, SeekSet );
+  len = f.read( buf, len );
+  f.close();
+
+  return len;
+}
@@ -0,0 +1,133 @@
+//
+// Archive.h - Library for keeping a round-robin history of readings
+//             on SPIFFS at three resolutions (raw, per minute, hourly)
+//
+
+#ifndef Archive_h
+#define Archive_h
+
+#include "Arduino.h"
+#include "defaults.h"
+#include "Sensor.h"
+
+#define ARCHIVE_DIR            "/archive/"
+#define ARCHIVE_TIERS          3
+#define ARCHIVE_MAX_FIELDS     6
+#define ARCHIVE_BLOCK_SIZE     256         // One SPIFFS page, the unit of every flash write
+#define ARCHIVE_FLUSH_INTERVAL 60*60       // Seconds between saves of partly filled blocks
+
+#define ARCHIVE_TIER_RAW       0           // Every reading, temp + humidity
+#define ARCHIVE_TIER_MINUTE    1           // 1 minute means, temp + humidity
+#define ARCHIVE_TIER_HOUR      2           // Hourly min/max/mean of temp + humidity
+
+// Minute/hour accumulators carried over an ESP.restart().  Blocks
+// 32..36 belong to Clock, 40..48 to DeltaUpdate.
+#define ARCHIVE_RTC_BLOCK      50
+#define ARCHIVE_RTC_MAGIC      0x41524331
+
+
+//
+// Block layout: this header, then a bit stream.  The first sample's
+// values are stored as 32 bit integers; after that each timestamp and
+// value is stored as the change in its delta (delta-of-delta), with a
+// prefix code:
+//   0                 0
+//   10   + 7 bits     -64..63
+//   110  + 12 bits    -2048..2047
+//   1110 + 20 bits
+//   1111 + 32 bits
+// Bits are packed most significant first.  Readings arrive on regular
+// wall-clock boundaries and change slowly, so most of them cost 1-9 bits.
+struct archive_header {
+  uint32_t seq;            // Block sequence number, the highest is the newest
+  uint32_t start;          // Unix time of the first sample
+  uint16_t count;          // Samples in the block
+  uint16_t bits;           // Bits of the stream used
+  uint8_t  tier;
+  uint8_t  fields;         // Values per sample
+  uint16_t interval;       // Nominal seconds between samples
+};
+
+#define ARCHIVE_DATA_BITS   ( ( ARCHIVE_BLOCK_SIZE - sizeof(archive_header) ) * 8 )
+
+
+//
+// Per tier layout
+struct archive_tier {
+  const char *path;
+  uint16_t    blocks;      // File size in blocks
+  uint16_t    interval;    // Seconds (0 = the sensor poll interval)
+  uint8_t     fields;
+};
+
+
+//
+// Block being filled, plus the encoder state needed to append to it
+struct archive_state {
+  uint8_t  block[ ARCHIVE_BLOCK_SIZE ];
+  uint16_t slot;           // Where the block goes in the file
+  bool     dirty;          // Has samples that aren't on flash yet
+  uint32_t last_ts;
+  int32_t  ts_delta;
+  int32_t  last[ ARCHIVE_MAX_FIELDS ];
+  int32_t  delta[ ARCHIVE_MAX_FIELDS ];
+};
+
+
+//
+// Minute and hour aggregates in progress
+struct archive_rtc {
+  uint32_t magic;
+  uint32_t minute;         // Start of the minute being averaged
+  uint32_t min_count;
+  int32_t  min_sum[2];     // temp, humidity
+  uint32_t hour;
+  uint32_t hour_count;
+  int32_t  hour_min[2];
+  int32_t  hour_max[2];
+  int32_t  hour_sum[2];
+  uint32_t check;          // XOR of the words above
+};
+
+
+//
+// Archive Library Class
+class Archive
+{
+  public:
+    Archive();
+
+    void   begin( Sensor *sensor );
+    void   loop();
+    void   save();                      // Ahead of an ESP.restart()
+    void   add( uint32_t timestamp, int32_t temp, int32_t humidity );
+
+    // Export: the tier file as stored, with the block in RAM in its slot
+    size_t size( byte tier );
+    size_t read( byte tier, uint8_t *buf, size_t len, size_t index );
+
+  private:
+    Sensor        *_sensor;
+    uint32_t       _last_seq = 0;
+    unsigned long  _next_flush;
+    archive_state  _state[ ARCHIVE_TIERS ];
+    archive_rtc    _agg;
+
+    void     open_tier( byte tier );
+    void     encode( byte tier, uint32_t timestamp, const int32_t *values );
+    void     write_block( byte tier );
+    void     new_block( byte tier, uint32_t seq );
+    bool     resume( byte tier );
+    void     flush();
+    uint32_t rtc_check( const archive_rtc &rtc );
+
+    archive_header* header( byte tier ) { return (archive_header *)_state[tier].block; }
+
+    // Bit stream
+    void     put_bits( byte tier, uint32_t value, uint8_t count );
+    void     put_dod( byte tier, int32_t value );
+    uint32_t get_bits( const uint8_t *data, uint16_t &pos, uint8_t count );
+    int32_t  get_dod( const uint8_t *data, uint16_t &pos );
+};
+
+#endif
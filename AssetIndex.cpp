@@ -0,0 +1,198 @@
+//
+// AssetIndex.cpp - Library for indexing the files stored in SPIFFS
+//                  so web requests can be resolved without touching flash
+//
+
+#include <FS.h>
+#include <MD5Builder.h>
+
+#include "AssetIndex.h"
+#include "Archive.h"
+#include "Log.h"
+
+// Indexed by the MIME_* defines
+static const char* _mime_types[] = {
+  "text/plain",
+  "text/html",
+  "text/css",
+  "application/javascript",
+  "image/png",
+  "image/gif",
+  "image/jpeg",
+  "image/x-icon",
+  "text/xml",
+  "application/pdf",
+  "application/zip",
+  "application/octet-stream"
+};
+
+// Extension to MIME type lookup
+struct mime_ext {
+  const char *ext;
+  byte       type;
+};
+
+static const mime_ext _mime_exts[] = {
+  { ".html", MIME_HTML },
+  { ".htm",  MIME_HTML },
+  { ".css",  MIME_CSS },
+  { ".js",   MIME_JS },
+  { ".png",  MIME_PNG },
+  { ".gif",  MIME_GIF },
+  { ".jpg",  MIME_JPEG },
+  { ".ico",  MIME_ICON },
+  { ".xml",  MIME_XML },
+  { ".pdf",  MIME_PDF },
+  { ".zip",  MIME_ZIP }
+};
+
+
+AssetIndex::AssetIndex() {
+  memset( _slots, 0, sizeof(_slots) );
+  _count = 0;
+}
+
+
+// FNV-1a hash of a path.  Never returns 0 since that marks an empty slot.
+uint32_t AssetIndex::hash( const char *str ) {
+  uint32_t h = 2166136261UL;
+
+  while ( *str ) {
+    h ^= (byte)*str++;
+    h *= 16777619UL;
+  }
+
+  return h ? h : 1;
+}
+
+
+// First word of a file's MD5.  A delta update can change a file and
+// not version.txt, or keep its size, so this is what tells an ETag
+// the file changed.  A read of every file, but only when (re)indexing.
+static uint32_t content_hash( Dir &dir ) {
+  File f = dir.openFile( "r" );
+  if ( !f ) return 0;
+
+  MD5Builder md5;
+  uint8_t    digest[16];
+  md5.begin();
+  md5.addStream( f, f.size() );
+  md5.calculate();
+  md5.getBytes( digest );
+  f.close();
+
+  return (uint32_t)digest[0] | (uint32_t)digest[1] << 8 | (uint32_t)digest[2] << 16 | (uint32_t)digest[3] << 24;
+}
+
+
+//
+// Scan SPIFFS once and (re)build the index.  The version string is
+// mixed into every ETag so a new SPIFFS image invalidates client caches,
+// and each file's contents so a single changed file does too.
+void AssetIndex::build( String version ) {
+  uint32_t version_hash = hash( version.c_str() );
+
+  memset( _slots, 0, sizeof(_slots) );
+  _count = 0;
+
+  Dir dir = SPIFFS.openDir("/");
+  while ( dir.next() ) {
+    String name = dir.fileName();
+    bool   gzip = false;
+
+    // Device data, not web assets
+    if ( name.startsWith( ARCHIVE_DIR ) ) continue;
+
+    if ( name.endsWith(".gz") ) {
+      name = name.substring( 0, name.length() - 3 );
+      gzip = true;
+    }
+
+    if ( name.length() >= ASSET_MAX_PATH ) continue;
+
+    asset *entry = insert( name.c_str() );
+    if ( !entry ) {
+      LOG_WARN( LOG_WEB, "Asset index full, skipping: %s", name.c_str() );
+      continue;
+    }
+
+    // A .gz variant always wins over the plain file
+    if ( gzip || !entry->gzip ) {
+      entry->gzip = gzip;
+      entry->size = dir.fileSize();
+      entry->etag = version_hash ^ ( entry->hash * 31 ) ^ entry->size ^ content_hash( dir );
+    }
+  }
+
+  LOG_INFO( LOG_WEB, "Indexed %u files", _count );
+}
+
+
+// Find the slot for a path, creating it if it doesn't exist yet
+asset* AssetIndex::insert( const char *path ) {
+  uint32_t h    = hash( path );
+  byte     slot = h & ( ASSET_INDEX_SLOTS - 1 );
+
+  for ( byte i = 0; i < ASSET_INDEX_SLOTS; i++ ) {
+    asset *entry = &_slots[ slot ];
+
+    if ( entry->hash == 0 ) {
+      entry->hash = h;
+      entry->mime = mime_for( path );
+      strcpy( entry->path, path );
+      _count++;
+      return entry;
+    }
+
+    if ( entry->hash == h && strcmp( entry->path, path ) == 0 )
+      return entry;
+
+    slot = ( slot + 1 ) & ( ASSET_INDEX_SLOTS - 1 );
+  }
+
+  return NULL;
+}
+
+
+// Look up a request path.  Returns NULL if no such file exists.
+const asset* AssetIndex::find( const char *path ) {
+  uint32_t h    = hash( path );
+  byte     slot = h & ( ASSET_INDEX_SLOTS - 1 );
+
+  for ( byte i = 0; i < ASSET_INDEX_SLOTS; i++ ) {
+    const asset *entry = &_slots[ slot ];
+
+    if ( entry->hash == 0 )
+      return NULL;
+
+    if ( entry->hash == h && strcmp( entry->path, path ) == 0 )
+      return entry;
+
+    slot = ( slot + 1 ) & ( ASSET_INDEX_SLOTS - 1 );
+  }
+
+  return NULL;
+}
+
+
+const char* AssetIndex::mime( byte type ) {
+  if ( type > MIME_OCTET ) type = MIME_PLAIN;
+  return _mime_types[ type ];
+}
+
+
+byte AssetIndex::count() { return _count; }
+
+
+// Resolve the MIME type from the file extension
+byte AssetIndex::mime_for( const char *path ) {
+  const char *ext = strrchr( path, '.' );
+  if ( !ext ) return MIME_PLAIN;
+
+  for ( byte i = 0; i < sizeof(_mime_exts) / sizeof(_mime_exts[0]); i++ ) {
+    if ( strcmp( ext, _mime_exts[i].ext ) == 0 )
+      return _mime_exts[i].type;
+  }
+
+  return MIME_PLAIN;
+}
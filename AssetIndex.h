@@ -0,0 +1,63 @@
+//
+// AssetIndex.h - Library for indexing the files stored in SPIFFS
+//                so web requests can be resolved without touching flash
+//
+
+#ifndef AssetIndex_h
+#define AssetIndex_h
+
+#include "Arduino.h"
+
+#define ASSET_INDEX_SLOTS   32    // Hash table slots (power of two)
+#define ASSET_MAX_PATH      32    // SPIFFS object name length, including the \0
+
+// MIME types known to the index
+#define MIME_PLAIN   0
+#define MIME_HTML    1
+#define MIME_CSS     2
+#define MIME_JS      3
+#define MIME_PNG     4
+#define MIME_GIF     5
+#define MIME_JPEG    6
+#define MIME_ICON    7
+#define MIME_XML     8
+#define MIME_PDF     9
+#define MIME_ZIP     10
+#define MIME_OCTET   11
+
+
+//
+// Index entry for one servable file
+struct asset {
+  uint32_t hash;                    // FNV-1a hash of the request path, 0 = empty slot
+  uint32_t size;                    // Size of the file that will be streamed
+  uint32_t etag;                    // Changes whenever the SPIFFS image or file changes
+  byte     mime;                    // MIME_* type resolved from the extension
+  bool     gzip;                    // Stream path + ".gz" with Content-Encoding: gzip
+  char     path[ ASSET_MAX_PATH ];  // Request path (without .gz)
+};
+
+
+//
+// AssetIndex Library Class
+class AssetIndex
+{
+  public:
+    AssetIndex();
+
+    void         build( String version );
+    const asset* find( const char *path );
+    const char*  mime( byte type );
+    byte         count();
+
+    static uint32_t hash( const char *str );
+
+  private:
+    asset  _slots[ ASSET_INDEX_SLOTS ];
+    byte   _count;
+
+    asset* insert( const char *path );
+    byte   mime_for( const char *path );
+};
+
+#endif
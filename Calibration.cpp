@@ -0,0 +1,110 @@
+//
+// Calibration.cpp - Library for per-channel sensor calibration.  Raw
+//                   readings are mapped through a table of reference
+//                   points, piecewise linear, in fixed point.
+//
+
+#include "Calibration.h"
+#include "Sensor.h"
+
+// Indexed by CAL_*
+static const char _channel_names[ CAL_CHANNELS ][2] = { "t", "h", "p" };
+
+
+// a / b to the nearest, halves away from zero
+static int32_t div_round( int64_t a, int64_t b ) {
+  if ( b < 0 ) {
+    a = -a;
+    b = -b;
+  }
+  return ( a >= 0 ? a + b / 2 : a - b / 2 ) / b;
+}
+
+
+int32_t Calibration::apply( const cal_table &table, int32_t raw ) {
+  if ( table.points == 0 ) return raw;
+  if ( table.points == 1 ) return raw + ( table.value[0] - table.raw[0] );
+
+  // The segment raw falls in.  Past either end the nearest one carries on.
+  byte i = 0;
+  while ( i + 2 < table.points && raw > table.raw[ i + 1 ] ) i++;
+
+  return table.value[i] + div_round( (int64_t)( raw - table.raw[i] ) * ( table.value[i+1] - table.value[i] ),
+                                     (int64_t)table.raw[i+1] - table.raw[i] );
+}
+
+
+// A reference reading taken against the raw one.  Replaces the point
+// at the same raw value, or with the table full the one nearest it.
+void Calibration::add_point( cal_table &table, int32_t raw, int32_t value ) {
+  byte i = 0;
+  while ( i < table.points && table.raw[i] < raw ) i++;
+
+  if ( i < table.points && table.raw[i] == raw ) {
+    table.value[i] = value;
+    return;
+  }
+
+  if ( table.points == CAL_POINTS ) {
+    // Either neighbour keeps the table in order
+    if ( i == CAL_POINTS || ( i > 0 && raw - table.raw[i-1] < table.raw[i] - raw ) ) i--;
+    table.raw[i]   = raw;
+    table.value[i] = value;
+    return;
+  }
+
+  memmove( &table.raw[ i + 1 ],   &table.raw[i],   ( table.points - i ) * sizeof(int32_t) );
+  memmove( &table.value[ i + 1 ], &table.value[i], ( table.points - i ) * sizeof(int32_t) );
+  table.raw[i]   = raw;
+  table.value[i] = value;
+  table.points++;
+}
+
+
+// "raw:value,raw:value,..", raw increasing.  Empty for readings as
+// they come.
+bool Calibration::parse( const char *spec, cal_table &table ) {
+  cal_table   parsed;
+  const char *p = spec;
+  memset( &parsed, 0, sizeof(parsed) );
+
+  while ( true ) {
+    while ( *p == ' ' ) p++;
+    if ( *p == '\0' ) break;
+    if ( parsed.points == CAL_POINTS ) return false;
+
+    int32_t raw, value;
+    if ( !Sensor::parse_fixed( p, raw ) || *p++ != ':' || !Sensor::parse_fixed( p, value ) ) return false;
+    if ( parsed.points > 0 && raw <= parsed.raw[ parsed.points - 1 ] ) return false;
+
+    parsed.raw[ parsed.points ]   = raw;
+    parsed.value[ parsed.points ] = value;
+    parsed.points++;
+
+    while ( *p == ' ' ) p++;
+    if ( *p == ',' ) p++;
+    else if ( *p != '\0' ) return false;
+  }
+
+  table = parsed;
+  return true;
+}
+
+
+String Calibration::format( const cal_table &table ) {
+  char   buf[16];
+  String spec;
+
+  for ( byte i = 0; i < table.points && i < CAL_POINTS; i++ ) {
+    if ( i > 0 ) spec += ',';
+    spec += Sensor::format_fixed( table.raw[i], buf );
+    spec += ':';
+    spec += Sensor::format_fixed( table.value[i], buf );
+  }
+  return spec;
+}
+
+
+const char* Calibration::channel_name( byte channel ) {
+  return channel < CAL_CHANNELS ? _channel_names[ channel ] : "?";
+}
@@ -0,0 +1,49 @@
+//
+// Calibration.h - Library for per-channel sensor calibration.  Raw
+//                 readings are mapped through a table of reference
+//                 points, piecewise linear, in fixed point.
+//
+
+#ifndef Calibration_h
+#define Calibration_h
+
+#include "Arduino.h"
+
+// Channels with a table in Config
+#define CAL_TEMP          0     // "t", F
+#define CAL_HUMIDITY      1     // "h", %
+#define CAL_PRESSURE      2     // "p", from ADC counts
+#define CAL_CHANNELS      3
+
+#define CAL_POINTS        5     // Reference points per table
+
+
+//
+// Raw reading -> calibrated value, both fixed point (value * 100).
+// Written as "raw:value,raw:value,.." in the settings and /config.
+// No points leaves readings as they are, one point is an offset,
+// two or more are joined by straight lines and the end segments
+// carry on past the ends.
+struct cal_table {
+  byte    points;
+  int32_t raw[ CAL_POINTS ];      // Increasing
+  int32_t value[ CAL_POINTS ];
+};
+
+
+//
+// Calibration Library Class
+class Calibration
+{
+  public:
+    static int32_t apply( const cal_table &table, int32_t raw );
+    static void    add_point( cal_table &table, int32_t raw, int32_t value );
+
+    // parse() leaves table alone and returns false on a bad spec
+    static bool    parse( const char *spec, cal_table &table );
+    static String  format( const cal_table &table );
+
+    static const char* channel_name( byte channel );
+};
+
+#endif
@@ -0,0 +1,306 @@
+//
+// Capture.cpp - Library for triggered burst capture on the analog
+//               pressure input.  The ADC is sampled continuously into a
+//               pre-trigger ring; a threshold or slope trigger freezes
+//               a window around the event for /capture and the DB.
+//
+
+#include "Capture.h"
+#include "Config.h"
+#include "Sensor.h"
+#include "Clock.h"
+#include "Log.h"
+
+static_assert( CAPTURE_PRE < CAPTURE_RING && CAPTURE_SLOPE < CAPTURE_PRE && CAPTURE_PRE < CAPTURE_WINDOW,
+               "Capture window doesn't fit the ring" );
+static_assert( CAPTURE_RING % CAPTURE_AVERAGE == 0, "Average samples don't spread evenly over the ring" );
+
+
+static void format_trigger( const capture_trigger &trigger, String &spec ) {
+  char buf[16];
+
+  spec += trigger.type;
+  spec += Sensor::format_fixed( trigger.threshold, buf );
+}
+
+
+void Capture::begin( Config *config, Clock *clock ) {
+  // Keep a reference to the config & clock
+  _config = config;
+  _clock  = clock;
+
+  memset( &_capture, 0, sizeof(_capture) );
+  start();
+
+  LOG_INFO( LOG_CAPTURE, "Triggers: %s", format( _config->conf.capture ).c_str() );
+
+  // New triggers start from an empty ring
+  _config->onChange( std::bind( &Capture::configChanged, this, std::placeholders::_1 ) );
+}
+
+
+void Capture::loop() {
+  if ( !_sampling ) return;
+
+  unsigned long late = micros() - _next_us;
+  if ( (long)late < 0 ) return;
+
+  // Whole periods gone by since the sample was due, the loop was held
+  // up elsewhere.  They're recorded as a gap rather than made up.
+  unsigned long missed = late / CAPTURE_PERIOD_US;
+  _next_us += ( missed + 1 ) * CAPTURE_PERIOD_US;
+
+  sample( analogRead( PRESSURE_PIN ), missed );
+}
+
+
+void Capture::configChanged( uint64_t changed ) {
+  if ( changed & CONFIG_BIT(CONFIG_CAPTURE) ) {
+    start();
+    LOG_INFO( LOG_CAPTURE, "Triggers: %s", format( _config->conf.capture ).c_str() );
+  }
+}
+
+
+// Sampling runs whenever there's a trigger, parse() fills them in
+// from the first.  A window being filled is dropped.
+void Capture::start() {
+  _sampling   = ( _config->conf.capture[0].type != 0 );
+  _ring_head  = 0;
+  _ring_count = 0;
+  _since_gap  = 0;
+  _filling    = false;
+  _rearm_at   = 0;
+  _next_us    = micros();
+}
+
+
+bool Capture::active() {
+  return _sampling;
+}
+
+
+int32_t Capture::pressure( uint16_t counts ) {
+  return Calibration::apply( _config->conf.cal[ CAL_PRESSURE ], (int32_t)counts * SENSOR_FIXED_SCALE );
+}
+
+
+// Sample back samples before the newest
+uint16_t Capture::ring_at( uint16_t back ) {
+  return _ring[ ( _ring_head + CAPTURE_RING - 1 - back ) % CAPTURE_RING ];
+}
+
+
+void Capture::sample( uint16_t counts, unsigned long missed ) {
+  uint16_t gap = ( missed > CAPTURE_GAP_MAX ) ? CAPTURE_GAP_MAX : missed;
+  uint16_t s   = ( counts & CAPTURE_VALUE_MASK ) | ( gap << CAPTURE_GAP_SHIFT );
+
+  _samples++;
+  _missed += missed;
+  if ( missed )                   _since_gap = 0;
+  else if ( _since_gap < 0xffff ) _since_gap++;
+
+  _ring[ _ring_head ] = s;
+  _ring_head = ( _ring_head + 1 ) % CAPTURE_RING;
+  if ( _ring_count < CAPTURE_RING ) _ring_count++;
+
+  int32_t p = pressure( counts & CAPTURE_VALUE_MASK );
+
+  if ( _filling ) {
+    _capture.samples[ _filled++ ] = s;
+    if ( _filled == CAPTURE_WINDOW ) finish();
+
+  } else if ( _ring_count > CAPTURE_PRE && millis() > _rearm_at ) {
+    int index = triggered( p );
+    if ( index >= 0 ) trigger( index, p );
+  }
+
+  _last = p;
+}
+
+
+// The first trigger the newest sample sets off, -1 for none.  Levels
+// fire on crossing, so a pressure that stays high fires once.  Slopes
+// need CAPTURE_SLOPE samples without a gap to go on.
+int Capture::triggered( int32_t p ) {
+  for ( byte i = 0; i < CAPTURE_TRIGGERS; i++ ) {
+    const capture_trigger &trigger = _config->conf.capture[i];
+    int32_t change;
+
+    switch ( trigger.type ) {
+      case CAPTURE_ABOVE:
+        if ( _last <= trigger.threshold && p > trigger.threshold ) return i;
+        break;
+
+      case CAPTURE_BELOW:
+        if ( _last >= trigger.threshold && p < trigger.threshold ) return i;
+        break;
+
+      case CAPTURE_RISE:
+      case CAPTURE_FALL:
+        if ( _since_gap < CAPTURE_SLOPE ) break;
+        change = p - pressure( ring_at( CAPTURE_SLOPE ) & CAPTURE_VALUE_MASK );
+        if ( trigger.type == CAPTURE_FALL ) change = -change;
+        if ( change > trigger.threshold ) return i;
+        break;
+    }
+  }
+  return -1;
+}
+
+
+// Start a window with the pre-trigger history, oldest first, ending
+// with the sample that set it off.  The rest is filled in as it comes.
+void Capture::trigger( byte index, int32_t p ) {
+  const capture_trigger &trigger = _config->conf.capture[ index ];
+  capture_header        &header  = _capture.header;
+
+  header.magic     = CAPTURE_MAGIC;
+  header.timestamp = ( _clock && _clock->valid() ) ? _clock->now() : 0;
+  header.period_us = CAPTURE_PERIOD_US;
+  header.count     = CAPTURE_WINDOW;
+  header.pre       = CAPTURE_PRE;
+  header.threshold = trigger.threshold;
+  header.value     = p;
+  header.type      = trigger.type;
+  header.cal       = _config->conf.cal[ CAL_PRESSURE ];
+
+  for ( uint16_t i = 0; i <= CAPTURE_PRE; i++ )
+    _capture.samples[i] = ring_at( CAPTURE_PRE - i );
+
+  // Whatever came before the window doesn't count
+  _capture.samples[0] &= CAPTURE_VALUE_MASK;
+
+  _filled  = CAPTURE_PRE + 1;
+  _filling = true;
+}
+
+
+// The window's full, sum it up and hold off the next
+void Capture::finish() {
+  capture_header &header = _capture.header;
+
+  header.low    = header.value;
+  header.high   = header.value;
+  header.missed = 0;
+  for ( uint16_t i = 0; i < CAPTURE_WINDOW; i++ ) {
+    int32_t p = pressure( _capture.samples[i] & CAPTURE_VALUE_MASK );
+    if ( p < header.low )  header.low  = p;
+    if ( p > header.high ) header.high = p;
+    header.missed += _capture.samples[i] >> CAPTURE_GAP_SHIFT;
+  }
+
+  header.seq = ++_captures;
+  _filling   = false;
+  _rearm_at  = millis() + CAPTURE_HOLDOFF * 1000UL;
+
+  char value[16], low[16], high[16];
+  LOG_INFO( LOG_CAPTURE, "Capture %u on %c: %s, %s..%s, %u periods missed", header.seq, header.type,
+            Sensor::format_fixed( header.value, value ), Sensor::format_fixed( header.low, low ),
+            Sensor::format_fixed( header.high, high ), header.missed );
+}
+
+
+// Every CAPTURE_RING / CAPTURE_AVERAGE samples back to the oldest, as
+// many as read_analog() takes and over about as long
+bool Capture::average( uint16_t &sum ) {
+  if ( !_sampling || _ring_count < CAPTURE_RING ) return false;
+
+  sum = 0;
+  for ( uint16_t i = 0; i < CAPTURE_AVERAGE; i++ )
+    sum += ring_at( i * ( CAPTURE_RING / CAPTURE_AVERAGE ) ) & CAPTURE_VALUE_MASK;
+  return true;
+}
+
+
+uint32_t Capture::seq()                     { return _captures; }
+const capture_header& Capture::header()     { return _capture.header; }
+const uint8_t* Capture::data()              { return (const uint8_t *)&_capture; }
+
+
+// Half of a window would be the old capture and half the new one
+size_t Capture::size() {
+  if ( _captures == 0 || _filling ) return 0;
+  return sizeof(capture_header) + _capture.header.count * sizeof(uint16_t);
+}
+
+
+// Trigger state and counters, and a summary of the last capture
+String Capture::JSON() {
+  char   buf[16];
+  String json;
+  json.reserve( 384 );
+
+  const char *state = !_sampling                         ? "off"
+                    : _filling                           ? "capturing"
+                    : ( _ring_count <= CAPTURE_PRE )     ? "filling"
+                    : ( millis() <= _rearm_at )          ? "holdoff"
+                    : "armed";
+
+  json += "{\"state\": \"";       json += state;
+  json += "\", \"triggers\": \""; json += format( _config->conf.capture );
+  json += "\", \"period_us\": ";  json += CAPTURE_PERIOD_US;
+  json += ", \"samples\": ";      json += _samples;
+  json += ", \"missed\": ";       json += _missed;
+  json += ", \"captures\": ";     json += _captures;
+  json += ", \"last\": ";
+
+  if ( _captures == 0 ) {
+    json += "null";
+  } else {
+    const capture_header &header = _capture.header;
+    json += "{\"seq\": ";         json += header.seq;
+    json += ", \"timestamp\": ";  json += header.timestamp;
+    json += ", \"trigger\": \"";  json += header.type; json += Sensor::format_fixed( header.threshold, buf );
+    json += "\", \"value\": ";    json += Sensor::format_fixed( header.value, buf );
+    json += ", \"low\": ";        json += Sensor::format_fixed( header.low, buf );
+    json += ", \"high\": ";       json += Sensor::format_fixed( header.high, buf );
+    json += ", \"missed\": ";     json += header.missed;
+    json += '}';
+  }
+
+  json += '}';
+  return json;
+}
+
+
+bool Capture::parse( const char *spec, capture_trigger *triggers ) {
+  capture_trigger parsed[ CAPTURE_TRIGGERS ];
+  memset( parsed, 0, sizeof(parsed) );
+
+  const char *p = spec;
+  byte        n = 0;
+
+  while ( true ) {
+    while ( *p == ' ' ) p++;
+    if ( *p == '\0' ) break;
+    if ( n == CAPTURE_TRIGGERS ) return false;
+
+    capture_trigger &trigger = parsed[ n++ ];
+
+    if ( *p != CAPTURE_ABOVE && *p != CAPTURE_BELOW && *p != CAPTURE_RISE && *p != CAPTURE_FALL ) return false;
+    trigger.type = *p++;
+
+    if ( !Sensor::parse_fixed( p, trigger.threshold ) ) return false;
+    if ( ( trigger.type == CAPTURE_RISE || trigger.type == CAPTURE_FALL ) && trigger.threshold <= 0 ) return false;
+
+    while ( *p == ' ' ) p++;
+    if ( *p == ',' ) p++;
+    else if ( *p != '\0' ) return false;
+  }
+
+  memcpy( triggers, parsed, sizeof(parsed) );
+  return true;
+}
+
+
+String Capture::format( const capture_trigger *triggers ) {
+  String spec;
+
+  for ( byte i = 0; i < CAPTURE_TRIGGERS; i++ ) {
+    if ( triggers[i].type == 0 ) continue;
+    if ( spec.length() > 0 ) spec += ',';
+    format_trigger( triggers[i], spec );
+  }
+  return spec;
+}
@@ -0,0 +1,142 @@
+//
+// Capture.h - Library for triggered burst capture on the analog
+//             pressure input.  The ADC is sampled continuously into a
+//             pre-trigger ring; a threshold or slope trigger freezes
+//             a window around the event for /capture and the DB.
+//             While any trigger is set loop() can't idle, so capture
+//             and WiFi light sleep are mutually exclusive.
+//
+
+#ifndef Capture_h
+#define Capture_h
+
+#include "Arduino.h"
+#include "Calibration.h"
+
+class Config;
+class Clock;
+
+// How the pressure is compared with a trigger's threshold
+#define CAPTURE_ABOVE       '>'   // Crosses above
+#define CAPTURE_BELOW       '<'   // Crosses below
+#define CAPTURE_RISE        '+'   // Rises more than threshold within CAPTURE_SLOPE samples
+#define CAPTURE_FALL        '-'   // Falls more than threshold within CAPTURE_SLOPE samples
+
+#define CAPTURE_TRIGGERS    2     // Triggers kept in Config
+
+#define CAPTURE_PERIOD_US   5000  // Between samples, 200 Hz.  analogRead() much more often
+                                  // than every few ms starves the WiFi stack and drops the AP
+#define CAPTURE_RING        256   // Samples always kept, the pre-trigger history..
+#define CAPTURE_PRE         128   // ..of which this many go in front of the trigger
+#define CAPTURE_WINDOW      512   // Samples in a capture, the rest after the trigger
+#define CAPTURE_SLOPE       10    // Samples a slope trigger looks back
+#define CAPTURE_AVERAGE     64    // Samples in the periodic reading, as read_analog() takes
+#define CAPTURE_HOLDOFF     30    // Seconds after a capture before the next can trigger
+
+#define CAPTURE_MAGIC       0x31504143    // "CAP1"
+
+// A sample: 10 bit ADC counts, and the periods missed before it in
+// the top 6 bits, when the loop was held up elsewhere
+#define CAPTURE_VALUE_MASK  0x03ff
+#define CAPTURE_GAP_SHIFT   10
+#define CAPTURE_GAP_MAX     63
+
+
+//
+// One trigger, stored in Config.  Written as a spec string in the
+// settings and /config, in calibrated pressure units:
+//   <type><threshold>
+// e.g. ">150" - pressure crosses above 150.  "+20" - pressure jumps
+// by more than 20 within CAPTURE_SLOPE samples (50 ms).
+struct capture_trigger {
+  char     type;           // CAPTURE_ABOVE, _BELOW, _RISE or _FALL, 0 - unused
+  int32_t  threshold;      // Hundredths
+};
+
+//
+// A frozen capture as served on /capture (website/capture.py decodes
+// it) and sent to the DB base64 encoded: this header then count
+// samples, little endian
+struct capture_header {
+  uint32_t  magic;         // CAPTURE_MAGIC
+  uint32_t  seq;           // Captures since boot
+  uint32_t  timestamp;     // Unix time of the trigger, 0 if the clock isn't set
+  uint16_t  period_us;     // Between samples without a gap
+  uint16_t  count;         // Samples after the header
+  uint16_t  pre;           // Samples before the one that triggered
+  uint16_t  missed;        // Periods missed in the window, from the gaps
+  int32_t   threshold;     // Of the trigger that fired, hundredths
+  int32_t   value;         // Pressure that set it off, hundredths
+  int32_t   low;           // Pressure range over the window, hundredths
+  int32_t   high;
+  char      type;          // Of the trigger that fired
+  uint8_t   reserved[3];
+  cal_table cal;           // Pressure calibration, counts * 100 -> pressure
+};
+
+
+//
+// Capture Library Class
+class Capture
+{
+  public:
+    void begin( Config *config, Clock *clock );
+    void loop();
+    String JSON();
+
+    // Sampling, so the main loop shouldn't sleep
+    bool active();
+
+    // Sum of CAPTURE_AVERAGE samples across the ring for the periodic
+    // reading, false when not sampling
+    bool average( uint16_t &sum );
+
+    // The last capture, seq() 0 if none yet.  size() is 0 while the
+    // next one is being filled in.
+    uint32_t seq();
+    const capture_header& header();
+    const uint8_t* data();
+    size_t size();
+
+    // Trigger specs, comma separated, to and from the config triggers.
+    // parse() leaves triggers alone and returns false on a bad spec.
+    static bool   parse( const char *spec, capture_trigger *triggers );
+    static String format( const capture_trigger *triggers );
+
+  private:
+    Config *_config;
+    Clock  *_clock;
+
+    uint16_t      _ring[ CAPTURE_RING ];
+    uint16_t      _ring_head     = 0;
+    uint16_t      _ring_count    = 0;
+    unsigned long _next_us       = 0;
+    bool          _sampling      = false;
+    uint16_t      _since_gap     = 0;   // Samples since the last gap, for slopes
+    int32_t       _last          = 0;   // Previous pressure, hundredths
+
+    // Frozen window, header and samples together so it goes out as is
+    struct {
+      capture_header header;
+      uint16_t       samples[ CAPTURE_WINDOW ];
+    } _capture;
+    bool          _filling       = false;
+    uint16_t      _filled        = 0;
+    unsigned long _rearm_at      = 0;   // millis() triggers are checked again
+
+    // Since boot, for /capture?status
+    uint32_t      _samples       = 0;
+    uint32_t      _missed        = 0;
+    uint32_t      _captures      = 0;
+
+    void start();
+    void sample( uint16_t counts, unsigned long missed );
+    int  triggered( int32_t pressure );
+    void trigger( byte index, int32_t pressure );
+    void finish();
+    int32_t pressure( uint16_t counts );
+    uint16_t ring_at( uint16_t back );
+    void configChanged( uint64_t changed );
+};
+
+#endif
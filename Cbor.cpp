@@ -0,0 +1,86 @@
+//
+// Cbor.cpp - Minimal CBOR (RFC 7049) encoder for the binary API responses
+//
+
+#include "Cbor.h"
+
+// Major types
+#define CBOR_UINT    0
+#define CBOR_NINT    1
+#define CBOR_TEXT    3
+#define CBOR_ARRAY   4
+#define CBOR_MAP     5
+#define CBOR_SIMPLE  7
+
+
+CborWriter::CborWriter( Print &out ) : _out( out ) {
+  _len      = 0;
+  _overflow = false;
+}
+
+
+void CborWriter::put( uint8_t b ) {
+  if ( _overflow ) return;
+  if ( _out.write( b ) != 1 ) {
+    _overflow = true;
+    return;
+  }
+  _len++;
+}
+
+
+// Write a major type with its argument in the shortest encoding
+void CborWriter::head( uint8_t major, uint32_t value ) {
+  major <<= 5;
+
+  if ( value < 24 ) {
+    put( major | value );
+  } else if ( value <= 0xFF ) {
+    put( major | 24 );
+    put( value );
+  } else if ( value <= 0xFFFF ) {
+    put( major | 25 );
+    put( value >> 8 );
+    put( value );
+  } else {
+    put( major | 26 );
+    put( value >> 24 );
+    put( value >> 16 );
+    put( value >> 8 );
+    put( value );
+  }
+}
+
+
+void CborWriter::map( size_t pairs )   { head( CBOR_MAP, pairs ); }
+void CborWriter::array( size_t items ) { head( CBOR_ARRAY, items ); }
+void CborWriter::uint( uint32_t value ) { head( CBOR_UINT, value ); }
+
+void CborWriter::sint( int32_t value ) {
+  if ( value >= 0 )
+    head( CBOR_UINT, value );
+  else
+    head( CBOR_NINT, -1 - value );
+}
+
+void CborWriter::text( const char *str ) {
+  size_t len = strlen( str );
+
+  head( CBOR_TEXT, len );
+  for ( size_t i = 0; i < len; i++ )
+    put( str[i] );
+}
+
+void CborWriter::boolean( bool value ) { put( ( CBOR_SIMPLE << 5 ) | ( value ? 21 : 20 ) ); }
+void CborWriter::null()                { put( ( CBOR_SIMPLE << 5 ) | 22 ); }
+
+void CborWriter::fixed( int32_t value, bool valid ) {
+  if ( valid )
+    sint( value );
+  else
+    null();
+}
+
+
+size_t CborWriter::length()   { return _len; }
+bool   CborWriter::overflow() { return _overflow; }
@@ -0,0 +1,46 @@
+//
+// Cbor.h - Minimal CBOR (RFC 7049) encoder for the binary API responses
+//
+
+#ifndef Cbor_h
+#define Cbor_h
+
+#include "Arduino.h"
+
+#define CBOR_MIME   "application/cbor"
+
+
+//
+// CborWriter Class
+// Encodes straight into a Print, e.g. an AsyncResponseStream, so no
+// buffer is needed on the way.  A byte the Print doesn't take (out of
+// heap) sets the overflow flag.
+class CborWriter
+{
+  public:
+    CborWriter( Print &out );
+
+    void map( size_t pairs );
+    void array( size_t items );
+    void uint( uint32_t value );
+    void sint( int32_t value );
+    void text( const char *str );
+    void boolean( bool value );
+    void null();
+
+    // Fixed-point value, or null if the reading isn't available
+    void fixed( int32_t value, bool valid );
+
+    size_t length();
+    bool   overflow();
+
+  private:
+    Print  &_out;
+    size_t  _len;
+    bool    _overflow;
+
+    void head( uint8_t major, uint32_t value );
+    void put( uint8_t b );
+};
+
+#endif
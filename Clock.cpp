@@ -0,0 +1,182 @@
+//
+// Clock.cpp - Library for keeping wall-clock time, synced over SNTP
+//             with drift compensation between syncs
+//
+
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+
+#include "Clock.h"
+#include "Log.h"
+
+
+Clock::Clock() {
+}
+
+
+// Pick up the time saved before a restart (if any), then try a sync
+void Clock::begin() {
+  clock_rtc rtc;
+
+  if ( ESP.rtcUserMemoryRead( CLOCK_RTC_BLOCK, (uint32_t *)&rtc, sizeof(rtc) ) &&
+       rtc.magic == CLOCK_RTC_MAGIC &&
+       rtc.check == ( rtc.magic ^ rtc.epoch_hi ^ rtc.epoch_lo ^ (uint32_t)rtc.drift_ppm ) ) {
+
+    // We've been running for millis() since the save
+    _base_ms     = ( ( (uint64_t)rtc.epoch_hi << 32 ) | rtc.epoch_lo ) + millis();
+    _base_millis = millis();
+    _drift_ppm   = rtc.drift_ppm;
+    _valid       = true;
+
+    LOG_INFO( LOG_CLOCK, "Restored time from RTC memory: %u  drift: %.2f ppm", now(), (double)_drift_ppm );
+  }
+
+  // Only good for one boot, a crash or power loss would make it stale
+  memset( &rtc, 0, sizeof(rtc) );
+  ESP.rtcUserMemoryWrite( CLOCK_RTC_BLOCK, (uint32_t *)&rtc, sizeof(rtc) );
+
+  _udp.begin( NTP_LOCAL_PORT );
+  _next_sync = millis();
+}
+
+
+void Clock::loop() {
+  if ( millis() > _next_sync ) {
+    if ( WiFi.status() != WL_CONNECTED ) {
+      _next_sync = millis() + NTP_RETRY_INTERVAL * 1000;
+      return;
+    }
+
+    if ( sync() )
+      _next_sync = millis() + NTP_SYNC_INTERVAL * 1000UL;
+    else
+      _next_sync = millis() + NTP_RETRY_INTERVAL * 1000;
+  }
+}
+
+
+// Save the current time to RTC memory ahead of an ESP.restart()
+void Clock::save() {
+  if ( !_valid ) return;
+
+  uint64_t  ms = now_ms();
+  clock_rtc rtc;
+
+  rtc.magic     = CLOCK_RTC_MAGIC;
+  rtc.epoch_hi  = ms >> 32;
+  rtc.epoch_lo  = ms & 0xFFFFFFFF;
+  rtc.drift_ppm = _drift_ppm;
+  rtc.check     = rtc.magic ^ rtc.epoch_hi ^ rtc.epoch_lo ^ (uint32_t)rtc.drift_ppm;
+
+  ESP.rtcUserMemoryWrite( CLOCK_RTC_BLOCK, (uint32_t *)&rtc, sizeof(rtc) );
+}
+
+
+// Sync to NTP and update the drift estimate
+bool Clock::sync() {
+  uint64_t epoch_ms;
+  uint32_t at_millis;
+
+  if ( !query( epoch_ms, at_millis ) ) {
+    LOG_WARN( LOG_CLOCK, "NTP sync failed" );
+    return false;
+  }
+
+  // How far off we were, for the log
+  int32_t offset = _valid ? (int32_t)( (int64_t)( epoch_ms + ( millis() - at_millis ) ) - (int64_t)now_ms() ) : 0;
+
+  // Measure how fast millis() runs compared to NTP since the last sync
+  if ( _synced && epoch_ms - _sync_ms > NTP_DRIFT_MIN_SPAN * 1000ULL ) {
+    int64_t true_elapsed = epoch_ms - _sync_ms;
+    int64_t raw_elapsed  = at_millis - _sync_millis;
+    int32_t measured     = ( raw_elapsed - true_elapsed ) * 1000000 / true_elapsed;
+
+    // Smooth out the noise in the network delay
+    _drift_ppm = ( _drift_ppm == 0 ) ? measured : ( _drift_ppm * 3 + measured ) / 4;
+  }
+
+  if ( !_synced || epoch_ms - _sync_ms > NTP_DRIFT_MIN_SPAN * 1000ULL ) {
+    _sync_ms     = epoch_ms;
+    _sync_millis = at_millis;
+  }
+
+  _base_ms     = epoch_ms;
+  _base_millis = at_millis;
+  _valid       = true;
+  _synced      = true;
+
+  LOG_INFO( LOG_CLOCK, "NTP sync: %u  offset: %ld ms  drift: %.2f ppm", now(), (long)offset, (double)_drift_ppm );
+  return true;
+}
+
+
+// Send one SNTP request and wait for the reply.  The result is
+// corrected by half the round trip time.
+bool Clock::query( uint64_t &epoch_ms, uint32_t &at_millis ) {
+  IPAddress server;
+  uint8_t   packet[48];
+
+  if ( !WiFi.hostByName( NTP_SERVER, server ) ) return false;
+
+  // Drop anything left over from an earlier request
+  while ( _udp.parsePacket() > 0 ) _udp.flush();
+
+  memset( packet, 0, sizeof(packet) );
+  packet[0] = 0x23;   // LI 0, version 4, mode 3 (client)
+
+  uint32_t sent = millis();
+  _udp.beginPacket( server, NTP_PORT );
+  _udp.write( packet, sizeof(packet) );
+  if ( !_udp.endPacket() ) return false;
+
+  while ( millis() - sent < NTP_TIMEOUT ) {
+    if ( _udp.parsePacket() >= (int)sizeof(packet) ) {
+      at_millis = millis();
+      _udp.read( packet, sizeof(packet) );
+
+      // Transmit timestamp, seconds and fraction since 1900
+      uint32_t secs = ( (uint32_t)packet[40] << 24 ) | ( (uint32_t)packet[41] << 16 ) | ( (uint32_t)packet[42] << 8 ) | packet[43];
+      uint32_t frac = ( (uint32_t)packet[44] << 24 ) | ( (uint32_t)packet[45] << 16 ) | ( (uint32_t)packet[46] << 8 ) | packet[47];
+
+      if ( secs < NTP_UNIX_OFFSET ) return false;   // Kiss-o'-death or garbage
+
+      epoch_ms = (uint64_t)( secs - NTP_UNIX_OFFSET ) * 1000 + ( ( (uint64_t)frac * 1000 ) >> 32 ) +
+                 ( at_millis - sent ) / 2;
+      return true;
+    }
+    delay( 10 );
+  }
+
+  return false;
+}
+
+
+bool    Clock::valid()     { return _valid; }
+bool    Clock::synced()    { return _synced; }
+int32_t Clock::drift_ppm() { return _drift_ppm; }
+
+
+uint64_t Clock::now_ms() {
+  if ( !_valid ) return 0;
+
+  uint32_t elapsed = millis() - _base_millis;
+  return _base_ms + elapsed - (int64_t)elapsed * _drift_ppm / 1000000;
+}
+
+
+uint32_t Clock::now() {
+  return now_ms() / 1000;
+}
+
+
+// Milliseconds (of millis()) until the wall clock reaches the next
+// multiple of interval seconds, e.g. :00/:10/:20 for 10.
+uint32_t Clock::millis_until( uint32_t interval ) {
+  if ( !_valid || interval == 0 ) return interval * 1000;
+
+  uint64_t period = interval * 1000ULL;
+  uint64_t ms     = now_ms();
+  uint32_t wait   = period - ( ms % period );
+
+  return wait + (int64_t)wait * _drift_ppm / 1000000;
+}
@@ -0,0 +1,73 @@
+//
+// Clock.h - Library for keeping wall-clock time, synced over SNTP
+//           with drift compensation between syncs
+//
+
+#ifndef Clock_h
+#define Clock_h
+
+#include <WiFiUdp.h>
+#include "defaults.h"
+
+#define NTP_SERVER           "pool.ntp.org"
+#define NTP_PORT             123
+#define NTP_LOCAL_PORT       2390
+#define NTP_TIMEOUT          1500        // ms to wait for a reply
+#define NTP_SYNC_INTERVAL    60*60       // Seconds between syncs
+#define NTP_RETRY_INTERVAL   60          // Seconds between failed attempts
+#define NTP_DRIFT_MIN_SPAN   60*10       // Seconds between syncs before drift is measured
+#define NTP_UNIX_OFFSET      2208988800UL  // Seconds from 1900 to 1970
+
+// RTC user memory used to carry the time over an ESP.restart().
+// The first 128 bytes (32 blocks) are reserved for OTA.
+#define CLOCK_RTC_BLOCK      32
+#define CLOCK_RTC_MAGIC      0x434C4B31
+
+
+//
+// State kept in RTC memory across a restart
+struct clock_rtc {
+  uint32_t magic;
+  uint32_t epoch_hi;       // epoch ms at the time of the save
+  uint32_t epoch_lo;
+  int32_t  drift_ppm;
+  uint32_t check;          // magic ^ epoch_hi ^ epoch_lo ^ drift_ppm
+};
+
+
+//
+// Clock Library Class
+class Clock
+{
+  public:
+    Clock();
+
+    void begin();
+    void loop();
+    bool sync();
+    void save();
+
+    bool     valid();                           // Wall-clock time is known
+    bool     synced();                          // ..and came from NTP since boot
+    uint32_t now();                             // Unix time, seconds
+    uint64_t now_ms();                          // Unix time, milliseconds
+    uint32_t millis_until( uint32_t interval ); // ms until the next multiple of interval seconds
+    int32_t  drift_ppm();
+
+  private:
+    WiFiUDP  _udp;
+    bool     _valid     = false;
+    bool     _synced    = false;
+    uint64_t _base_ms   = 0;       // Unix ms at _base_millis
+    uint32_t _base_millis = 0;
+    int32_t  _drift_ppm = 0;       // millis() runs fast by this much (parts per million)
+
+    uint64_t _sync_ms     = 0;     // Unix ms / millis() of the last NTP sync, for drift
+    uint32_t _sync_millis = 0;
+
+    unsigned long _next_sync = 0;
+
+    bool query( uint64_t &epoch_ms, uint32_t &at_millis );
+};
+
+#endif
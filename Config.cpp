@@ -21,16 +21,19 @@ Config::Config() {
 void Config::readConfig() {
   unsigned int current_version;
 
-  Serial.print( "READING CONFIG FROM EEPROM.  VERSION: " );
-
   // Read the config version number from eeprom
   EEPROM.get( EEPROM_CONFIG_START, current_version );
-  Serial.println( current_version, DEC );
+  LOG_INFO( LOG_CONFIG, "Reading config from EEPROM, version %u", current_version );
+
+  // Settings from an older version are carried over, anything else
+  // is a default config.
+  if ( current_version >= CONFIG_OLDEST && current_version < CONFIG_VERSION ) {
+    LOG_WARN( LOG_CONFIG, "Upgrading config from version %u", current_version );
+    migrate( current_version );
+    writeConfig();
 
-  // If config version is not something we can upgrade from,
-  // set a default config.
-  if ( current_version != CONFIG_VERSION ) {
-    Serial.println( "Unsupported or no config found in EEPROM.  Resettings to defaults." );
+  } else if ( current_version != CONFIG_VERSION ) {
+    LOG_WARN( LOG_CONFIG, "Unsupported or no config found in EEPROM.  Resetting to defaults." );
     conf = _defaults;
     writeConfig();
   }
@@ -40,103 +43,399 @@ void Config::readConfig() {
 }
 
 
+//
+// Custom parsing, for the members that need more than a copy or a
+// range check
+
+// Strings are cut to fit, and copied only up to the \0 so an
+// unchanged value leaves the member byte for byte the same
+static void copy_text( char *member, size_t size, const char *value ) {
+  size_t len = strnlen( value, size - 1 );
+  memcpy( member, value, len );
+  member[ len ] = '\0';
+}
+
+// SHA-1 of the server cert, as shown by browsers ("AB:CD:..") or
+// openssl.  Stored as bare hex, empty to pin to /ca.pem.
+static bool parse_fingerprint( configuration &conf, const char *value ) {
+  char hex[ MAX_DB_FINGERPRINT+1 ];
+  byte len = 0;
+
+  for ( ; *value; value++ ) {
+    char c = tolower( *value );
+    if ( isxdigit( c ) ) {
+      if ( len == MAX_DB_FINGERPRINT ) return false;
+      hex[ len++ ] = c;
+    } else if ( c != ':' && c != ' ' ) {
+      return false;
+    }
+  }
+
+  if ( len != 0 && len != MAX_DB_FINGERPRINT ) return false;
+
+  hex[ len ] = '\0';
+  strcpy( conf.db_fingerprint, hex );
+  return true;
+}
+
+// One digit, 0 (none) to 4 (debug), per LOG_* module
+static bool parse_log_levels( configuration &conf, const char *value ) {
+  if ( strlen( value ) != LOG_MODULES ) return false;
+  for ( const char *c = value; *c; c++ )
+    if ( *c < '0' || *c > '0' + LOG_LEVEL_DEBUG ) return false;
+
+  strcpy( conf.log_levels, value );
+  return true;
+}
+
+// Plain http, the webhook has no TLS setup of its own
+static bool parse_alert_url( configuration &conf, const char *value ) {
+  if ( *value && strncmp( value, "http://", 7 ) != 0 ) return false;
+
+  copy_text( conf.alert_url, sizeof(conf.alert_url), value );
+  return true;
+}
+
+// Rule specs, see Alerts.h.  Empty clears them.
+static bool parse_alert_rules( configuration &conf, const char *value ) {
+  return Alerts::parse( value, conf.alert_rules );
+}
+
+static String format_alert_rules( const configuration &conf ) {
+  return Alerts::format( conf.alert_rules );
+}
+
+// Calibration tables, see Calibration.h
+template <byte channel> static bool parse_cal( configuration &conf, const char *value ) {
+  return Calibration::parse( value, conf.cal[ channel ] );
+}
+
+template <byte channel> static String format_cal( const configuration &conf ) {
+  return Calibration::format( conf.cal[ channel ] );
+}
+
+// Capture trigger specs, see Capture.h.  Empty turns capture off.
+static bool parse_capture( configuration &conf, const char *value ) {
+  return Capture::parse( value, conf.capture );
+}
+
+static String format_capture( const configuration &conf ) {
+  return Capture::format( conf.capture );
+}
+
+// From the settings page, or /calibration for doing a batch of units
+#define CAL_FORMS  ( CONFIG_FORM_SETTINGS | CONFIG_FORM_CALIBRATION )
+
+
+//
+// Every setting.  JSON and CBOR list them in this order within their
+// group; a new setting is a member in configuration and a line here,
+// with since at the CONFIG_VERSION it comes in.
+static constexpr config_field _fields[] PROGMEM = {
+  //            key                     member               group                 form                  flags                      min         max          since  json              form name
+  CONFIG_FIELD( CONFIG_HOSTNAME,        hostname,            CONFIG_GROUP_TOP,     CONFIG_FORM_NETWORK,  0,                         0,          0,           5,     "hostname",       "hostname",       nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_LOG_LEVELS,      log_levels,          CONFIG_GROUP_TOP,     CONFIG_FORM_SETTINGS, 0,                         0,          0,           13,    "log_levels",     "log_levels",     parse_log_levels,        nullptr ),
+  CONFIG_FIELD( CONFIG_HTTP_PW,         http_pw,             CONFIG_GROUP_TOP,     CONFIG_FORM_SETTINGS, FIELD_HIDDEN,              0,          0,           5,     "http_pw",        "http_pw",        nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_HTTP_PORT,       http_server_port,    CONFIG_GROUP_TOP,     CONFIG_FORM_NONE,     FIELD_HIDDEN,              1,          65535,       5,     "http_port",      "http_port",      nullptr,                 nullptr ),
+
+  CONFIG_FIELD( CONFIG_DB_NAME,         db_name,             CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          0,           5,     "db_name",        "db_name",        nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_HOST,         db_host,             CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          0,           5,     "db_host",        "db_host",        nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_LOCATION,        location,            CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          0,           5,     "location",       "location",       nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_MEASUREMENT,  db_measurement,      CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          0,           5,     "db_measurement", "db_measurement", nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_TYPE,         db_type,             CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          3,           5,     "db_type",        "db_type",        nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_PORT,         db_port,             CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         1,          65534,       5,     "db_port",        "db_port",        nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_ORG,          db_org,              CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          0,           6,     "db_org",         "db_org",         nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_BUCKET,       db_bucket,           CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          0,           6,     "db_bucket",      "db_bucket",      nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_TOKEN,        db_token,            CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, FIELD_SECRET | FIELD_KEEP, 0,          0,           6,     "db_token",       "db_token",       nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_GZIP,         db_gzip,             CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, FIELD_BOOL,                0,          1,           6,     "db_gzip",        "db_gzip",        nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_FLUSH,        db_flush,            CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          3600,        9,     "db_flush",       "db_flush",       nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_TLS,          db_tls,              CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, FIELD_BOOL,                0,          1,           10,    "db_tls",         "db_tls",         nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DB_FINGERPRINT,  db_fingerprint,      CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          0,           10,    "db_fingerprint", "db_fingerprint", parse_fingerprint,       nullptr ),
+  CONFIG_FIELD( CONFIG_SAMPLE_INTERVAL, sample_interval,     CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         1,          86400,       5,     "interval",       "interval",       nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_DERIVED,         derived,             CONFIG_GROUP_DB,      CONFIG_FORM_SETTINGS, 0,                         0,          DERIVED_ALL, 7,     "derived",        "derived",        nullptr,                 nullptr ),
+
+  CONFIG_FIELD( CONFIG_SSID,            ssid,                CONFIG_GROUP_NET,     CONFIG_FORM_NETWORK,  0,                         0,          0,           5,     "ssid",           "ssid",           nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_WIFI_PW,         wifi_pw,             CONFIG_GROUP_NET,     CONFIG_FORM_NETWORK,  FIELD_SECRET | FIELD_KEEP, 0,          0,           5,     "pw",             "wifi_pw",        nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_SLEEP_MODE,      sleep_mode,          CONFIG_GROUP_NET,     CONFIG_FORM_SETTINGS, 0,                         SLEEP_NONE, SLEEP_LIGHT, 9,     "sleep",          "sleep",          nullptr,                 nullptr ),
+  CONFIG_FIELD( CONFIG_LISTEN_INTERVAL, listen_interval,     CONFIG_GROUP_NET,     CONFIG_FORM_SETTINGS, 0,                         1,          10,          9,     "listen",         "listen",         nullptr,                 nullptr ),
+
+  CONFIG_FIELD( CONFIG_ALERT_URL,       alert_url,           CONFIG_GROUP_ALERTS,  CONFIG_FORM_SETTINGS, 0,                         0,          0,           11,    "alert_url",      "alert_url",      parse_alert_url,         nullptr ),
+  CONFIG_FIELD( CONFIG_ALERT_RULES,     alert_rules,         CONFIG_GROUP_ALERTS,  CONFIG_FORM_SETTINGS, 0,                         0,          0,           11,    "alert_rules",    "alert_rules",    parse_alert_rules,       format_alert_rules ),
+
+  CONFIG_FIELD( CONFIG_CAL_TEMP,        cal[ CAL_TEMP ],     CONFIG_GROUP_CAL,     CAL_FORMS,            0,                         0,          0,           12,    "cal_t",          "cal_t",          parse_cal<CAL_TEMP>,     format_cal<CAL_TEMP> ),
+  CONFIG_FIELD( CONFIG_CAL_HUMIDITY,    cal[ CAL_HUMIDITY ], CONFIG_GROUP_CAL,     CAL_FORMS,            0,                         0,          0,           12,    "cal_h",          "cal_h",          parse_cal<CAL_HUMIDITY>, format_cal<CAL_HUMIDITY> ),
+  CONFIG_FIELD( CONFIG_CAL_PRESSURE,    cal[ CAL_PRESSURE ], CONFIG_GROUP_CAL,     CAL_FORMS,            0,                         0,          0,           12,    "cal_p",          "cal_p",          parse_cal<CAL_PRESSURE>, format_cal<CAL_PRESSURE> ),
+
+  CONFIG_FIELD( CONFIG_CAPTURE,         capture,             CONFIG_GROUP_CAPTURE, CONFIG_FORM_SETTINGS, 0,                         0,          0,           13,    "capture",        "capture",        parse_capture,           format_capture ),
+};
+
+#define CONFIG_FIELDS  ( sizeof(_fields) / sizeof(_fields[0]) )
+
+// Checked when building, set() copies the old value onto the stack
+// and a member of no type it knows has to come with a parse()
+static constexpr bool fields_ok() {
+  for ( const config_field &field : _fields ) {
+    if ( field.size > CONFIG_FIELD_MAX ) return false;
+    if ( field.type == FIELD_OTHER && ( !field.parse || !field.format ) ) return false;
+  }
+  return true;
+}
+static_assert( fields_ok(), "Config field too large, or missing its parse/format" );
+
+static const char _group_names[ CONFIG_GROUPS ][8] = { "", "db", "net", "alerts", "cal", "capture" };
+
+
+//
+// Members older versions had that configuration doesn't, or not at
+// the size it has them now.  Each followed the field keyed after.
+struct config_retired {
+  byte     key;            // CONFIG_*
+  byte     after;
+  byte     since;          // Versions it was in
+  byte     until;
+  uint16_t size;
+  byte     align;
+};
+
+static constexpr config_retired _retired[] PROGMEM = {
+  { CONFIG_T_OFFSET,   CONFIG_SAMPLE_INTERVAL, 5,  11, sizeof(float), alignof(float) },
+  { CONFIG_LOG_LEVELS, CONFIG_DERIVED,         8,  10, 9 + 1,         1 },   // Before LOG_ALERTS
+  { CONFIG_LOG_LEVELS, CONFIG_DERIVED,         11, 12, 10 + 1,        1 },   // Before LOG_CAPTURE
+};
+
+#define CONFIG_RETIRED  ( sizeof(_retired) / sizeof(_retired[0]) )
+
+
+static void read_field( size_t i, config_field &field ) {
+  memcpy_P( &field, &_fields[i], sizeof(field) );
+}
+
+// Integer members are read and written at their own width
+template <typename T> static uint32_t get_as( const byte *member ) {
+  T value;
+  memcpy( &value, member, sizeof(value) );
+  return value;
+}
+
+template <typename T> static void put_as( byte *member, uint32_t value ) {
+  T narrow = value;
+  memcpy( member, &narrow, sizeof(narrow) );
+}
+
+static uint32_t get_uint( const byte *member, uint16_t size ) {
+  switch ( size ) {
+    case 1:  return get_as<uint8_t>( member );
+    case 2:  return get_as<uint16_t>( member );
+    default: return get_as<uint32_t>( member );
+  }
+}
+
+static void put_uint( byte *member, uint16_t size, uint32_t value ) {
+  switch ( size ) {
+    case 1:  put_as<uint8_t>( member, value );   break;
+    case 2:  put_as<uint16_t>( member, value );  break;
+    default: put_as<uint32_t>( member, value );  break;
+  }
+}
+
+
+static bool find_field( byte key, config_field &field ) {
+  for ( size_t i = 0; i < CONFIG_FIELDS; i++ ) {
+    read_field( i, field );
+    if ( field.key == key ) return true;
+  }
+  return false;
+}
+
+
+//
+// Bring the settings of an older version over from the EEPROM.  The
+// compiler lays configuration out in member order, each member at its
+// alignment, so where the old version kept a member follows from the
+// members it had before it.  Whatever it didn't have is the default.
+void Config::migrate( unsigned int version ) {
+  config_field   field;
+  config_retired retired;
+  size_t         offset = sizeof( conf.version );
+  int            last   = -1;
+
+  conf = _defaults;
+
+  for ( ;; ) {
+    // The field after the last in member order, the table is in JSON order
+    int next = -1;
+    for ( size_t i = 0; i < CONFIG_FIELDS; i++ ) {
+      read_field( i, field );
+      if ( field.offset > last && ( next < 0 || field.offset < next ) ) next = field.offset;
+    }
+    if ( next < 0 ) break;
+
+    for ( size_t i = 0; i < CONFIG_FIELDS; i++ ) {
+      read_field( i, field );
+      if ( field.offset == next ) break;
+    }
+    last = next;
+
+    if ( field.since <= version )
+      migrate_member( field.key, version, offset, field.size, field.align );
+
+    for ( size_t i = 0; i < CONFIG_RETIRED; i++ ) {
+      memcpy_P( &retired, &_retired[i], sizeof(retired) );
+      if ( retired.after == field.key && retired.since <= version && version <= retired.until )
+        migrate_member( retired.key, version, offset, retired.size, retired.align );
+    }
+  }
+
+  // Modules added since start at their default level
+  size_t len = strlen( conf.log_levels );
+  memcpy( conf.log_levels + len, _defaults.log_levels + len, sizeof(conf.log_levels) - len );
+
+  conf.version = CONFIG_VERSION;
+}
+
+
+// One member of the old config, at offset (moved on past it)
+void Config::migrate_member( byte key, unsigned int version, size_t &offset, uint16_t size, byte align ) {
+  byte value[ CONFIG_FIELD_MAX + 1 ];   // No member is larger, fields_ok() checks
+
+  offset = ( offset + align - 1 ) / align * align;
+  for ( uint16_t i = 0; i < size; i++ )
+    value[i] = EEPROM.read( EEPROM_CONFIG_START + offset + i );
+  value[ size ] = '\0';
+  offset += size;
+
+  // The temperature offset is a one point table now
+  if ( key == CONFIG_T_OFFSET ) {
+    float t_offset;
+    memcpy( &t_offset, value, sizeof(t_offset) );
+    if ( t_offset != 0 && !isnan( t_offset ) )
+      Calibration::add_point( conf.cal[ CAL_TEMP ], 0, -lroundf( t_offset * 100 ) );
+    return;
+  }
+
+  config_field field;
+  if ( !find_field( key, field ) ) return;
+
+  byte *member = (byte *)&conf + field.offset;
+  if ( field.type == FIELD_TEXT ) {
+    copy_text( (char *)member, field.size, (const char *)value );
+  } else if ( field.type == FIELD_UINT ) {
+    put_uint( member, field.size, get_uint( value, size ) );
+  } else if ( size == field.size ) {
+    memcpy( member, value, size );
+  } else {
+    LOG_WARN( LOG_CONFIG, "Config key %u from version %u left at its default", key, version );
+  }
+}
+
+
 //
 // Update a value in the running config (does not commit)
 // Truncates strings that exceed the max length for any field.
-bool Config::set( int key, String value ) {
-  Serial.println( "Config::set( " + String(key) + ", " + value + ")" );
-
-  switch( key ) {
-    case CONFIG_HOSTNAME:
-      strcpy( conf.hostname, value.substring(0, MAX_HOSTNAME).c_str() );
-      break;
-    case CONFIG_SSID:
-      strcpy( conf.ssid, value.substring(0, MAX_SSID).c_str() );
-      break;
-    case CONFIG_WIFI_PW:
-      strcpy( conf.wifi_pw, value.substring(0, MAX_WIFI_PW).c_str() );
-      break;
-
-    case CONFIG_DB_TYPE:
-      // Convert string to int.  Valid range 0 - 2
-      unsigned short dbtype;
-      dbtype = value.toInt();
-
-      if ( dbtype >= 0 && dbtype < 3 )
-        conf.db_type = dbtype;
-      else
-        return false;
-
-      break;
-    
-    case CONFIG_DB_HOST:
-      strcpy( conf.db_host, value.substring(0, MAX_DB_HOST).c_str() );
-      break;
-
-    case CONFIG_DB_PORT:
-      // Convert string to int.  Valid port range 1 - 65535
-      long port;
-      port = value.toInt();
-
-      if ( port > 0 && port < 65535 )
-        conf.db_port = port;
-      else
-        return false;
-
-      break;
-
-    case CONFIG_DB_NAME:
-      strcpy( conf.db_name, value.substring(0, MAX_DB_NAME).c_str() );
-      break;
-
-    case CONFIG_SAMPLE_INTERVAL:
-      // Convert string to int.  Valid range 1 - 86400
-      long interval;
-      interval = value.toInt();
-
-      if ( interval > 0 && interval <= 86400 )
-        conf.sample_interval = interval;
-      else
-        return false;
-
-      break;
-
-    case CONFIG_DB_MEASUREMENT:
-      strcpy( conf.db_measurement, value.substring(0, MAX_DB_MEASUREMENT).c_str() );
-      break;
-
-    case CONFIG_LOCATION:
-      strcpy( conf.location, value.substring(0, MAX_LOCATION).c_str() );
-      break;
-
-    case CONFIG_HTTP_PW:
-      strcpy( conf.http_pw, value.substring(0, MAX_HTTP_PW).c_str() );
-      break;
-
-    case CONFIG_T_OFFSET:
-      conf.t_offset = atof(value.c_str());
-      break;
-
-    default:
-      Serial.println( "[Config::set] Unknown config key: " + String(key) + " = " + value );
-      return false;
+bool Config::set( int key, const char *value ) {
+  config_field field;
+
+  if ( find_field( key, field ) ) return set( field, value );
+
+  LOG_WARN( LOG_CONFIG, "Unknown config key: %d", key );
+  return false;
+}
+
+
+// A field posted to one of the settings forms.  Only fields that
+// belong to that form can be set from it; anything else posted isn't
+// a setting and is passed over.  False if the value is rejected.
+bool Config::set( const char *name, const char *value, byte form ) {
+  config_field field;
+
+  for ( size_t i = 0; i < CONFIG_FIELDS; i++ ) {
+    read_field( i, field );
+    if ( ( field.form & form ) && strcmp( field.name, name ) == 0 ) return set( field, value );
   }
 
+  LOG_DEBUG( LOG_CONFIG, "Not a setting: %s", name );
   return true;
+}
+
+
+bool Config::set( const config_field &field, const char *value ) {
+  // Not the value, it may be a password
+  LOG_DEBUG( LOG_CONFIG, "set( %u )", field.key );
 
+  // Passwords and tokens are only changed when a new one is given
+  if ( *value == '\0' && ( field.flags & FIELD_KEEP ) ) return true;
+
+  // Keep a copy to tell whether the value actually changed
+  byte *member = (byte *)&conf + field.offset;
+  byte  before[ CONFIG_FIELD_MAX ];
+  memcpy( before, member, field.size );
+
+  if ( field.parse ) {
+    if ( !field.parse( conf, value ) ) return false;
+
+  } else if ( field.type == FIELD_TEXT ) {
+    copy_text( (char *)member, field.size, value );
+
+  } else if ( field.type == FIELD_UINT ) {
+    long number = atol( value );
+    if ( field.flags & FIELD_BOOL ) number = ( number != 0 );
+    if ( number < field.min || number > field.max ) return false;
+    put_uint( member, field.size, number );
+
+  } else {
+    return false;
+  }
+
+  // Strings only up to the \0, whatever was left past it doesn't count
+  bool changed = ( field.type == FIELD_TEXT ) ? strcmp( (const char *)before, (const char *)member ) != 0
+                                              : memcmp( before, member, field.size ) != 0;
+  if ( changed )
+    _changed |= CONFIG_BIT( field.key );
+
+  return true;
 }
 
 
-// Save the running config
-void Config::writeConfig() {
-  Serial.print( "Clearing EEPROM, size: " );
-  Serial.println( EEPROM.length() );
-  for (int i = 0 ; i < EEPROM.length() ; i++) {
-    EEPROM.write(i, 0);
+// Register a function to be told about config changes
+void Config::onChange( ConfigListener listener ) {
+  if ( _listener_count >= CONFIG_MAX_LISTENERS ) {
+    LOG_ERROR( LOG_CONFIG, "Too many change listeners" );
+    return;
   }
-  EEPROM.commit();
-  
-  Serial.println( "Writing config to EEPROM" );
+
+  _listeners[ _listener_count++ ] = listener;
+}
+
+
+// Hand any changes made since the last call to the listeners.  Runs
+// from the main loop so subsystems never see a change mid-operation.
+void Config::loop() {
+  if ( _changed == 0 ) return;
+
+  uint64_t changed = _changed;
+  _changed = 0;
+
+  for ( byte i = 0; i < _listener_count; i++ )
+    _listeners[i]( changed );
+}
+
+
+// Put back the config as it was, and forget whatever was set since,
+// so listeners aren't told about changes that were undone
+void Config::save( snapshot &to ) {
+  to.conf    = conf;
+  to.changed = _changed;
+}
+
+void Config::restore( const snapshot &from ) {
+  conf     = from.conf;
+  _changed = from.changed;
+}
+
+
+// Save the running config.  A single commit, so one sector erase.
+void Config::writeConfig() {
+  LOG_INFO( LOG_CONFIG, "Writing config to EEPROM" );
   EEPROM.put( EEPROM_CONFIG_START, conf );
   EEPROM.commit();
 }
@@ -146,36 +445,130 @@ void Config::writeConfig() {
 void Config::resetConfig() {
   conf = _defaults;
   writeConfig();
+
+  _changed = ~0ULL;
+}
+
+
+// Quotes and backslashes escaped, nothing else needs it here
+void Config::json_text( Print &out, const char *text ) {
+  for ( ; *text; text++ ) {
+    if ( *text == '"' || *text == '\\' ) out.print( '\\' );
+    out.print( *text );
+  }
+}
+
+void Config::json_text( String &out, const char *text ) {
+  for ( ; *text; text++ ) {
+    if ( *text == '"' || *text == '\\' ) out += '\\';
+    out += *text;
+  }
 }
 
 
-// Returns a JSON String of the current config
-String Config::JSON(String macaddr) {
-  bool wifiPassSaved = false;
-
-  if (String(conf.wifi_pw).length() > 0)
-    wifiPassSaved = true;
-  
-  String jsonstr = "{\"ver\": \"" + String(conf.version) + "\", " 
-                   "\"ino_ver\": \"" + INO_VERSION + "\", "
-                   "\"mac\": \"" + macaddr + "\", "
-                   "\"hostname\": \"" + String(conf.hostname) + "\", "
-                   "\"db\": {"
-                       "\"db_name\": \"" + String(conf.db_name) + "\", "
-                       "\"db_host\": \"" + String(conf.db_host) + "\", "
-                       "\"location\": \"" + String(conf.location) + "\", "
-                       "\"db_measurement\": \"" + String(conf.db_measurement) + "\", "
-                       "\"db_type\": \"" + String(conf.db_type) + "\", "
-                       "\"db_port\": \"" + String(conf.db_port) + "\", "
-                       "\"interval\": \"" + String(conf.sample_interval) + "\", "
-                       "\"t_offset\": \"" + String(conf.t_offset) + "\""
-                       "}, "
-                   "\"net\": {"
-                       "\"ssid\": \"" + String(conf.ssid) + "\", "
-                       "\"pw\": \"" + String(wifiPassSaved) + "\""
-                       "}"
-                   "}";
-
-  return jsonstr;
+void Config::json_value( Print &out, const config_field &field ) {
+  const byte *member = (const byte *)&conf + field.offset;
+
+  if ( field.flags & FIELD_SECRET ) {
+    out.print( member[0] ? '1' : '0' );
+
+  } else if ( field.format ) {
+    json_text( out, field.format( conf ).c_str() );
+
+  } else if ( field.type == FIELD_TEXT ) {
+    json_text( out, (const char *)member );
+
+  } else if ( field.type == FIELD_UINT ) {
+    out.print( get_uint( member, field.size ) );
+  }
 }
 
+
+// Writes the current config as JSON, straight to out so there's no
+// String to build.  Values are all strings, as the web UI expects.
+void Config::JSON( Print &out, const String &macaddr ) {
+  config_field field;
+
+  out.print( "{\"ver\": \"" );        out.print( conf.version );
+  out.print( "\", \"ino_ver\": \"" ); out.print( INO_VERSION );
+  out.print( "\", \"mac\": \"" );     out.print( macaddr );
+  out.print( '"' );
+
+  for ( byte group = CONFIG_GROUP_TOP; group < CONFIG_GROUPS; group++ ) {
+    if ( group != CONFIG_GROUP_TOP ) {
+      out.print( ", \"" );  out.print( _group_names[ group ] );  out.print( "\": {" );
+    }
+
+    bool first = ( group != CONFIG_GROUP_TOP );
+    for ( size_t i = 0; i < CONFIG_FIELDS; i++ ) {
+      read_field( i, field );
+      if ( field.group != group || ( field.flags & FIELD_HIDDEN ) ) continue;
+
+      if ( !first ) out.print( ", " );
+      first = false;
+
+      out.print( '"' );  out.print( field.json );  out.print( "\": \"" );
+      json_value( out, field );
+      out.print( '"' );
+    }
+
+    if ( group != CONFIG_GROUP_TOP ) out.print( '}' );
+  }
+
+  out.print( '}' );
+}
+
+
+void Config::cbor_value( CborWriter &cbor, const config_field &field ) {
+  const byte *member = (const byte *)&conf + field.offset;
+
+  if ( field.flags & FIELD_SECRET ) {
+    cbor.boolean( member[0] != '\0' );
+
+  } else if ( field.format ) {
+    cbor.text( field.format( conf ).c_str() );
+
+  } else if ( field.type == FIELD_TEXT ) {
+    cbor.text( (const char *)member );
+
+  } else if ( field.type == FIELD_UINT ) {
+    if ( field.flags & FIELD_BOOL ) cbor.boolean( get_uint( member, field.size ) != 0 );
+    else                            cbor.uint( get_uint( member, field.size ) );
+
+  } else {
+    cbor.null();
+  }
+}
+
+
+// Encodes the current config as CBOR.  Same layout as JSON(), but
+// numbers are sent as numbers.
+void Config::CBOR( CborWriter &cbor, const String &macaddr ) {
+  config_field field;
+  byte         count[ CONFIG_GROUPS ] = {};
+
+  for ( size_t i = 0; i < CONFIG_FIELDS; i++ ) {
+    read_field( i, field );
+    if ( !( field.flags & FIELD_HIDDEN ) ) count[ field.group ]++;
+  }
+
+  cbor.map( 3 + count[ CONFIG_GROUP_TOP ] + CONFIG_GROUPS - 1 );
+  cbor.text( "ver" );       cbor.uint( conf.version );
+  cbor.text( "ino_ver" );   cbor.text( INO_VERSION );
+  cbor.text( "mac" );       cbor.text( macaddr.c_str() );
+
+  for ( byte group = CONFIG_GROUP_TOP; group < CONFIG_GROUPS; group++ ) {
+    if ( group != CONFIG_GROUP_TOP ) {
+      cbor.text( _group_names[ group ] );
+      cbor.map( count[ group ] );
+    }
+
+    for ( size_t i = 0; i < CONFIG_FIELDS; i++ ) {
+      read_field( i, field );
+      if ( field.group != group || ( field.flags & FIELD_HIDDEN ) ) continue;
+
+      cbor.text( field.json );
+      cbor_value( cbor, field );
+    }
+  }
+}
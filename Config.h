@@ -6,11 +6,22 @@
 #ifndef Config_h
 #define Config_h
 
+#include <functional>
+#include <type_traits>
+#include <stddef.h>
+
 #include "Arduino.h"
 #include "defaults.h"
+#include "Cbor.h"
+#include "Derived.h"
+#include "Alerts.h"
+#include "Calibration.h"
+#include "Capture.h"
+#include "Log.h"
 
-#define CONFIG_VERSION           5
-#define EEPROM_SIZE              512
+#define CONFIG_VERSION           13
+#define CONFIG_OLDEST            5       // Oldest version whose settings are carried over
+#define EEPROM_SIZE              1024
 #define EEPROM_CONFIG_START      0
 
 #define DEFAULT_HOSTNAME         "esp-dht-1"
@@ -19,11 +30,20 @@
 #define DEFAULT_SSID             "SightUnseenFarm"
 #define DEFAULT_WIFI_PW          "PASSWORD"        // Also the default AP password
 #define DEFAULT_HTTP_PW          "admin"
-#define DEFAULT_T_OFFSET         0
+#define DEFAULT_DERIVED          DERIVED_HINDEX
+#define DEFAULT_LOG_LEVELS       "33333333333"     // LOG_LEVEL_INFO for each LOG_* module
+#define DEFAULT_SLEEP_MODE       SLEEP_MODEM
+#define DEFAULT_LISTEN_INTERVAL  3                 // DTIM periods between wakes
+#define DEFAULT_DB_FLUSH         120               // Seconds between batched sends
+
+// The transducer's nominal 0 - 200 over the ADC's 1024 counts, less
+// the offset measured on the first units
+#define DEFAULT_CAL_PRESSURE     { 2, { 0, 102400 }, { -335, 19665 } }
 
 #define CONFIG_HOSTNAME        1
 #define CONFIG_LOCATION        2
 #define CONFIG_HTTP_PW         3
+#define CONFIG_HTTP_PORT       4
 #define CONFIG_SSID            10
 #define CONFIG_WIFI_PW         11
 #define CONFIG_DB_HOST         20
@@ -31,8 +51,65 @@
 #define CONFIG_DB_NAME         22
 #define CONFIG_DB_MEASUREMENT  23
 #define CONFIG_SAMPLE_INTERVAL 24
-#define CONFIG_T_OFFSET        25
+#define CONFIG_T_OFFSET        25    // Versions 5 - 11, now CONFIG_CAL_TEMP
 #define CONFIG_DB_TYPE         26
+#define CONFIG_DB_ORG          27
+#define CONFIG_DB_BUCKET       28
+#define CONFIG_DB_TOKEN        29
+#define CONFIG_DB_GZIP         30
+#define CONFIG_DERIVED         31
+#define CONFIG_LOG_LEVELS      32
+#define CONFIG_SLEEP_MODE      33
+#define CONFIG_LISTEN_INTERVAL 34
+#define CONFIG_DB_FLUSH        35
+#define CONFIG_DB_TLS          36
+#define CONFIG_DB_FINGERPRINT  37
+#define CONFIG_ALERT_URL       38
+#define CONFIG_ALERT_RULES     39
+#define CONFIG_CAL_TEMP        40    // CONFIG_CAL_TEMP + CAL_*
+#define CONFIG_CAL_HUMIDITY    41
+#define CONFIG_CAL_PRESSURE    42
+#define CONFIG_CAPTURE         43
+
+// Change notification masks, one bit per CONFIG_* key
+#define CONFIG_BIT(key)        ( 1ULL << (key) )
+#define CONFIG_DB_CHANGES      ( CONFIG_BIT(CONFIG_DB_TYPE) | CONFIG_BIT(CONFIG_DB_HOST) | CONFIG_BIT(CONFIG_DB_PORT) | \
+                                 CONFIG_BIT(CONFIG_DB_NAME) | CONFIG_BIT(CONFIG_DB_ORG) | CONFIG_BIT(CONFIG_DB_BUCKET) | \
+                                 CONFIG_BIT(CONFIG_DB_TOKEN) | CONFIG_BIT(CONFIG_DB_GZIP) | CONFIG_BIT(CONFIG_DB_TLS) | \
+                                 CONFIG_BIT(CONFIG_DB_FINGERPRINT) )
+#define CONFIG_WIFI_CHANGES    ( CONFIG_BIT(CONFIG_SSID) | CONFIG_BIT(CONFIG_WIFI_PW) )
+#define CONFIG_SLEEP_CHANGES   ( CONFIG_BIT(CONFIG_SLEEP_MODE) | CONFIG_BIT(CONFIG_LISTEN_INTERVAL) )
+
+#define CONFIG_MAX_LISTENERS   8
+
+// Where a field shows up in JSON and CBOR..
+#define CONFIG_GROUP_TOP       0
+#define CONFIG_GROUP_DB        1
+#define CONFIG_GROUP_NET       2
+#define CONFIG_GROUP_ALERTS    3
+#define CONFIG_GROUP_CAL       4
+#define CONFIG_GROUP_CAPTURE   5
+#define CONFIG_GROUPS          6
+
+// ..and the forms that set it (bitmask)
+#define CONFIG_FORM_NONE       0
+#define CONFIG_FORM_SETTINGS   1     // POST /settings
+#define CONFIG_FORM_NETWORK    2     // POST /network
+#define CONFIG_FORM_CALIBRATION 4    // POST /calibration
+
+#define CONFIG_FIELD_MAX       128   // Largest member a field can be, bytes
+#define CONFIG_NAME_MAX        16    // JSON and form names, with the \0
+
+// How a field's member is stored, worked out from its declared type
+#define FIELD_TEXT             0     // char[], truncated to fit
+#define FIELD_UINT             1     // Unsigned integer of any width, min - max
+#define FIELD_OTHER            2     // Only through the field's parse/format
+
+// Field flags
+#define FIELD_SECRET           0x01  // Shown as whether it's set, never the value
+#define FIELD_KEEP             0x02  // An empty form value leaves it as it is
+#define FIELD_BOOL             0x04  // Any non-zero value is 1, a boolean in CBOR
+#define FIELD_HIDDEN           0x08  // Not in JSON or CBOR
 
 #define MAX_HOSTNAME  20
 #define MAX_LOCATION  20
@@ -42,11 +119,21 @@
 #define MAX_DB_HOST   64
 #define MAX_DB_NAME   20
 #define MAX_DB_MEASUREMENT 20
+#define MAX_DB_ORG    32
+#define MAX_DB_BUCKET 32
+#define MAX_DB_TOKEN  100
+#define MAX_DB_FINGERPRINT 40       // SHA-1, hex
 
 // Database Types
 #define DB_TYPE_NONE       0
 #define DB_TYPE_INFLUXDB   1
 #define DB_TYPE_HTTP       2
+#define DB_TYPE_INFLUXDB2  3
+
+// WiFi power saving between sends
+#define SLEEP_NONE         0
+#define SLEEP_MODEM        1
+#define SLEEP_LIGHT        2
 
 
 //
@@ -65,20 +152,83 @@ struct configuration {
   char wifi_pw[ MAX_WIFI_PW+1 ];
 
   // Database Settings
-  byte           db_type;             // 0 - none, 1 - influxdb, 2 - http
+  byte           db_type;             // 0 - none, 1 - influxdb, 2 - http, 3 - influxdb 2.x
   char           db_host[ MAX_DB_HOST+1 ];
   unsigned short db_port;
   char           db_name[ MAX_DB_NAME+1 ];
   char           db_measurement[ MAX_DB_MEASUREMENT+1 ];  // Measurement string
+  char           db_org[ MAX_DB_ORG+1 ];        // InfluxDB 2.x only
+  char           db_bucket[ MAX_DB_BUCKET+1 ];  // InfluxDB 2.x only
+  char           db_token[ MAX_DB_TOKEN+1 ];    // InfluxDB 2.x only
+  byte           db_gzip;             // 1 - gzip request bodies
+  unsigned short db_flush;            // Seconds between sends of batched points, 0 - every sample
+  byte           db_tls;              // 1 - https
+  char           db_fingerprint[ MAX_DB_FINGERPRINT+1 ];  // Server cert pin, empty - CA in /ca.pem
 
   unsigned int sample_interval;
 
-  // Temperature offset
-  float t_offset;
+  // Derived metrics to compute (DERIVED_* bitmask)
+  byte derived;
+
+  // Log level digit for each LOG_* module
+  char log_levels[ LOG_MODULES+1 ];
+
+  // WiFi power saving
+  byte sleep_mode;                    // SLEEP_* mode while the radio isn't needed
+  byte listen_interval;               // 1 - 10 DTIM periods between beacon wakes
+
+  // Alerts, pushed to the webhook as they fire and clear
+  char       alert_url[ MAX_ALERT_URL+1 ];   // http:// only, empty - alerts are only logged
+  alert_rule alert_rules[ ALERT_RULES ];
+
+  // Raw reading -> calibrated, per CAL_* channel
+  cal_table cal[ CAL_CHANNELS ];
+
+  // Burst capture on the pressure input, off with no triggers
+  capture_trigger capture[ CAPTURE_TRIGGERS ];
 
 };
 
 
+//
+// One setting: everything set(), JSON(), CBOR() and the forms need to
+// know about it.  The table of them is in Config.cpp, built with
+// CONFIG_FIELD() so the type and size come from the member itself.
+struct config_field {
+  byte     key;            // CONFIG_*
+  byte     type;           // FIELD_TEXT ..
+  byte     flags;          // FIELD_SECRET ..
+  byte     group;          // CONFIG_GROUP_*
+  byte     form;           // CONFIG_FORM_* bits
+  byte     since;          // CONFIG_VERSION the member came in, at its size now
+  uint16_t offset;         // Of the member in configuration..
+  uint16_t size;           // ..its size..
+  byte     align;          // ..and alignment, for the layout of older versions
+  int32_t  min;            // FIELD_UINT range
+  int32_t  max;
+  char     json[ CONFIG_NAME_MAX ];   // Name in JSON and CBOR
+  char     name[ CONFIG_NAME_MAX ];   // Name in the form
+
+  // For members that need more than a copy or a range check
+  bool   (*parse)( configuration &conf, const char *value );
+  String (*format)( const configuration &conf );
+};
+
+template <typename T> struct config_type {
+  static constexpr byte value = std::is_unsigned<T>::value ? FIELD_UINT : FIELD_OTHER;
+};
+template <size_t N> struct config_type<char[N]> { static constexpr byte value = FIELD_TEXT; };
+
+#define CONFIG_FIELD( key, member, group, form, flags, min, max, since, json, name, parse, format ) \
+  { key, config_type< decltype(configuration::member) >::value, flags, group, form, since, \
+    offsetof( configuration, member ), sizeof( configuration::member ), \
+    alignof( decltype(configuration::member) ), min, max, json, name, parse, format }
+
+
+// Called from Config::loop() with the CONFIG_BIT()s of the changed keys
+typedef std::function<void(uint64_t changed)> ConfigListener;
+
+
 //
 // Config Library Class
 class Config
@@ -86,21 +236,48 @@ class Config
   public:
     Config();
     void readConfig();
-    bool set( int key, String value );
+    bool set( int key, const char *value );
+    bool set( const char *name, const char *value, byte form );   // From a form field
     void writeConfig();
     void resetConfig();
 
+    void onChange( ConfigListener listener );
+    void loop();
+
+    // The config and its pending changes, to undo a half-applied form
+    struct snapshot { configuration conf; uint64_t changed; };
+    void save( snapshot &to );
+    void restore( const snapshot &from );
+
     void reboot();
 
-    String JSON(String macaddr);
+    void JSON( Print &out, const String &macaddr );
+    void CBOR( CborWriter &cbor, const String &macaddr );
+
+    // Text for inside a JSON string, quotes and backslashes escaped
+    static void json_text( Print &out, const char *text );
+    static void json_text( String &out, const char *text );
 
     configuration conf;
 
 
   private:
+    ConfigListener _listeners[ CONFIG_MAX_LISTENERS ];
+    byte           _listener_count = 0;
+    uint64_t       _changed        = 0;   // Keys set since the last loop()
+
+    bool set( const config_field &field, const char *value );
+    void migrate( unsigned int version );
+    void migrate_member( byte key, unsigned int version, size_t &offset, uint16_t size, byte align );
+    void json_value( Print &out, const config_field &field );
+    void cbor_value( CborWriter &cbor, const config_field &field );
+
     configuration _defaults = { CONFIG_VERSION, DEFAULT_HOSTNAME, "unknown", DEFAULT_HTTP_PORT, DEFAULT_HTTP_PW,
                                 DEFAULT_SSID, DEFAULT_WIFI_PW,
-                                DB_TYPE_INFLUXDB, "influxdb", 8086, "temp", "ambient", DEFAULT_SAMPLE_INTERVAL  };    
+                                DB_TYPE_INFLUXDB, "influxdb", 8086, "temp", "ambient", "", "", "", 0, DEFAULT_DB_FLUSH, 0, "",
+                                DEFAULT_SAMPLE_INTERVAL, DEFAULT_DERIVED, DEFAULT_LOG_LEVELS,
+                                DEFAULT_SLEEP_MODE, DEFAULT_LISTEN_INTERVAL, "", {},
+                                { {}, {}, DEFAULT_CAL_PRESSURE }, {}  };    
 
 };
 
@@ -3,10 +3,16 @@
  *  
  */
 
+#include <ESP8266WiFi.h>
 #include <ESP8266HTTPClient.h>
+#include <FS.h>
+#include <base64.h>
+#include <umm_malloc/umm_malloc.h>
 
 #include "DB.h"
 #include "Config.h"
+#include "Log.h"
+#include "Diag.h"
 
 // Init DB Class
 DB::DB() {
@@ -15,50 +21,283 @@ DB::DB() {
 
 
 // Setup database based on current config values
-void DB::begin( Config *config, Sensor *sensor ) {
-  // Keep a reference to the config & sensor
-  _config = config;
-  _sensor = sensor;
-  
+void DB::begin( Config *config, Sensor *sensor, Clock *clock, Network *net, Capture *capture ) {
+  // Keep a reference to the config, sensor, clock, network & capture
+  _config  = config;
+  _sensor  = sensor;
+  _clock   = clock;
+  _net     = net;
+  _capture = capture;
+
+  _send_interval = _config->conf.sample_interval * 1000;
+  _next_send     = millis() + next_send_delay();
+  _next_flush    = millis() + next_flush_delay();
+  _batch.reserve( DB_BATCH_MAX / 4 );
+
+  connect();
+  build_tags();
+
+  // Apply settings changes in place
+  _config->onChange( std::bind( &DB::configChanged, this, std::placeholders::_1 ) );
+}
+
+
+// (Re)build the URL and HTTP connection from the config
+void DB::connect() {
+  // Drop the old connection and its headers
+  _http.end();
+  _plain.stop();
+
+  delete _tls;
+  delete _ca;
+  _tls = nullptr;
+  _ca  = nullptr;
+
   // Create the URL we'll be sending influx data to
+  String scheme = _config->conf.db_tls ? "https://" : "http://";
   _influx_url = "";
   if (_config->conf.db_type == DB_TYPE_INFLUXDB) {
-    _influx_url = "http://" + 
+    _influx_url = scheme + 
                   String(_config->conf.db_host) + ":" + String(_config->conf.db_port) +
-                  "/write?db=" + String(_config->conf.db_name);
+                  "/write?db=" + urlencode(_config->conf.db_name) +
+                  "&precision=s";
+
+  } else if (_config->conf.db_type == DB_TYPE_INFLUXDB2) {
+    _influx_url = scheme +
+                  String(_config->conf.db_host) + ":" + String(_config->conf.db_port) +
+                  "/api/v2/write?org=" + urlencode(_config->conf.db_org) +
+                  "&bucket=" + urlencode(_config->conf.db_bucket) +
+                  "&precision=s";
+  }
+
+  if (_influx_url.length() > 0 && _config->conf.db_tls && !tls_setup())
+    _influx_url = "";
 
+  if (_influx_url.length() > 0) {
     // Start the HTTP Client connection
-    _http.begin( _influx_url );
+    if (_tls)
+      _http.begin( *_tls, _influx_url );
+    else
+      _http.begin( _plain, _influx_url );
+    _http.setReuse( true );
+
+    // Request headers stay set for every POST on this connection
+    if (_config->conf.db_type == DB_TYPE_INFLUXDB2)
+      _http.addHeader( "Authorization", "Token " + String(_config->conf.db_token) );
+
+    if (_config->conf.db_gzip)
+      _http.addHeader( "Content-Encoding", "gzip" );
   }
 
 
   // Print the influx server info
-  Serial.println( "[DB] Influx Server: " + _influx_url );
+  LOG_INFO( LOG_DB, "Influx Server: %s%s", _influx_url.c_str(), _config->conf.db_gzip ? " (gzip)" : "" );
+
+}
+
+
+// A TLS client pinned to the configured fingerprint, or failing that
+// to the CA in DB_TLS_CA_FILE.  Without either nothing is sent, an
+// unverified connection would hand the token to anyone.
+bool DB::tls_setup() {
+  _tls = new BearSSL::WiFiClientSecure();
+
+  if (strlen(_config->conf.db_fingerprint) > 0) {
+    _tls->setFingerprint( _config->conf.db_fingerprint );
+
+  } else {
+    File file = SPIFFS.open( DB_TLS_CA_FILE, "r" );
+    if (file) {
+      String pem = file.readString();
+      file.close();
+
+      _ca = new BearSSL::X509List( pem.c_str() );
+      if (_ca->getCount() == 0) {
+        delete _ca;
+        _ca = nullptr;
+      }
+    }
+
+    if (!_ca) {
+      LOG_ERROR( LOG_DB, "TLS needs a fingerprint or a CA in %s, not sending", DB_TLS_CA_FILE );
+      delete _tls;
+      _tls = nullptr;
+      return false;
+    }
+
+    _tls->setTrustAnchors( _ca );
+  }
+
+  // A new server, so the old session is no use to it
+  _session    = BearSSL::Session();
+  _tls->setSession( &_session );
+  _tls_probed = false;
+
+  return true;
+}
+
+
+// Connect ahead of the POST so the handshake is timed on its own,
+// HTTPClient carries on over the open connection.  The session is
+// kept, so after the first connection the server can skip the key
+// exchange.  (HTTPClient redoes the very first connection after boot
+// since it hasn't seen a keep-alive response yet, that one resumes.)
+bool DB::tls_connect() {
+  if (_tls->connected()) return true;
+
+  const char *host = _config->conf.db_host;
+  uint16_t    port = _config->conf.db_port;
+
+  // Asked once per server.  Without it the server may send 16k
+  // records, so the receive buffer has to hold one.
+  if (!_tls_probed) {
+    _tls_mfln   = BearSSL::WiFiClientSecure::probeMaxFragmentLength( host, port, DB_TLS_MFLN );
+    _tls_probed = true;
+    _tls->setBufferSizes( _tls_mfln ? DB_TLS_MFLN : DB_TLS_RX, DB_TLS_TX );
+    LOG_INFO( LOG_DB, "TLS max fragment length %s", _tls_mfln ? "accepted" : "refused, full size buffers" );
+  }
+
+  // Certificate dates can only be checked once we know the time
+  if (_ca && _clock && _clock->valid())
+    _tls->setX509Time( _clock->now() );
+
+  // What the last connection held goes first, so the low point from
+  // here is all this one's.  The mark hands Diag the low point so far
+  // and starts umm_malloc's over.
+  _tls->stop();
+  Diag.mark( DIAG_DB );
+
+  uint32_t      heap    = ESP.getFreeHeap();
+  unsigned long started = millis();
+
+  if (!_tls->connect( host, port )) {
+    char error[64];
+    int  code = _tls->getLastSSLError( error, sizeof(error) );
+    LOG_ERROR( LOG_DB, "TLS connect to %s:%u failed: %d %s", host, port, code, error );
+    return false;
+  }
 
+  _hs_ms_last = millis() - started;
+  if (_handshakes == 0) _hs_ms_first = _hs_ms_last;
+  if (_hs_ms_last > _hs_ms_max) _hs_ms_max = _hs_ms_last;
+  _handshakes++;
+
+  // The handshake's peak, not what's left held after it
+#if defined(UMM_STATS) || defined(UMM_STATS_FULL)
+  uint32_t low = umm_free_heap_size_min();
+#else
+  uint32_t low = ESP.getFreeHeap();
+#endif
+  _tls_heap = heap - low;
+  if (_tls_heap_min == 0 || low < _tls_heap_min) _tls_heap_min = low;
+
+  LOG_INFO( LOG_DB, "TLS handshake %u ms, %u bytes heap at peak", _hs_ms_last, _tls_heap );
+  return true;
+}
+
+
+// Track the low point of free heap while a TLS connection is up
+void DB::tls_heap_check() {
+  uint32_t heap = ESP.getFreeHeap();
+  if (_tls_heap_min == 0 || heap < _tls_heap_min) _tls_heap_min = heap;
 }
 
 void DB::loop() {
-  
+  if (millis() > _next_send) {  // Time to take readings for the db
+    collect();
+    _next_send = millis() + next_send_delay();
+  }
+
+  // A capture goes out with the next flush, brought forward
+  if (_capture->seq() != _capture_seq && _capture->size() > 0) {
+    _capture_seq = _capture->seq();
+    if (_config->conf.db_type == DB_TYPE_INFLUXDB || _config->conf.db_type == DB_TYPE_INFLUXDB2) {
+      add_lines( influxDBCaptureLine() );
+      _next_flush = millis() + DB_WAKE_LEAD;
+    }
+  }
+
+  if (_batch.length() == 0) return;
+
+  // Get the radio out of power save a little ahead of the flush
+  if (millis() + DB_WAKE_LEAD > _next_flush)
+    _net->wake( DB_WAKE_LEAD + DB_WAKE_HOLD );
+
+  if (millis() > _next_flush) {  // Time to send readings to the db
+    if ( WiFi.status() == WL_CONNECTED ) {  // Can't send if we're not connected
+      flush();
+    } else {
+      LOG_WARN( LOG_DB, "No network, holding %u bytes for the DB", _batch.length() );
+    }
+    _next_flush = millis() + next_flush_delay();
+  }
+}
+
+
+// Only the parts affected by a settings change are redone
+void DB::configChanged( uint64_t changed ) {
+  if ( changed & CONFIG_DB_CHANGES )
+    connect();
+
+  if ( changed & ( CONFIG_BIT(CONFIG_HOSTNAME) | CONFIG_BIT(CONFIG_LOCATION) | CONFIG_BIT(CONFIG_DB_MEASUREMENT) ) )
+    build_tags();
+
+  if ( changed & CONFIG_BIT(CONFIG_DB_FLUSH) )
+    _next_flush = millis() + next_flush_delay();
+
+  if ( changed & CONFIG_BIT(CONFIG_SAMPLE_INTERVAL) ) {
+    _send_interval = _config->conf.sample_interval * 1000;
+    _next_send     = millis() + next_send_delay();
+    LOG_INFO( LOG_DB, "Sample interval: %us", _config->conf.sample_interval );
+  }
+}
+
+
+// Time until the next send, on a wall-clock boundary if we know the time
+unsigned long DB::next_send_delay() {
+  if ( _clock && _clock->valid() )
+    return _clock->millis_until( _send_interval / 1000 ) + DB_SEND_SETTLE;
+
+  return _send_interval;
+}
+
+
+// Time until the next batch goes out, also on a wall-clock boundary
+unsigned long DB::next_flush_delay() {
+  unsigned long interval = _config->conf.db_flush;
+
+  // Sending every sample, collect() brings the flush forward
+  if ( interval == 0 )
+    return _send_interval;
+
+  if ( _clock && _clock->valid() )
+    return _clock->millis_until( interval ) + DB_SEND_SETTLE;
+
+  return interval * 1000;
 }
 
 
 // URL encode a string
-String DB::urlencode( String text ) {
-  String encoded = "";
+String DB::urlencode( const String &text ) {
+  static const char hex[] = "0123456789ABCDEF";
+
+  // Room for the worst case, so the string is only allocated once
+  String encoded;
+  encoded.reserve( text.length() * 3 );
 
   // Scan through each character, if it's special, encode it.
-  for (int i=0; i < text.length(); i++) {
-    char c = text.charAt(i);
+  for (unsigned int i=0; i < text.length(); i++) {
+    unsigned char c = text[i];
 
     if ( c == ' ' )         // Handle spaces
       encoded += '+';
     else if ( isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' )  // Unreserved characters..
-      encoded += c;
+      encoded += (char)c;
     else {
       // Other characters need to get converted to their hex codes
-      char enchar[5] = "";
-      sprintf(enchar, "%%%X", c);
-      encoded += enchar;
+      encoded += '%';
+      encoded += hex[ c >> 4 ];
+      encoded += hex[ c & 0x0F ];
     }
 
   }
@@ -68,101 +307,336 @@ String DB::urlencode( String text ) {
 
 //
 // Escape a string based on the InfluxDB Line Protocol
-String DB::influx_escape( String text ) {
-  String encoded = "";
+String DB::influx_escape( const String &text ) {
+  // Most names have nothing to escape
+  if ( !strpbrk( text.c_str(), ",= \"" ) ) return text;
+
+  String encoded;
+  encoded.reserve( text.length() + 8 );
 
   // Scan through each character, if it's special, escape it
-  for (int i=0; i < text.length(); i++) {
-    char c = text.charAt(i);
+  for (unsigned int i=0; i < text.length(); i++) {
+    char c = text[i];
 
-    if ( c == ',' || c == '=' || c == ' ' || c == '"' ) {
-      encoded += "\\";
-      encoded += c;
-    } else
-      encoded += c;
+    if ( c == ',' || c == '=' || c == ' ' || c == '"' )
+      encoded += '\\';
+    encoded += c;
   }
 
   return encoded;
 }
 
 
-// Send readings to database
-uint16_t DB::influxDBSend( float temp, float humidity, float hindex ) {
-  
-  // Build the POST
-  String influxout;
-  influxout = influx_escape( _config->conf.db_measurement ) + ",host=" + influx_escape( _config->conf.hostname ) +
-              ",location=" + influx_escape( _config->conf.location ) +
-              " temperature=" + String(temp, 2) +
-              ",humidity=" + String(humidity, 2) +
-              ",heat_index=" + String(hindex, 2);
+// The host/location tags are the same on every point, so they're
+// escaped once here rather than per line
+void DB::build_tags() {
+  _tags = ",host=" + influx_escape( _config->conf.hostname ) +
+          ",location=" + influx_escape( _config->conf.location );
+  _series = influx_escape( _config->conf.db_measurement ) + _tags;
+}
+
+
+// Line protocol timestamp suffix (seconds).  Without a known time the
+// point is left unstamped and the database stamps it on arrival.
+static void append_timestamp( String &line, uint32_t timestamp ) {
+  if (timestamp == 0) return;
+  line += ' ';
+  line += timestamp;
+}
 
-  Serial.println( "[InfluxDB] " + _influx_url );
-  Serial.println( "[InfluxDB] " + String(influxout) );
+// Append a field, fixed point value
+static void append_fixed( String &line, const char *name, int32_t value ) {
+  char buf[16];
+  line += name;
+  line += Sensor::format_fixed( value, buf );
+}
 
-  // POST the POST and return the result
-  return _http.POST(influxout);
-  
+// Append a field, float value
+static void append_float( String &line, const char *name, float value, int decimals ) {
+  char buf[24];
+  line += name;
+  line += dtostrf( value, 1, decimals, buf );
 }
 
-// Send analog readings to database
-uint16_t DB::influxDBAnalogSend( String measurement, float reading, float pressure ) {
-  
-  // Build the POST
-  String influxout;
-  influxout = influx_escape( measurement ) + ",host=" + influx_escape( _config->conf.hostname ) +
-              ",location=" + influx_escape( _config->conf.location ) +
-              " analog=" + String(reading, 2) +
-              ",pressure=" + String(pressure, 2);
+// Line protocol for the temperature readings and whichever
+// derived metrics are enabled
+String DB::influxDBLine( const sensor_sample &sample ) {
+  String line;
+  line.reserve( _series.length() + 112 );
+
+  line += _series;
+  append_fixed( line, " temperature=", sample.temp );
+  append_fixed( line, ",humidity=", sample.humidity );
 
-  Serial.println( "[InfluxDB] " + _influx_url );
-  Serial.println( "[InfluxDB] " + String(influxout) );
+  if (sample.derived & DERIVED_HINDEX)       append_fixed( line, ",heat_index=", sample.hindex );
+  if (sample.derived & DERIVED_DEWPOINT)     append_fixed( line, ",dew_point=", sample.dewpoint );
+  if (sample.derived & DERIVED_ABS_HUMIDITY) append_fixed( line, ",abs_humidity=", sample.abs_humidity );
+  if (sample.derived & DERIVED_VPD)          append_fixed( line, ",vpd=", sample.vpd );
 
-  // POST the POST and return the result
-  return _http.POST(influxout);
-  
+  append_timestamp( line, sample.timestamp );
+  return line;
 }
 
+// Line protocol for the analog readings
+String DB::influxDBAnalogLine( const String &measurement, float reading, float pressure, uint32_t timestamp ) {
+  String line;
+  line.reserve( measurement.length() + _tags.length() + 48 );
+
+  line += influx_escape( measurement );
+  line += _tags;
+  append_float( line, " analog=", reading, 2 );
+  append_float( line, ",pressure=", pressure, 2 );
+  append_timestamp( line, timestamp );
+  return line;
+}
 
-// Send sensor readings to database
-// (if the network is available!)
-void DB::send() {
-  float temp     = _sensor->get_temp();
-  float humidity = _sensor->get_humidity();
-  float hindex   = _sensor->get_hindex();
+
+// Line protocol for the radio power figures, so sleep settings can
+// be compared over time
+String DB::influxDBPowerLine( uint32_t timestamp ) {
+  String line;
+  line.reserve( _tags.length() + 72 );
+
+  line += "power";
+  line += _tags;
+  append_float( line, " awake_pct=", _net->awake_permille() / 10.0, 1 );
+  append_float( line, ",est_ma=", _net->est_ua() / 1000.0, 2 );
+  line += ",post_ms=";
+  line += _post_ms_last;
+  line += 'i';
+  if (_tls) {
+    line += ",tls_ms=";
+    line += _hs_ms_last;
+    line += 'i';
+  }
+  append_timestamp( line, timestamp );
+  return line;
+}
+
+
+// Line protocol for a burst capture: what set it off and the range it
+// covered, with the capture itself as /capture serves it, base64
+String DB::influxDBCaptureLine() {
+  const capture_header &header = _capture->header();
+  size_t size = _capture->size();
+  String line;
+  line.reserve( _tags.length() + 160 + ( size + 2 ) / 3 * 4 );
+
+  line += "capture";
+  line += _tags;
+  line += " trigger=\"";
+  line += header.type;
+  append_fixed( line, "\",threshold=", header.threshold );
+  append_fixed( line, ",value=", header.value );
+  append_fixed( line, ",low=", header.low );
+  append_fixed( line, ",high=", header.high );
+  line += ",missed=";
+  line += header.missed;
+  line += "i,wave=\"";
+  line += base64::encode( _capture->data(), size, false );
+  line += '"';
+  append_timestamp( line, header.timestamp );
+  return line;
+}
+
+
+// Line protocol for why the last boot ended: reset reason, the part of
+// loop() that was running, the heap low points and for a crash the
+// exception registers and code addresses from the stack
+String DB::influxDBResetLine( uint32_t timestamp ) {
+  const diag_report &last = Diag.last();
+  char   hex[12];
+  String line;
+  line.reserve( _tags.length() + 320 );
+
+  line += "reset";
+  line += _tags;
+  line += " reason=\"";
+  line += Diagnostics::reason_name( last.reason );
+  line += "\",deliberate=";
+  line += last.deliberate ? "true" : "false";
+
+  if (last.known) {
+    line += ",subsystem=\"";
+    line += Diagnostics::subsystem_name( last.live.subsystem );
+    line += "\",uptime=";
+    line += last.live.uptime_ms / 1000;
+    line += "i,heap_min=";
+    line += last.live.heap_min;
+    line += "i,heap_min_in=\"";
+    line += Diagnostics::subsystem_name( last.live.heap_min_in );
+    line += "\",block_min=";
+    line += last.live.block_min;
+    line += "i,block_min_in=\"";
+    line += Diagnostics::subsystem_name( last.live.block_min_in );
+    line += '"';
+  }
+
+  if (last.crashed) {
+    line += ",exccause=";
+    line += last.crash.exccause;
+    snprintf( hex, sizeof(hex), "0x%08x", last.crash.epc1 );
+    line += "i,epc1=\"";
+    line += hex;
+    snprintf( hex, sizeof(hex), "0x%08x", last.crash.excvaddr );
+    line += "\",excvaddr=\"";
+    line += hex;
+    line += "\",stack=\"";
+    for (int i = 0; i < DIAG_STACK_WORDS && last.crash.stack[i]; i++) {
+      snprintf( hex, sizeof(hex), i ? " 0x%08x" : "0x%08x", last.crash.stack[i] );
+      line += hex;
+    }
+    line += '"';
+  }
+
+  append_timestamp( line, timestamp );
+  return line;
+}
+
+
+// POST a line protocol body to the database, gzipped if configured
+uint16_t DB::influxDBPost( String &body ) {
+  LOG_DEBUG( LOG_DB, "POST %s", _influx_url.c_str() );
+  LOG_DEBUG( LOG_DB, "%s", body.c_str() );
+
+  if (!_config->conf.db_gzip) {
+    // POST the POST and return the result
+    return _http.POST(body);
+  }
+
+  size_t   size = Gzip::bound( body.length() );
+  uint8_t *buf  = (uint8_t *)malloc( size );
+  if (!buf) {
+    LOG_ERROR( LOG_DB, "Out of memory for gzip buffer" );
+    return 0;
+  }
+
+  // Connection, body and gzip buffer all held at once, the peak
+  if (_tls) tls_heap_check();
+
+  _gzip.begin( buf, size );
+  _gzip.write( (const uint8_t *)body.c_str(), body.length() );
+  size_t len = _gzip.finish();
+
+  LOG_DEBUG( LOG_DB, "gzip %u -> %u bytes", body.length(), len );
+
+  uint16_t httpCode = len ? _http.POST( buf, len ) : 0;
+  free( buf );
+
+  return httpCode;
+}
+
+
+// Add the current readings to the batch
+void DB::collect() {
+  if (_config->conf.db_type != DB_TYPE_INFLUXDB && _config->conf.db_type != DB_TYPE_INFLUXDB2) return;
+
+  const sensor_sample &sample = _sensor->get_sample();
   float analog   = _sensor->get_analog();
   float pressure = _sensor->get_pressure();
 
-  if (_config->conf.db_type == DB_TYPE_INFLUXDB) {
-    // Send Temp Sensor
-    if (isnan(temp) || isnan(humidity) || isnan(hindex)) {
-       Serial.println( "[InfluxDB] No Temp Sensor Readings Available to Send!" );
-    } else {
-      uint16_t httpCode = influxDBSend( temp, humidity, hindex );
-  
-      // Parse the return
-      // HTTP Code 204 is successful for influxDB.
-      if (httpCode != HTTP_CODE_OK && httpCode != 204) {
-        Serial.println( "[DB] INFLUX HTTP ERROR: " + String(httpCode) );
-      }
-    }
+  // Analog is read in the same poll as the DHT, so it shares the timestamp
+  uint32_t timestamp = sample.timestamp;
 
-    // Send Analog
-    if (isnan(analog) || isnan(pressure)) {
-       Serial.println( "[InfluxDB] No Analog Sensor Readings Available to Send!" );
-    } else {
-      uint16_t httpCode = influxDBAnalogSend( "analog", analog, pressure );
-      
-      // Parse the return
-      // HTTP Code 204 is successful for influxDB.
-      if (httpCode != HTTP_CODE_OK && httpCode != 204) {
-        Serial.println( "[DB] INFLUX HTTP ERROR: " + String(httpCode) );
-      }
+  // Goes out with the first batch after boot
+  if (_reset_pending) {
+    add_lines( influxDBResetLine( timestamp ) );
+    _reset_pending = false;
+  }
+
+  // Temp Sensor
+  if (!sample.valid) {
+     LOG_WARN( LOG_DB, "No temp sensor readings available to send" );
+  } else {
+    add_lines( influxDBLine( sample ) );
+  }
+
+  // Analog
+  if (isnan(analog) || isnan(pressure)) {
+     LOG_WARN( LOG_DB, "No analog sensor readings available to send" );
+  } else {
+    add_lines( influxDBAnalogLine( "analog", analog, pressure, timestamp ) );
+  }
+
+  // Unstamped points get the time they arrive, so they can't wait.
+  // A batch that's getting full goes early.
+  if (_config->conf.db_flush == 0 || timestamp == 0 || _batch.length() > DB_BATCH_MAX * 3 / 4)
+    _next_flush = millis() + DB_WAKE_LEAD;
+}
+
+
+// Append to the batch, dropping the oldest lines if it's full
+void DB::add_lines( const String &lines ) {
+  if (_batch.length() > 0) _batch += "\n";
+  _batch += lines;
+
+  while (_batch.length() > DB_BATCH_MAX) {
+    int end = _batch.indexOf( '\n' );
+    _batch.remove( 0, end < 0 ? _batch.length() : end + 1 );
+    _dropped_lines++;
+  }
+}
+
+
+// Send the batched readings to the database
+// (if the network is available!)
+void DB::flush() {
+  if (_config->conf.db_type == DB_TYPE_INFLUXDB || _config->conf.db_type == DB_TYPE_INFLUXDB2) {
+    // The batch and the power figures go out in a single write
+    uint32_t timestamp = ( _clock && _clock->valid() ) ? _clock->now() : 0;
+    String   body      = _batch + "\n" + influxDBPowerLine( timestamp );
+
+    // Can't connect, keep the batch for next time
+    if (_tls && !tls_connect()) return;
+
+    unsigned long started  = millis();
+    uint16_t      httpCode = influxDBPost( body );
+    if (_tls) tls_heap_check();
+
+    _post_ms_last   = millis() - started;
+    _post_ms_total += _post_ms_last;
+    if (_post_ms_last > _post_ms_max) _post_ms_max = _post_ms_last;
+    _posts++;
+
+    // Parse the return
+    // HTTP Code 204 is successful for influxDB.
+    if (httpCode != HTTP_CODE_OK && httpCode != 204) {
+      LOG_ERROR( LOG_DB, "Influx HTTP error: %u", httpCode );
+
+      // No answer or a server error, try again next flush.  Anything
+      // else would be refused again.
+      if (httpCode == 0 || httpCode >= 500) return;
     }
 
   } else if (_config->conf.db_type == DB_TYPE_HTTP) {
     // TODO HTTP CALL
-    Serial.println( "[DB] IF AN HTTP CALL WAS CONFIGURED IT WOULD HAPPEN HERE." );
+    LOG_DEBUG( LOG_DB, "If an HTTP call was configured it would happen here" );
   }
 
+  _batch = "";
+}
+
+
+// Batching and send timing for /power
+String DB::statsJSON() {
+  return "{\"flush\": " + String( _config->conf.db_flush ) + ", "
+         "\"batch_bytes\": " + String( _batch.length() ) + ", "
+         "\"dropped_lines\": " + String( _dropped_lines ) + ", "
+         "\"posts\": " + String( _posts ) + ", "
+         "\"post_ms_avg\": " + String( _posts ? _post_ms_total / _posts : 0 ) + ", "
+         "\"post_ms_max\": " + String( _post_ms_max ) +
+         ( _tls ? ", \"tls\": " + tlsJSON() : String() ) + "}";
+}
+
+
+// Handshake cost and memory of the TLS connection
+String DB::tlsJSON() {
+  return "{\"mfln\": " + String( _tls_probed ? ( _tls_mfln ? DB_TLS_MFLN : 0 ) : -1 ) + ", "
+         "\"pinned\": \"" + String( _ca ? "ca" : "fingerprint" ) + "\", "
+         "\"handshakes\": " + String( _handshakes ) + ", "
+         "\"handshake_ms_first\": " + String( _hs_ms_first ) + ", "
+         "\"handshake_ms_last\": " + String( _hs_ms_last ) + ", "
+         "\"handshake_ms_max\": " + String( _hs_ms_max ) + ", "
+         "\"heap_used\": " + String( _tls_heap ) + ", "
+         "\"heap_free_min\": " + String( _tls_heap_min ) + "}";
 }
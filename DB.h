@@ -7,26 +7,97 @@
 #define DB_H
 
 #include <ESP8266HTTPClient.h>
+#include <WiFiClientSecureBearSSL.h>
 #include "defaults.h"
 #include "Config.h"
 #include "Sensor.h"
+#include "Clock.h"
+#include "Network.h"
+#include "Capture.h"
+#include "Gzip.h"
+
+// Sends happen this long after an aligned sensor poll so the
+// sample taken on the boundary is the one that goes out.
+#define DB_SEND_SETTLE  2000    // ms
+
+// Points are batched between flushes, the radio is only
+// woken up for the flush
+#define DB_BATCH_MAX    4096    // Bytes of line protocol held, oldest dropped past this
+#define DB_WAKE_LEAD    500     // ms the radio is woken ahead of a flush..
+#define DB_WAKE_HOLD    3000    // ..and kept awake for the POST
+
+// TLS record buffers.  The receive side can only shrink when the
+// server agrees to max fragment length, sends are always small.
+#define DB_TLS_RX       16384
+#define DB_TLS_MFLN     512
+#define DB_TLS_TX       512
+#define DB_TLS_CA_FILE  "/ca.pem"
 
 class DB {
   public:
     DB();
-    void     begin( Config *config, Sensor *sensor );
+    void     begin( Config *config, Sensor *sensor, Clock *clock, Network *net, Capture *capture );
     void     loop();
-    void     send();
-    uint16_t influxDBSend( float cur_temp, float cur_humidity, float cur_hindex );
-    uint16_t influxDBAnalogSend( String measurement, float reading, float pressure );
-    String   urlencode( String text );
-    String   influx_escape( String test );
+    void     collect();
+    void     flush();
+    String   influxDBLine( const sensor_sample &sample );
+    String   influxDBAnalogLine( const String &measurement, float reading, float pressure, uint32_t timestamp );
+    String   influxDBPowerLine( uint32_t timestamp );
+    String   influxDBResetLine( uint32_t timestamp );
+    String   influxDBCaptureLine();
+    String   statsJSON();
+    String   tlsJSON();
+    uint16_t influxDBPost( String &body );
+    String   urlencode( const String &text );
+    String   influx_escape( const String &text );
 
   private:
     String _influx_url;
+    String _tags;                     // ",host=..,location=..", escaped
+    String _series;                   // Measurement and tags of the sensor line
     HTTPClient _http;
+    WiFiClient _plain;
+    BearSSL::WiFiClientSecure *_tls = nullptr;  // New one per server, pins don't reset
+    BearSSL::Session   _session;      // Kept across connections for resumption
+    BearSSL::X509List *_ca = nullptr;
+    Gzip       _gzip;
     Config *_config;
     Sensor *_sensor;
+    Clock  *_clock;
+    Network *_net;
+    Capture *_capture;
+
+    unsigned long _send_interval = 30000;
+    unsigned long _next_send     = 30000;
+    unsigned long _next_flush    = 30000;
+
+    String   _batch;                  // Line protocol waiting for the next flush
+    uint32_t _posts         = 0;
+    uint32_t _post_ms_total = 0;
+    uint32_t _post_ms_last  = 0;
+    uint32_t _post_ms_max   = 0;
+    uint32_t _dropped_lines = 0;      // Lost to DB_BATCH_MAX
+    bool     _reset_pending = true;   // Why the last boot ended, sent once
+    uint32_t _capture_seq   = 0;      // Last capture sent
+
+    bool     _tls_probed    = false;  // Max fragment length asked for yet?
+    bool     _tls_mfln      = false;
+    uint32_t _handshakes    = 0;      // The first is a full handshake, later
+    uint32_t _hs_ms_first   = 0;      // ones resume the session if the server
+    uint32_t _hs_ms_last    = 0;      // still has it
+    uint32_t _hs_ms_max     = 0;
+    uint32_t _tls_heap      = 0;      // Taken by the last handshake at its peak
+    uint32_t _tls_heap_min  = 0;      // Lowest free heap seen around a send
+
+    void connect();
+    bool tls_setup();
+    bool tls_connect();
+    void tls_heap_check();
+    void build_tags();
+    void configChanged( uint64_t changed );
+    void add_lines( const String &lines );
+    unsigned long next_send_delay();
+    unsigned long next_flush_delay();
   
 };
 
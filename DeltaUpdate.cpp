@@ -0,0 +1,474 @@
+//
+// DeltaUpdate.cpp - Library for manifest driven updates: only the SPIFFS
+//                   files that changed are downloaded, and firmware comes
+//                   as a patch against the running image when possible
+//
+
+#include <ESP8266WiFi.h>
+#include <ESP8266HTTPClient.h>
+#include <MD5Builder.h>
+#include <Updater.h>
+#include <FS.h>
+
+#include "DeltaUpdate.h"
+#include "AssetIndex.h"
+#include "Archive.h"
+#include "DB.h"
+#include "Log.h"
+
+using namespace std::placeholders;
+
+
+static uint32_t le32( const uint8_t *p ) {
+  return (uint32_t)p[0] | ( (uint32_t)p[1] << 8 ) | ( (uint32_t)p[2] << 16 ) | ( (uint32_t)p[3] << 24 );
+}
+
+
+DeltaUpdate::DeltaUpdate() {
+}
+
+
+// Pick up the manifest ETag from before a restart
+void DeltaUpdate::begin() {
+  delta_rtc rtc;
+
+  if ( ESP.rtcUserMemoryRead( DELTA_RTC_BLOCK, (uint32_t *)&rtc, sizeof(rtc) ) && rtc.magic == DELTA_RTC_MAGIC ) {
+    char etag[ DELTA_ETAG_LEN + 1 ];
+    memcpy( etag, rtc.etag, DELTA_ETAG_LEN );
+    etag[ DELTA_ETAG_LEN ] = '\0';
+    _etag = etag;
+  }
+}
+
+
+// A fixed per-device offset in [0, window) taken from the MAC address,
+// so a fleet that booted together doesn't check in together.
+uint32_t DeltaUpdate::jitter( uint32_t window ) {
+  if ( window == 0 ) return 0;
+  return AssetIndex::hash( WiFi.macAddress().c_str() ) % window;
+}
+
+
+// Fetch the manifest and bring the file system and firmware up to it.
+// The manifest is plain text, one entry per line:
+//   fw <version> <size> <md5>
+//   file <path> <size> <md5>
+// Files it no longer lists are removed, apart from the device's own.
+int DeltaUpdate::check() {
+  HTTPClient  http;
+  const char *headers[] = { "ETag" };
+
+  http.begin( String( DELTA_MANIFEST_URL ) + "?version=" + INO_VERSION + "&md5=" + ESP.getSketchMD5() +
+              "&mac=" + WiFi.macAddress() );
+  http.collectHeaders( headers, 1 );
+
+  // Nothing has changed since the last manifest is a 304 with no body
+  if ( _etag.length() > 0 )
+    http.addHeader( "If-None-Match", "\"" + _etag + "\"" );
+
+  int code = http.GET();
+  if ( code == HTTP_CODE_NOT_MODIFIED ) {
+    http.end();
+    LOG_DEBUG( LOG_UPDATE, "Manifest unchanged" );
+    return DELTA_NO_UPDATES;
+  }
+
+  if ( code != HTTP_CODE_OK ) {
+    http.end();
+    LOG_INFO( LOG_UPDATE, "No manifest (%d)", code );
+    return ( code == HTTP_CODE_NOT_FOUND ) ? DELTA_NO_MANIFEST : DELTA_FAILED;
+  }
+
+  String manifest = http.getString();
+  String etag     = http.header( "ETag" );
+  http.end();
+
+  int           result  = DELTA_NO_UPDATES;
+  int           files   = 0;
+  unsigned long started = millis();
+  String        fw_version, fw_md5;
+  size_t        fw_size = 0;
+  String        listed  = "\n";      // "\n/a\n/b\n", every file in the manifest
+
+  _bytes = 0;
+  SPIFFS.remove( DELTA_TEMP_FILE );   // Left over from an interrupted update
+
+  unsigned int start = 0;
+  while ( start < manifest.length() ) {
+    int end = manifest.indexOf( '\n', start );
+    if ( end < 0 ) end = manifest.length();
+
+    String line = manifest.substring( start, end );
+    start = end + 1;
+
+    line.trim();
+    if ( line.length() == 0 || line[0] == '#' ) continue;
+
+    // <kind> <name> <size> <md5>
+    int a = line.indexOf( ' ' );
+    int b = line.indexOf( ' ', a + 1 );
+    int c = line.indexOf( ' ', b + 1 );
+    if ( a < 0 || b < 0 || c < 0 ) continue;
+
+    String kind = line.substring( 0, a );
+    String name = line.substring( a + 1, b );
+    size_t size = line.substring( b + 1, c ).toInt();
+    String md5  = line.substring( c + 1 );
+
+    if ( kind == "file" ) {
+      listed += name;
+      listed += '\n';
+
+      if ( file_md5( name ) == md5 ) continue;   // Unchanged
+
+      if ( update_file( name, size, md5 ) ) {
+        result |= DELTA_FILES_UPDATED;
+        files++;
+      } else {
+        result |= DELTA_FAILED;
+      }
+
+    } else if ( kind == "fw" ) {
+      fw_version = name;
+      fw_size    = size;
+      fw_md5     = md5;
+    }
+  }
+
+  // A manifest without files says nothing about them
+  int removed = ( listed.length() > 1 ) ? remove_unlisted( listed ) : 0;
+  if ( removed > 0 ) result |= DELTA_FILES_UPDATED;
+
+  if ( fw_md5.length() > 0 && fw_md5 != ESP.getSketchMD5() ) {
+    LOG_INFO( LOG_UPDATE, "Firmware %s available", fw_version.c_str() );
+
+    if ( update_firmware( fw_size, fw_md5 ) )
+      result |= DELTA_FW_UPDATED;
+    else
+      result |= DELTA_FAILED;
+
+    // The server holds a rollout back when builds fail to apply
+    report( fw_version, result & DELTA_FW_UPDATED );
+  }
+
+  // Only skip this manifest next time if everything in it was applied
+  etag.replace( "\"", "" );
+  save_etag( ( result & DELTA_FAILED ) ? String( "" ) : etag );
+
+  LOG_INFO( LOG_UPDATE, "%d file(s) updated, %d removed, %u bytes downloaded in %lu ms",
+            files, removed, _bytes, millis() - started );
+  return result;
+}
+
+
+// Download a file into a temp file, check it and swap it in
+bool DeltaUpdate::update_file( String path, size_t size, String md5 ) {
+  if ( !path.startsWith( "/" ) || path.length() >= ASSET_MAX_PATH || path.indexOf( ".." ) >= 0 ) {
+    LOG_ERROR( LOG_UPDATE, "Bad path in manifest: %s", path.c_str() );
+    return false;
+  }
+
+  // The old file stays until the new one is verified, so both need to fit
+  FSInfo info;
+  SPIFFS.info( info );
+  if ( size > info.totalBytes - info.usedBytes ) {
+    LOG_ERROR( LOG_UPDATE, "Not enough space for %s", path.c_str() );
+    return false;
+  }
+
+  File f = SPIFFS.open( DELTA_TEMP_FILE, "w" );
+  if ( !f ) return false;
+
+  MD5Builder hash;
+  size_t     written = 0;
+  hash.begin();
+
+  bool ok = download( String( DELTA_FILES_URL ) + path, [&]( const uint8_t *data, size_t len ) {
+    hash.add( (uint8_t *)data, len );
+    written += len;
+    return f.write( data, len ) == len;
+  });
+  f.close();
+  hash.calculate();
+
+  if ( !ok || written != size || hash.toString() != md5 ) {
+    LOG_ERROR( LOG_UPDATE, "%s failed verification", path.c_str() );
+    SPIFFS.remove( DELTA_TEMP_FILE );
+    return false;
+  }
+
+  SPIFFS.remove( path );
+  if ( !SPIFFS.rename( DELTA_TEMP_FILE, path ) ) {
+    LOG_ERROR( LOG_UPDATE, "Couldn't move %s into place", path.c_str() );
+    SPIFFS.remove( DELTA_TEMP_FILE );
+    return false;
+  }
+
+  LOG_INFO( LOG_UPDATE, "Updated %s (%u bytes)", path.c_str(), size );
+  return true;
+}
+
+
+// Remove the files that left the build.  The CA certificate and the
+// archive are the device's own and never in a manifest.  Names are
+// collected first, SPIFFS doesn't like removing under an open Dir.
+int DeltaUpdate::remove_unlisted( const String &listed ) {
+  String stale;
+  Dir    dir = SPIFFS.openDir( "/" );
+
+  while ( dir.next() ) {
+    String name = dir.fileName();
+
+    if ( name == DB_TLS_CA_FILE || name == DELTA_TEMP_FILE || name.startsWith( ARCHIVE_DIR ) ) continue;
+    if ( listed.indexOf( "\n" + name + "\n" ) >= 0 ) continue;
+
+    stale += name;
+    stale += '\n';
+  }
+
+  int          removed = 0;
+  unsigned int start   = 0;
+  while ( start < stale.length() ) {
+    int    end  = stale.indexOf( '\n', start );
+    String name = stale.substring( start, end );
+    start = end + 1;
+
+    if ( SPIFFS.remove( name ) ) {
+      LOG_INFO( LOG_UPDATE, "Removed %s, no longer in the manifest", name.c_str() );
+      removed++;
+    }
+  }
+  return removed;
+}
+
+
+// Patch the running firmware, or fall back to the whole image when
+// the server has no patch from our build.  Builds are named by MD5 so
+// the server doesn't need to remember which one it offered us.
+bool DeltaUpdate::update_firmware( size_t size, String md5 ) {
+  if ( apply_patch( String( DELTA_PATCH_URL ) + ESP.getSketchMD5() + "/" + md5 ) ) return true;
+
+  LOG_INFO( LOG_UPDATE, "No usable patch, downloading the full image" );
+
+  if ( !Update.begin( size ) ) {
+    LOG_ERROR( LOG_UPDATE, "Update.begin failed: %u", Update.getError() );
+    return false;
+  }
+  Update.setMD5( md5.c_str() );
+
+  bool ok = download( String( DELTA_FIRMWARE_URL ) + md5 + ".bin", []( const uint8_t *data, size_t len ) {
+    return Update.write( (uint8_t *)data, len ) == len;
+  });
+
+  // end() checks the size and MD5
+  bool done = Update.end();
+  if ( !ok || !done ) {
+    LOG_ERROR( LOG_UPDATE, "Firmware update failed: %u", Update.getError() );
+    return false;
+  }
+
+  return true;
+}
+
+
+bool DeltaUpdate::apply_patch( String url ) {
+  _state     = PATCH_HEADER;
+  _have      = 0;
+  _need      = DELTA_PATCH_HEADER;
+  _remaining = 0;
+
+  bool ok = download( url, std::bind( &DeltaUpdate::patch_write, this, _1, _2 ) );
+
+  // Nothing was started if the header never arrived
+  if ( _state == PATCH_HEADER ) return false;
+
+  bool done = Update.end();
+  if ( !ok || _state != PATCH_DONE || !done ) {
+    LOG_ERROR( LOG_UPDATE, "Patch failed: %u", Update.getError() );
+    return false;
+  }
+
+  LOG_INFO( LOG_UPDATE, "Firmware patched" );
+  return true;
+}
+
+
+// Feed downloaded patch bytes through the patch state machine.  Op
+// headers are collected in _hdr, literal data goes straight to Update.
+bool DeltaUpdate::patch_write( const uint8_t *data, size_t len ) {
+  while ( len > 0 ) {
+    if ( _state == PATCH_ADD ) {
+      size_t n = ( len < _remaining ) ? len : _remaining;
+      if ( Update.write( (uint8_t *)data, n ) != n ) return false;
+
+      data       += n;
+      len        -= n;
+      _remaining -= n;
+
+      if ( _remaining == 0 ) {
+        _state = PATCH_OP;
+        _have  = 0;
+        _need  = 1;
+      }
+      continue;
+    }
+
+    if ( _state == PATCH_DONE ) return false;   // Data after the end
+
+    _hdr[ _have++ ] = *data++;
+    len--;
+
+    if ( _have == _need && !patch_op() ) return false;
+  }
+
+  return true;
+}
+
+
+// A complete header or op is in _hdr
+bool DeltaUpdate::patch_op() {
+  if ( _state == PATCH_HEADER ) {
+    if ( memcmp( _hdr, DELTA_PATCH_MAGIC, 4 ) != 0 || _hdr[4] != DELTA_PATCH_VERSION ) {
+      LOG_ERROR( LOG_UPDATE, "Not a patch" );
+      return false;
+    }
+
+    char md5[33];
+    for ( int i = 0; i < 16; i++ )
+      sprintf( md5 + i * 2, "%02x", _hdr[ 9 + i ] );
+
+    if ( !Update.begin( le32( _hdr + 5 ) ) ) {
+      LOG_ERROR( LOG_UPDATE, "Update.begin failed: %u", Update.getError() );
+      return false;
+    }
+    Update.setMD5( md5 );
+    _state = PATCH_OP;
+
+  } else if ( _have == 1 ) {
+    // Op byte, now we know how much more to collect
+    switch ( _hdr[0] ) {
+      case 'C': _need = 9; return true;
+      case 'A': _need = 5; return true;
+      case 'E': _state = PATCH_DONE; return true;
+      default:  return false;
+    }
+
+  } else if ( _hdr[0] == 'C' ) {
+    if ( !copy_firmware( le32( _hdr + 1 ), le32( _hdr + 5 ) ) ) return false;
+
+  } else {
+    _remaining = le32( _hdr + 1 );
+    if ( _remaining > 0 ) _state = PATCH_ADD;
+  }
+
+  _have = 0;
+  _need = 1;
+  return true;
+}
+
+
+// Copy part of the running firmware (flash offset 0) into the update
+bool DeltaUpdate::copy_firmware( uint32_t offset, uint32_t length ) {
+  if ( (uint64_t)offset + length > ESP.getSketchSize() ) return false;
+
+  uint32_t buf[ DELTA_CHUNK / 4 ];
+
+  while ( length > 0 ) {
+    // flashRead wants 4 byte alignment
+    uint32_t aligned = offset & ~3;
+    uint32_t skip    = offset - aligned;
+    uint32_t n       = DELTA_CHUNK - skip;
+    if ( n > length ) n = length;
+
+    if ( !ESP.flashRead( aligned, buf, ( skip + n + 3 ) & ~3 ) ) return false;
+    if ( Update.write( (uint8_t *)buf + skip, n ) != n ) return false;
+
+    offset += n;
+    length -= n;
+  }
+
+  return true;
+}
+
+
+// GET url and hand the body to sink a chunk at a time
+bool DeltaUpdate::download( String url, delta_sink sink ) {
+  HTTPClient http;
+
+  http.begin( url );
+  int code = http.GET();
+  if ( code != HTTP_CODE_OK ) {
+    LOG_ERROR( LOG_UPDATE, "GET %s failed: %d", url.c_str(), code );
+    http.end();
+    return false;
+  }
+
+  int           len    = http.getSize();   // -1 if the server didn't say
+  WiFiClient   *stream = http.getStreamPtr();
+  uint8_t       buf[ DELTA_CHUNK ];
+  unsigned long last   = millis();
+  bool          ok     = true;
+
+  while ( ok && ( len > 0 || len == -1 ) ) {
+    size_t avail = stream->available();
+    if ( avail == 0 ) {
+      if ( !http.connected() || millis() - last > DELTA_TIMEOUT ) break;
+      delay( 1 );
+      continue;
+    }
+
+    int n = stream->readBytes( buf, ( avail < sizeof(buf) ) ? avail : sizeof(buf) );
+    if ( n <= 0 ) break;
+
+    ok      = sink( buf, n );
+    _bytes += n;
+    if ( len > 0 ) len -= n;
+    last = millis();
+  }
+
+  http.end();
+  return ok && len <= 0;
+}
+
+
+void DeltaUpdate::save_etag( String etag ) {
+  delta_rtc rtc;
+
+  _etag = ( etag.length() == DELTA_ETAG_LEN ) ? etag : String( "" );
+
+  memset( &rtc, 0, sizeof(rtc) );
+  if ( _etag.length() > 0 ) {
+    rtc.magic = DELTA_RTC_MAGIC;
+    memcpy( rtc.etag, _etag.c_str(), DELTA_ETAG_LEN );
+  }
+  ESP.rtcUserMemoryWrite( DELTA_RTC_BLOCK, (uint32_t *)&rtc, sizeof(rtc) );
+}
+
+
+// Tell the update server how a firmware update went
+void DeltaUpdate::report( String version, bool ok ) {
+  HTTPClient http;
+
+  http.begin( String( DELTA_REPORT_URL ) + "?mac=" + WiFi.macAddress() + "&version=" + version +
+              "&result=" + ( ok ? "ok" : "failed" ) );
+  int code = http.POST( "" );
+  http.end();
+
+  if ( code != HTTP_CODE_OK )
+    LOG_WARN( LOG_UPDATE, "Report failed: %d", code );
+}
+
+
+// MD5 of a SPIFFS file, "" if it doesn't exist
+String DeltaUpdate::file_md5( String path ) {
+  File f = SPIFFS.open( path, "r" );
+  if ( !f ) return String( "" );
+
+  MD5Builder hash;
+  hash.begin();
+  hash.addStream( f, f.size() );
+  hash.calculate();
+  f.close();
+
+  return hash.toString();
+}
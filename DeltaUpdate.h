@@ -0,0 +1,95 @@
+//
+// DeltaUpdate.h - Library for manifest driven updates: only the SPIFFS
+//                 files that changed are downloaded, and firmware comes
+//                 as a patch against the running image when possible
+//
+
+#ifndef DeltaUpdate_h
+#define DeltaUpdate_h
+
+#include <functional>
+
+#include "Arduino.h"
+#include "defaults.h"
+
+#define DELTA_MANIFEST_URL   UPDATE_SERVER "/manifest"
+#define DELTA_FILES_URL      UPDATE_SERVER "/files"
+#define DELTA_PATCH_URL      UPDATE_SERVER "/patch/"
+#define DELTA_FIRMWARE_URL   UPDATE_SERVER "/firmware/"
+#define DELTA_REPORT_URL     UPDATE_SERVER "/report"
+
+#define DELTA_TEMP_FILE      "/delta.tmp"
+#define DELTA_TIMEOUT        10000     // ms without data before a download is abandoned
+#define DELTA_CHUNK          256
+
+// Firmware patch format, all integers little endian:
+//   header  "ESPD" version(1) new_size(4) new_md5(16)
+//   'C' offset(4) length(4)     copy bytes from the running firmware
+//   'A' length(4) data...       add literal bytes
+//   'E'                         end of patch
+#define DELTA_PATCH_MAGIC    "ESPD"
+#define DELTA_PATCH_VERSION  1
+#define DELTA_PATCH_HEADER   25
+
+// RTC user memory holding the ETag of the last manifest that was fully
+// applied, so a restart doesn't cost a full manifest download.  Blocks
+// 32..36 belong to Clock.
+#define DELTA_RTC_BLOCK      40
+#define DELTA_RTC_MAGIC      0x444C5431
+#define DELTA_ETAG_LEN       32
+
+// check() results (bitmask)
+#define DELTA_NO_UPDATES     0x00
+#define DELTA_FILES_UPDATED  0x01
+#define DELTA_FW_UPDATED     0x02   // Restart to run the new firmware
+#define DELTA_FAILED         0x04
+#define DELTA_NO_MANIFEST    0x08   // Server doesn't do manifests, use the old image update
+
+
+//
+// Manifest ETag kept in RTC memory
+struct delta_rtc {
+  uint32_t magic;
+  char     etag[ DELTA_ETAG_LEN ];   // Not terminated
+};
+
+
+//
+// DeltaUpdate Library Class
+class DeltaUpdate
+{
+  public:
+    DeltaUpdate();
+    void     begin();
+    int      check();
+    uint32_t jitter( uint32_t window );
+
+  private:
+    String      _etag;             // Of the last manifest fully applied
+
+    enum patch_state { PATCH_HEADER, PATCH_OP, PATCH_ADD, PATCH_DONE };
+
+    patch_state _state;
+    uint8_t     _hdr[ DELTA_PATCH_HEADER ];
+    uint8_t     _have;
+    uint8_t     _need;
+    uint32_t    _remaining;        // Literal bytes left in an 'A' op
+
+    size_t      _bytes;            // Downloaded, for the log
+
+    typedef std::function<bool(const uint8_t *data, size_t len)> delta_sink;
+
+    bool download( String url, delta_sink sink );
+    bool update_file( String path, size_t size, String md5 );
+    int  remove_unlisted( const String &listed );
+    bool update_firmware( size_t size, String md5 );
+    bool apply_patch( String url );
+    bool patch_write( const uint8_t *data, size_t len );
+    bool patch_op();
+    bool copy_firmware( uint32_t offset, uint32_t length );
+    String file_md5( String path );
+    void   save_etag( String etag );
+    void   report( String version, bool ok );
+};
+
+#endif
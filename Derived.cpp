@@ -0,0 +1,223 @@
+//
+// Derived.cpp - Library for computing metrics derived from temperature
+//               and humidity (heat index, dew point, absolute humidity,
+//               vapor-pressure deficit) in fixed point
+//
+
+#include "Derived.h"
+
+#define ES_COUNT   ( DERIVED_ES_MAX_C - DERIVED_ES_MIN_C + 1 )
+#define HI_T_COUNT ( ( DERIVED_HI_MAX_F - DERIVED_HI_MIN_F ) / DERIVED_HI_STEP_F + 1 )
+#define HI_H_COUNT ( 100 / DERIVED_HI_STEP_RH + 1 )
+
+
+//
+// Compile-time math used to generate the tables.  None of this is
+// evaluated on the device.
+
+static constexpr double c_exp( double x ) {
+  // exp(x) = exp(x/16)^16, with a Taylor series for the small argument
+  double r    = x / 16;
+  double sum  = 1;
+  double term = 1;
+  for ( int i = 1; i < 20; i++ ) {
+    term *= r / i;
+    sum  += term;
+  }
+  for ( int i = 0; i < 4; i++ ) sum *= sum;
+  return sum;
+}
+
+// Magnus formula over water, Pa
+static constexpr double c_sat_vapor_pressure( double temp_c ) {
+  return 611.2 * c_exp( 17.62 * temp_c / ( 243.12 + temp_c ) );
+}
+
+// NWS heat index regression (Rothfusz), as used by DHT::computeHeatIndex()
+// above 79F.  It's a smooth polynomial so it interpolates well; the
+// low/high humidity adjustments are applied at runtime.
+static constexpr double c_heat_index( double t, double rh ) {
+  return -42.379 + 2.04901523 * t + 10.14333127 * rh - 0.22475541 * t * rh -
+         0.00683783 * t * t - 0.05481717 * rh * rh + 0.00122874 * t * t * rh +
+         0.00085282 * t * rh * rh - 0.00000199 * t * t * rh * rh;
+}
+
+
+// Saturation vapor pressure in deci-Pa, one entry per degree C
+struct es_table {
+  uint32_t v[ ES_COUNT ];
+
+  constexpr es_table() : v() {
+    for ( int i = 0; i < ES_COUNT; i++ )
+      v[i] = (uint32_t)( c_sat_vapor_pressure( DERIVED_ES_MIN_C + i ) * 10 + 0.5 );
+  }
+};
+
+// Heat index in deci-F over a temperature x humidity grid
+struct hi_table {
+  int16_t v[ HI_T_COUNT ][ HI_H_COUNT ];
+
+  constexpr hi_table() : v() {
+    for ( int t = 0; t < HI_T_COUNT; t++ ) {
+      for ( int h = 0; h < HI_H_COUNT; h++ ) {
+        double hi = c_heat_index( DERIVED_HI_MIN_F + t * DERIVED_HI_STEP_F, h * DERIVED_HI_STEP_RH ) * 10;
+        if ( hi > 32000 ) hi = 32000;
+        v[t][h] = (int16_t)( hi < 0 ? hi - 0.5 : hi + 0.5 );
+      }
+    }
+  }
+};
+
+static constexpr es_table _es PROGMEM = es_table();
+static constexpr hi_table _hi PROGMEM = hi_table();
+
+
+//
+// Runtime, integer only
+
+static int32_t isqrt( uint32_t n );
+
+void Derived::compute( int32_t temp_f, int32_t humidity, byte metrics, derived_metrics &out ) {
+  int32_t temp_c = f_to_c( temp_f );
+
+  out.hindex       = ( metrics & DERIVED_HINDEX )       ? heat_index( temp_f, humidity ) : 0;
+  out.dewpoint     = ( metrics & DERIVED_DEWPOINT )     ? c_to_f( dew_point( temp_c, humidity ) ) : 0;
+  out.abs_humidity = ( metrics & DERIVED_ABS_HUMIDITY ) ? abs_humidity( temp_c, humidity ) : 0;
+  out.vpd          = ( metrics & DERIVED_VPD )          ? vpd( temp_c, humidity ) : 0;
+}
+
+
+// temp_c in C * 100, returns deci-Pa
+int32_t Derived::sat_vapor_pressure( int32_t temp_c ) {
+  int32_t offset = temp_c - DERIVED_ES_MIN_C * 100;
+
+  if ( offset <= 0 ) return pgm_read_dword( &_es.v[0] );
+  if ( offset >= ( ES_COUNT - 1 ) * 100 ) return pgm_read_dword( &_es.v[ ES_COUNT - 1 ] );
+
+  int32_t i    = offset / 100;
+  int32_t frac = offset % 100;
+  int32_t lo   = pgm_read_dword( &_es.v[i] );
+  int32_t hi   = pgm_read_dword( &_es.v[i + 1] );
+
+  return lo + ( ( hi - lo ) * frac ) / 100;
+}
+
+
+// temp_f in F * 100, humidity in % * 100, returns F * 100
+int32_t Derived::heat_index( int32_t temp_f, int32_t humidity ) {
+  // Steadman's simple formula is linear, only use the table above 79F.
+  // Kept at 2000x scale so the switch-over doesn't suffer from rounding.
+  int32_t simple = 2200 * temp_f + 6100000 - 8160000 + 94 * humidity;
+  if ( simple <= 7900 * 2000 ) return simple / 2000;
+
+  if ( humidity < 0 )     humidity = 0;
+  if ( humidity > 10000 ) humidity = 10000;
+
+  int32_t t = temp_f - DERIVED_HI_MIN_F * 100;
+  if ( t < 0 ) t = 0;
+  if ( t > ( HI_T_COUNT - 1 ) * DERIVED_HI_STEP_F * 100 ) t = ( HI_T_COUNT - 1 ) * DERIVED_HI_STEP_F * 100;
+
+  // Bilinear interpolation, fractions out of T_SPAN and H_SPAN
+  const int32_t T_SPAN = DERIVED_HI_STEP_F * 100;
+  const int32_t H_SPAN = DERIVED_HI_STEP_RH * 20;
+
+  int32_t ti = t / T_SPAN;
+  int32_t tf = t % T_SPAN;
+  int32_t hi = humidity / ( DERIVED_HI_STEP_RH * 100 );
+  int32_t hf = ( humidity % ( DERIVED_HI_STEP_RH * 100 ) ) / 5;
+
+  if ( ti >= HI_T_COUNT - 1 ) { ti = HI_T_COUNT - 2; tf = T_SPAN; }
+  if ( hi >= HI_H_COUNT - 1 ) { hi = HI_H_COUNT - 2; hf = H_SPAN; }
+
+  int32_t v00 = (int16_t)pgm_read_word( &_hi.v[ti][hi] );
+  int32_t v01 = (int16_t)pgm_read_word( &_hi.v[ti][hi + 1] );
+  int32_t v10 = (int16_t)pgm_read_word( &_hi.v[ti + 1][hi] );
+  int32_t v11 = (int16_t)pgm_read_word( &_hi.v[ti + 1][hi + 1] );
+
+  int32_t sum = v00 * ( T_SPAN - tf ) * ( H_SPAN - hf ) +
+                v10 * tf * ( H_SPAN - hf ) +
+                v01 * ( T_SPAN - tf ) * hf +
+                v11 * tf * hf;
+
+  int32_t hindex = sum / ( T_SPAN * H_SPAN / 10 );
+
+  // NWS adjustments for very dry and very humid air
+  if ( humidity < 1300 && temp_f >= 8000 && temp_f <= 11200 ) {
+    int32_t x = 1700 - abs( temp_f - 9500 );
+    hindex -= ( ( 1300 - humidity ) / 4 ) * isqrt( x * 10000 / 17 ) / 1000;   // sqrt((17 - |T-95|) / 17)
+
+  } else if ( humidity > 8500 && temp_f >= 8000 && temp_f <= 8700 ) {
+    hindex += ( ( humidity - 8500 ) * ( 8700 - temp_f ) ) / 5000;
+  }
+
+  return hindex;
+}
+
+
+// Integer square root
+static int32_t isqrt( uint32_t n ) {
+  uint32_t root = 0;
+  uint32_t bit  = 1UL << 30;
+
+  while ( bit > n ) bit >>= 2;
+
+  while ( bit ) {
+    if ( n >= root + bit ) {
+      n    -= root + bit;
+      root  = ( root >> 1 ) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return root;
+}
+
+
+// Actual vapor pressure in deci-Pa
+static int32_t vapor_pressure( int32_t temp_c, int32_t humidity ) {
+  return ( (int64_t)Derived::sat_vapor_pressure( temp_c ) * humidity ) / 10000;
+}
+
+
+// Temperature (C * 100) where the air would be saturated.  Inverts the
+// saturation vapor pressure table instead of taking a log.
+int32_t Derived::dew_point( int32_t temp_c, int32_t humidity ) {
+  int32_t e = vapor_pressure( temp_c, humidity );
+
+  if ( e <= (int32_t)pgm_read_dword( &_es.v[0] ) ) return DERIVED_ES_MIN_C * 100;
+
+  // Binary search for the bracketing entries
+  int32_t lo = 0;
+  int32_t hi = ES_COUNT - 1;
+  if ( e >= (int32_t)pgm_read_dword( &_es.v[hi] ) ) return DERIVED_ES_MAX_C * 100;
+
+  while ( hi - lo > 1 ) {
+    int32_t mid = ( lo + hi ) / 2;
+    if ( (int32_t)pgm_read_dword( &_es.v[mid] ) <= e )
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  int32_t es_lo = pgm_read_dword( &_es.v[lo] );
+  int32_t es_hi = pgm_read_dword( &_es.v[hi] );
+
+  return ( DERIVED_ES_MIN_C + lo ) * 100 + ( ( e - es_lo ) * 100 ) / ( es_hi - es_lo );
+}
+
+
+// Grams of water per cubic meter of air, * 100
+int32_t Derived::abs_humidity( int32_t temp_c, int32_t humidity ) {
+  // AH = e / (Rv * T), Rv = 461.5 J/(kg K)
+  int64_t e = vapor_pressure( temp_c, humidity );
+  return ( e * 21668 ) / ( ( temp_c + 27315 ) * 10 );
+}
+
+
+// Vapor-pressure deficit in kPa * 100
+int32_t Derived::vpd( int32_t temp_c, int32_t humidity ) {
+  int32_t es = sat_vapor_pressure( temp_c );
+  return ( es - vapor_pressure( temp_c, humidity ) ) / 100;
+}
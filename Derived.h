@@ -0,0 +1,62 @@
+//
+// Derived.h - Library for computing metrics derived from temperature
+//             and humidity (heat index, dew point, absolute humidity,
+//             vapor-pressure deficit) in fixed point
+//
+
+#ifndef Derived_h
+#define Derived_h
+
+#include "Arduino.h"
+
+// Metrics that can be enabled in Config (bitmask)
+#define DERIVED_HINDEX        0x01
+#define DERIVED_DEWPOINT      0x02
+#define DERIVED_ABS_HUMIDITY  0x04
+#define DERIVED_VPD           0x08
+#define DERIVED_ALL           0x0F
+
+// Saturation vapor pressure table range, C
+#define DERIVED_ES_MIN_C      -40
+#define DERIVED_ES_MAX_C      60
+
+// Heat index table range, F and %RH
+#define DERIVED_HI_MIN_F      76
+#define DERIVED_HI_MAX_F      140
+#define DERIVED_HI_STEP_F     2
+#define DERIVED_HI_STEP_RH    5
+
+
+//
+// Derived metrics, all fixed point (value * 100).  Metrics that weren't
+// requested are left at 0.
+struct derived_metrics {
+  int32_t hindex;          // F
+  int32_t dewpoint;        // F
+  int32_t abs_humidity;    // g/m^3
+  int32_t vpd;             // kPa
+};
+
+
+//
+// Derived Library Class
+// Everything runs on lookup tables generated at compile time with
+// integer interpolation, so no soft-float pow/exp on the ESP8266.
+class Derived
+{
+  public:
+    static void compute( int32_t temp_f, int32_t humidity, byte metrics, derived_metrics &out );
+
+    static int32_t heat_index( int32_t temp_f, int32_t humidity );
+    static int32_t dew_point( int32_t temp_c, int32_t humidity );
+    static int32_t abs_humidity( int32_t temp_c, int32_t humidity );
+    static int32_t vpd( int32_t temp_c, int32_t humidity );
+
+    // Saturation vapor pressure (deci-Pa) at temp_c (C * 100)
+    static int32_t sat_vapor_pressure( int32_t temp_c );
+
+    static int32_t f_to_c( int32_t temp_f ) { return ( ( temp_f - 3200 ) * 5 ) / 9; }
+    static int32_t c_to_f( int32_t temp_c ) { return ( temp_c * 9 ) / 5 + 3200; }
+};
+
+#endif
@@ -0,0 +1,255 @@
+//
+// Diag.cpp - Library for post-mortem diagnostics.  Tracks which part of
+//            loop() is running and the heap low points in RTC memory, so
+//            the next boot can tell what was going on when we went down.
+//
+
+#include <umm_malloc/umm_malloc.h>
+
+#include "Diag.h"
+#include "Log.h"
+#include "Clock.h"
+#include "DeltaUpdate.h"
+#include "Archive.h"
+
+Diagnostics Diag;
+
+// Everyone's RTC memory in block order, each clear of the next and
+// all of it in the 128 blocks there are
+#define RTC_END( block, type )  ( (block) + ( sizeof(type) + 3 ) / 4 )
+static_assert( RTC_END( CLOCK_RTC_BLOCK,   clock_rtc )   <= DELTA_RTC_BLOCK &&
+               RTC_END( DELTA_RTC_BLOCK,   delta_rtc )   <= ARCHIVE_RTC_BLOCK &&
+               RTC_END( ARCHIVE_RTC_BLOCK, archive_rtc ) <= DIAG_RTC_BLOCK &&
+               RTC_END( DIAG_RTC_BLOCK,    diag_live )   <= DIAG_RTC_CRASH &&
+               RTC_END( DIAG_RTC_CRASH,    diag_crash )  <= 128, "RTC memory blocks overlap" );
+
+static const char _subsystem_names[ DIAG_SUBSYSTEMS ][8] = {
+  "boot", "config", "clock", "sensor", "archive", "net", "web", "db", "log", "sys", "restart", "alerts", "capture"
+};
+
+// Indexed by REASON_*
+static const char _reason_names[][12] = {
+  "power_on", "hw_wdt", "exception", "soft_wdt", "restart", "deep_sleep", "external"
+};
+
+
+// Called by the core's postmortem on an exception or soft WDT, before
+// it restarts us
+extern "C" void custom_crash_callback( struct rst_info *info, uint32_t stack, uint32_t stack_end ) {
+  Diag.crashed( info, stack, stack_end );
+}
+
+
+static uint32_t crash_check( const diag_crash &crash ) {
+  const uint32_t *word  = (const uint32_t *)&crash;
+  uint32_t        check = 0;
+
+  for ( size_t i = 0; i < offsetof( diag_crash, check ) / 4; i++ )
+    check ^= word[i];
+  return check;
+}
+
+
+// Flash (irom) or IRAM, where return addresses point
+static bool code_address( uint32_t addr ) {
+  return ( addr >= 0x40200000 && addr < 0x40300000 ) ||
+         ( addr >= 0x40100000 && addr < 0x40108000 );
+}
+
+
+static const char* hex32( uint32_t value, char *buf ) {
+  snprintf( buf, 11, "0x%08x", value );
+  return buf;
+}
+
+
+// Pick up what the last boot left behind, then start this boot's record
+void Diagnostics::begin() {
+  struct rst_info *info = ESP.getResetInfoPtr();
+  _last.reason = info->reason;
+
+  // Power on leaves RTC memory random, the magic won't match
+  diag_live live;
+  if ( ESP.rtcUserMemoryRead( DIAG_RTC_BLOCK, (uint32_t *)&live, sizeof(live) ) &&
+       live.magic == DIAG_RTC_MAGIC && _last.reason != REASON_DEFAULT_RST ) {
+    _last.live       = live;
+    _last.known      = true;
+    _last.deliberate = ( _last.reason == REASON_SOFT_RESTART && live.subsystem == DIAG_RESTART );
+  }
+
+  if ( _last.reason == REASON_EXCEPTION_RST || _last.reason == REASON_SOFT_WDT_RST ) {
+    diag_crash crash;
+    if ( ESP.rtcUserMemoryRead( DIAG_RTC_CRASH, (uint32_t *)&crash, sizeof(crash) ) &&
+         crash.magic == DIAG_CRASH_MAGIC && crash.check == crash_check( crash ) ) {
+      _last.crash = crash;
+
+    } else {
+      // The SDK keeps the registers, only the stack is missing
+      _last.crash.exccause = info->exccause;
+      _last.crash.epc1     = info->epc1;
+      _last.crash.epc2     = info->epc2;
+      _last.crash.epc3     = info->epc3;
+      _last.crash.excvaddr = info->excvaddr;
+      _last.crash.depc     = info->depc;
+    }
+    _last.crashed = true;
+  }
+
+  // One crash, one report
+  diag_crash clear = {};
+  ESP.rtcUserMemoryWrite( DIAG_RTC_CRASH, (uint32_t *)&clear, sizeof(clear) );
+
+  _live.magic        = DIAG_RTC_MAGIC;
+  _live.subsystem    = DIAG_BOOT;
+  _live.uptime_ms    = millis();
+  _live.heap_min     = heap_low();
+  _live.heap_min_in  = DIAG_BOOT;
+  _live.block_min    = ESP.getMaxFreeBlockSize();
+  _live.block_min_in = DIAG_BOOT;
+  save();
+
+  if ( _last.crashed ) {
+    char epc[12];
+    LOG_WARN( LOG_MAIN, "Reset: %s in %s, exccause %u at %s", reason_name( _last.reason ),
+              _last.known ? subsystem_name( _last.live.subsystem ) : "?",
+              _last.crash.exccause, hex32( _last.crash.epc1, epc ) );
+  } else if ( _last.known && !_last.deliberate ) {
+    LOG_WARN( LOG_MAIN, "Reset: %s in %s", reason_name( _last.reason ), subsystem_name( _last.live.subsystem ) );
+  } else {
+    LOG_INFO( LOG_MAIN, "Reset: %s", reason_name( _last.reason ) );
+  }
+}
+
+
+// The heap low point since the last mark was reached by whatever ran
+// in between, so it's charged to that before moving on
+void Diagnostics::mark( byte subsystem ) {
+  uint32_t low   = heap_low();
+  uint32_t block = ESP.getMaxFreeBlockSize();
+
+  if ( _heap_min[ _subsystem ] == 0 || low < _heap_min[ _subsystem ] )
+    _heap_min[ _subsystem ] = low;
+
+  if ( low < _live.heap_min ) {
+    _live.heap_min    = low;
+    _live.heap_min_in = _subsystem;
+  }
+
+  if ( block < _live.block_min ) {
+    _live.block_min    = block;
+    _live.block_min_in = _subsystem;
+  }
+
+  _subsystem       = subsystem;
+  _live.subsystem  = subsystem;
+  _live.uptime_ms  = millis();
+  save();
+}
+
+
+// Runs from the exception handler: registers and the code addresses
+// found on the stack go to RTC memory, nothing else
+void Diagnostics::crashed( struct rst_info *info, uint32_t stack, uint32_t stack_end ) {
+  diag_crash crash = {};
+
+  crash.magic    = DIAG_CRASH_MAGIC;
+  crash.exccause = info->exccause;
+  crash.epc1     = info->epc1;
+  crash.epc2     = info->epc2;
+  crash.epc3     = info->epc3;
+  crash.excvaddr = info->excvaddr;
+  crash.depc     = info->depc;
+
+  int found = 0;
+  for ( uint32_t pos = stack, n = 0; pos < stack_end && n < DIAG_STACK_SCAN && found < DIAG_STACK_WORDS; pos += 4, n++ ) {
+    uint32_t word = *(const uint32_t *)pos;
+    if ( code_address( word ) ) crash.stack[ found++ ] = word;
+  }
+
+  crash.check = crash_check( crash );
+  ESP.rtcUserMemoryWrite( DIAG_RTC_CRASH, (uint32_t *)&crash, sizeof(crash) );
+}
+
+
+// Lowest free heap since the last call.  umm_malloc keeps the low
+// water mark, so short lived allocations between marks are seen too.
+uint32_t Diagnostics::heap_low() {
+#if defined(UMM_STATS) || defined(UMM_STATS_FULL)
+  uint32_t low = umm_free_heap_size_min();
+  umm_free_heap_size_min_reset();
+  return low;
+#else
+  return ESP.getFreeHeap();
+#endif
+}
+
+
+void Diagnostics::save() {
+  ESP.rtcUserMemoryWrite( DIAG_RTC_BLOCK, (uint32_t *)&_live, sizeof(_live) );
+}
+
+
+const char* Diagnostics::subsystem_name( uint32_t subsystem ) {
+  return subsystem < DIAG_SUBSYSTEMS ? _subsystem_names[ subsystem ] : "unknown";
+}
+
+const char* Diagnostics::reason_name( uint32_t reason ) {
+  return reason < sizeof(_reason_names) / sizeof(_reason_names[0]) ? _reason_names[ reason ] : "unknown";
+}
+
+
+// The last reset for /debug/crash, and this boot's heap low points
+// by subsystem so the ones fragmenting it stand out
+String Diagnostics::JSON() {
+  char   hex[12];
+  String json;
+  json.reserve( 768 );
+
+  json += "{\"last\": {\"reason\": \"";  json += reason_name( _last.reason );
+  json += "\", \"deliberate\": ";         json += _last.deliberate ? "true" : "false";
+
+  if ( _last.known ) {
+    json += ", \"subsystem\": \"";        json += subsystem_name( _last.live.subsystem );
+    json += "\", \"uptime\": ";           json += _last.live.uptime_ms / 1000;
+    json += ", \"heap_min\": ";           json += _last.live.heap_min;
+    json += ", \"heap_min_in\": \"";      json += subsystem_name( _last.live.heap_min_in );
+    json += "\", \"block_min\": ";        json += _last.live.block_min;
+    json += ", \"block_min_in\": \"";     json += subsystem_name( _last.live.block_min_in );
+    json += '"';
+  }
+
+  if ( _last.crashed ) {
+    json += ", \"exccause\": ";           json += _last.crash.exccause;
+    json += ", \"epc1\": \"";             json += hex32( _last.crash.epc1, hex );
+    json += "\", \"epc2\": \"";           json += hex32( _last.crash.epc2, hex );
+    json += "\", \"epc3\": \"";           json += hex32( _last.crash.epc3, hex );
+    json += "\", \"excvaddr\": \"";       json += hex32( _last.crash.excvaddr, hex );
+    json += "\", \"depc\": \"";           json += hex32( _last.crash.depc, hex );
+    json += "\", \"stack\": [";
+    for ( int i = 0; i < DIAG_STACK_WORDS && _last.crash.stack[i]; i++ ) {
+      if ( i > 0 ) json += ", ";
+      json += '"';  json += hex32( _last.crash.stack[i], hex );  json += '"';
+    }
+    json += ']';
+  }
+
+  json += "}, \"now\": {\"heap\": ";      json += ESP.getFreeHeap();
+  json += ", \"block\": ";                json += ESP.getMaxFreeBlockSize();
+  json += ", \"frag\": ";                 json += ESP.getHeapFragmentation();
+  json += ", \"heap_min\": ";             json += _live.heap_min;
+  json += ", \"heap_min_in\": \"";        json += subsystem_name( _live.heap_min_in );
+  json += "\", \"block_min\": ";          json += _live.block_min;
+  json += ", \"block_min_in\": \"";       json += subsystem_name( _live.block_min_in );
+  json += "\", \"heap_min_by\": {";
+
+  bool first = true;
+  for ( int i = 0; i < DIAG_SUBSYSTEMS; i++ ) {
+    if ( _heap_min[i] == 0 ) continue;
+    if ( !first ) json += ", ";
+    json += '"';  json += _subsystem_names[i];  json += "\": ";  json += _heap_min[i];
+    first = false;
+  }
+
+  json += "}}}";
+  return json;
+}
@@ -0,0 +1,107 @@
+//
+// Diag.h - Library for post-mortem diagnostics.  Tracks which part of
+//          loop() is running and the heap low points in RTC memory, so
+//          the next boot can tell what was going on when we went down.
+//
+
+#ifndef Diag_h
+#define Diag_h
+
+#include "Arduino.h"
+#include <user_interface.h>
+
+// Parts of loop() a reset or a heap low point gets charged to
+#define DIAG_BOOT          0     // setup()
+#define DIAG_CONFIG        1
+#define DIAG_CLOCK         2
+#define DIAG_SENSOR        3
+#define DIAG_ARCHIVE       4
+#define DIAG_NETWORK       5
+#define DIAG_WEB           6
+#define DIAG_DB            7
+#define DIAG_LOG           8
+#define DIAG_SYS           9     // Between passes: SDK, TCP and the web handlers
+#define DIAG_RESTART       10    // Deliberate ESP.restart()
+#define DIAG_ALERTS        11
+#define DIAG_CAPTURE       12
+#define DIAG_SUBSYSTEMS    13
+
+// RTC user memory.  Blocks 32..36 belong to Clock, 40..48 to
+// DeltaUpdate, 50..63 to Archive; Diag.cpp checks they don't overlap.
+#define DIAG_RTC_BLOCK     64    // diag_live
+#define DIAG_RTC_CRASH     72    // diag_crash
+#define DIAG_RTC_MAGIC     0x44474C31
+#define DIAG_CRASH_MAGIC   0x44474331
+
+#define DIAG_STACK_WORDS   16    // Code addresses kept from the stack
+#define DIAG_STACK_SCAN    512   // Stack words looked through for them
+
+
+//
+// Kept current in RTC memory as loop() runs, whatever takes us down
+struct diag_live {
+  uint32_t magic;
+  uint32_t subsystem;      // DIAG_* running, or last run
+  uint32_t uptime_ms;      // millis() when it started
+  uint32_t heap_min;       // Lowest free heap since boot..
+  uint32_t heap_min_in;    // ..and the DIAG_* it happened in
+  uint32_t block_min;      // Smallest largest free block seen..
+  uint32_t block_min_in;   // ..and the DIAG_* it happened in
+};
+
+//
+// Written by the crash callback on an exception or soft WDT
+struct diag_crash {
+  uint32_t magic;
+  uint32_t exccause;
+  uint32_t epc1;
+  uint32_t epc2;
+  uint32_t epc3;
+  uint32_t excvaddr;
+  uint32_t depc;
+  uint32_t stack[ DIAG_STACK_WORDS ];   // Innermost first, 0 past the last
+  uint32_t check;          // XOR of all of the above
+};
+
+//
+// What the last boot left behind, for /debug/crash and the DB
+struct diag_report {
+  uint32_t reason;         // REASON_* from the SDK
+  bool     known;          // The fields below were found in RTC memory
+  bool     crashed;        // ..and so were the exception registers
+  bool     deliberate;     // We restarted ourselves
+  diag_live  live;
+  diag_crash crash;
+};
+
+
+//
+// Diagnostics Library Class
+// Constant initialized like Log, the crash callback can't rely on
+// anything having been set up.
+class Diagnostics
+{
+  public:
+    void begin();                          // First thing in setup()
+    void mark( byte subsystem );           // Entering this part of loop()
+    void crashed( struct rst_info *info, uint32_t stack, uint32_t stack_end );
+
+    const diag_report& last() { return _last; }
+    String JSON();
+
+    static const char* subsystem_name( uint32_t subsystem );
+    static const char* reason_name( uint32_t reason );
+
+  private:
+    diag_live   _live       = {};
+    diag_report _last       = {};
+    byte        _subsystem  = DIAG_BOOT;
+    uint32_t    _heap_min[ DIAG_SUBSYSTEMS ] = {};   // Low point charged to each, 0 - not seen yet
+
+    uint32_t heap_low();
+    void     save();
+};
+
+extern Diagnostics Diag;
+
+#endif
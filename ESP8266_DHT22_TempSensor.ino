@@ -39,8 +39,14 @@
 
 #include "defaults.h"
 #include "Config.h"
+#include "Log.h"
+#include "Diag.h"
 #include "Network.h"
+#include "Clock.h"
 #include "Sensor.h"
+#include "Archive.h"
+#include "Alerts.h"
+#include "Capture.h"
 #include "DB.h"
 #include "Webserver.h"
 
@@ -49,18 +55,15 @@
 // Helper Classes
 Config config;
 Network net;
+Clock wallclock;
 DB db;
 Sensor sensor(DHTPIN, DHTTYPE);
+Capture capture;
+Archive archive;
+Alerts alerts;
 Webserver web;
 
 
-//
-// GLOBALS
-//
-int send_to_db_interval    = 30000;    // 30 seconds
-int next_send_to_db        = send_to_db_interval;
-
-
 //
 // A R D U I N O  S E T U P
 void setup() {
@@ -70,51 +73,73 @@ void setup() {
   Serial.begin(115200);
   Serial.println();
 
-  Serial.println("---------------------------");
-  Serial.println("HEATSTROKE INO: " + String(INO_VERSION));
-  Serial.println("---------------------------");
-  Serial.println();
+  // Per module levels come from the config from here on
+  Log.begin( &config );
+  LOG_INFO( LOG_MAIN, "HEATSTROKE INO: %s", INO_VERSION );
+
+  // What the last boot was doing when it went down
+  Diag.begin();
  
   // Initialize Network/WiFi
   net.begin( &config );
 
+  // Sync the wall clock (or pick it up from before a restart)
+  wallclock.begin();
+  wallclock.loop();
+
+  // Burst capture on the pressure input, feeds the sensor's analog
+  // readings while it runs
+  capture.begin( &config, &wallclock );
+
   // Start the temperature sensor
-  sensor.begin( &config );
+  sensor.begin( &config, &wallclock, &capture );
+
+  // Pick up the on-flash history
+  archive.begin( &sensor );
+
+  // Check the readings against the alert rules
+  alerts.begin( &config, &sensor, &wallclock, &net );
 
   // Initialize the database library
-  db.begin( &config, &sensor );
-  send_to_db_interval = config.conf.sample_interval * 1000;
+  db.begin( &config, &sensor, &wallclock, &net, &capture );
 
   // Initialize File System and Web Server
-  web.begin( &config, &sensor, &db );
+  web.begin( &config, &sensor, &db, &wallclock, &archive, &net, &alerts, &capture );
   delay(500);
 }
 
 
 // Main Arduino Loop
 void loop() {
-  sensor.loop();
-  net.loop();
-  web.loop();
-
-  if (millis() > next_send_to_db) {  // Time to send readings to the db
-    if ( net.connected() ) {  // Can't send if we're not connected
-      db.send();
-    } else {
-      Serial.println("[NO NETWORK] Cannot send to DB.");
-    }
-    next_send_to_db = millis() + send_to_db_interval;
-  }
+  // Each part is marked so a crash or a heap low point can be
+  // put down to it
+  Diag.mark( DIAG_CONFIG );   config.loop();     // Apply any settings changes
+  Diag.mark( DIAG_CAPTURE );  capture.loop();     // Once a pass, the pass has to be short
+  Diag.mark( DIAG_CLOCK );    wallclock.loop();
+  Diag.mark( DIAG_SENSOR );   sensor.loop();
+  Diag.mark( DIAG_ALERTS );   alerts.loop();     // Right after a poll, for the latency
+  Diag.mark( DIAG_ARCHIVE );  archive.loop();
+  Diag.mark( DIAG_NETWORK );  net.loop();
+  Diag.mark( DIAG_WEB );      web.loop();
+  Diag.mark( DIAG_DB );       db.loop();
+  Diag.mark( DIAG_LOG );      Log.loop();
 
   if ( millis() > MAX_RUNTIME ) {
     // If we've been running more than MAX_RUN, just reboot to reset
     // millis() so we don't have to deal with overflow
-    Serial.println( "----------------------------------" );
-    Serial.println( "MAX RUNTIME REACHED, RESTARTING..." );
-    Serial.println( "----------------------------------" );
+    LOG_INFO( LOG_MAIN, "Max runtime reached, restarting..." );
+    wallclock.save();
+    archive.save();
+    Log.flush();
+    Diag.mark( DIAG_RESTART );
     ESP.restart();
   }
 
+  // Lets the radio light sleep when that's enabled, unless capture is
+  // sampling: the two don't mix, a sample is due every few ms.  The
+  // web handlers run from here until the next pass.
+  Diag.mark( DIAG_SYS );
+  delay( capture.active() ? 0 : net.idle() );
 }
 
 
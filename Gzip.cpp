@@ -0,0 +1,237 @@
+//
+// Gzip.cpp - Small-window streaming gzip (deflate) compressor for
+//            request bodies sent to the database
+//
+
+#include "Gzip.h"
+
+// Length codes 257..285 (RFC 1951 3.2.5)
+static const uint16_t _len_base[] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t _len_extra[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+// Distance codes 0..29, only the ones reachable with GZIP_WINDOW are used
+static const uint16_t _dist_base[] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+  8193, 12289, 16385, 24577
+};
+static const uint8_t _dist_extra[] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// CRC-32, one nibble at a time
+static const uint32_t _crc_table[16] = {
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+
+Gzip::Gzip() {
+  begin( NULL, 0 );
+}
+
+
+// Start a new gzip stream written into out
+void Gzip::begin( uint8_t *out, size_t size ) {
+  _out       = out;
+  _out_size  = size;
+  _out_len   = 0;
+  _overflow  = false;
+  _bits      = 0;
+  _bit_count = 0;
+  _fill      = 0;
+  _pos       = 0;
+  _crc       = 0xFFFFFFFF;
+  _total     = 0;
+  memset( _head, 0, sizeof(_head) );
+
+  if ( !out ) return;
+
+  // Header: magic, deflate, no flags, no mtime, no extra flags, OS unknown
+  const uint8_t header[] = { 0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF };
+  for ( uint8_t i = 0; i < sizeof(header); i++ )
+    put_byte( header[i] );
+
+  // One final block using the fixed Huffman codes
+  put_bits( 1, 1 );
+  put_bits( 1, 2 );
+}
+
+
+size_t Gzip::bound( size_t len ) {
+  // Literals are at most 9 bits, plus header, block bits and trailer
+  return len + len / 8 + 32;
+}
+
+
+void Gzip::write( const uint8_t *data, size_t len ) {
+  while ( len > 0 ) {
+    if ( _fill == GZIP_BUFFER ) slide();
+
+    size_t n = GZIP_BUFFER - _fill;
+    if ( n > len ) n = len;
+
+    memcpy( _buf + _fill, data, n );
+
+    for ( size_t i = 0; i < n; i++ ) {
+      _crc ^= data[i];
+      _crc = ( _crc >> 4 ) ^ _crc_table[ _crc & 0x0F ];
+      _crc = ( _crc >> 4 ) ^ _crc_table[ _crc & 0x0F ];
+    }
+
+    _fill  += n;
+    _total += n;
+    data   += n;
+    len    -= n;
+
+    compress( false );
+  }
+}
+
+
+// Encode what's left, write the trailer and return the gzip length.
+// Returns 0 if the output buffer was too small.
+size_t Gzip::finish() {
+  compress( true );
+
+  put_code( 0, 7 );   // End of block (256)
+  flush_bits();
+
+  uint32_t crc = ~_crc;
+  for ( uint8_t i = 0; i < 32; i += 8 ) put_byte( crc >> i );
+  for ( uint8_t i = 0; i < 32; i += 8 ) put_byte( _total >> i );
+
+  return _overflow ? 0 : _out_len;
+}
+
+
+// Drop the oldest GZIP_WINDOW bytes to make room for more input
+void Gzip::slide() {
+  memmove( _buf, _buf + GZIP_WINDOW, _fill - GZIP_WINDOW );
+  _fill -= GZIP_WINDOW;
+  _pos  -= GZIP_WINDOW;
+
+  for ( uint16_t i = 0; i < GZIP_HASH_SIZE; i++ )
+    _head[i] = ( _head[i] > GZIP_WINDOW ) ? _head[i] - GZIP_WINDOW : 0;
+}
+
+
+uint16_t Gzip::hash( size_t pos ) {
+  return ( ( _buf[pos] << 5 ) ^ ( _buf[pos+1] << 2 ) ^ _buf[pos+2] ^ ( _buf[pos+2] >> 3 ) ) & ( GZIP_HASH_SIZE - 1 );
+}
+
+
+// Encode buffered input.  Unless flushing, stop GZIP_MAX_MATCH bytes short
+// of the end so matches can extend into data that hasn't arrived yet.
+void Gzip::compress( bool flush ) {
+  size_t limit = _fill;
+  if ( !flush ) {
+    if ( _fill < GZIP_MAX_MATCH ) return;
+    limit = _fill - GZIP_MAX_MATCH;
+  }
+
+  while ( _pos < limit ) {
+    uint16_t best = 0;
+
+    if ( _pos + GZIP_MIN_MATCH <= _fill ) {
+      uint16_t h    = hash( _pos );
+      size_t   cand = _head[h];
+      _head[h] = _pos + 1;
+
+      if ( cand-- && _pos - cand <= GZIP_WINDOW ) {
+        size_t max = _fill - _pos;
+        if ( max > GZIP_MAX_MATCH ) max = GZIP_MAX_MATCH;
+
+        while ( best < max && _buf[ cand + best ] == _buf[ _pos + best ] )
+          best++;
+
+        if ( best >= GZIP_MIN_MATCH ) {
+          match( best, _pos - cand );
+
+          // Remember the positions inside the match too
+          for ( uint16_t i = 1; i < best && _pos + i + GZIP_MIN_MATCH <= _fill; i++ )
+            _head[ hash( _pos + i ) ] = _pos + i + 1;
+
+          _pos += best;
+          continue;
+        }
+      }
+    }
+
+    literal( _buf[ _pos++ ] );
+  }
+}
+
+
+void Gzip::literal( uint8_t c ) {
+  if ( c < 144 )
+    put_code( 0x30 + c, 8 );
+  else
+    put_code( 0x190 + c - 144, 9 );
+}
+
+
+void Gzip::match( uint16_t length, uint16_t distance ) {
+  uint8_t code = 28;
+  while ( _len_base[code] > length ) code--;
+
+  uint16_t symbol = 257 + code;
+  if ( symbol < 280 )
+    put_code( symbol - 256, 7 );
+  else
+    put_code( 0xC0 + symbol - 280, 8 );
+  put_bits( length - _len_base[code], _len_extra[code] );
+
+  code = 29;
+  while ( _dist_base[code] > distance ) code--;
+
+  put_code( code, 5 );
+  put_bits( distance - _dist_base[code], _dist_extra[code] );
+}
+
+
+// Append bits, least significant first
+void Gzip::put_bits( uint32_t value, uint8_t count ) {
+  _bits |= value << _bit_count;
+  _bit_count += count;
+
+  while ( _bit_count >= 8 ) {
+    put_byte( _bits );
+    _bits >>= 8;
+    _bit_count -= 8;
+  }
+}
+
+
+// Huffman codes are packed most significant bit first
+void Gzip::put_code( uint16_t code, uint8_t count ) {
+  uint16_t reversed = 0;
+  for ( uint8_t i = 0; i < count; i++ ) {
+    reversed = ( reversed << 1 ) | ( code & 1 );
+    code >>= 1;
+  }
+  put_bits( reversed, count );
+}
+
+
+void Gzip::flush_bits() {
+  if ( _bit_count > 0 ) put_byte( _bits );
+  _bits      = 0;
+  _bit_count = 0;
+}
+
+
+void Gzip::put_byte( uint8_t b ) {
+  if ( _out_len >= _out_size ) {
+    _overflow = true;
+    return;
+  }
+  _out[ _out_len++ ] = b;
+}
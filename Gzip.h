@@ -0,0 +1,62 @@
+//
+// Gzip.h - Small-window streaming gzip (deflate) compressor for
+//          request bodies sent to the database
+//
+
+#ifndef Gzip_h
+#define Gzip_h
+
+#include "Arduino.h"
+
+#define GZIP_WINDOW      256                // LZ77 history, bytes
+#define GZIP_BUFFER      ( GZIP_WINDOW*2 )  // History + lookahead
+#define GZIP_MAX_MATCH   128                // Longest match we look for
+#define GZIP_MIN_MATCH   3
+#define GZIP_HASH_SIZE   256                // Hash table heads (power of two)
+
+
+//
+// Gzip Compressor Class
+// Input is fed in any number of write() calls; the compressed stream is
+// written into the caller's buffer as it is produced.  Uses a single
+// fixed-Huffman block, which needs no tables and suits short text.
+class Gzip
+{
+  public:
+    Gzip();
+
+    void   begin( uint8_t *out, size_t size );
+    void   write( const uint8_t *data, size_t len );
+    size_t finish();
+
+    // Worst case compressed size for len input bytes
+    static size_t bound( size_t len );
+
+  private:
+    uint8_t  _buf[ GZIP_BUFFER ];
+    uint16_t _head[ GZIP_HASH_SIZE ];   // Last position+1 seen for each hash, 0 = none
+    size_t   _fill;                     // Bytes in _buf
+    size_t   _pos;                      // Next byte in _buf to encode
+
+    uint8_t  *_out;
+    size_t   _out_size;
+    size_t   _out_len;
+    bool     _overflow;
+    uint32_t _bits;
+    uint8_t  _bit_count;
+
+    uint32_t _crc;
+    uint32_t _total;
+
+    void     compress( bool flush );
+    void     slide();
+    uint16_t hash( size_t pos );
+    void     literal( uint8_t c );
+    void     match( uint16_t length, uint16_t distance );
+    void     put_bits( uint32_t value, uint8_t count );
+    void     put_code( uint16_t code, uint8_t count );
+    void     put_byte( uint8_t b );
+    void     flush_bits();
+};
+
+#endif
@@ -0,0 +1,140 @@
+//
+// Log.cpp - Library for buffered, leveled logging.  Lines are formatted
+//           into a RAM ring and drained to serial without blocking.
+//
+
+#include <stdarg.h>
+
+#include "Log.h"
+#include "Config.h"
+
+Logger Log;
+
+static const char _level_tags[] = "-EWID";
+static const char _module_names[ LOG_MODULES ][8] = {
+  "main", "config", "net", "clock", "sensor", "db", "web", "update", "archive", "alerts", "capture"
+};
+
+
+// Runtime levels come from the config from here on
+void Logger::begin( Config *config ) {
+  _config = config;
+}
+
+
+// Push out whatever serial has room for
+void Logger::loop() {
+  drain();
+}
+
+
+// Wait for everything to go out, the ring doesn't survive a restart
+void Logger::flush() {
+  while ( _serial < _head ) {
+    drain();
+    yield();
+  }
+  Serial.flush();
+}
+
+
+void Logger::write( byte level, byte module, PGM_P fmt, ... ) {
+  if ( module >= LOG_MODULES ) module = LOG_MAIN;
+
+  // One digit per module in the config, e.g. "334333333"
+  byte limit = LOG_LEVEL;
+  if ( _config ) {
+    char c = _config->conf.log_levels[ module ];
+    if ( c >= '0' && c <= '0' + LOG_LEVEL_DEBUG ) limit = c - '0';
+  }
+  if ( level > limit ) return;
+
+  // Rate limit everything but errors so a chatty loop can't flood the
+  // ring and push out the lines that matter
+  unsigned long now    = millis();
+  uint32_t      earned = ( now - _refill ) * LOG_RATE / 1000;
+  if ( earned > 0 ) {
+    _tokens = ( _tokens + earned > LOG_BURST ) ? LOG_BURST : _tokens + earned;
+    _refill = now;
+  }
+
+  if ( level > LOG_LEVEL_ERROR ) {
+    if ( _tokens == 0 ) {
+      _dropped++;
+      return;
+    }
+    _tokens--;
+  }
+
+  char line[ LOG_LINE_MAX ];
+  int  len;
+
+  if ( _dropped > 0 ) {
+    len = snprintf_P( line, sizeof(line), PSTR( "[log] %u lines dropped\n" ), _dropped );
+    append( line, len );
+    _dropped = 0;
+  }
+
+  // "12.345 I sensor: message"
+  len = snprintf_P( line, sizeof(line), PSTR( "%lu.%03lu %c %s: " ),
+                    now / 1000, now % 1000, _level_tags[ level ], _module_names[ module ] );
+
+  va_list args;
+  va_start( args, fmt );
+  int msg = vsnprintf_P( line + len, sizeof(line) - len - 1, fmt, args );
+  va_end( args );
+
+  // Truncated lines keep room for the newline
+  if ( msg > 0 ) len += msg;
+  if ( len > (int)sizeof(line) - 2 ) len = sizeof(line) - 2;
+  line[ len++ ] = '\n';
+
+  append( line, len );
+  drain();
+}
+
+
+// Add a line to the ring, dropping the oldest whole lines to make room
+void Logger::append( const char *line, size_t len ) {
+  while ( _head + len - _tail > LOG_BUFFER_SIZE ) {
+    while ( _tail < _head && _ring[ _tail % LOG_BUFFER_SIZE ] != '\n' ) _tail++;
+    _tail++;
+  }
+
+  for ( size_t i = 0; i < len; i++ )
+    _ring[ _head++ % LOG_BUFFER_SIZE ] = line[i];
+
+  // Lines serial never got to are gone
+  if ( _serial < _tail ) _serial = _tail;
+}
+
+
+// Write only what fits in the UART FIFO, never wait on it
+void Logger::drain() {
+  while ( _serial < _head ) {
+    size_t room = Serial.availableForWrite();
+    if ( room == 0 ) return;
+
+    size_t index = _serial % LOG_BUFFER_SIZE;
+    size_t len   = _head - _serial;
+    if ( len > LOG_BUFFER_SIZE - index ) len = LOG_BUFFER_SIZE - index;
+    if ( len > room ) len = room;
+
+    Serial.write( (const uint8_t *)_ring + index, len );
+    _serial += len;
+  }
+}
+
+
+String Logger::lines( uint32_t since, uint32_t &next ) {
+  String out;
+
+  if ( since < _tail || since > _head ) since = _tail;
+  out.reserve( _head - since );
+
+  for ( uint32_t pos = since; pos < _head; pos++ )
+    out += _ring[ pos % LOG_BUFFER_SIZE ];
+
+  next = _head;
+  return out;
+}
@@ -0,0 +1,100 @@
+//
+// Log.h - Library for buffered, leveled logging.  Lines are formatted
+//         into a RAM ring and drained to serial without blocking.
+//
+
+#ifndef Log_h
+#define Log_h
+
+#include "Arduino.h"
+
+#define LOG_LEVEL_NONE    0
+#define LOG_LEVEL_ERROR   1
+#define LOG_LEVEL_WARN    2
+#define LOG_LEVEL_INFO    3
+#define LOG_LEVEL_DEBUG   4
+
+// Anything above this is compiled out, format strings and all
+#ifndef LOG_LEVEL
+#define LOG_LEVEL         LOG_LEVEL_INFO
+#endif
+
+// Modules, each with its own runtime level in Config
+#define LOG_MAIN          0
+#define LOG_CONFIG        1
+#define LOG_NETWORK       2
+#define LOG_CLOCK         3
+#define LOG_SENSOR        4
+#define LOG_DB            5
+#define LOG_WEB           6
+#define LOG_UPDATE        7
+#define LOG_ARCHIVE       8
+#define LOG_ALERTS        9
+#define LOG_CAPTURE       10
+#define LOG_MODULES       11
+
+#define LOG_BUFFER_SIZE   2048      // Ring of recent lines, also served on /log
+#define LOG_LINE_MAX      160       // Longer lines are truncated
+#define LOG_RATE          20        // Lines per second on average..
+#define LOG_BURST         40        // ..with bursts up to this many
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR( module, fmt, ... )  Log.write( LOG_LEVEL_ERROR, module, PSTR( fmt ), ##__VA_ARGS__ )
+#else
+#define LOG_ERROR( module, fmt, ... )  do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN( module, fmt, ... )   Log.write( LOG_LEVEL_WARN, module, PSTR( fmt ), ##__VA_ARGS__ )
+#else
+#define LOG_WARN( module, fmt, ... )   do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO( module, fmt, ... )   Log.write( LOG_LEVEL_INFO, module, PSTR( fmt ), ##__VA_ARGS__ )
+#else
+#define LOG_INFO( module, fmt, ... )   do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG( module, fmt, ... )  Log.write( LOG_LEVEL_DEBUG, module, PSTR( fmt ), ##__VA_ARGS__ )
+#else
+#define LOG_DEBUG( module, fmt, ... )  do {} while (0)
+#endif
+
+class Config;
+
+
+//
+// Logger Library Class
+// Everything is constant initialized so other globals' constructors
+// (Config reads EEPROM in its constructor) can log before setup().
+class Logger
+{
+  public:
+    void begin( Config *config );
+    void loop();
+    void flush();                       // Blocking, ahead of an ESP.restart()
+    void write( byte level, byte module, PGM_P fmt, ... ) __attribute__(( format( printf, 4, 5 ) ));
+
+    // Lines written at or after position since, and where the next
+    // call should continue from
+    String lines( uint32_t since, uint32_t &next );
+
+  private:
+    Config        *_config     = nullptr;
+    char           _ring[ LOG_BUFFER_SIZE ] = {};
+    uint32_t       _head       = 0;     // Positions count bytes ever written,
+    uint32_t       _tail       = 0;     // the ring index is position % size
+    uint32_t       _serial     = 0;     // Drained to serial up to here
+    uint32_t       _dropped    = 0;     // Rate limited since the last line
+    uint16_t       _tokens     = LOG_BURST;
+    unsigned long  _refill     = 0;
+
+    void append( const char *line, size_t len );
+    void drain();
+};
+
+extern Logger Log;
+
+#endif
@@ -6,6 +6,8 @@
 
 #include "Network.h"
 #include "Config.h"
+#include "Sensor.h"
+#include "Log.h"
 
 Network::Network() {
   // Set the SSID we'll use in AP mode
@@ -21,6 +23,7 @@ Network::Network() {
 void Network::begin( Config *config ) {
   // Keep a reference to the config
   _config = config;
+  _config->onChange( std::bind( &Network::configChanged, this, std::placeholders::_1 ) );
   
   // Try WIFI_CONNECT_ATTEMPTS times to get on the network
   connect( WIFI_CONNECT_ATTEMPTS );
@@ -28,7 +31,7 @@ void Network::begin( Config *config ) {
   // If after trying to connect we're still not connected, 
   // start in Access Point mode.
   if ( !connected() ) {
-    Serial.println( "[Network] WiFi Connection failed, Starting AP..." );
+    LOG_WARN( LOG_NETWORK, "WiFi connection failed, starting AP..." );
 
     // Start the access point
     start_ap();
@@ -36,11 +39,29 @@ void Network::begin( Config *config ) {
 }
 
 void Network::loop() {
-  if ( millis() > _next_network_check ) {
+  apply_sleep();
+  mdns_loop();
+
+  if ( _reconnect && millis() > _reconnect_at ) {
+    _reconnect = false;
+
+    // Join the network with the new settings
+    WiFi.disconnect( true );
+    connect( WIFI_CONNECT_ATTEMPTS );
     if ( !connected() )
+      start_ap();
+    else if ( _mdns )
+      MDNS.notifyAPChange();
+  }
+
+  if ( millis() > _next_network_check ) {
+    if ( !connected() ) {
       connect( WIFI_CONNECT_ATTEMPTS );
-    else
-      Serial.printf( "[Network] Signal Strength: %d dBm\n", WiFi.RSSI() );
+      if ( connected() && _mdns )
+        MDNS.notifyAPChange();
+    } else {
+      LOG_INFO( LOG_NETWORK, "Signal strength: %d dBm", WiFi.RSSI() );
+    }
 
     if ( !connected() )
       start_ap();
@@ -50,6 +71,205 @@ void Network::loop() {
   
 }
 
+// Settings changed: a new SSID/password needs a reconnect, a new
+// hostname can be set in place.
+void Network::configChanged( uint64_t changed ) {
+  if ( changed & CONFIG_WIFI_CHANGES ) {
+    // Give the web request that made the change time to be answered
+    _reconnect_at = millis() + 2000;
+    _reconnect    = true;
+
+  } else if ( changed & CONFIG_BIT(CONFIG_HOSTNAME) ) {
+    WiFi.hostname( _config->conf.hostname );
+  }
+
+  // The responder probes for the new name and announces it
+  if ( ( changed & CONFIG_BIT(CONFIG_HOSTNAME) ) && _mdns )
+    MDNS.setHostname( _config->conf.hostname );
+
+  if ( changed & CONFIG_BIT(CONFIG_LOCATION) )
+    _announce = true;
+
+  // Picked up by the next apply_sleep()
+  if ( changed & CONFIG_SLEEP_CHANGES )
+    _sleep_applied = 0xff;
+}
+
+
+void Network::wake( unsigned long ms ) {
+  unsigned long until = millis() + ms;
+  if ( until > _awake_until ) _awake_until = until;
+}
+
+bool Network::awake() { return millis() < _awake_until; }
+
+
+// Set the radio's power save mode for what's going on right now.
+// Between wakes the radio only listens for every listen_interval'th
+// DTIM beacon, which is where packets for us get announced.
+void Network::apply_sleep() {
+  account();
+
+  byte mode = _config->conf.sleep_mode;
+
+  // The AP has to answer clients, and joining needs the radio up
+  if ( awake() || !connected() || ( WiFi.getMode() & WIFI_AP ) )
+    mode = SLEEP_NONE;
+
+  if ( mode == _sleep_applied ) return;
+
+  switch ( mode ) {
+    case SLEEP_MODEM:
+      WiFi.setSleepMode( WIFI_MODEM_SLEEP, _config->conf.listen_interval );
+      break;
+    case SLEEP_LIGHT:
+      WiFi.setSleepMode( WIFI_LIGHT_SLEEP, _config->conf.listen_interval );
+      break;
+    default:
+      WiFi.setSleepMode( WIFI_NONE_SLEEP );
+      break;
+  }
+
+  LOG_DEBUG( LOG_NETWORK, "Sleep mode %d, listen interval %d", mode, _config->conf.listen_interval );
+  _sleep_applied = mode;
+}
+
+
+// Charge the time since the last call to the mode the radio was in
+void Network::account() {
+  unsigned long now = millis();
+
+  if ( _sleep_applied <= SLEEP_LIGHT )
+    _ms_in[ _sleep_applied ] += now - _accounted_at;
+
+  _accounted_at = now;
+}
+
+
+// Light sleep only happens while the CPU idles in delay()
+unsigned long Network::idle() {
+  return ( _sleep_applied == SLEEP_LIGHT ) ? NET_LIGHT_IDLE : 0;
+}
+
+
+uint32_t Network::awake_permille() {
+  uint32_t total = _ms_in[ SLEEP_NONE ] + _ms_in[ SLEEP_MODEM ] + _ms_in[ SLEEP_LIGHT ];
+  return total ? (uint64_t)_ms_in[ SLEEP_NONE ] * 1000 / total : 1000;
+}
+
+
+uint32_t Network::est_ua() {
+  uint64_t total = _ms_in[ SLEEP_NONE ] + _ms_in[ SLEEP_MODEM ] + _ms_in[ SLEEP_LIGHT ];
+  if ( total == 0 ) return NET_MA_AWAKE * 1000;
+
+  uint64_t charge = (uint64_t)_ms_in[ SLEEP_NONE ]  * NET_MA_AWAKE +
+                    (uint64_t)_ms_in[ SLEEP_MODEM ] * NET_MA_MODEM +
+                    (uint64_t)_ms_in[ SLEEP_LIGHT ] * NET_MA_LIGHT;
+  return charge * 1000 / total;
+}
+
+
+uint32_t Network::wake_latency_ms() {
+  if ( _sleep_applied == SLEEP_MODEM || _sleep_applied == SLEEP_LIGHT )
+    return _config->conf.listen_interval * NET_BEACON_MS;
+  return 0;
+}
+
+
+// Power figures for /power.  Estimates from time in each mode, not
+// a measurement; compare them between settings rather than trust them.
+String Network::powerJSON() {
+  static const char *modes[] = { "none", "modem", "light" };
+
+  return "{\"mode\": \"" + String( _sleep_applied <= SLEEP_LIGHT ? modes[ _sleep_applied ] : "unknown" ) + "\", "
+         "\"listen_interval\": " + String( _config->conf.listen_interval ) + ", "
+         "\"awake_pct\": " + String( awake_permille() / 10.0, 1 ) + ", "
+         "\"ms_awake\": " + String( _ms_in[ SLEEP_NONE ] ) + ", "
+         "\"ms_modem\": " + String( _ms_in[ SLEEP_MODEM ] ) + ", "
+         "\"ms_light\": " + String( _ms_in[ SLEEP_LIGHT ] ) + ", "
+         "\"est_ma\": " + String( est_ua() / 1000.0, 2 ) + ", "
+         "\"est_mah_day\": " + String( est_ua() * 24 / 1000.0, 1 ) + ", "
+         "\"wake_latency_ms\": " + String( wake_latency_ms() ) + "}";
+}
+
+
+void Network::advertise( Sensor *sensor, uint16_t port, const String &fs_version ) {
+  _sensor     = sensor;
+  _mdns_port  = port;
+  _fs_version = fs_version;
+}
+
+
+// Start the responder once there's a network to answer on, and push
+// changed readings out to the caches of whoever's listening
+void Network::mdns_loop() {
+  if ( !_sensor || !connected() ) return;
+
+  if ( !_mdns ) {
+    if ( millis() < _next_announce ) return;
+    _next_announce = millis() + NET_MDNS_ANNOUNCE;
+
+    if ( !MDNS.begin( _config->conf.hostname ) ) {
+      LOG_ERROR( LOG_NETWORK, "mDNS responder failed to start" );
+      return;
+    }
+
+    MDNS.addService( "http", "tcp", _mdns_port );
+    MDNSResponder::hMDNSService service = MDNS.addService( nullptr, NET_MDNS_SERVICE, "tcp", _mdns_port );
+    MDNS.setDynamicServiceTxtCallback( service, std::bind( &Network::mdns_txt, this, std::placeholders::_1 ) );
+
+    _mdns = true;
+    LOG_INFO( LOG_NETWORK, "mDNS: %s.local, _http._tcp and _%s._tcp", _config->conf.hostname, NET_MDNS_SERVICE );
+  }
+
+  MDNS.update();
+
+  // Answers always carry the current values, announcing just saves
+  // a listener from asking again.  Rate limited, a fast sample
+  // interval shouldn't turn into multicast traffic.
+  if ( millis() < _next_announce ) return;
+
+  const sensor_sample &sample = _sensor->get_sample();
+  if ( sample.valid && ( sample.temp != _announced[0] || sample.humidity != _announced[1] ) )
+    _announce = true;
+  if ( sample.analog_valid && sample.pressure != _announced[2] )
+    _announce = true;
+
+  if ( !_announce ) return;
+
+  _announced[0]  = sample.temp;
+  _announced[1]  = sample.humidity;
+  _announced[2]  = sample.pressure;
+  _announce      = false;
+  _next_announce = millis() + NET_MDNS_ANNOUNCE;
+
+  MDNS.announce();
+}
+
+
+// TXT record of the _heatstroke._tcp service, built per answer.  Short
+// keys, the whole record has to fit in the answer packet.
+void Network::mdns_txt( const MDNSResponder::hMDNSService service ) {
+  const sensor_sample &sample = _sensor->get_sample();
+  char buf[16];
+
+  MDNS.addDynamicServiceTxt( service, "fw", INO_VERSION );
+  MDNS.addDynamicServiceTxt( service, "fs", _fs_version.c_str() );
+  MDNS.addDynamicServiceTxt( service, "loc", _config->conf.location );
+
+  if ( sample.valid ) {
+    MDNS.addDynamicServiceTxt( service, "t", Sensor::format_fixed( sample.temp, buf ) );      // F
+    MDNS.addDynamicServiceTxt( service, "h", Sensor::format_fixed( sample.humidity, buf ) );  // %
+  }
+
+  if ( sample.analog_valid )
+    MDNS.addDynamicServiceTxt( service, "p", Sensor::format_fixed( sample.pressure, buf ) );
+
+  if ( sample.timestamp )
+    MDNS.addDynamicServiceTxt( service, "ts", sample.timestamp );
+}
+
+
 // Returns true if the wifi is connected
 bool Network::connected() {
   if ( WiFi.status() != WL_CONNECTED )
@@ -72,20 +292,21 @@ void Network::connect( int attempts ) {
   WiFi.begin( _config->conf.ssid, _config->conf.wifi_pw );
 
   // Try *attempts* times to get on the network
-  Serial.println( "[Network] Mac Address: " + WiFi.macAddress() );
-  Serial.print( "[Network] Connecting to WiFi (" + String( _config->conf.ssid ) + ")" );
-  for ( int x=0; x < attempts; x++ ) {
+  LOG_INFO( LOG_NETWORK, "Mac address: %s", WiFi.macAddress().c_str() );
+  LOG_INFO( LOG_NETWORK, "Connecting to WiFi (%s)", _config->conf.ssid );
+  int x;
+  for ( x=0; x < attempts; x++ ) {
     if ( connected() )
       break;
     
-    Serial.print(".");
     delay(5000);
   }
-  Serial.println();
 
   if ( WiFi.status() == WL_CONNECTED ) {
     _ipaddr = WiFi.localIP().toString();
-    Serial.println( "[Network] Connected to: " + ssid() + "  IP: " + _ipaddr );
+    LOG_INFO( LOG_NETWORK, "Connected to: %s  IP: %s", ssid().c_str(), _ipaddr.c_str() );
+  } else {
+    LOG_WARN( LOG_NETWORK, "Not connected after %d attempts", x );
   }
 
 }
@@ -98,6 +319,6 @@ void Network::start_ap() {
   WiFi.softAP( _ap_ssid.c_str(), _ap_passwd );
   
   _ipaddr = WiFi.softAPIP().toString();
-  Serial.println("AP SSID:" + _ap_ssid + "  Web config IP: http://" + _ipaddr + ":8080");
+  LOG_INFO( LOG_NETWORK, "AP SSID: %s  Web config IP: http://%s:8080", _ap_ssid.c_str(), _ipaddr.c_str() );
 }
 
@@ -5,15 +5,39 @@
 #ifndef Network_h
 #define Network_h
 
+#include <ESP8266mDNS.h>
+
 #include "defaults.h"
 #include "Config.h"
 
+class Sensor;
+
 // Number of tries to connect to wifi before starting AP
 #define WIFI_CONNECT_ATTEMPTS    5     
 
 // How often to test check network connection
 #define NETWORK_CHECK_INTERVAL   60*5
 
+// Radio kept fully awake this long after a web request, so the
+// pages that follow it aren't held up by beacon wakes
+#define NET_WAKE_INTERACTIVE     30*1000   // ms
+
+// How long loop() idles per pass in light sleep; the SDK only
+// sleeps inside delay()
+#define NET_LIGHT_IDLE           100       // ms
+
+// Rough ESP8266 current for the power estimate, from the datasheet.
+// Light sleep includes the beacon wakes at a listen interval of 1-3.
+#define NET_MA_AWAKE             70
+#define NET_MA_MODEM             16
+#define NET_MA_LIGHT             3
+#define NET_BEACON_MS            102       // Beacon interval, assuming DTIM 1
+
+// DNS-SD service carrying the readings in its TXT record, next to
+// the plain _http._tcp one
+#define NET_MDNS_SERVICE         "heatstroke"
+#define NET_MDNS_ANNOUNCE        30*1000   // ms, least time between announcing new readings
+
 
 //
 // Network Library Class
@@ -31,16 +55,53 @@ class Network
     String ipaddr();
     String macaddr();
     String hostname();
+    void configChanged( uint64_t changed );
+
+    // Keep the radio out of power save for the next ms.  Only records
+    // the request, so it's safe from web handlers; loop() applies it.
+    void wake( unsigned long ms );
+    bool awake();
+    unsigned long idle();              // ms for loop() to idle, 0 if it shouldn't
+
+    // Power/latency estimates since boot
+    uint32_t awake_permille();
+    uint32_t est_ua();                 // Average current, microamps
+    uint32_t wake_latency_ms();        // Worst case added delay answering a packet
+    String   powerJSON();
+
+    // Advertise the web server and the readings over mDNS once we're
+    // on the network.  TXT values are filled in when a query comes in.
+    void advertise( Sensor *sensor, uint16_t port, const String &fs_version );
 
 
   private:
     Config     *_config;
+    bool       _reconnect              = false;   // SSID/password changed
+    unsigned long _reconnect_at        = 0;
     const int  _network_check_interval = NETWORK_CHECK_INTERVAL * 1000;
     int        _next_network_check     = _network_check_interval;
     String     _ap_ssid;
     const char *_ap_passwd = DEFAULT_WIFI_PW;
     String     _ipaddr;
     String     _hostname;
+
+    byte          _sleep_applied = 0xff;    // SLEEP_* the radio is set to
+    unsigned long _awake_until   = 0;
+    unsigned long _accounted_at  = 0;
+    uint32_t      _ms_in[3]      = { 0, 0, 0 };  // Time spent in each SLEEP_* mode
+
+    Sensor       *_sensor        = nullptr;   // Nothing advertised without it
+    uint16_t      _mdns_port     = 0;
+    String        _fs_version;
+    bool          _mdns          = false;     // Responder started
+    bool          _announce      = false;     // TXT values changed outside the readings
+    unsigned long _next_announce = 0;
+    int32_t       _announced[3]  = { 0, 0, 0 };  // temp, humidity, pressure last announced
+
+    void apply_sleep();
+    void account();
+    void mdns_loop();
+    void mdns_txt( const MDNSResponder::hMDNSService service );
 };
 
 #endif
@@ -5,7 +5,11 @@
 #include <DHT.h>
 
 #include "Sensor.h"
+#include "Derived.h"
 #include "defaults.h"
+#include "Log.h"
+
+static const uint8_t _rungs[] = SENSOR_POLL_RUNGS;
 
 
 //Sensor::Sensor(uint8_t pin, uint8_t type) {
@@ -14,11 +18,13 @@
 //};
 
 
-void Sensor::begin( Config *config ) {
-  // Keep a reference to the config
-  _config = config;
+void Sensor::begin( Config *config, Clock *clock, Capture *capture ) {
+  // Keep a reference to the config, clock & capture
+  _config  = config;
+  _clock   = clock;
+  _capture = capture;
   _poll_sensor_interval = SENSOR_POLL_INTERVAL * 1000;
-  _next_sensor_poll = millis() + _poll_sensor_interval;
+  _next_sensor_poll = millis() + next_poll_delay();
 
   sensor_on();
   _dht.begin();
@@ -27,12 +33,23 @@ void Sensor::begin( Config *config ) {
 
 void Sensor::loop() {
   if (millis() > _next_sensor_poll) {   // Time to read the sensors
+    _retry_delay = 0;
     read_sensor();
-    _next_sensor_poll = millis() + _poll_sensor_interval;
+    _next_sensor_poll = millis() + ( _retry_delay ? _retry_delay : next_poll_delay() );
   }
 }
 
 
+// Once the wall clock is known, polls line up with its boundaries
+// (:00, :10, :20...) so readings across units share timestamps.
+unsigned long Sensor::next_poll_delay() {
+  if ( _clock && _clock->valid() )
+    return _clock->millis_until( _poll_sensor_interval / 1000 );
+
+  return _poll_sensor_interval;
+}
+
+
 // Main Sensor Turn On
 void Sensor::sensor_on() {
   pinMode(DHTPWR, OUTPUT);
@@ -43,15 +60,23 @@ void Sensor::sensor_on() {
 // Try to reset the DHT sensor.  This only works if your
 // sensor is wired to use the DHTPWR pin
 void Sensor::reset_sensor() {
-  Serial.println("Resetting Sensor...");
+  _health.resets++;
+  _resets_in_row++;
+
+  // Each reset that doesn't bring it back waits longer for the next
+  unsigned long backoff = SENSOR_RESET_BACKOFF;
+  for ( byte i = 1; i < _resets_in_row && backoff < SENSOR_RESET_BACKOFF_MAX; i++ ) backoff *= 2;
+  if ( backoff > SENSOR_RESET_BACKOFF_MAX ) backoff = SENSOR_RESET_BACKOFF_MAX;
+  _next_reset_at = millis() + backoff * 1000;
+
+  LOG_WARN( LOG_SENSOR, "Resetting sensor (%u in a row, next no sooner than %lus)", _resets_in_row, backoff );
 
   digitalWrite(DHTPWR, 0);
   delay(500);
   digitalWrite(DHTPWR, 1);
 
-  // Give the sensor a cooling off by skipping the next interval
-  _next_sensor_poll = millis() + _poll_sensor_interval*2;
-//  delay(SENSOR_DELAY_AFTER_RESET);
+  // Only as long as the sensor needs to come up, not a whole interval
+  _retry_delay = SENSOR_RESET_SETTLE;
   
   _dht.begin();
 }
@@ -61,48 +86,251 @@ float Sensor::get_temp()     { return _cur_temp; }
 float Sensor::get_humidity() { return _cur_humidity; }
 float Sensor::get_hindex()   { return _cur_hindex; }
 float Sensor::get_analog()   { return _cur_analog; }
+const sensor_sample& Sensor::get_sample() { return _sample; }
+const sensor_health& Sensor::get_health() { return _health; }
+
+
+// Health counters for /health
+String Sensor::healthJSON() {
+  const char *status = _health.is_stuck                              ? "stuck"
+                     : ( _health.consecutive >= SENSOR_RESET_AFTER ) ? "failing"
+                     : ( _health.consecutive > 0 || _health.fail_rate >= 100 ) ? "degraded"
+                     : "ok";
+
+  String json;
+  json.reserve( 200 );
+  json += "{\"status\": \"";     json += status;
+  json += "\", \"reads\": ";     json += _health.reads;
+  json += ", \"failures\": ";     json += _health.failures;
+  json += ", \"rejected\": ";     json += _health.rejected;
+  json += ", \"stuck\": ";        json += _health.stuck;
+  json += ", \"resets\": ";       json += _health.resets;
+  json += ", \"fail_rate\": ";    json += _health.fail_rate / 10.0;
+  json += ", \"consecutive\": ";  json += _health.consecutive;
+  json += ", \"interval\": ";     json += _health.interval;
+  json += ", \"last_good_s\": ";  json += _last_sensor_read ? (long)( ( millis() - _last_sensor_read ) / 1000 ) : -1L;
+  json += "}";
+  return json;
+}
+
+
+bool Sensor::get_raw( byte channel, int32_t &raw ) {
+  if ( channel >= CAL_CHANNELS || !_raw_valid[ channel ] ) return false;
+  raw = _raw[ channel ];
+  return true;
+}
+
+
+// Each channel's table with the latest raw reading and what it
+// calibrates to, for /calibration
+String Sensor::calibrationJSON() {
+  char   buf[16];
+  String json;
+  json.reserve( 384 );
+  json += "{";
+  for ( byte ch = 0; ch < CAL_CHANNELS; ch++ ) {
+    const cal_table &table = _config->conf.cal[ ch ];
+
+    if ( ch > 0 ) json += ", ";
+    json += "\"";             json += Calibration::channel_name( ch );
+    json += "\": {\"table\": \""; json += Calibration::format( table );
+    json += "\", \"raw\": ";
+    if ( _raw_valid[ ch ] ) {
+      json += format_fixed( _raw[ ch ], buf );
+      json += ", \"value\": "; json += format_fixed( Calibration::apply( table, _raw[ ch ] ), buf );
+    } else {
+      json += "null, \"value\": null";
+    }
+    json += "}";
+  }
+  json += "}";
+  return json;
+}
+
+
+// Format a fixed-point reading as a decimal string ("-12.05")
+// without going through float.
+String Sensor::format_fixed( int32_t value ) {
+  char buf[16];
+  return String( format_fixed( value, buf ) );
+}
+
+// Without the printf machinery, this runs for every field of every point
+const char* Sensor::format_fixed( int32_t value, char *buf ) {
+  uint32_t mag = ( value < 0 ) ? -(uint32_t)value : value;
+  char     tmp[12];
+  byte     n = 0;
+
+  // Digits backwards, the two decimals first
+  uint32_t whole = mag / SENSOR_FIXED_SCALE;
+  uint32_t frac  = mag % SENSOR_FIXED_SCALE;
+  tmp[n++] = '0' + frac % 10;
+  tmp[n++] = '0' + frac / 10;
+  tmp[n++] = '.';
+  do {
+    tmp[n++] = '0' + whole % 10;
+    whole /= 10;
+  } while ( whole );
+
+  char *p = buf;
+  if ( value < 0 ) *p++ = '-';
+  while ( n ) *p++ = tmp[--n];
+  *p = '\0';
+
+  return buf;
+}
+
+// The other way, "-12.5" -> -1250.  Moves p past the number.
+bool Sensor::parse_fixed( const char *&p, int32_t &out ) {
+  bool     negative = ( *p == '-' );
+  int32_t  value    = 0;
+  byte     digits   = 0;
+
+  if ( *p == '-' || *p == '+' ) p++;
+
+  for ( ; isdigit( *p ); p++, digits++ ) {
+    if ( digits >= 7 ) return false;
+    value = value * 10 + ( *p - '0' );
+  }
+  value *= SENSOR_FIXED_SCALE;
+
+  if ( *p == '.' ) {
+    p++;
+    int32_t scale = SENSOR_FIXED_SCALE / 10;
+    for ( ; isdigit( *p ); p++, digits++ ) {
+      if ( scale == 0 ) return false;    // More decimals than we keep
+      value += ( *p - '0' ) * scale;
+      scale /= 10;
+    }
+  }
+
+  out = negative ? -value : value;
+  return digits > 0;
+}
+
+
 float Sensor::get_pressure() {
   if (_cur_analog)
-    return ((_cur_analog / 1024) * 200) - 3.35; // dirty offset removal  
+    return float(_sample.pressure) / SENSOR_FIXED_SCALE;
   return NAN;
 }
 
 
-// Attempt to read sensor values from the DHT22
+// Attempt to read sensor values from the DHT22.  Readings that fail,
+// are out of range, jump implausibly or stop changing altogether
+// never make it to the sample.
 void Sensor::read_sensor() {
-    Serial.println("[Sensor] read_sensor");
+    LOG_DEBUG( LOG_SENSOR, "read_sensor" );
+    _health.reads++;
 
-    // Subtract the temperature offset due to heating from the MCU
-    float temp     = _dht.readTemperature(true) - _config->conf.t_offset;
+    // Readings are stamped with the time they were taken
+    uint32_t timestamp = ( _clock && _clock->valid() ) ? _clock->now() : 0;
+
+    float temp     = _dht.readTemperature(true);
     float humidity = _dht.readHumidity();
 
     if (isnan(temp) || isnan(humidity)) {
       // Successfully failed to get a readout from the DHT22
-      Serial.println("[Sensor] Failed to get reading from DHT22");
+      LOG_WARN( LOG_SENSOR, "Failed to get reading from DHT22" );
+      _health.failures++;
+      failed();
+
+    } else {
+      // Through the calibration tables, which also take out the
+      // heating from the MCU
+      int32_t raw_t = lroundf( temp * SENSOR_FIXED_SCALE );
+      int32_t raw_h = lroundf( humidity * SENSOR_FIXED_SCALE );
+      _raw[ CAL_TEMP ]           = raw_t;
+      _raw[ CAL_HUMIDITY ]       = raw_h;
+      _raw_valid[ CAL_TEMP ]     = true;
+      _raw_valid[ CAL_HUMIDITY ] = true;
+
+      int32_t t = Calibration::apply( _config->conf.cal[ CAL_TEMP ], raw_t );
+      int32_t h = raw_h;
+
+      // Calibrated just past 0 or 100 % is 0 or 100 %.  Out of range
+      // raw is garbage and left for plausible() to turn down.
+      if ( raw_h >= 0 && raw_h <= 100 * SENSOR_FIXED_SCALE )
+        h = constrain( Calibration::apply( _config->conf.cal[ CAL_HUMIDITY ], raw_h ), 0, 100 * SENSOR_FIXED_SCALE );
+
+      if ( plausible( t, h ) ) {
+        // Successfully got a readout
+        bool changing = !_sample.valid ||
+                        abs( t - _sample.temp ) >= SENSOR_STABLE_TEMP || abs( h - _sample.humidity ) >= SENSOR_STABLE_HUM;
+
+        // Exactly the same for a long time means the sensor stopped
+        // converting and is repeating its last result.  Compared with
+        // the last reading rather than the sample, which is cleared
+        // once the readings are found stuck.
+        bool same = _have_last && t == _last_temp && h == _last_hum;
+        _last_temp = t;
+        _last_hum  = h;
+        _have_last = true;
+
+        if ( same ) {
+          _stuck_reads++;
+        } else {
+          _stuck_reads = 0;
+          _stuck_since = millis();
+        }
+
+        // Once stuck, only a different value clears it
+        bool stuck = same && ( _health.is_stuck ||
+                               ( _stuck_reads >= SENSOR_STUCK_READS && millis() - _stuck_since > SENSOR_STUCK_SECONDS * 1000UL ) );
+
+        if ( stuck ) {
+          if ( !_health.is_stuck ) {
+            LOG_ERROR( LOG_SENSOR, "Readings stuck at %ld/%ld", (long)t, (long)h );
+            _health.stuck++;
+            _health.is_stuck = true;
+          }
+          _cur_temp     = NAN;
+          _cur_humidity = NAN;
+          _cur_hindex   = NAN;
+          _sample.valid = false;
+          failed();
+        } else {
+          _health.is_stuck    = false;
+          _health.consecutive = 0;
+          _health.fail_rate   = _health.fail_rate * 15 / 16;
+          _resets_in_row      = 0;
+          _last_sensor_read   = millis();
+
+          _cur_temp     = float(t) / SENSOR_FIXED_SCALE;
+          _cur_humidity = float(h) / SENSOR_FIXED_SCALE;
+
+          // Fixed-point copy for the API and DB
+          _sample.seq++;
+          _sample.timestamp = timestamp;
+          _sample.temp      = t;
+          _sample.humidity  = h;
+          _sample.valid     = true;
+
+          // Heat index, dew point, etc. straight from the fixed-point readings
+          derived_metrics metrics;
+          Derived::compute( _sample.temp, _sample.humidity, _config->conf.derived, metrics );
+          _sample.derived      = _config->conf.derived;
+          _sample.hindex       = metrics.hindex;
+          _sample.dewpoint     = metrics.dewpoint;
+          _sample.abs_humidity = metrics.abs_humidity;
+          _sample.vpd          = metrics.vpd;
 
-      // If we haven't got a reading in SENSOR_RESET_INTERVAL, reset the sensor
-      if (millis() - _last_sensor_read > SENSOR_RESET_INTERVAL * 1000) {
-        reset_sensor();  // may the odds be ever in your favor.
-        _last_sensor_read = millis();   // not really, but set the counters based off now
+          _cur_hindex = ( _sample.derived & DERIVED_HINDEX ) ? float(_sample.hindex) / SENSOR_FIXED_SCALE : NAN;
 
-        // Clear out current readings
-        _cur_temp     = NAN;
-        _cur_humidity = NAN;
-        _cur_hindex   = NAN;
+          LOG_DEBUG( LOG_SENSOR, "Temp: %.2fF   Humidity: %.2f%%   Heat Index: %.2f",
+                     (double)_cur_temp, (double)_cur_humidity, (double)_cur_hindex );
+
+          adapt_interval( changing );
+        }
       }
+    }
 
-    } else {
-      // Successfully got a readout
-      _last_sensor_read = millis();
-   
-      _cur_temp     = temp;
-      _cur_humidity = humidity;
-      _cur_hindex   = _dht.computeHeatIndex(temp, humidity);
-
-      // Write out to serial
-      Serial.println("[Sensor] Temp: " + String(_cur_temp, 2) + "F   " 
-                    "Humidity: " + String(_cur_humidity, 2) + "%   "
-                    "Heat Index: " + String(_cur_hindex, 2));
+    // Nothing good in a while, stop handing out old readings
+    if ( _sample.valid && millis() - _last_sensor_read > SENSOR_STALE_AFTER * 1000UL ) {
+      _cur_temp     = NAN;
+      _cur_humidity = NAN;
+      _cur_hindex   = NAN;
+      _sample.valid = false;
     }
 
     // Calculate Pressure
@@ -110,15 +338,106 @@ void Sensor::read_sensor() {
 }
 
 
+// Range and rate-of-change checks.  A jump is only believed once a
+// second reading agrees with it, so a real step (the unit was moved)
+// costs one reading and a glitch costs nothing.
+bool Sensor::plausible( int32_t temp, int32_t humidity ) {
+  if ( temp < SENSOR_MIN_TEMP || temp > SENSOR_MAX_TEMP || humidity < 0 || humidity > 100 * SENSOR_FIXED_SCALE ) {
+    LOG_WARN( LOG_SENSOR, "Rejected out of range reading %ld/%ld", (long)temp, (long)humidity );
+    _health.rejected++;
+    failed();   // Checksum-valid garbage, as bad as no reading
+    return false;
+  }
+
+  if ( !_sample.valid ) return true;
+
+  unsigned long secs     = ( millis() - _last_sensor_read ) / 1000;
+  int32_t       max_temp = SENSOR_SPIKE_TEMP + SENSOR_SPIKE_TEMP_RATE * secs;
+  int32_t       max_hum  = SENSOR_SPIKE_HUM  + SENSOR_SPIKE_HUM_RATE  * secs;
+
+  if ( abs( temp - _sample.temp ) <= max_temp && abs( humidity - _sample.humidity ) <= max_hum ) {
+    _candidate = false;
+    return true;
+  }
+
+  if ( _candidate && abs( temp - _candidate_temp ) <= SENSOR_SPIKE_TEMP && abs( humidity - _candidate_hum ) <= SENSOR_SPIKE_HUM ) {
+    LOG_INFO( LOG_SENSOR, "Step change confirmed: %ld/%ld", (long)temp, (long)humidity );
+    _candidate = false;
+    return true;
+  }
+
+  LOG_WARN( LOG_SENSOR, "Rejected spike %ld/%ld", (long)temp, (long)humidity );
+  _health.rejected++;
+  _candidate      = true;
+  _candidate_temp = temp;
+  _candidate_hum  = humidity;
+
+  // Confirm or dismiss it soon
+  _retry_delay = SENSOR_RETRY_DELAY;
+  return false;
+}
+
+
+// Poll faster while readings move, slower once they settle.  Never
+// slower than the DB sends, so every send has a fresh reading.
+void Sensor::adapt_interval( bool changing ) {
+  byte top = 0;
+  while ( top + 1 < sizeof(_rungs) && _rungs[ top + 1 ] <= _config->conf.sample_interval ) top++;
+
+  if ( changing ) {
+    _stable_reads = 0;
+    if ( _rung > 0 ) _rung--;
+  } else if ( ++_stable_reads >= SENSOR_STABLE_READS ) {
+    _stable_reads = 0;
+    if ( _rung < top ) _rung++;
+  }
+  if ( _rung > top ) _rung = top;
+
+  if ( _health.interval != _rungs[ _rung ] )
+    LOG_DEBUG( LOG_SENSOR, "Poll interval %us", _rungs[ _rung ] );
+
+  _health.interval      = _rungs[ _rung ];
+  _poll_sensor_interval = _health.interval * 1000;
+}
+
+
+// A read that gave nothing usable: retry quickly a couple of times,
+// then power cycle, backing off between cycles
+void Sensor::failed() {
+  _health.consecutive++;
+  _health.fail_rate = ( _health.fail_rate * 15 + 1000 ) / 16;
+
+  if ( _health.consecutive < SENSOR_RESET_AFTER ) {
+    _retry_delay = SENSOR_RETRY_DELAY;
+  } else if ( millis() >= _next_reset_at ) {
+    reset_sensor();  // may the odds be ever in your favor.
+    _stuck_reads = 0;
+    _stuck_since = millis();
+  }
+}
+
+
 // Sample the analog sensor
 void Sensor::read_analog() {
   uint16_t sum = 0;
-  for(int i=0; i < 64; i++) {
-    delay(5);
-    sum += analogRead(PRESSURE_PIN);
+
+  // While capturing, the ADC is already being sampled.  Reading it
+  // here as well would leave a hole in the capture.
+  if ( !_capture || !_capture->average( sum ) ) {
+    for(int i=0; i < 64; i++) {
+      delay(5);
+      sum += analogRead(PRESSURE_PIN);
+    }
   }
   _cur_analog = float(sum) / 64.0;
-  Serial.println("[Sensor] Analog Sensor: " + String(_cur_analog));
+
+  _sample.analog       = ( (int32_t)sum * SENSOR_FIXED_SCALE ) / 64;
+  _sample.pressure     = Calibration::apply( _config->conf.cal[ CAL_PRESSURE ], _sample.analog );
+  _sample.analog_valid = true;
+
+  _raw[ CAL_PRESSURE ]       = _sample.analog;
+  _raw_valid[ CAL_PRESSURE ] = true;
+  LOG_DEBUG( LOG_SENSOR, "Analog sensor: %.2f", (double)_cur_analog );
 }
 
 
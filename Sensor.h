@@ -9,10 +9,77 @@
 #include <DHT.h>
 #include "defaults.h"
 #include "Config.h"
+#include "Clock.h"
+#include "Derived.h"
+#include "Capture.h"
+
+#define SENSOR_POLL_INTERVAL     10    // Seconds, where adaptive polling starts
+#define SENSOR_STALE_AFTER       120   // Seconds without a good reading before the
+                                       // current readings are dropped
+#define SENSOR_FIXED_SCALE       100   // Fixed-point readings are in hundredths
+
+// Adaptive polling: one rung faster as soon as readings change, one
+// slower after SENSOR_STABLE_READS readings that didn't.  Every rung
+// divides a minute so polls stay on wall-clock boundaries.
+#define SENSOR_POLL_RUNGS        { 2, 5, 10, 20, 30, 60 }
+#define SENSOR_STABLE_READS      3
+#define SENSOR_STABLE_TEMP       20    // Hundredths F, less change counts as stable
+#define SENSOR_STABLE_HUM        50    // Hundredths %
+
+// Spike rejection: a reading that moved further than this from the
+// last good one is held back until the next reading confirms it
+#define SENSOR_SPIKE_TEMP        500   // Hundredths F..
+#define SENSOR_SPIKE_TEMP_RATE   2     // ..plus this per second since the last reading
+#define SENSOR_SPIKE_HUM         1000  // Hundredths %..
+#define SENSOR_SPIKE_HUM_RATE    5     // ..plus this per second
+#define SENSOR_MIN_TEMP          -4000 // DHT22 range, hundredths F
+#define SENSOR_MAX_TEMP          17600
+
+// The same reading this long is a sensor that stopped converting
+#define SENSOR_STUCK_SECONDS     60*30
+#define SENSOR_STUCK_READS       10
+
+// Failures: quick retries first, then power cycles with a growing
+// wait between them
+#define SENSOR_RETRY_DELAY       2500  // ms, the DHT22 needs 2 s between reads
+#define SENSOR_RESET_AFTER       3     // Failures in a row before a power cycle
+#define SENSOR_RESET_SETTLE      2000  // ms after power up before the next read
+#define SENSOR_RESET_BACKOFF     30    // Seconds before a second reset, doubling..
+#define SENSOR_RESET_BACKOFF_MAX 60*15 // ..up to this
+
+
+//
+// Latest readings in fixed point (value * SENSOR_FIXED_SCALE)
+struct sensor_sample {
+  uint32_t seq;            // Incremented on every successful DHT reading
+  uint32_t timestamp;      // Unix time when the reading was taken, 0 if the clock isn't set
+  int32_t  temp;           // F
+  int32_t  humidity;       // %
+  int32_t  hindex;         // F
+  int32_t  dewpoint;       // F
+  int32_t  abs_humidity;   // g/m^3
+  int32_t  vpd;            // kPa
+  byte     derived;        // DERIVED_* metrics computed for this sample
+  int32_t  analog;         // ADC counts
+  int32_t  pressure;
+  bool     valid;          // temp, humidity and the derived metrics are available
+  bool     analog_valid;   // analog and pressure are available
+};
+
+//
+// Health counters since boot, served on /health
+struct sensor_health {
+  uint32_t reads;          // DHT reads attempted
+  uint32_t failures;       // No reading (timeout or checksum)
+  uint32_t rejected;       // Out of range or spikes
+  uint32_t stuck;          // Times the readings were found stuck
+  uint32_t resets;         // Power cycles
+  uint16_t fail_rate;      // Recent failures, permille (moving average)
+  uint16_t consecutive;    // Failures in a row
+  uint16_t interval;       // Current poll interval, seconds
+  bool     is_stuck;
+};
 
-#define SENSOR_POLL_INTERVAL     10    // Seconds
-#define SENSOR_RESET_INTERVAL    60    // Reset the sensor if it's been at least this many
-                                       // seconds since we last got a successful reading
 
 //
 // Sensor Library Class
@@ -21,7 +88,7 @@ class Sensor
   public:
     Sensor(uint8_t pin, uint8_t type): _dht(pin, type) { };
 
-    void begin( Config *config );
+    void begin( Config *config, Clock *clock, Capture *capture );
     void loop();
 
     void sensor_on();
@@ -34,14 +101,48 @@ class Sensor
     float get_hindex();
     float get_analog();
     float get_pressure();
+    const sensor_sample& get_sample();
+    const sensor_health& get_health();
+    String healthJSON();
+
+    // Latest reading before calibration, false if there's none yet
+    bool   get_raw( byte channel, int32_t &raw );
+    String calibrationJSON();
+
+    static String format_fixed( int32_t value );
+    static const char* format_fixed( int32_t value, char *buf );     // buf of 16
+    static bool parse_fixed( const char *&p, int32_t &value );
     
   private:
     Config     *_config;
+    Clock      *_clock;
+    Capture    *_capture;
     DHT        _dht;
 //    DHT        _dht(DHTPIN, DHTTYPE);
 
-    int _poll_sensor_interval   = SENSOR_POLL_INTERVAL * 1000;    // Read the sensors every 10 seconds
+    int _poll_sensor_interval   = SENSOR_POLL_INTERVAL * 1000;    // Adapted by adapt_interval()
     int _next_sensor_poll       = _poll_sensor_interval;
+    unsigned long _retry_delay  = 0;    // Overrides the interval for the next poll
+
+    unsigned long next_poll_delay();
+    bool plausible( int32_t temp, int32_t humidity );
+    void adapt_interval( bool changing );
+    void failed();
+
+    // Health model
+    sensor_health _health  = { 0, 0, 0, 0, 0, 0, 0, SENSOR_POLL_INTERVAL, false };
+    byte     _rung         = 2;         // Index into SENSOR_POLL_RUNGS
+    byte     _stable_reads = 0;
+    bool     _candidate    = false;     // A spike waiting for confirmation
+    int32_t  _candidate_temp;
+    int32_t  _candidate_hum;
+    uint32_t _stuck_since  = 0;         // millis() the current value was first read
+    uint16_t _stuck_reads  = 0;
+    int32_t  _last_temp    = 0;         // Last plausible reading, stuck or not
+    int32_t  _last_hum     = 0;
+    bool     _have_last    = false;
+    byte     _resets_in_row = 0;
+    unsigned long _next_reset_at = 0;
 
     unsigned long _last_sensor_read = 0;
     float _cur_temp       = NAN;
@@ -49,6 +150,11 @@ class Sensor
     float _cur_hindex     = NAN;
     float _cur_analog     = NAN;
 
+    int32_t _raw[ CAL_CHANNELS ]       = {};    // Before calibration, by CAL_*
+    bool    _raw_valid[ CAL_CHANNELS ] = {};
+
+    sensor_sample _sample = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, false };
+
 };
 
 #endif
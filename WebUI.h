@@ -0,0 +1,537 @@
+//
+// WebUI.h - The web UI as served from data/index.html.gz, for when
+//           SPIFFS doesn't have it.  Generated by tools/build_ui.py
+//           from ui/, don't edit.
+//
+
+#ifndef WebUI_h
+#define WebUI_h
+
+#define WEBUI_ETAG  "\"509b9857\""
+
+static const uint8_t WEBUI_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x3d, 0x6b, 0x73, 0xdb, 0x46,
+  0x92, 0xdf, 0xf5, 0x2b, 0x26, 0xf4, 0x66, 0x29, 0x55, 0x04, 0x10, 0x6f, 0x3e, 0xf4, 0xb8, 0x95,
+  0x65, 0x67, 0xe3, 0x2b, 0x2b, 0xf1, 0xc6, 0xce, 0xa6, 0xae, 0x52, 0x2e, 0x17, 0x08, 0x80, 0x24,
+  0x4e, 0x20, 0xc0, 0x03, 0x40, 0x52, 0xb2, 0x4e, 0xff, 0xfd, 0xba, 0x7b, 0x66, 0xf0, 0x22, 0xf8,
+  0x90, 0xac, 0xa4, 0xce, 0x8e, 0x41, 0x60, 0xa6, 0xa7, 0xdf, 0xdd, 0xd3, 0x33, 0x18, 0x32, 0xe7,
+  0xb3, 0x7c, 0x1e, 0x5d, 0x1e, 0x9d, 0xcf, 0x02, 0xd7, 0x87, 0x8f, 0x3c, 0xcc, 0xa3, 0xe0, 0xf2,
+  0x53, 0x30, 0x5f, 0x04, 0xa9, 0x9b, 0x2f, 0xd3, 0x80, 0x7d, 0x0c, 0xe2, 0x2c, 0x49, 0xcf, 0x7b,
+  0xbc, 0xe7, 0xe8, 0x3c, 0xcb, 0xef, 0xe1, 0x73, 0x9c, 0xf8, 0xf7, 0x0f, 0x63, 0xd7, 0xbb, 0x9d,
+  0xa6, 0xc9, 0x32, 0xf6, 0x15, 0x2f, 0x89, 0x92, 0x74, 0xf4, 0x6a, 0x62, 0x4f, 0xfa, 0x13, 0xf7,
+  0x6c, 0x92, 0xc4, 0xb9, 0x32, 0x71, 0xe7, 0x61, 0x74, 0x3f, 0xea, 0x7c, 0x4c, 0x96, 0xa9, 0x07,
+  0x78, 0xdc, 0x38, 0x63, 0x1f, 0xd2, 0xa4, 0x73, 0x9a, 0xc1, 0x9d, 0x92, 0x05, 0x69, 0x38, 0x39,
+  0x13, 0xc3, 0x2c, 0x07, 0xff, 0xf2, 0x61, 0x59, 0xf8, 0x35, 0x18, 0xe9, 0xaa, 0x11, 0xcc, 0x1f,
+  0x55, 0x0f, 0x1a, 0x02, 0x68, 0x23, 0xda, 0x0f, 0xe3, 0x24, 0xf5, 0x83, 0x54, 0x19, 0x27, 0x79,
+  0x9e, 0xcc, 0x47, 0xfa, 0xe2, 0x8e, 0x65, 0x49, 0x14, 0xfa, 0xec, 0x95, 0x37, 0xf1, 0xc7, 0x81,
+  0x71, 0x16, 0x85, 0x71, 0xa0, 0xcc, 0x82, 0x70, 0x3a, 0xcb, 0x01, 0x81, 0x5e, 0x43, 0x67, 0x57,
+  0xd1, 0xad, 0x53, 0x77, 0x01, 0xf2, 0x3d, 0xcc, 0xdd, 0x74, 0x1a, 0xc6, 0x12, 0x61, 0xdf, 0x5e,
+  0xdc, 0x3d, 0xce, 0x4c, 0x96, 0xcd, 0xdd, 0x28, 0x7a, 0xa0, 0xc1, 0x6b, 0x8e, 0x2c, 0x4e, 0x52,
+  0x68, 0x93, 0xcc, 0x0e, 0x03, 0xfc, 0x5b, 0xc1, 0xae, 0xa9, 0x7d, 0x42, 0x1f, 0xb9, 0xf7, 0xc9,
+  0x12, 0xe4, 0x0e, 0xef, 0x02, 0x5f, 0xe2, 0xce, 0x93, 0xc5, 0x48, 0x3b, 0x13, 0x0f, 0x51, 0x30,
+  0xc9, 0x47, 0xda, 0xa3, 0x2a, 0xe9, 0x2f, 0x92, 0x2c, 0xcc, 0xc3, 0x24, 0x1e, 0xa5, 0x41, 0xe4,
+  0xe6, 0xe1, 0x2a, 0x38, 0xab, 0x73, 0x64, 0x6b, 0xc0, 0x91, 0x9a, 0xbb, 0x63, 0xc1, 0xf8, 0x83,
+  0x1f, 0x66, 0x0b, 0xa0, 0x02, 0x0c, 0xc5, 0xc1, 0x99, 0x1b, 0x87, 0x73, 0x97, 0x86, 0x4f, 0x5c,
+  0x3f, 0x78, 0x3b, 0x99, 0x04, 0x5e, 0xce, 0xf4, 0x0c, 0xd0, 0xbb, 0x79, 0x00, 0x0c, 0xa7, 0xb7,
+  0x0f, 0x93, 0x30, 0x8a, 0x46, 0xaf, 0x7c, 0x0d, 0xff, 0x5a, 0xee, 0x59, 0x41, 0x8f, 0x58, 0x3c,
+  0x13, 0x54, 0x14, 0x5d, 0x03, 0x3a, 0x67, 0x29, 0x89, 0x2a, 0x1e, 0xbe, 0x2a, 0x61, 0xec, 0x07,
+  0x77, 0x23, 0xc5, 0xd6, 0xb4, 0x0a, 0x42, 0x96, 0xad, 0xa6, 0x0f, 0xa5, 0xe0, 0x36, 0xc1, 0x0a,
+  0x8d, 0xf3, 0x87, 0x75, 0xe8, 0xe7, 0x33, 0x7e, 0xff, 0xf8, 0x8f, 0xdb, 0xe0, 0x7e, 0x92, 0xba,
+  0xf3, 0x20, 0x63, 0x25, 0x87, 0x0f, 0x93, 0x34, 0x99, 0x3f, 0x24, 0x0b, 0xd7, 0x0b, 0xf3, 0x7b,
+  0x50, 0x46, 0x9e, 0x14, 0x0f, 0xfa, 0xe3, 0xa3, 0x1a, 0x82, 0xa8, 0x85, 0x98, 0x61, 0x4c, 0x26,
+  0x1d, 0x47, 0x89, 0x77, 0x2b, 0x30, 0xeb, 0xc1, 0x5c, 0x12, 0xc4, 0xdb, 0x2c, 0x4f, 0x93, 0xdb,
+  0x40, 0xe1, 0x7d, 0x9a, 0x78, 0x1c, 0x79, 0xcb, 0x34, 0x05, 0x75, 0x5d, 0xa3, 0xbd, 0xce, 0x48,
+  0x07, 0xd5, 0x16, 0x4e, 0x04, 0x3c, 0x36, 0x8e, 0x81, 0x1f, 0x50, 0xc7, 0x83, 0x40, 0xad, 0x1a,
+  0x68, 0xc6, 0xd8, 0x5d, 0xb5, 0x38, 0xb6, 0xe9, 0x9a, 0x13, 0x5b, 0x3f, 0x4b, 0x56, 0x41, 0x3a,
+  0x89, 0x92, 0xb5, 0x72, 0x37, 0x9a, 0x85, 0xbe, 0x1f, 0xc4, 0x65, 0xcb, 0xfd, 0x28, 0xf3, 0xd2,
+  0x24, 0x8a, 0x0a, 0xf6, 0x34, 0xed, 0xfb, 0xb3, 0x85, 0xeb, 0xfb, 0x61, 0x3c, 0x95, 0x06, 0x35,
+  0x50, 0x45, 0xb2, 0x0d, 0x5d, 0x43, 0x47, 0x3d, 0x01, 0x45, 0xb6, 0x8c, 0x5a, 0xbc, 0x41, 0x42,
+  0x72, 0xbf, 0x69, 0x38, 0x87, 0x06, 0xfe, 0x9e, 0x81, 0x21, 0x30, 0x1c, 0xb9, 0x43, 0xd4, 0x5c,
+  0x4e, 0xea, 0x90, 0x94, 0x27, 0x48, 0xb0, 0x28, 0x94, 0x41, 0x44, 0x28, 0xcd, 0x22, 0x84, 0xf2,
+  0x14, 0x62, 0x72, 0xe1, 0xa2, 0x8e, 0x1a, 0x64, 0x8c, 0xd2, 0xaa, 0x03, 0x1b, 0xb9, 0xdf, 0xe0,
+  0xb2, 0x46, 0xe9, 0x2c, 0x0f, 0xee, 0x72, 0xc5, 0x8d, 0xc2, 0x69, 0x3c, 0xf2, 0x00, 0x5b, 0x90,
+  0x96, 0xb4, 0x99, 0xfb, 0x20, 0xb4, 0x19, 0x98, 0xf8, 0x57, 0xca, 0x47, 0x34, 0x98, 0xc6, 0x87,
+  0xfa, 0x81, 0x97, 0xa4, 0xdc, 0xad, 0x49, 0xa8, 0x4a, 0x10, 0xdb, 0x42, 0x57, 0xdc, 0x49, 0xca,
+  0x0e, 0x0b, 0x59, 0x14, 0x98, 0x3d, 0x0d, 0xff, 0x16, 0x6e, 0x08, 0x1d, 0x64, 0xff, 0xf5, 0x2c,
+  0xcc, 0x83, 0xa6, 0x35, 0x0a, 0x7c, 0xae, 0x87, 0x82, 0x48, 0xbc, 0x14, 0x33, 0xa6, 0x37, 0xf6,
+  0x27, 0x7d, 0xea, 0x76, 0x45, 0xbf, 0x64, 0x5e, 0x74, 0x65, 0xc2, 0x79, 0xaa, 0xe6, 0xb4, 0x2b,
+  0xe6, 0x25, 0x0d, 0x23, 0xcf, 0xb5, 0xe8, 0xd7, 0x35, 0xb3, 0x55, 0x89, 0x55, 0xa7, 0xa9, 0x9b,
+  0xee, 0x95, 0x1b, 0x05, 0x69, 0x2e, 0x89, 0x0f, 0x5c, 0xc7, 0x37, 0xc7, 0x67, 0x2d, 0x99, 0xd7,
+  0x9b, 0x0c, 0x40, 0xa5, 0xc2, 0xbc, 0xb2, 0xd1, 0x0d, 0xc6, 0x9e, 0x27, 0x1a, 0xab, 0x19, 0x53,
+  0xa3, 0x3f, 0x46, 0xa1, 0x12, 0x72, 0x44, 0x66, 0x6a, 0x25, 0xb7, 0x32, 0xcb, 0x92, 0x0a, 0x0f,
+  0x4d, 0xe7, 0xd5, 0x8c, 0xab, 0x41, 0x2c, 0x8d, 0x97, 0x80, 0x24, 0x56, 0xbd, 0x28, 0xc9, 0x82,
+  0x16, 0xff, 0x46, 0x95, 0x29, 0x46, 0x99, 0x7b, 0x0c, 0xbd, 0x30, 0x64, 0x18, 0xcf, 0x00, 0x63,
+  0x7e, 0x06, 0x29, 0x78, 0x7c, 0x1b, 0x82, 0x47, 0x41, 0xc2, 0x74, 0xc1, 0x49, 0x3d, 0xe1, 0xeb,
+  0x92, 0x6f, 0xed, 0x0c, 0x42, 0x1b, 0xe6, 0xa7, 0xd1, 0x22, 0x09, 0xd1, 0xdb, 0x2a, 0x9a, 0x19,
+  0x69, 0xe0, 0x53, 0x42, 0x74, 0xed, 0x0c, 0x62, 0xd4, 0xcd, 0x47, 0x44, 0xa8, 0xc2, 0x26, 0x51,
+  0xac, 0xa6, 0xfa, 0xbe, 0xa6, 0xd5, 0xe7, 0x11, 0xee, 0x95, 0xd9, 0xcc, 0xf5, 0x93, 0x35, 0x60,
+  0x44, 0x1d, 0x6a, 0xec, 0xd5, 0x64, 0x32, 0x41, 0xc7, 0x02, 0x82, 0x23, 0x37, 0x5a, 0xcc, 0xdc,
+  0x63, 0x91, 0xc3, 0x2e, 0x0c, 0xed, 0xe4, 0x4c, 0xe6, 0x33, 0xd5, 0x78, 0x7c, 0x35, 0x49, 0x92,
+  0xbc, 0x9a, 0xe9, 0x6b, 0x99, 0x17, 0x75, 0xcb, 0x63, 0x7b, 0xc3, 0x6f, 0x74, 0x53, 0x32, 0x26,
+  0xa7, 0x18, 0xc8, 0x76, 0x5c, 0x35, 0xae, 0x2b, 0x26, 0x58, 0x1e, 0xfa, 0x61, 0x0e, 0xd1, 0xe6,
+  0x55, 0xe5, 0x4e, 0xa7, 0x63, 0xf7, 0xd8, 0xb0, 0xed, 0x53, 0xf9, 0x0f, 0x46, 0x0f, 0x4f, 0x64,
+  0x02, 0x45, 0x0f, 0x13, 0xc2, 0x59, 0xcd, 0x74, 0x84, 0xde, 0x2a, 0x3c, 0x88, 0xb2, 0x53, 0x73,
+  0x8a, 0x95, 0xf2, 0x30, 0x75, 0xb1, 0x8c, 0x22, 0x85, 0xb4, 0x29, 0x67, 0x3a, 0x6e, 0x43, 0xdd,
+  0x30, 0x71, 0xce, 0xaa, 0x4e, 0x85, 0xac, 0x98, 0xef, 0xb6, 0xb4, 0x33, 0x15, 0x88, 0x41, 0xa4,
+  0x8d, 0xdd, 0x54, 0xd9, 0x98, 0x1a, 0xb9, 0xc2, 0x78, 0x4e, 0xab, 0x48, 0x20, 0x27, 0x28, 0xdd,
+  0xd0, 0xb7, 0x60, 0xbd, 0x74, 0xb3, 0xd0, 0x0f, 0x9a, 0x88, 0x8a, 0x71, 0x38, 0xaf, 0xb5, 0x8f,
+  0x53, 0xf9, 0x40, 0xe9, 0x00, 0x18, 0x12, 0x20, 0x5e, 0x25, 0x40, 0x77, 0x0f, 0x14, 0x1f, 0x40,
+  0x27, 0xde, 0x26, 0x87, 0x34, 0xff, 0x63, 0x55, 0x8d, 0x15, 0x07, 0xfd, 0x2e, 0x9c, 0x2f, 0x92,
+  0x34, 0x77, 0xe3, 0xfc, 0x51, 0x4d, 0xa1, 0x2e, 0x03, 0xf3, 0x34, 0xd3, 0x5d, 0xd5, 0x67, 0xc7,
+  0x49, 0xe4, 0x6f, 0xe6, 0x5d, 0x99, 0x11, 0x0d, 0xc7, 0xf2, 0x7d, 0xf7, 0x51, 0xf5, 0x03, 0x98,
+  0x9f, 0xc2, 0x05, 0xe5, 0xac, 0x4d, 0xe0, 0x4a, 0xe4, 0x3a, 0x68, 0xc0, 0x34, 0x59, 0xd7, 0x0d,
+  0xab, 0x6c, 0xa4, 0x32, 0x6a, 0xc1, 0xa2, 0x2a, 0x32, 0xc5, 0x0c, 0x6a, 0x38, 0xdf, 0x9f, 0x6d,
+  0x9f, 0xc5, 0x84, 0x83, 0xb4, 0xe7, 0x48, 0x2e, 0x3d, 0x3e, 0x3f, 0xaa, 0x13, 0x28, 0xb7, 0x14,
+  0xf4, 0xe5, 0xc5, 0xc3, 0x66, 0x32, 0xaa, 0x76, 0xb3, 0xc8, 0x1d, 0x07, 0x51, 0x7b, 0xb9, 0xb0,
+  0xc9, 0x87, 0xe0, 0x91, 0xca, 0x94, 0x8a, 0x02, 0x9a, 0x29, 0x41, 0x53, 0x87, 0x58, 0xcc, 0x55,
+  0xa8, 0x84, 0xf1, 0x62, 0x99, 0x9f, 0x66, 0x41, 0x84, 0xe5, 0xcb, 0x36, 0xbc, 0x96, 0xfd, 0x7d,
+  0xa3, 0x00, 0xb5, 0x4c, 0x19, 0x67, 0xa6, 0x5d, 0x0b, 0x66, 0xdd, 0x2a, 0x55, 0x30, 0x02, 0x6d,
+  0x33, 0xdd, 0x28, 0xe2, 0xae, 0x16, 0x73, 0x45, 0xea, 0x56, 0x52, 0x70, 0x82, 0x65, 0x46, 0x33,
+  0x56, 0x95, 0x33, 0x75, 0x9c, 0xc7, 0x0f, 0x55, 0x9b, 0x18, 0x1a, 0x81, 0x60, 0x73, 0x7d, 0xa4,
+  0xd5, 0x4c, 0x27, 0x50, 0xea, 0xb4, 0xcc, 0x22, 0xa6, 0xd9, 0x77, 0xc7, 0x7d, 0xe1, 0x3a, 0xb5,
+  0x49, 0x73, 0x34, 0x00, 0xc6, 0x0c, 0x64, 0xb4, 0x99, 0x70, 0x9b, 0x7c, 0x57, 0x6a, 0x09, 0xe2,
+  0x44, 0xf1, 0xdd, 0x78, 0x0a, 0xa1, 0xb0, 0x49, 0x6d, 0x68, 0xe0, 0x2c, 0x24, 0x66, 0x89, 0x11,
+  0x98, 0xd1, 0x1d, 0x47, 0x50, 0x3a, 0x6f, 0x02, 0x0e, 0x5c, 0x4f, 0x92, 0x8d, 0x13, 0x34, 0x1c,
+  0x14, 0x5c, 0x81, 0xff, 0x78, 0xde, 0xe3, 0x8b, 0x91, 0xa3, 0x73, 0xd0, 0xfc, 0x2d, 0x03, 0x8b,
+  0x5c, 0x74, 0x70, 0x0e, 0xef, 0xb0, 0x59, 0x1a, 0x4c, 0x2e, 0x3a, 0xbe, 0x9b, 0xbb, 0x23, 0x28,
+  0x92, 0xa7, 0x41, 0xef, 0x4e, 0xc1, 0x0e, 0x90, 0x38, 0x0b, 0x1c, 0xeb, 0xf4, 0xea, 0xea, 0xea,
+  0xf5, 0xd5, 0xd5, 0xdb, 0xab, 0xb7, 0x70, 0xc5, 0xcf, 0x77, 0x57, 0xaf, 0x13, 0xbc, 0xfd, 0x71,
+  0x0a, 0x97, 0x6b, 0xbc, 0x5c, 0xfd, 0x0b, 0x2f, 0xef, 0xae, 0x64, 0xbf, 0xfc, 0xf3, 0xaf, 0xab,
+  0xe7, 0xfd, 0xf9, 0x0d, 0x49, 0xce, 0xf0, 0xee, 0x7e, 0x0d, 0x97, 0x9b, 0xac, 0x78, 0x7e, 0xfd,
+  0x5c, 0x94, 0x62, 0xfc, 0x1d, 0x8e, 0x7f, 0xf7, 0x16, 0x19, 0x7f, 0x5d, 0x3c, 0xff, 0xf3, 0xed,
+  0x73, 0x91, 0x72, 0xfe, 0x08, 0xdf, 0x9b, 0x1e, 0x3e, 0xf7, 0xca, 0xe7, 0xf7, 0xcf, 0x46, 0xfa,
+  0xcb, 0x0d, 0xf2, 0x6b, 0x15, 0xf8, 0x3e, 0x0c, 0x8a, 0x67, 0x6b, 0xfd, 0x5c, 0xa4, 0xd7, 0xff,
+  0xc4, 0xeb, 0x0a, 0xcd, 0xf5, 0x9f, 0x88, 0xe4, 0xda, 0x2b, 0x9e, 0xdf, 0xfd, 0xd7, 0xb3, 0x59,
+  0x25, 0x7b, 0x10, 0x7f, 0xd7, 0xf4, 0x4c, 0xde, 0x40, 0xcf, 0x57, 0x3f, 0x5e, 0x7d, 0xd3, 0x1f,
+  0xae, 0xcf, 0x69, 0xe1, 0x58, 0xfc, 0xf9, 0x5b, 0xff, 0x70, 0xfb, 0x5c, 0x15, 0xfc, 0xf6, 0xd6,
+  0x2f, 0x80, 0xb4, 0x5d, 0xfe, 0xab, 0x97, 0x90, 0x9f, 0x2c, 0xf3, 0xcf, 0x17, 0x96, 0x7f, 0xc7,
+  0xf3, 0xf3, 0xe5, 0xdf, 0xf1, 0xfc, 0x0d, 0xf2, 0x6f, 0x7f, 0xfe, 0x7f, 0x24, 0xff, 0xcd, 0x2d,
+  0x46, 0x02, 0x79, 0xd5, 0xc7, 0xe2, 0xf9, 0x9b, 0xff, 0x90, 0x12, 0xef, 0xff, 0x55, 0xe0, 0xdb,
+  0xab, 0xd4, 0x5e, 0x0c, 0x20, 0x1f, 0xd6, 0xa0, 0xa7, 0x37, 0xd6, 0x4f, 0x20, 0xd7, 0x0f, 0x11,
+  0x3e, 0x4f, 0x27, 0xf0, 0x3c, 0xf8, 0x00, 0xcf, 0xbd, 0x37, 0x45, 0x3f, 0x7f, 0x1e, 0xe3, 0xb3,
+  0x81, 0xcf, 0xc3, 0x55, 0xdb, 0x33, 0xe2, 0xbb, 0xba, 0xb8, 0xe8, 0x5c, 0x9e, 0xf7, 0xc4, 0x86,
+  0x17, 0x6e, 0x64, 0x31, 0x2f, 0x72, 0xb3, 0xec, 0xa2, 0x53, 0x2d, 0xeb, 0x3a, 0xb8, 0xd5, 0xb5,
+  0x9a, 0x32, 0x37, 0x0d, 0x5d, 0x85, 0xaf, 0xf5, 0x2f, 0x3a, 0x79, 0xba, 0x0c, 0x3a, 0x8c, 0x26,
+  0x9d, 0x8b, 0x4e, 0x51, 0x09, 0x30, 0x77, 0x0c, 0x33, 0xdf, 0x12, 0xe6, 0x4a, 0xc6, 0x6b, 0x01,
+  0x58, 0x77, 0x30, 0x31, 0xf5, 0xe3, 0xad, 0xdc, 0x22, 0x18, 0x31, 0xb1, 0x67, 0xd0, 0x61, 0xd0,
+  0x92, 0xc1, 0xd0, 0x8b, 0x8e, 0xae, 0xea, 0x1d, 0x76, 0x37, 0x8f, 0x62, 0x20, 0x3f, 0xcb, 0xf3,
+  0xc5, 0xa8, 0xd7, 0x5b, 0xaf, 0xd7, 0xea, 0xda, 0x54, 0x93, 0x74, 0xda, 0xc3, 0xf9, 0xb1, 0x07,
+  0x5c, 0x08, 0x90, 0xd1, 0x1d, 0xce, 0x73, 0x6d, 0x80, 0xfa, 0x70, 0x38, 0xec, 0x51, 0x2f, 0xf2,
+  0xed, 0x07, 0x93, 0x0c, 0xd9, 0xbf, 0x9f, 0x43, 0x69, 0xc8, 0x42, 0x9f, 0xcf, 0x8a, 0xca, 0x2c,
+  0x99, 0x03, 0xf7, 0xab, 0x30, 0x58, 0xbf, 0x4e, 0xee, 0x2e, 0x3a, 0xb0, 0x3c, 0x62, 0xa6, 0x01,
+  0xff, 0x75, 0x8a, 0x7d, 0x3f, 0x84, 0x28, 0x77, 0xfa, 0x16, 0x6e, 0x3e, 0x63, 0x30, 0xf8, 0x06,
+  0xa0, 0xf4, 0x81, 0x6a, 0xd9, 0x7a, 0xa4, 0xe8, 0x8e, 0xa2, 0x1b, 0xaa, 0x65, 0xc0, 0x0d, 0xa3,
+  0x9b, 0x95, 0x62, 0xab, 0x9a, 0x63, 0x45, 0xb2, 0x83, 0xc9, 0x8e, 0xaf, 0x37, 0xc6, 0x00, 0x86,
+  0xad, 0x74, 0x63, 0xa6, 0x0c, 0x56, 0xca, 0x00, 0xaf, 0x74, 0x01, 0xb8, 0x48, 0x37, 0x94, 0xe1,
+  0x57, 0xb4, 0x02, 0xd2, 0x00, 0x52, 0x3d, 0xce, 0x6b, 0x0b, 0xd3, 0xe5, 0x36, 0x4d, 0x83, 0x75,
+  0x4b, 0xab, 0xb1, 0x5e, 0xc2, 0xb5, 0x08, 0x60, 0xc0, 0xc2, 0x6d, 0xe0, 0x99, 0xaa, 0xa9, 0x0d,
+  0x60, 0xa4, 0x43, 0x9f, 0xba, 0x6a, 0x5a, 0x0e, 0x03, 0xb1, 0x06, 0x3a, 0x33, 0x55, 0x5b, 0x1f,
+  0x46, 0x8a, 0xa1, 0x0e, 0x8c, 0x3e, 0xa3, 0xab, 0xa7, 0x40, 0x01, 0x67, 0x0d, 0xc5, 0xd5, 0xa4,
+  0xab, 0x81, 0x23, 0x40, 0x5c, 0xc7, 0xb6, 0xf8, 0x7d, 0xa6, 0x58, 0xaa, 0xa1, 0x39, 0x4c, 0x53,
+  0x07, 0xc3, 0x3e, 0xef, 0x60, 0xd4, 0x21, 0x50, 0xf1, 0xab, 0x67, 0xa8, 0x7a, 0xdf, 0x54, 0xe8,
+  0xca, 0x6c, 0xba, 0x27, 0x7a, 0x9c, 0x36, 0xbf, 0xff, 0x7a, 0x63, 0xab, 0x03, 0x1b, 0x98, 0xa2,
+  0x0f, 0xe0, 0xb4, 0xdf, 0xef, 0x2b, 0x74, 0x05, 0xa8, 0x81, 0x22, 0x3a, 0x2d, 0x55, 0x07, 0xcd,
+  0xd3, 0x43, 0xa6, 0x6b, 0xaa, 0xe9, 0xd8, 0x40, 0x4e, 0x1b, 0x68, 0xa2, 0x87, 0x51, 0x0f, 0xa7,
+  0x3d, 0x20, 0x31, 0x06, 0x1e, 0x20, 0xd1, 0x0c, 0x43, 0x5c, 0xfb, 0xaa, 0x66, 0x69, 0xc0, 0xb3,
+  0x33, 0x00, 0x63, 0x81, 0xfc, 0xba, 0xc5, 0x1f, 0x32, 0x65, 0xa0, 0x1a, 0x43, 0x30, 0x9d, 0xea,
+  0x38, 0x96, 0xe8, 0x61, 0xd4, 0x23, 0x90, 0xf1, 0xeb, 0xd7, 0x1b, 0x13, 0x25, 0x1d, 0x32, 0x94,
+  0x5a, 0x47, 0x75, 0x9a, 0x16, 0x8c, 0xb1, 0x74, 0xd4, 0xa8, 0x31, 0x04, 0x2d, 0x5a, 0x06, 0x4a,
+  0x85, 0x20, 0xce, 0x4a, 0x6b, 0x30, 0x62, 0xa9, 0xb6, 0x69, 0x8a, 0x2b, 0x30, 0x6f, 0x3b, 0xc8,
+  0x8e, 0x01, 0x1a, 0x76, 0xd4, 0x61, 0x5f, 0xe7, 0x0f, 0x19, 0xf9, 0x90, 0x89, 0x63, 0xac, 0xa1,
+  0x23, 0xba, 0x18, 0x75, 0xd5, 0x38, 0x01, 0x95, 0xda, 0x30, 0x86, 0xae, 0x20, 0xb5, 0xed, 0xd8,
+  0x88, 0x78, 0x20, 0x88, 0x2b, 0x0e, 0xb2, 0x62, 0x9b, 0x68, 0x3c, 0x07, 0x87, 0x83, 0xb7, 0x19,
+  0xc8, 0x32, 0xd3, 0x89, 0x7f, 0xfe, 0x90, 0xf5, 0xc1, 0xa8, 0x68, 0xbb, 0xbe, 0x25, 0x3b, 0x18,
+  0x75, 0x7c, 0xbd, 0xd1, 0x81, 0x81, 0x81, 0xa7, 0xc1, 0x78, 0x5d, 0xb3, 0xc9, 0xba, 0xb6, 0x62,
+  0x30, 0x40, 0x92, 0x19, 0xfc, 0x89, 0xc1, 0x93, 0x07, 0x6a, 0xc7, 0x7e, 0x45, 0xb4, 0x20, 0x44,
+  0xa6, 0x18, 0x8a, 0x00, 0x57, 0x8c, 0x43, 0xfd, 0x7b, 0xba, 0x3b, 0x26, 0x01, 0xa0, 0xcd, 0xa3,
+  0x87, 0xaa, 0x0e, 0x8e, 0xab, 0x0f, 0x55, 0xad, 0xaf, 0xa1, 0xb3, 0x3a, 0x7d, 0x94, 0x6b, 0xa8,
+  0x0d, 0x80, 0x01, 0xc7, 0x01, 0x1d, 0xa8, 0x8e, 0x89, 0xde, 0x08, 0xeb, 0x7f, 0xb0, 0xae, 0x69,
+  0x80, 0x5f, 0x98, 0xe0, 0x24, 0x36, 0xb8, 0x8f, 0x65, 0x81, 0x7b, 0x23, 0x9b, 0x10, 0x0c, 0xaa,
+  0x0d, 0x6e, 0xaa, 0xab, 0x43, 0xcb, 0x44, 0xc9, 0x0c, 0x74, 0x75, 0xcd, 0x1e, 0x14, 0xf7, 0x26,
+  0xe8, 0x4f, 0x03, 0x5c, 0xda, 0x00, 0x44, 0x02, 0x4d, 0x19, 0xe2, 0xde, 0x01, 0x9d, 0xda, 0x33,
+  0xf8, 0x30, 0x06, 0x43, 0x4f, 0x53, 0x35, 0x8a, 0x27, 0xcd, 0xb2, 0x00, 0xad, 0x61, 0x83, 0x22,
+  0x40, 0x31, 0x26, 0x92, 0xd0, 0x31, 0xb6, 0x80, 0x43, 0xce, 0x20, 0xe3, 0x0c, 0x02, 0x07, 0xd4,
+  0x8e, 0x41, 0x03, 0xac, 0x99, 0xa4, 0x77, 0x5d, 0xe7, 0x0c, 0x5a, 0x8c, 0x33, 0x08, 0xcb, 0x30,
+  0xd2, 0xbd, 0xad, 0xdb, 0xe8, 0x97, 0x60, 0x5b, 0x5d, 0x35, 0x1c, 0xf4, 0x0c, 0x03, 0xac, 0x06,
+  0x57, 0xf2, 0x3d, 0xa7, 0xef, 0x10, 0x52, 0xe4, 0xde, 0xe9, 0x1b, 0xe0, 0x88, 0x8e, 0x81, 0xa1,
+  0x66, 0x80, 0x4d, 0x01, 0x35, 0x04, 0x35, 0x09, 0x5d, 0xe0, 0x44, 0xd3, 0xa0, 0xcc, 0xe8, 0xeb,
+  0x43, 0x93, 0x6c, 0x67, 0x20, 0x87, 0xc4, 0x39, 0xdd, 0x9a, 0x36, 0x65, 0x08, 0xcd, 0xc1, 0x44,
+  0xd0, 0x37, 0x6c, 0xbc, 0x1f, 0x58, 0x78, 0x1d, 0x1a, 0x33, 0x2e, 0xaf, 0x82, 0x02, 0xa3, 0x77,
+  0x69, 0xc0, 0x03, 0x0a, 0x8c, 0x9a, 0xc7, 0x30, 0x24, 0x81, 0x51, 0x83, 0xe6, 0x80, 0xf3, 0xa6,
+  0x70, 0xde, 0x6c, 0xd5, 0x1c, 0xa2, 0x36, 0x07, 0x43, 0x0b, 0xb9, 0x32, 0x50, 0x97, 0x86, 0xe4,
+  0xad, 0x6a, 0x90, 0xa1, 0x42, 0x02, 0x93, 0xb6, 0x06, 0x0a, 0x0a, 0x8c, 0x28, 0x0c, 0x93, 0xfc,
+  0xd7, 0x70, 0xc0, 0x33, 0x41, 0x5c, 0x88, 0x8d, 0xfe, 0x10, 0x03, 0xdb, 0xee, 0x0f, 0xc8, 0x38,
+  0x96, 0x30, 0xbd, 0x2e, 0xee, 0xe9, 0x9a, 0x55, 0x5a, 0x58, 0xa5, 0xdd, 0x13, 0xe3, 0x78, 0x1b,
+  0x29, 0x4f, 0x67, 0x15, 0xa8, 0x4c, 0xa9, 0x34, 0x55, 0x87, 0x1f, 0xe6, 0xce, 0xf3, 0x00, 0xd6,
+  0x84, 0xbb, 0x1d, 0x9a, 0x40, 0x5a, 0x5c, 0x1a, 0x65, 0xf3, 0x20, 0x80, 0xcd, 0x3e, 0x8c, 0x81,
+  0x07, 0x88, 0x5b, 0xc7, 0xa4, 0xe9, 0xc4, 0xe1, 0x26, 0x01, 0xbd, 0x61, 0xce, 0x01, 0xaf, 0x07,
+  0xcd, 0x40, 0xf8, 0x43, 0xd2, 0x02, 0xdf, 0xb0, 0x66, 0x0a, 0x64, 0x4d, 0x6b, 0x38, 0xc4, 0x14,
+  0x33, 0x44, 0x4d, 0xf5, 0xc1, 0x75, 0xb1, 0x0f, 0x72, 0xca, 0xb0, 0x6f, 0xf3, 0x5b, 0x48, 0x68,
+  0x9a, 0xc2, 0x91, 0x13, 0x5e, 0x9a, 0xbf, 0x30, 0xc3, 0xc0, 0x34, 0x85, 0x13, 0x98, 0xc6, 0x8c,
+  0x3e, 0x7e, 0x78, 0x34, 0xb9, 0xd1, 0x44, 0x06, 0xe9, 0x17, 0x72, 0x08, 0x64, 0x75, 0x18, 0xc3,
+  0xef, 0x87, 0x08, 0x31, 0xc3, 0x14, 0xa4, 0x9b, 0x2b, 0xc5, 0x98, 0x19, 0x90, 0xf1, 0xc9, 0x72,
+  0x60, 0x4c, 0x4c, 0x36, 0x9a, 0x43, 0xc1, 0x87, 0x49, 0xaa, 0x6f, 0xa3, 0x15, 0x31, 0xe1, 0xcd,
+  0x90, 0x69, 0xa3, 0xcf, 0xe1, 0x35, 0x8d, 0xdc, 0xc7, 0x20, 0x37, 0x34, 0x1d, 0x0a, 0x56, 0x70,
+  0x19, 0x48, 0x42, 0x06, 0x66, 0x8e, 0x21, 0xcd, 0x38, 0x40, 0x84, 0xe6, 0x1d, 0x4b, 0x5c, 0x4d,
+  0x31, 0x7f, 0xd8, 0x60, 0x4f, 0xe2, 0x15, 0x5b, 0xf4, 0xe1, 0x0a, 0x67, 0x14, 0x98, 0x51, 0x61,
+  0x0a, 0x46, 0x46, 0x06, 0x88, 0xd8, 0xb1, 0x91, 0x05, 0x5d, 0x33, 0x90, 0xb8, 0x81, 0x4e, 0xad,
+  0xdb, 0x36, 0x25, 0x25, 0xf8, 0xcc, 0xb0, 0xd1, 0x42, 0x97, 0xd5, 0x40, 0x18, 0x4c, 0x65, 0xd0,
+  0xb8, 0xa2, 0xb1, 0x02, 0x0b, 0xe0, 0xc3, 0x5c, 0x32, 0x18, 0xf4, 0x31, 0x9e, 0x74, 0x9c, 0x82,
+  0x1c, 0x1e, 0x7f, 0x7d, 0x8b, 0x93, 0x66, 0x44, 0x1a, 0x99, 0x37, 0x31, 0x4b, 0xc0, 0x95, 0xa8,
+  0x22, 0x52, 0x67, 0x28, 0x44, 0x60, 0x24, 0x02, 0x97, 0x76, 0x65, 0x08, 0xf9, 0x89, 0x3b, 0x07,
+  0xe3, 0xce, 0xb0, 0x50, 0x35, 0x3a, 0xa4, 0x00, 0x10, 0x69, 0x68, 0x91, 0x9a, 0x98, 0xc5, 0x95,
+  0x89, 0xe0, 0xa4, 0x5e, 0x4f, 0xa3, 0xe9, 0x04, 0xe1, 0x4d, 0xe8, 0x86, 0xb8, 0xb6, 0xb8, 0x11,
+  0x18, 0x19, 0x81, 0x48, 0xdb, 0xc5, 0xd5, 0x19, 0xd0, 0xd5, 0xe2, 0x59, 0x68, 0xc8, 0x90, 0x0d,
+  0x08, 0x56, 0x0d, 0x92, 0x0a, 0x50, 0xb2, 0xd0, 0xda, 0x33, 0x5d, 0xed, 0xeb, 0x16, 0x7f, 0x04,
+  0xcb, 0xf3, 0x5e, 0x0f, 0x8d, 0x40, 0x49, 0x6b, 0x88, 0xea, 0x00, 0x00, 0xe4, 0x12, 0x66, 0x74,
+  0x42, 0x43, 0xd2, 0x1c, 0xe6, 0xf6, 0x61, 0x3c, 0x49, 0x76, 0x7b, 0x3d, 0x42, 0xb4, 0x39, 0xbd,
+  0x05, 0x02, 0xd9, 0x30, 0xd7, 0x60, 0xfa, 0x21, 0x21, 0xfa, 0xa8, 0x1d, 0xd4, 0x39, 0x7d, 0xce,
+  0x90, 0x47, 0xea, 0xc1, 0x16, 0xde, 0xcf, 0x44, 0xff, 0x0a, 0xfa, 0x28, 0x53, 0xa3, 0x33, 0x89,
+  0x76, 0x39, 0x16, 0x82, 0xc2, 0x93, 0x38, 0xb1, 0x4d, 0x29, 0x30, 0xe3, 0x3f, 0xa8, 0xc1, 0xaa,
+  0x72, 0x55, 0xeb, 0x24, 0xc3, 0xa2, 0x1a, 0x0d, 0x9c, 0x75, 0xa5, 0x38, 0xdc, 0x2d, 0x66, 0x0e,
+  0x14, 0x6e, 0x46, 0xeb, 0x00, 0x0c, 0x4d, 0x4f, 0xc4, 0x95, 0xa6, 0xc8, 0xa0, 0xe5, 0xc1, 0x95,
+  0x55, 0x03, 0x98, 0x87, 0x9b, 0x6c, 0x51, 0xe4, 0xbd, 0xc2, 0xef, 0x75, 0x91, 0xda, 0x20, 0x38,
+  0xa0, 0x19, 0xb3, 0x9a, 0x8e, 0x91, 0x37, 0x30, 0xf0, 0x53, 0x37, 0x33, 0x71, 0xcb, 0xe8, 0x09,
+  0xae, 0x58, 0xe9, 0x18, 0x8c, 0x37, 0x88, 0x5b, 0xde, 0x71, 0x98, 0xb5, 0x6e, 0x83, 0xfb, 0xdd,
+  0xc6, 0x02, 0x80, 0xb6, 0x39, 0xd7, 0x40, 0x61, 0xa1, 0xdc, 0x30, 0x4c, 0xe4, 0x10, 0x4a, 0x50,
+  0xc8, 0x8b, 0x7d, 0xbc, 0xd1, 0x11, 0x07, 0x68, 0xd8, 0x70, 0x28, 0xb8, 0xd0, 0x0d, 0x0d, 0x8a,
+  0x0f, 0xdd, 0xc1, 0xfb, 0x81, 0x69, 0x44, 0x58, 0xd9, 0xd0, 0x13, 0x7d, 0xac, 0x1c, 0x59, 0x3e,
+  0x94, 0x05, 0x05, 0x23, 0x9d, 0x1b, 0x33, 0x6b, 0x05, 0x49, 0x83, 0x5f, 0x22, 0x8c, 0x10, 0x9c,
+  0x2d, 0xe0, 0xea, 0x61, 0x54, 0xe1, 0x3c, 0x67, 0x0e, 0x6c, 0x2a, 0x54, 0xd0, 0xcd, 0xa1, 0x1d,
+  0xe3, 0x84, 0xcf, 0x94, 0x43, 0x9c, 0xe7, 0x88, 0x39, 0x60, 0x48, 0x21, 0xe6, 0xf0, 0x46, 0xd7,
+  0x32, 0x45, 0x72, 0xca, 0xff, 0x83, 0x9c, 0x07, 0xa9, 0x72, 0xe8, 0x60, 0xd9, 0xa3, 0x69, 0x16,
+  0x95, 0x0f, 0x36, 0x1a, 0xd0, 0xa4, 0x0c, 0x01, 0xf5, 0xa9, 0x62, 0x66, 0xe2, 0x8e, 0xd1, 0x3f,
+  0xaa, 0x96, 0xf1, 0x53, 0x40, 0xf0, 0xd6, 0xc3, 0xb4, 0x8d, 0xbb, 0x70, 0xb8, 0xef, 0xb6, 0x5b,
+  0xe5, 0x12, 0xaa, 0x7d, 0x62, 0xa8, 0x3b, 0x19, 0x4e, 0x89, 0x58, 0x38, 0x32, 0x7b, 0x65, 0x81,
+  0x1e, 0x21, 0xdb, 0xf2, 0x32, 0x0f, 0xd4, 0x63, 0xa3, 0xa7, 0xd9, 0x99, 0xce, 0xe7, 0xcd, 0x21,
+  0xfa, 0x1a, 0x78, 0x3b, 0x40, 0x29, 0x04, 0x25, 0xbc, 0xce, 0x46, 0xa7, 0xb3, 0xb7, 0x79, 0xb4,
+  0xde, 0xaf, 0x52, 0x53, 0x24, 0x35, 0x40, 0xe4, 0x1c, 0x44, 0xad, 0x80, 0x12, 0xfe, 0x6e, 0x13,
+  0xab, 0xdb, 0xa8, 0x19, 0xce, 0x9f, 0x4d, 0x6d, 0xbb, 0x69, 0xb2, 0x05, 0xbd, 0xa5, 0x18, 0xee,
+  0x36, 0x8d, 0x84, 0xda, 0x61, 0x9a, 0xbe, 0x8e, 0x75, 0x22, 0xcc, 0xc3, 0x7d, 0xf0, 0x2a, 0xa8,
+  0xda, 0x81, 0x1b, 0x78, 0x18, 0x82, 0x47, 0xc2, 0x87, 0x63, 0xe0, 0xf4, 0xa0, 0x0f, 0x70, 0x42,
+  0xb6, 0x21, 0x38, 0xa0, 0xc3, 0xc4, 0x70, 0xa6, 0x0e, 0x88, 0x07, 0x00, 0x93, 0x4f, 0x3c, 0xfa,
+  0x31, 0xb2, 0x1d, 0xaa, 0xf6, 0x30, 0xa8, 0x2d, 0xca, 0x7d, 0xe8, 0xa0, 0x85, 0x13, 0x32, 0x33,
+  0xab, 0x38, 0xa2, 0x27, 0x66, 0xf6, 0xb6, 0x94, 0x62, 0x62, 0x49, 0x41, 0xdc, 0x31, 0xce, 0x9d,
+  0x42, 0xdc, 0x31, 0xce, 0x9d, 0xc2, 0xb9, 0x53, 0x88, 0x3b, 0x46, 0xdc, 0x29, 0xc4, 0x1d, 0xe3,
+  0xfc, 0x28, 0x9c, 0x3b, 0xf9, 0x54, 0xe6, 0x26, 0xe2, 0x8e, 0x92, 0x93, 0x45, 0xf9, 0x15, 0xb8,
+  0x2b, 0x43, 0x07, 0x82, 0x47, 0x11, 0x11, 0x83, 0x51, 0x02, 0xf6, 0xa9, 0x14, 0x1e, 0x45, 0x32,
+  0x3c, 0xcc, 0x42, 0xf9, 0x2c, 0x48, 0xe7, 0x09, 0x95, 0x4c, 0xca, 0xcc, 0x8d, 0x26, 0xbb, 0x2d,
+  0xd5, 0x84, 0x6e, 0xb5, 0x98, 0x3a, 0x1c, 0x80, 0xd7, 0xc1, 0x3c, 0xee, 0x38, 0x90, 0x53, 0x70,
+  0x51, 0xaa, 0x41, 0x06, 0xc1, 0xca, 0x5a, 0xd3, 0xb1, 0xa6, 0xc6, 0x0c, 0xc2, 0xef, 0x61, 0x26,
+  0x36, 0x0b, 0xed, 0x57, 0x03, 0x3f, 0xab, 0x66, 0x0a, 0x5a, 0x28, 0x99, 0xa8, 0x62, 0x75, 0x60,
+  0xe9, 0x54, 0x3b, 0x39, 0x1c, 0x81, 0x42, 0x08, 0xa8, 0x5c, 0xc6, 0xc9, 0x54, 0xb3, 0x71, 0x1a,
+  0xd2, 0x68, 0x92, 0xd5, 0xa9, 0xea, 0x11, 0xf7, 0x90, 0x0f, 0xa1, 0xb6, 0x02, 0x45, 0xd3, 0x3c,
+  0x68, 0x5b, 0x58, 0x7d, 0x58, 0x16, 0x16, 0xc0, 0x9a, 0x06, 0xa6, 0x10, 0x9f, 0xd0, 0x63, 0x63,
+  0x25, 0xa8, 0x53, 0x2f, 0xb8, 0x3f, 0xa3, 0xf6, 0x95, 0x18, 0x49, 0x99, 0xb7, 0x4f, 0xc4, 0x30,
+  0x1b, 0xea, 0xba, 0xc9, 0x09, 0xf0, 0x2c, 0xbc, 0xd2, 0xf8, 0xb2, 0x0e, 0x52, 0xa9, 0x89, 0xd3,
+  0xdf, 0x00, 0x3e, 0x0d, 0xb1, 0xc4, 0xc3, 0x41, 0x83, 0x01, 0x56, 0x6d, 0x90, 0x0c, 0x71, 0xe5,
+  0x46, 0x9f, 0x22, 0x3b, 0x2b, 0x7c, 0xc9, 0x87, 0xab, 0x3b, 0x6c, 0x5e, 0x89, 0x91, 0xd8, 0x3d,
+  0x74, 0x44, 0xd5, 0x43, 0xab, 0x89, 0x01, 0x0c, 0xc5, 0x5c, 0xec, 0xe0, 0x5c, 0xcd, 0xf3, 0x33,
+  0x94, 0x1c, 0x43, 0x9d, 0x59, 0xf8, 0x37, 0x43, 0x84, 0xf4, 0x44, 0xc9, 0x48, 0xa7, 0xa5, 0x3f,
+  0x20, 0x46, 0x82, 0xb0, 0xcc, 0x87, 0x72, 0x4c, 0xa1, 0xb1, 0xc0, 0x25, 0xc8, 0xe3, 0x40, 0x61,
+  0x0e, 0x86, 0xf0, 0x74, 0x5a, 0xec, 0x80, 0x98, 0xb4, 0x36, 0xd5, 0x4c, 0x2c, 0x99, 0xfa, 0xdc,
+  0x54, 0x70, 0x6f, 0x61, 0x41, 0x80, 0x4b, 0x16, 0xd2, 0x34, 0xac, 0xd6, 0x19, 0x78, 0x37, 0x83,
+  0xd5, 0xbc, 0xc3, 0x1f, 0xe1, 0xd3, 0x21, 0x5a, 0x7d, 0x5e, 0xdd, 0x40, 0x0b, 0xce, 0x15, 0x3a,
+  0x1f, 0x8e, 0x2b, 0x66, 0xd4, 0x90, 0xa1, 0x93, 0x09, 0xe8, 0xde, 0xd4, 0xa9, 0xb2, 0x33, 0x8a,
+  0x7b, 0x5b, 0x83, 0x42, 0x17, 0x5d, 0x66, 0xc8, 0x53, 0xa8, 0xa1, 0xd9, 0x5c, 0x2a, 0x18, 0x0d,
+  0x6b, 0x20, 0x94, 0x86, 0x3e, 0x79, 0x0f, 0xcc, 0x88, 0x8c, 0x53, 0xc3, 0xed, 0x03, 0x68, 0x5f,
+  0xc9, 0xa1, 0x68, 0x04, 0xb2, 0x0d, 0xb9, 0x09, 0xaf, 0x1a, 0x51, 0x04, 0x4e, 0x01, 0xba, 0xdb,
+  0xa3, 0xa1, 0x27, 0x76, 0xb2, 0x70, 0x0f, 0x0c, 0xf7, 0xb5, 0xc2, 0x95, 0xdc, 0xaa, 0x13, 0xef,
+  0x5c, 0xd1, 0xf5, 0xe9, 0x75, 0xab, 0x6c, 0xa7, 0x07, 0x6c, 0xc5, 0x93, 0x1b, 0xa2, 0x0d, 0x9b,
+  0xc6, 0x2e, 0xc1, 0x2e, 0x23, 0x7a, 0x59, 0x74, 0x79, 0xee, 0x8a, 0x57, 0x44, 0xaf, 0x3a, 0x0c,
+  0x67, 0x1e, 0x05, 0x26, 0x1f, 0x7c, 0x5f, 0x94, 0xcd, 0xc6, 0x89, 0x9b, 0xfa, 0x1d, 0x39, 0x14,
+  0xe8, 0xbb, 0xcb, 0x28, 0x67, 0xfc, 0x04, 0x88, 0xdc, 0x13, 0x14, 0x9d, 0x18, 0xa0, 0xac, 0xb2,
+  0xea, 0xb9, 0x3c, 0x5f, 0x66, 0x01, 0xa3, 0x5d, 0xb8, 0x91, 0xc0, 0x5e, 0xeb, 0xed, 0x41, 0xf7,
+  0x25, 0x97, 0xe5, 0x7c, 0x9c, 0xf6, 0x2e, 0x8f, 0xde, 0x48, 0x7a, 0x20, 0xa1, 0x0b, 0x3d, 0xc0,
+  0xd8, 0x0e, 0xee, 0xe2, 0x20, 0x5f, 0x27, 0xe9, 0xed, 0x56, 0x26, 0x2a, 0x3b, 0x65, 0xdb, 0x38,
+  0xa9, 0x81, 0x6c, 0xb0, 0xf3, 0x33, 0x27, 0x70, 0x10, 0x33, 0x19, 0x9d, 0x0a, 0xdc, 0xca, 0xcb,
+  0x46, 0xda, 0xda, 0xc6, 0x51, 0x0b, 0xe0, 0x06, 0x5f, 0xfc, 0x04, 0xe2, 0x41, 0x6c, 0x15, 0xb5,
+  0xc6, 0x36, 0xc6, 0x4a, 0x80, 0x2d, 0x0c, 0x55, 0x00, 0x5a, 0xec, 0xc5, 0xfb, 0x0e, 0xd4, 0x90,
+  0xb7, 0x4c, 0xc3, 0xfc, 0x7e, 0x2b, 0x2b, 0x58, 0x85, 0x6e, 0xe3, 0x82, 0xf7, 0xb5, 0x68, 0x82,
+  0xe3, 0x3c, 0x8c, 0x81, 0xfb, 0x2c, 0x0f, 0xe6, 0x3b, 0xdc, 0x65, 0xba, 0xc3, 0x4f, 0xa6, 0xad,
+  0xe4, 0x09, 0x63, 0x95, 0x78, 0x8f, 0x02, 0xaa, 0x07, 0xc1, 0x86, 0x1f, 0xfc, 0xfc, 0x03, 0xd0,
+  0xe3, 0x3e, 0x56, 0x8f, 0xd8, 0xc6, 0xe1, 0x4b, 0xe4, 0x6b, 0x66, 0x36, 0x3b, 0x69, 0xba, 0x22,
+  0x96, 0xf1, 0x10, 0xa6, 0xec, 0x2d, 0x4f, 0x49, 0xb0, 0x28, 0xf1, 0x5c, 0xee, 0xbf, 0x0a, 0x70,
+  0x86, 0x40, 0x97, 0x47, 0x9b, 0xa7, 0x55, 0x81, 0x97, 0x99, 0x29, 0xc8, 0xe3, 0x54, 0x4a, 0x47,
+  0xa8, 0x8a, 0x8d, 0x7b, 0x79, 0x5e, 0x80, 0xd1, 0x49, 0x22, 0xa4, 0xc6, 0xdf, 0x40, 0xb3, 0xfc,
+  0x7e, 0x01, 0xdd, 0xfc, 0xa1, 0x48, 0x01, 0x74, 0x78, 0x49, 0xe8, 0x15, 0x46, 0xce, 0x43, 0x4a,
+  0x33, 0x1c, 0x21, 0xbd, 0x1c, 0xa0, 0x43, 0x08, 0x17, 0x9d, 0x6b, 0x82, 0xbb, 0x3c, 0xcf, 0x16,
+  0x6e, 0xdc, 0xf2, 0xd6, 0xe0, 0xf2, 0x0e, 0xf8, 0x85, 0x2e, 0xd0, 0x1c, 0x27, 0x80, 0x93, 0x32,
+  0xe6, 0x3c, 0x4a, 0x73, 0xe1, 0xaa, 0xc2, 0xed, 0x66, 0x1a, 0x2a, 0x8f, 0x80, 0x76, 0x1a, 0x69,
+  0x50, 0x9e, 0xcc, 0x14, 0x66, 0x7e, 0x42, 0x0a, 0xaa, 0x91, 0x15, 0xe8, 0xd2, 0x64, 0xdd, 0x69,
+  0x5a, 0x2d, 0x32, 0x1b, 0x4d, 0xe2, 0x44, 0x0a, 0x13, 0x9f, 0x0a, 0xb8, 0xc4, 0xa2, 0x73, 0x19,
+  0xf7, 0xdc, 0xbf, 0xfb, 0xc1, 0xf4, 0xec, 0xc7, 0x16, 0xb4, 0x95, 0xa3, 0x27, 0x9d, 0xea, 0xd9,
+  0x62, 0x09, 0xba, 0x39, 0xe2, 0x00, 0xb2, 0xb3, 0xe5, 0x3c, 0xf4, 0x29, 0xbe, 0x80, 0xf4, 0xf7,
+  0xfb, 0xa8, 0xfe, 0x24, 0xa0, 0xbf, 0x8d, 0x64, 0xe8, 0xdf, 0x11, 0xb9, 0xbd, 0xd4, 0x02, 0x37,
+  0x67, 0xef, 0xf0, 0xa0, 0x51, 0x83, 0xde, 0x26, 0x75, 0x34, 0xb8, 0x88, 0xd4, 0x17, 0xb3, 0xf6,
+  0x46, 0xf8, 0x16, 0x14, 0x21, 0x2a, 0x7e, 0x84, 0xb9, 0x2c, 0x49, 0xef, 0xd9, 0xaf, 0x41, 0x16,
+  0xe4, 0x3c, 0xae, 0x79, 0xb4, 0x5d, 0xbe, 0x9b, 0xb0, 0xfb, 0x64, 0xc9, 0xd6, 0xc9, 0x32, 0xf2,
+  0x59, 0x14, 0xde, 0x06, 0x2c, 0x4f, 0x40, 0x76, 0x00, 0x63, 0x18, 0x8c, 0xf0, 0x99, 0x83, 0x16,
+  0x32, 0x6c, 0x85, 0xb4, 0x1d, 0xa6, 0x47, 0x72, 0x76, 0x5c, 0xb9, 0xd1, 0x32, 0xc8, 0x4e, 0x19,
+  0x72, 0x03, 0x3d, 0x4c, 0x84, 0x13, 0x84, 0x45, 0xb2, 0x56, 0x8b, 0x30, 0xad, 0xc4, 0xa4, 0x90,
+  0xa7, 0x3c, 0xc9, 0x52, 0x09, 0x42, 0x54, 0xc8, 0x38, 0x8f, 0xbf, 0x4c, 0x38, 0x9f, 0xc4, 0x66,
+  0xa1, 0x1a, 0xe8, 0x60, 0xe5, 0x91, 0x92, 0x4e, 0x3d, 0x62, 0x1b, 0xa2, 0x95, 0x71, 0x26, 0x84,
+  0x87, 0x70, 0x9b, 0xa5, 0xfc, 0x15, 0xdd, 0x45, 0x67, 0xa0, 0x7d, 0xdf, 0x61, 0x3d, 0x11, 0x80,
+  0xa8, 0x96, 0x30, 0x9d, 0xaf, 0x5d, 0xc8, 0x20, 0xbf, 0x2d, 0x20, 0xd4, 0x83, 0x9a, 0x62, 0x7e,
+  0x23, 0xb9, 0xc2, 0x8c, 0x21, 0xc3, 0x28, 0xfe, 0x92, 0x60, 0x48, 0xd6, 0x89, 0x1c, 0x87, 0xf9,
+  0x03, 0x61, 0xfc, 0x60, 0x15, 0x7a, 0x81, 0x2a, 0x11, 0xe4, 0x69, 0x12, 0x4f, 0x2f, 0x7f, 0x77,
+  0xd3, 0x18, 0x74, 0xf7, 0x1d, 0x63, 0x9f, 0x10, 0xc6, 0x83, 0x14, 0x31, 0x77, 0x41, 0xc1, 0xa0,
+  0xef, 0x54, 0x8c, 0x60, 0x61, 0x9c, 0x60, 0x60, 0x8c, 0x23, 0xb8, 0x9d, 0x30, 0x1f, 0x72, 0x13,
+  0x0b, 0xe7, 0x8b, 0x14, 0x1b, 0xa3, 0x7b, 0x54, 0x23, 0x47, 0x75, 0xd4, 0x54, 0x68, 0x4e, 0x43,
+  0xf8, 0x31, 0x1c, 0x58, 0x15, 0xd0, 0x6a, 0x20, 0xc5, 0x8b, 0x7f, 0x79, 0xcd, 0x8f, 0x3d, 0xb3,
+  0x42, 0xb8, 0x7f, 0xf3, 0xf7, 0x8e, 0x23, 0x58, 0x18, 0xd0, 0x69, 0x7f, 0xbf, 0x92, 0x80, 0x27,
+  0x5f, 0x80, 0x83, 0x2f, 0x2b, 0xcc, 0x13, 0x77, 0x2a, 0xfc, 0x15, 0x30, 0x3d, 0x8e, 0xac, 0x81,
+  0xf1, 0xb7, 0x77, 0x7b, 0x70, 0xc1, 0xa2, 0x71, 0x92, 0x65, 0x02, 0x1d, 0xfc, 0xa9, 0x61, 0xeb,
+  0x11, 0xcf, 0x70, 0x43, 0x0a, 0x85, 0xe4, 0x34, 0x4b, 0xfc, 0x8b, 0xee, 0x87, 0x5f, 0x3e, 0x7e,
+  0xea, 0x52, 0xa9, 0x95, 0xc4, 0x17, 0xdd, 0x9e, 0xd4, 0x6c, 0x97, 0x05, 0xb1, 0x47, 0x86, 0xee,
+  0xce, 0xc1, 0xdb, 0xc2, 0x85, 0x9b, 0xe6, 0x3d, 0x72, 0x1d, 0xcc, 0xc9, 0x5d, 0xc0, 0x42, 0x07,
+  0xb4, 0xb8, 0x2f, 0x74, 0x27, 0x61, 0x04, 0x23, 0x62, 0x77, 0x0e, 0xf7, 0xdc, 0x4c, 0x4d, 0x88,
+  0x6c, 0x39, 0x9e, 0x87, 0x79, 0x97, 0x7b, 0xed, 0x45, 0x97, 0xdb, 0xbb, 0x50, 0x51, 0xb7, 0xe2,
+  0x6a, 0xa8, 0x4a, 0xa2, 0x84, 0xde, 0x49, 0xe6, 0xe4, 0x8e, 0x14, 0xcc, 0x2f, 0xaf, 0x4a, 0xc3,
+  0x0b, 0x67, 0x00, 0xb3, 0xba, 0x2b, 0x37, 0x8c, 0xc8, 0x1a, 0x09, 0x1d, 0x45, 0x03, 0xa3, 0x05,
+  0xf3, 0x4d, 0xcf, 0xe6, 0x9d, 0x7c, 0x58, 0xa7, 0x7d, 0xd2, 0x21, 0xe2, 0x6f, 0x92, 0x75, 0x1c,
+  0x25, 0xae, 0x2f, 0x5d, 0x72, 0xc3, 0xa1, 0x9b, 0x69, 0x84, 0xd7, 0x64, 0x2f, 0x96, 0x46, 0xda,
+  0x4b, 0xa1, 0x6a, 0x2e, 0xe1, 0xb3, 0x2d, 0x4c, 0xba, 0x3c, 0x33, 0xb4, 0x04, 0x4d, 0x50, 0xa6,
+  0x0d, 0x4a, 0x07, 0x18, 0x3d, 0xe8, 0x1f, 0xe1, 0x14, 0x67, 0x6b, 0xec, 0x77, 0xf3, 0xdc, 0xf5,
+  0x66, 0x81, 0xcf, 0x38, 0xfb, 0xd9, 0x46, 0xc2, 0x20, 0x1f, 0xe1, 0xf2, 0x71, 0x4c, 0x3f, 0x42,
+  0x43, 0x47, 0x3a, 0x7e, 0xc5, 0x37, 0x0b, 0x47, 0xac, 0xdc, 0xdd, 0x84, 0x31, 0x24, 0x62, 0x30,
+  0x7e, 0xa5, 0xc9, 0xbd, 0xdb, 0x68, 0x02, 0xa8, 0x5f, 0x96, 0xf9, 0x06, 0x58, 0xad, 0xad, 0x1e,
+  0x08, 0x57, 0xb1, 0x1b, 0x25, 0x53, 0xa6, 0x6d, 0x78, 0x7f, 0x3d, 0xa9, 0xf1, 0x53, 0x83, 0x70,
+  0x93, 0xd0, 0xd4, 0x70, 0xf9, 0x73, 0x92, 0xb3, 0x2b, 0x5a, 0x4c, 0x9c, 0xf7, 0x44, 0x53, 0xd1,
+  0xb7, 0xd1, 0xde, 0x2b, 0x46, 0xef, 0x22, 0x52, 0x75, 0xee, 0x0e, 0x1e, 0x6c, 0xec, 0x70, 0xf7,
+  0xef, 0xcc, 0xc3, 0xf8, 0x0b, 0xf5, 0x75, 0x84, 0xaf, 0x77, 0x60, 0xd1, 0x85, 0x49, 0x6f, 0xf5,
+  0x4c, 0x7c, 0xee, 0x5d, 0x03, 0x9f, 0xa9, 0x1a, 0xdf, 0x82, 0x0f, 0xf8, 0x4b, 0x48, 0xc3, 0x3c,
+  0x13, 0xff, 0xc9, 0x38, 0x8e, 0xb6, 0x22, 0x59, 0xc6, 0x61, 0x29, 0xd3, 0x22, 0x0b, 0x11, 0xd5,
+  0x51, 0xab, 0xd5, 0xdf, 0x84, 0x53, 0x3c, 0x6f, 0x5d, 0x31, 0xfb, 0x13, 0x6d, 0x2c, 0x1c, 0xaf,
+  0xd9, 0xfc, 0xe1, 0xf7, 0x9b, 0xcd, 0xc6, 0x37, 0x3f, 0x7d, 0x32, 0x0c, 0x76, 0x8c, 0x05, 0x53,
+  0x0f, 0xea, 0x97, 0x93, 0x1d, 0x9e, 0xd1, 0xce, 0xa5, 0xfe, 0x4c, 0x2e, 0x19, 0x87, 0x0d, 0x28,
+  0xe6, 0xf8, 0x5d, 0x67, 0x1b, 0xe7, 0x32, 0x44, 0x5e, 0x5a, 0xa2, 0xa7, 0xda, 0x70, 0x1e, 0xb8,
+  0x19, 0xa4, 0x94, 0x39, 0xa6, 0x3b, 0x69, 0xca, 0x0e, 0x83, 0x3a, 0xdf, 0x0b, 0x66, 0x49, 0x44,
+  0x53, 0x63, 0x0d, 0x64, 0x9f, 0x85, 0x8d, 0x97, 0xb5, 0x70, 0xab, 0x4a, 0xff, 0x0a, 0x1d, 0xc5,
+  0xcb, 0xf9, 0x18, 0x2b, 0x25, 0xae, 0xa5, 0xc5, 0x7a, 0xfe, 0x85, 0x94, 0xd3, 0x61, 0x10, 0x39,
+  0x58, 0x2d, 0x40, 0x1d, 0x72, 0x77, 0xd1, 0xd1, 0x35, 0x6d, 0xbf, 0x4a, 0xac, 0x17, 0x76, 0xfa,
+  0xa7, 0xb8, 0x4e, 0xab, 0xfe, 0xbe, 0x39, 0x40, 0x06, 0x3b, 0x24, 0x6a, 0xa5, 0xf8, 0x27, 0x4b,
+  0xf9, 0x74, 0x89, 0x8a, 0x4a, 0xea, 0xd0, 0xb2, 0x9a, 0xcf, 0xb2, 0x1f, 0xdd, 0x55, 0x50, 0x2b,
+  0x36, 0x1a, 0x95, 0x34, 0xf6, 0x97, 0xd3, 0xfa, 0x66, 0xe1, 0x21, 0x8a, 0xa2, 0x8d, 0x85, 0xab,
+  0x7c, 0xd3, 0xf3, 0xd7, 0x95, 0x20, 0x72, 0x4f, 0xe6, 0xf9, 0x45, 0x08, 0xd4, 0xe2, 0x90, 0x47,
+  0x82, 0x14, 0x26, 0xf4, 0xa3, 0x3c, 0x9c, 0x07, 0xf4, 0x5d, 0xa6, 0x20, 0x63, 0x92, 0x36, 0x42,
+  0x67, 0xb0, 0xae, 0x08, 0x60, 0x4c, 0xc4, 0x1d, 0x41, 0xd4, 0x2a, 0x72, 0x61, 0xf8, 0x84, 0x9a,
+  0x65, 0xab, 0x99, 0x68, 0x17, 0x01, 0x17, 0x18, 0xa0, 0xc6, 0xf1, 0x17, 0xb4, 0x46, 0xa7, 0x94,
+  0xed, 0x13, 0x3c, 0x9e, 0xf7, 0x08, 0xa4, 0x70, 0x54, 0x11, 0xd1, 0x05, 0x70, 0xe1, 0xb7, 0x22,
+  0xf9, 0xe9, 0x98, 0xb2, 0x27, 0xd1, 0xf2, 0xee, 0xcd, 0xeb, 0xcd, 0x68, 0x92, 0xf3, 0x77, 0x09,
+  0xc3, 0x0c, 0xac, 0xf8, 0xb7, 0xc0, 0x19, 0xb0, 0xa4, 0xfd, 0xf4, 0xe9, 0x43, 0xbb, 0x37, 0x6e,
+  0x2c, 0x85, 0x77, 0x09, 0x36, 0x4b, 0x32, 0xf0, 0x05, 0x20, 0xf7, 0x13, 0xdc, 0xf4, 0xde, 0x7d,
+  0x28, 0xa5, 0xda, 0x96, 0xd8, 0xe5, 0xa0, 0x7a, 0x2e, 0xc7, 0xe1, 0xd8, 0xcf, 0xc0, 0x0a, 0xef,
+  0x3e, 0xb0, 0x2b, 0xdf, 0x87, 0x85, 0x6a, 0x46, 0xd9, 0x2c, 0x0a, 0xe2, 0x29, 0xae, 0xf0, 0x1c,
+  0x4b, 0xa4, 0xb4, 0x27, 0x31, 0x88, 0x5f, 0xbc, 0x21, 0x06, 0x3f, 0xc0, 0xcd, 0x41, 0xdc, 0xd1,
+  0x88, 0x3a, 0x77, 0x72, 0x61, 0x3c, 0xd0, 0x06, 0x4e, 0x8d, 0x27, 0xfb, 0x39, 0x2c, 0x21, 0x25,
+  0x62, 0xe9, 0x67, 0x77, 0x1e, 0x1c, 0xc4, 0x12, 0x8d, 0xa8, 0xb3, 0x44, 0xbb, 0x34, 0x55, 0x56,
+  0x0c, 0xed, 0x39, 0xbc, 0x24, 0xe9, 0xb4, 0x73, 0xf9, 0x4b, 0x3a, 0x75, 0xe3, 0xf0, 0xab, 0xcb,
+  0x4f, 0x5b, 0x1e, 0xc0, 0x0f, 0x8e, 0xaa, 0xd2, 0x36, 0x8d, 0xe7, 0xd0, 0x1e, 0x2f, 0xbd, 0xdb,
+  0x00, 0x8c, 0xf3, 0x9a, 0x3e, 0x0f, 0x22, 0x2c, 0x86, 0x7c, 0x3b, 0xed, 0x3c, 0xb9, 0x0d, 0x20,
+  0x2f, 0x5e, 0x7d, 0x78, 0xc7, 0x3e, 0xe1, 0x6d, 0x3b, 0xf5, 0x05, 0xe0, 0x59, 0x27, 0xb8, 0x71,
+  0x57, 0x06, 0x27, 0x0d, 0xac, 0x32, 0x50, 0xce, 0xb5, 0x4f, 0xe2, 0x60, 0xfa, 0x35, 0x84, 0xd6,
+  0xeb, 0x64, 0xbe, 0x40, 0x4f, 0xaf, 0x69, 0xbe, 0x99, 0x10, 0x38, 0x68, 0x33, 0x88, 0x35, 0x9c,
+  0xbe, 0xe2, 0x60, 0x6b, 0x90, 0x43, 0xc2, 0xc0, 0x81, 0x2f, 0x10, 0xe4, 0x79, 0x94, 0x21, 0xa7,
+  0xe5, 0x81, 0xdc, 0xad, 0x99, 0x0b, 0x01, 0x5b, 0xf8, 0x6c, 0x24, 0x9b, 0x0d, 0x3e, 0xb1, 0xff,
+  0xe3, 0x0b, 0x30, 0x3a, 0x09, 0x71, 0x1b, 0x69, 0x91, 0x86, 0x38, 0x41, 0x5d, 0x07, 0x69, 0x1e,
+  0x4e, 0x42, 0x8f, 0xef, 0x06, 0x14, 0x1d, 0xec, 0xf8, 0xe3, 0x4f, 0x57, 0x8a, 0x7e, 0x72, 0x90,
+  0xbf, 0x55, 0x11, 0xd6, 0xe2, 0x7e, 0xd8, 0x08, 0xc7, 0xb7, 0xf3, 0x45, 0x7e, 0x4f, 0xf3, 0xd0,
+  0x2c, 0xf0, 0x6e, 0x99, 0x3b, 0x75, 0xc3, 0x38, 0xcb, 0x59, 0xcf, 0x73, 0xd5, 0x05, 0x6e, 0x05,
+  0x3e, 0xdd, 0x3f, 0xaa, 0xd5, 0xed, 0xe5, 0x4d, 0xf9, 0x70, 0x10, 0xdf, 0xb5, 0xd2, 0xb8, 0xc6,
+  0xa8, 0x3b, 0x1f, 0x87, 0x41, 0x43, 0x9a, 0x67, 0xa4, 0x8e, 0x72, 0xdf, 0xfe, 0xbd, 0xb8, 0xdb,
+  0xcf, 0x57, 0x31, 0xe6, 0x1b, 0x69, 0x7b, 0x6e, 0xf4, 0x25, 0xaf, 0x6d, 0x3c, 0xb3, 0x6b, 0x37,
+  0x0a, 0xc7, 0xe9, 0x81, 0x7c, 0xf0, 0xf1, 0x75, 0xb5, 0xa4, 0xee, 0x7a, 0x44, 0xfe, 0x78, 0xaa,
+  0xaa, 0x2c, 0x50, 0xa7, 0x2a, 0xeb, 0x6b, 0x23, 0x67, 0xa0, 0xda, 0xcf, 0xe2, 0x6e, 0x56, 0x6e,
+  0x50, 0x3f, 0x9d, 0xb5, 0xd9, 0x0e, 0xd6, 0x9e, 0xc5, 0x0d, 0xb4, 0x7d, 0xc0, 0x1c, 0xf3, 0x2c,
+  0x45, 0x2d, 0x76, 0x29, 0xea, 0xf8, 0xea, 0xcd, 0x35, 0x54, 0x51, 0xcb, 0x38, 0xcf, 0x4e, 0x9e,
+  0xee, 0xe3, 0x50, 0x96, 0xad, 0xa8, 0xec, 0xe7, 0x37, 0xec, 0x26, 0xc8, 0xd3, 0xd0, 0xcb, 0xda,
+  0xf9, 0xa2, 0xb8, 0x1a, 0x27, 0x77, 0x85, 0x93, 0x8b, 0xd1, 0x65, 0x16, 0x01, 0xfa, 0xac, 0xdc,
+  0xa8, 0x7f, 0xda, 0x68, 0x9a, 0x43, 0xd8, 0x9b, 0x60, 0x0d, 0x65, 0x02, 0xc4, 0xfa, 0xd3, 0x06,
+  0x53, 0x5d, 0xc2, 0xae, 0xc4, 0x97, 0x46, 0x98, 0xb4, 0xfc, 0xd3, 0x90, 0x0c, 0x08, 0xc9, 0xbf,
+  0x3f, 0xbc, 0x79, 0x92, 0x0e, 0xe9, 0x2b, 0x9b, 0x80, 0x01, 0x2b, 0xfc, 0xf9, 0x22, 0x0a, 0x40,
+  0x76, 0xde, 0xb0, 0x25, 0x47, 0x97, 0xf0, 0x2d, 0x59, 0x58, 0x87, 0x32, 0x18, 0xca, 0x68, 0x7f,
+  0x6b, 0xa6, 0xb6, 0x3b, 0x97, 0xb6, 0x80, 0xc9, 0xb6, 0xa7, 0x73, 0xc8, 0xf7, 0xba, 0xb6, 0x1f,
+  0x0c, 0x90, 0xe9, 0xfb, 0xb1, 0x99, 0x80, 0xcd, 0xdc, 0x8f, 0xcd, 0x02, 0x6c, 0xd6, 0x7e, 0x6c,
+  0x0e, 0xf2, 0x86, 0x2b, 0xe5, 0x65, 0xbe, 0x63, 0xde, 0x84, 0x94, 0x74, 0x69, 0x08, 0xa8, 0x1d,
+  0x02, 0x0c, 0x90, 0xb5, 0xbd, 0x60, 0x86, 0x05, 0x60, 0xd6, 0x5e, 0x30, 0x13, 0x8a, 0x08, 0x50,
+  0xee, 0x3e, 0x30, 0x47, 0xe3, 0xda, 0xdd, 0x07, 0x37, 0x24, 0x38, 0xfb, 0x10, 0x21, 0xb8, 0x82,
+  0xf7, 0xf2, 0xc7, 0x29, 0xb3, 0x59, 0xb2, 0x4c, 0x5f, 0x62, 0xa2, 0x8e, 0x96, 0x19, 0x24, 0xc9,
+  0x8f, 0x41, 0xec, 0xb3, 0xd7, 0x6e, 0xee, 0xcd, 0x60, 0x9e, 0xdd, 0x5e, 0x56, 0x08, 0xe8, 0x96,
+  0xc2, 0xe2, 0xed, 0x2a, 0x48, 0xef, 0x59, 0x46, 0xbe, 0xff, 0x97, 0x58, 0xfd, 0x2f, 0xb3, 0xd3,
+  0xb3, 0x34, 0x9b, 0x45, 0x41, 0x00, 0x6d, 0xbf, 0x87, 0x3f, 0x86, 0x90, 0xc8, 0xd6, 0x41, 0xca,
+  0x70, 0xe1, 0xbf, 0x45, 0xb1, 0x02, 0xb8, 0x45, 0xab, 0xbf, 0x4c, 0x26, 0xbb, 0xaa, 0xb5, 0x9b,
+  0xc4, 0x0f, 0xe6, 0x8c, 0x86, 0xef, 0x5a, 0x61, 0xbe, 0xa7, 0x17, 0xfc, 0x4d, 0xb0, 0x52, 0x2e,
+  0xbe, 0xc2, 0xae, 0x40, 0x31, 0x3f, 0x09, 0xb2, 0xb8, 0x9b, 0xb3, 0x19, 0x9e, 0x28, 0x88, 0xd9,
+  0x7a, 0x16, 0x42, 0x46, 0x5b, 0xc8, 0xa9, 0xcb, 0x73, 0x17, 0x34, 0xd7, 0xc3, 0x24, 0x31, 0x85,
+  0xa2, 0x2c, 0x63, 0xf8, 0xb2, 0x06, 0xd6, 0xe3, 0xd5, 0xc5, 0xfa, 0x13, 0x0a, 0x98, 0x30, 0xcb,
+  0x71, 0x05, 0xf0, 0x9e, 0x3e, 0xf7, 0xe5, 0x4d, 0x09, 0xdd, 0xa2, 0x0d, 0xee, 0x82, 0xe3, 0xc0,
+  0xf5, 0x70, 0x4a, 0xdd, 0xbe, 0x30, 0xe7, 0x70, 0x66, 0xea, 0xef, 0x83, 0xb5, 0x25, 0xac, 0x9d,
+  0xcf, 0xf6, 0xc1, 0xea, 0x45, 0x0c, 0xe8, 0x5a, 0x1b, 0xf4, 0xb3, 0xbc, 0x88, 0x0e, 0x43, 0x7c,
+  0x59, 0xa6, 0x30, 0x4b, 0x5c, 0xe1, 0x2d, 0xfb, 0x3d, 0x18, 0xcf, 0x92, 0xe4, 0x76, 0x7f, 0xc1,
+  0x50, 0x8e, 0xac, 0x96, 0x78, 0x43, 0xa7, 0x51, 0x43, 0x88, 0xef, 0x3b, 0xe2, 0x36, 0x00, 0x9d,
+  0x11, 0x3b, 0x65, 0x81, 0x2c, 0x9f, 0x93, 0x38, 0xba, 0x67, 0xf8, 0x22, 0x86, 0x50, 0x65, 0x4f,
+  0x2e, 0x2a, 0x38, 0x07, 0xe9, 0x32, 0x0a, 0x32, 0xc9, 0xfd, 0xaf, 0xf8, 0x70, 0x28, 0xef, 0x7c,
+  0x64, 0x9d, 0x5d, 0x2a, 0x07, 0xf3, 0xcb, 0xa1, 0xdd, 0xd3, 0xff, 0x01, 0x69, 0xe2, 0x74, 0xf6,
+  0x83, 0xfe, 0x9c, 0xa2, 0x95, 0xbc, 0xb7, 0x56, 0x8a, 0x71, 0x7f, 0xfe, 0x24, 0xfc, 0xf9, 0x90,
+  0x7a, 0x8c, 0xe3, 0x68, 0x61, 0x0f, 0x92, 0x88, 0x76, 0xfa, 0x83, 0x2c, 0xa6, 0x79, 0x3c, 0x5c,
+  0xc5, 0xf7, 0x32, 0x58, 0xd8, 0x2d, 0xc4, 0x57, 0x46, 0x5b, 0x67, 0x45, 0x3c, 0x71, 0x2a, 0x3c,
+  0x77, 0xfa, 0x0c, 0xea, 0x26, 0x43, 0xd3, 0xd8, 0x4f, 0x5f, 0x4f, 0x31, 0xee, 0xbc, 0x59, 0x39,
+  0xe2, 0x08, 0x7f, 0x72, 0x02, 0x2c, 0x03, 0xc0, 0xc9, 0x84, 0x45, 0x65, 0xbc, 0xaa, 0x8c, 0xbd,
+  0x0f, 0x70, 0x63, 0x91, 0x5b, 0x0f, 0x4f, 0x08, 0xb8, 0x39, 0x84, 0xd1, 0xfd, 0x13, 0x22, 0x72,
+  0x63, 0x37, 0x93, 0x6f, 0xaf, 0xfd, 0x39, 0xfb, 0x99, 0xf2, 0xc4, 0xdd, 0x0b, 0x1e, 0xcc, 0x68,
+  0x3f, 0x7f, 0x57, 0xdd, 0xd0, 0x14, 0xa7, 0xf0, 0x9e, 0xbd, 0x9f, 0x79, 0x34, 0xc3, 0x86, 0xf2,
+  0x24, 0x02, 0x13, 0x44, 0xe9, 0xdc, 0x06, 0x9d, 0x37, 0x58, 0x87, 0x29, 0x44, 0x79, 0x96, 0x1d,
+  0x09, 0xf9, 0xb6, 0xef, 0x5e, 0x0a, 0x80, 0xa7, 0x6c, 0x5e, 0x66, 0x59, 0x08, 0x25, 0xfa, 0xcd,
+  0xd5, 0xb5, 0xdc, 0x93, 0xdb, 0xef, 0xa6, 0x73, 0xd7, 0xab, 0x2f, 0x96, 0xc1, 0x2b, 0x71, 0x67,
+  0x15, 0x63, 0x9b, 0x1f, 0xc2, 0xc1, 0xbb, 0xf2, 0x25, 0xa6, 0x36, 0xaa, 0xff, 0xf7, 0xe4, 0xd8,
+  0xe2, 0x3c, 0x7e, 0xfc, 0xf8, 0xee, 0xcd, 0x7e, 0xe6, 0x08, 0xf6, 0x1b, 0xf7, 0x8f, 0xd6, 0xe1,
+  0x24, 0xfc, 0xb2, 0x58, 0x43, 0x2c, 0x03, 0xdc, 0x62, 0x96, 0xd2, 0xd7, 0x1c, 0x0e, 0xd9, 0x3f,
+  0x92, 0x03, 0xeb, 0x01, 0x9c, 0xb9, 0xb4, 0x10, 0xf8, 0x36, 0x9e, 0x84, 0x69, 0xc5, 0xe6, 0xb1,
+  0x74, 0xba, 0x1d, 0x1b, 0xcd, 0xf5, 0x01, 0xcd, 0x89, 0xc5, 0x9f, 0x79, 0x0b, 0x7c, 0x21, 0x73,
+  0xfd, 0xcd, 0x9b, 0xc4, 0x33, 0xb1, 0xb3, 0x0b, 0x4b, 0x62, 0x71, 0xb7, 0xdf, 0x48, 0xc5, 0x98,
+  0xe7, 0xec, 0x14, 0x34, 0x52, 0x8a, 0x90, 0xf3, 0xcf, 0xc9, 0x28, 0xc5, 0xa1, 0xd0, 0x17, 0x4b,
+  0x29, 0x1b, 0x27, 0x45, 0xeb, 0xe7, 0x33, 0x38, 0xb9, 0xf6, 0xd3, 0x4c, 0x0b, 0x77, 0x1a, 0x88,
+  0xd4, 0x91, 0xa7, 0x49, 0xc4, 0x5c, 0xcf, 0x83, 0x78, 0xe5, 0xc7, 0xbb, 0x2a, 0x07, 0x99, 0xb6,
+  0x25, 0x07, 0x0e, 0xfe, 0x94, 0xdc, 0x80, 0xf3, 0xf8, 0x17, 0xe0, 0x34, 0xed, 0x20, 0x13, 0xe9,
+  0x01, 0x76, 0x2d, 0x06, 0xd4, 0x37, 0x50, 0x77, 0xe6, 0x07, 0xd7, 0x87, 0xea, 0xf8, 0xc9, 0xf1,
+  0x40, 0xa4, 0x64, 0x8c, 0x62, 0x0c, 0x1e, 0x16, 0xa1, 0x72, 0xd8, 0xbe, 0x08, 0x7d, 0x46, 0x05,
+  0x50, 0x70, 0x74, 0x8d, 0xa9, 0x3d, 0x9d, 0x3f, 0x89, 0xa1, 0x2f, 0x1e, 0x1f, 0xd4, 0x60, 0xec,
+  0x59, 0x3c, 0x35, 0x02, 0x84, 0xdb, 0xfd, 0x65, 0xe3, 0x43, 0x7e, 0x94, 0x27, 0x87, 0x1b, 0x81,
+  0xc3, 0x7f, 0x77, 0x8e, 0x62, 0x01, 0xcf, 0xd7, 0x56, 0x4f, 0x9a, 0x95, 0x09, 0x43, 0x9c, 0xb0,
+  0x65, 0xc7, 0x9b, 0x40, 0x38, 0xc7, 0x5c, 0x9e, 0x87, 0x97, 0xef, 0x13, 0x7e, 0xa4, 0x53, 0x4e,
+  0xa0, 0xa7, 0xa0, 0x9f, 0x00, 0x5f, 0xb1, 0xad, 0xdd, 0x30, 0x57, 0x55, 0xf0, 0xf6, 0x50, 0xa2,
+  0x39, 0xa9, 0xa9, 0xa4, 0x3c, 0x83, 0x0c, 0x4c, 0x34, 0xcf, 0xd3, 0xb1, 0x4d, 0x82, 0xcd, 0xb3,
+  0x74, 0x84, 0xf2, 0xf4, 0xe8, 0xb7, 0x77, 0xf8, 0x75, 0x0e, 0x55, 0x6b, 0x4a, 0xce, 0x0f, 0x8f,
+  0x5e, 0x82, 0xaf, 0xa3, 0x38, 0xec, 0x82, 0x75, 0x3a, 0x67, 0x47, 0x93, 0x65, 0x4c, 0xea, 0x60,
+  0x7f, 0x3b, 0xe6, 0x99, 0x34, 0x49, 0x4f, 0xd8, 0xc3, 0x51, 0x1a, 0x40, 0x55, 0x17, 0xc3, 0xea,
+  0xc7, 0x5b, 0xe2, 0x86, 0xad, 0xfa, 0x3f, 0x4b, 0xa8, 0xa1, 0x3e, 0x0a, 0x80, 0x12, 0xf2, 0xec,
+  0xe8, 0xb1, 0x82, 0x01, 0x42, 0xb8, 0x0d, 0xc9, 0x55, 0x9a, 0xba, 0xf7, 0xea, 0x22, 0x4d, 0xf2,
+  0x04, 0xed, 0xa7, 0x66, 0x11, 0xc6, 0xbc, 0x87, 0xd0, 0xed, 0xf8, 0xaf, 0xaa, 0x78, 0xea, 0x34,
+  0x40, 0xa7, 0xff, 0xc6, 0x10, 0x2c, 0xfa, 0x4f, 0x79, 0x48, 0x22, 0xb9, 0x3a, 0x7d, 0xfc, 0x0d,
+  0xb3, 0xb7, 0xae, 0x37, 0x3b, 0x96, 0x63, 0x8f, 0x83, 0x08, 0xa0, 0x58, 0x10, 0xa9, 0x34, 0x02,
+  0xe4, 0xa7, 0xcf, 0x33, 0xf6, 0x58, 0x27, 0x31, 0x6d, 0x92, 0x40, 0xdc, 0x2b, 0x37, 0x85, 0x91,
+  0x30, 0xe6, 0x6f, 0x55, 0xe1, 0x85, 0x80, 0xd0, 0xf1, 0x1f, 0x25, 0xde, 0x11, 0xe9, 0xb5, 0xce,
+  0xf3, 0x4f, 0x9f, 0x6e, 0xde, 0x57, 0x58, 0xc6, 0xdf, 0x43, 0x7e, 0x12, 0xc7, 0xf4, 0xe5, 0x38,
+  0x44, 0x02, 0x1c, 0xe0, 0xe0, 0x0d, 0xa6, 0x33, 0xa8, 0xc8, 0x3e, 0xd0, 0xef, 0xa1, 0x55, 0xc8,
+  0x60, 0xe3, 0x93, 0xc8, 0xf0, 0x5f, 0x54, 0xfb, 0x19, 0xd6, 0xd2, 0x2a, 0x9d, 0x63, 0x57, 0xc5,
+  0x31, 0x76, 0xa0, 0x8a, 0xb8, 0x40, 0xca, 0x6e, 0x17, 0xe4, 0xeb, 0xe2, 0xa1, 0xf6, 0xee, 0x06,
+  0x0f, 0x49, 0x7c, 0x0d, 0x96, 0xbd, 0xad, 0xca, 0xe9, 0xc6, 0x3e, 0x2c, 0x61, 0x9e, 0xc4, 0x83,
+  0xeb, 0xfb, 0xb0, 0x7a, 0x8c, 0x73, 0xbe, 0x08, 0x0e, 0xd2, 0xe3, 0xae, 0x87, 0x58, 0xbb, 0x25,
+  0xb6, 0x0d, 0xc2, 0x69, 0x00, 0xee, 0x93, 0xe5, 0xc7, 0x7c, 0xdd, 0x86, 0x51, 0x2f, 0x4d, 0xc6,
+  0xcb, 0x84, 0x0c, 0xf8, 0x7f, 0x78, 0x3c, 0x3b, 0x0a, 0x27, 0xec, 0x98, 0xa6, 0x96, 0xef, 0x2e,
+  0x2e, 0xd8, 0x32, 0xf6, 0x83, 0x49, 0x18, 0x07, 0x3e, 0xc2, 0x0a, 0x38, 0x95, 0x1f, 0x13, 0xc5,
+  0xd0, 0xc0, 0x83, 0xa2, 0x60, 0x46, 0xd9, 0x41, 0x3f, 0xe1, 0x73, 0xc1, 0xe2, 0x60, 0xcd, 0x7e,
+  0xfb, 0xf5, 0xfd, 0xc7, 0xc0, 0x4d, 0xbd, 0x19, 0xe8, 0xdb, 0x9d, 0x67, 0x84, 0x91, 0xf8, 0x11,
+  0xde, 0x30, 0x09, 0x72, 0x10, 0x4c, 0x46, 0xd9, 0x0f, 0x8c, 0x73, 0x25, 0x10, 0x9d, 0xa8, 0x50,
+  0x5a, 0xc7, 0xa5, 0xd8, 0x50, 0xbd, 0x2e, 0xa0, 0x99, 0xfc, 0x17, 0xd9, 0xfb, 0x4e, 0x36, 0xa8,
+  0xc9, 0xed, 0xc9, 0x51, 0x3e, 0x4b, 0x41, 0xeb, 0x48, 0xf4, 0x6d, 0x9a, 0x42, 0xdc, 0x15, 0x9d,
+  0x59, 0xee, 0xe6, 0xcb, 0xac, 0xf4, 0x40, 0x92, 0xea, 0xa2, 0x2a, 0x15, 0xd8, 0xaa, 0x80, 0xfe,
+  0xef, 0x0c, 0x28, 0x9d, 0x80, 0xe1, 0x8a, 0x16, 0x9c, 0x00, 0x8f, 0x91, 0xe9, 0xba, 0x22, 0xc7,
+  0xcb, 0xec, 0xbe, 0x62, 0x3e, 0x84, 0x92, 0x9a, 0x14, 0x09, 0xba, 0x11, 0x00, 0xc4, 0x32, 0xef,
+  0x3a, 0x61, 0x92, 0x17, 0x29, 0xdb, 0x09, 0x29, 0x9d, 0xcc, 0x00, 0x49, 0x0d, 0x91, 0xc1, 0x70,
+  0xf1, 0x73, 0xad, 0x85, 0x43, 0x9f, 0x1d, 0x89, 0x16, 0xf9, 0xd3, 0x7c, 0x00, 0x83, 0x5f, 0x66,
+  0x28, 0xda, 0xab, 0xae, 0x8f, 0x38, 0x4a, 0x99, 0x2b, 0x74, 0x5a, 0x90, 0x4c, 0xdc, 0x28, 0x6b,
+  0xc7, 0x22, 0xb9, 0x01, 0xd1, 0x6b, 0xd2, 0x73, 0xff, 0xfa, 0xd9, 0x5d, 0x71, 0x37, 0x26, 0x9b,
+  0x04, 0x90, 0xb7, 0x02, 0x74, 0xc7, 0x37, 0xfc, 0x75, 0x3b, 0x2a, 0x0d, 0x25, 0x92, 0xc7, 0x75,
+  0x3e, 0xb9, 0x63, 0xe4, 0x0b, 0x6a, 0x19, 0x15, 0xcf, 0x72, 0xe0, 0xd6, 0x0f, 0x94, 0x5b, 0x67,
+  0xdc, 0xdd, 0xbb, 0x95, 0xdf, 0xd5, 0xee, 0xee, 0xf2, 0xf9, 0x66, 0xb0, 0x55, 0x03, 0xec, 0x6f,
+  0xc7, 0xdd, 0x57, 0x5d, 0x70, 0xa3, 0x0a, 0xc5, 0x93, 0xcd, 0x01, 0xf4, 0x83, 0x94, 0x5d, 0x49,
+  0x97, 0x7e, 0x52, 0x78, 0x27, 0x45, 0x9a, 0x46, 0x30, 0xc4, 0xd4, 0x34, 0x98, 0x27, 0xab, 0xe0,
+  0xb8, 0xcb, 0xbf, 0x7e, 0xd6, 0x15, 0xd1, 0x45, 0x12, 0x95, 0x40, 0x10, 0x94, 0x15, 0x88, 0x23,
+  0xfa, 0xbe, 0x0a, 0xed, 0x64, 0x1c, 0x9f, 0xb4, 0xa8, 0xf0, 0xcd, 0x6b, 0xac, 0xf1, 0xaf, 0x67,
+  0x78, 0x80, 0x9e, 0xab, 0x11, 0x55, 0xe6, 0x8f, 0x31, 0xfb, 0x03, 0xb3, 0x45, 0x82, 0xed, 0x72,
+  0x99, 0xfe, 0xa0, 0xaa, 0x42, 0x1c, 0x32, 0xf9, 0xdc, 0x15, 0x6e, 0x25, 0xc1, 0x21, 0x16, 0x8d,
+  0x0e, 0xe2, 0xa8, 0xa4, 0xb8, 0x2e, 0x55, 0x27, 0xc5, 0x38, 0x3c, 0x1d, 0xf1, 0x19, 0x12, 0x04,
+  0x99, 0x1c, 0x86, 0x6f, 0x87, 0xc4, 0xcf, 0xc3, 0x20, 0x2b, 0x6f, 0x2b, 0x6b, 0x03, 0x44, 0x2e,
+  0xef, 0x52, 0x9d, 0xf4, 0x07, 0x16, 0x51, 0xe2, 0xf0, 0x08, 0x42, 0x75, 0xf0, 0xa5, 0x31, 0x26,
+  0x88, 0x0e, 0x37, 0x5c, 0x1d, 0x25, 0x87, 0x3a, 0x51, 0x2b, 0xd5, 0x12, 0x9a, 0x6e, 0x99, 0x46,
+  0x60, 0xb8, 0x47, 0xb0, 0x0a, 0x94, 0x08, 0x87, 0x88, 0x89, 0xe1, 0x71, 0x90, 0x94, 0x7b, 0x01,
+  0x1b, 0x42, 0x4a, 0xf8, 0xdd, 0x32, 0x96, 0x07, 0x6b, 0x9e, 0x22, 0x65, 0xfb, 0x61, 0x1a, 0x14,
+  0xbc, 0x69, 0x6d, 0x73, 0x8f, 0xb5, 0x0f, 0xb7, 0x61, 0x92, 0x4e, 0x0f, 0x52, 0x03, 0x3f, 0xc1,
+  0x71, 0x10, 0x28, 0x1d, 0xb5, 0xa8, 0x40, 0x1e, 0x60, 0x36, 0xc1, 0xc5, 0x7e, 0x76, 0x4b, 0x36,
+  0xf6, 0xc3, 0x16, 0x7c, 0x48, 0xd0, 0xc7, 0x6a, 0x18, 0x8a, 0xc4, 0xc0, 0x23, 0x74, 0x9e, 0x4d,
+  0x51, 0xa1, 0x90, 0x87, 0xb2, 0x04, 0x92, 0x46, 0x94, 0x4c, 0x8f, 0xbb, 0x7f, 0xd0, 0xce, 0xe2,
+  0x67, 0x86, 0x89, 0x05, 0xfb, 0x2b, 0x46, 0xe7, 0xbf, 0x05, 0xce, 0x16, 0x80, 0x9b, 0xf7, 0xfc,
+  0x4d, 0xb6, 0x75, 0x77, 0xe4, 0x9d, 0x0a, 0xf1, 0x6a, 0x72, 0xc0, 0x89, 0x7f, 0xd7, 0x70, 0x9e,
+  0xe7, 0xaa, 0xa3, 0xf9, 0x57, 0x16, 0xc4, 0x5e, 0x01, 0xad, 0x4a, 0xa6, 0xc7, 0x98, 0x59, 0xe5,
+  0x04, 0x89, 0xf7, 0xea, 0xcc, 0xcd, 0x7e, 0x59, 0xc7, 0x1f, 0xe8, 0x7b, 0x2b, 0xf9, 0x3d, 0xe4,
+  0x91, 0x2c, 0xf4, 0xbb, 0x27, 0x27, 0x47, 0x45, 0x75, 0x58, 0xd5, 0x16, 0x76, 0xa2, 0xa6, 0x70,
+  0xe4, 0x1f, 0x1c, 0xf4, 0xb3, 0xcc, 0x31, 0x6d, 0xc8, 0x16, 0x6b, 0x44, 0x55, 0xf7, 0x6b, 0xb1,
+  0x49, 0xb2, 0xe9, 0xd7, 0x1d, 0x5c, 0x83, 0xf8, 0x2a, 0x13, 0xdf, 0x9f, 0xe0, 0xa7, 0x2d, 0x30,
+  0xef, 0xa9, 0x9d, 0x1d, 0x24, 0x68, 0xab, 0xb2, 0xce, 0x70, 0x35, 0x15, 0x52, 0x77, 0x85, 0x65,
+  0x82, 0xde, 0xc9, 0x33, 0x7f, 0x17, 0xb0, 0x1d, 0x23, 0xef, 0x2f, 0x51, 0x0a, 0xf8, 0xcf, 0x27,
+  0x2d, 0xba, 0x97, 0x0b, 0xaa, 0x86, 0xf2, 0xff, 0xe8, 0x8a, 0x0c, 0x0d, 0x48, 0xba, 0x22, 0x0c,
+  0xc5, 0x2d, 0x86, 0xbc, 0xb8, 0xc5, 0x1c, 0x25, 0x6e, 0x2b, 0xc9, 0x45, 0xb4, 0x40, 0x24, 0x88,
+  0x3b, 0xee, 0xea, 0xdd, 0xd3, 0xa3, 0xae, 0x38, 0x4a, 0x24, 0xda, 0xf3, 0x28, 0x13, 0x77, 0x95,
+  0x53, 0x2e, 0xd8, 0x22, 0x5f, 0x12, 0xcb, 0x5e, 0x7c, 0xfb, 0x86, 0xc3, 0x8b, 0xdd, 0x7d, 0xec,
+  0xa8, 0x6c, 0x97, 0xe3, 0x23, 0x9d, 0xa9, 0x90, 0x37, 0x33, 0x79, 0xb3, 0xc0, 0x61, 0x62, 0xd7,
+  0xba, 0xfb, 0x79, 0x73, 0x8a, 0x44, 0xb9, 0x76, 0x39, 0x1b, 0xf5, 0x57, 0xf5, 0xcc, 0x35, 0x8c,
+  0x91, 0x44, 0xf9, 0xed, 0x07, 0xd6, 0x2d, 0xf4, 0x4c, 0xa9, 0x4a, 0x94, 0x59, 0x5b, 0x6d, 0x27,
+  0xa3, 0xb9, 0x7b, 0xc2, 0xfe, 0xfe, 0x77, 0x61, 0x9f, 0xa2, 0xed, 0x33, 0xa5, 0x44, 0xbd, 0x73,
+  0xb2, 0x99, 0x68, 0x45, 0x0a, 0x78, 0x19, 0x8f, 0x94, 0xe7, 0x60, 0xc0, 0x85, 0x30, 0x99, 0xb5,
+  0xc5, 0x91, 0x04, 0xa9, 0x78, 0x91, 0x1c, 0xf4, 0xb9, 0x9a, 0x40, 0xd4, 0xa2, 0xb9, 0x15, 0xee,
+  0x71, 0x87, 0x26, 0xf8, 0xf9, 0x03, 0xce, 0x03, 0xaf, 0x64, 0xaa, 0x22, 0xf3, 0xde, 0xcf, 0x5b,
+  0xeb, 0x9a, 0x23, 0xac, 0x6b, 0xf0, 0x48, 0x03, 0xd5, 0x7f, 0xb0, 0x1a, 0x48, 0xb3, 0xe0, 0x1d,
+  0xa4, 0x4e, 0xa1, 0x52, 0x81, 0xfc, 0x33, 0xa8, 0x99, 0x15, 0x7d, 0x72, 0xd5, 0x06, 0x24, 0xbf,
+  0xbb, 0x60, 0x9a, 0xac, 0x88, 0xeb, 0xcb, 0x41, 0x1e, 0x09, 0x78, 0x52, 0xf6, 0x98, 0x2f, 0x6b,
+  0xf9, 0x72, 0xa3, 0xd3, 0xe3, 0x1b, 0xe2, 0x9d, 0x66, 0x51, 0x2f, 0x43, 0xa6, 0x9a, 0x72, 0xa9,
+  0x6d, 0x87, 0x01, 0xe4, 0x0e, 0x43, 0x61, 0x00, 0xa1, 0xcc, 0xda, 0xf6, 0x43, 0xa1, 0xd1, 0xa2,
+  0x41, 0x68, 0x7e, 0xd3, 0x5a, 0x12, 0xe2, 0x73, 0xfb, 0x98, 0x1d, 0x56, 0x98, 0xbb, 0x5e, 0x2b,
+  0x13, 0xd8, 0x2e, 0x71, 0xe1, 0xfd, 0x56, 0xd2, 0xd0, 0xf9, 0x79, 0x03, 0x72, 0x07, 0x41, 0xb1,
+  0x8d, 0x21, 0xb2, 0x57, 0x95, 0xa4, 0xec, 0x91, 0xc8, 0xe4, 0xf3, 0xce, 0x5c, 0x18, 0x43, 0x62,
+  0x01, 0x54, 0xdb, 0x26, 0x92, 0x3f, 0x08, 0xe0, 0xf3, 0xee, 0x88, 0x2c, 0x11, 0xb4, 0x64, 0x43,
+  0x0c, 0xcf, 0xdd, 0x08, 0xf8, 0x8b, 0xc2, 0x3d, 0x48, 0x04, 0xd0, 0x4e, 0x44, 0x90, 0xb0, 0xf6,
+  0x60, 0x41, 0x88, 0x3d, 0x28, 0x78, 0xaa, 0xdb, 0x87, 0x46, 0x24, 0x44, 0x40, 0xd5, 0x52, 0xc4,
+  0x53, 0x0e, 0x53, 0x3d, 0x3c, 0x15, 0x71, 0x5c, 0x5b, 0x77, 0xd5, 0x2a, 0x8d, 0x2e, 0xad, 0x52,
+  0x71, 0x1d, 0x98, 0x86, 0xc1, 0x0a, 0xb7, 0xc0, 0x78, 0x80, 0x90, 0xf5, 0xba, 0x9b, 0xcb, 0x4d,
+  0x08, 0x2d, 0xfe, 0xed, 0xbe, 0x5f, 0xf9, 0x19, 0xf7, 0x46, 0x74, 0x89, 0x2f, 0xeb, 0xbd, 0x48,
+  0x78, 0xe1, 0xd1, 0xe4, 0xba, 0x83, 0x55, 0xbf, 0x5a, 0x5e, 0x38, 0x18, 0x3d, 0x7c, 0x86, 0x1c,
+  0xde, 0xe1, 0x5f, 0x34, 0xef, 0xec, 0x0c, 0xd9, 0xe5, 0xbc, 0x1d, 0xa5, 0xfc, 0xda, 0x78, 0x19,
+  0x7a, 0x00, 0x49, 0x58, 0xbf, 0xdf, 0x8d, 0x30, 0xf4, 0xef, 0xb6, 0x60, 0xc4, 0x9e, 0x02, 0x1b,
+  0x3e, 0x88, 0xe8, 0xfb, 0x14, 0xce, 0x83, 0x64, 0x99, 0x1f, 0x37, 0x55, 0x79, 0xca, 0x74, 0xfc,
+  0xdd, 0xfb, 0xe7, 0xda, 0xad, 0xf1, 0xdd, 0x83, 0x16, 0xdb, 0xe1, 0xf6, 0xb3, 0xf4, 0xa4, 0xe3,
+  0x62, 0x89, 0x87, 0x5f, 0x28, 0xbe, 0xe0, 0xdb, 0x08, 0xdd, 0x57, 0xcd, 0x97, 0xa7, 0xb8, 0x78,
+  0x80, 0x4f, 0x78, 0x54, 0x55, 0xb5, 0x23, 0x16, 0xd2, 0x22, 0x2d, 0x33, 0x4a, 0xbe, 0x5b, 0x73,
+  0xfe, 0x48, 0xe4, 0xf5, 0xed, 0xb9, 0x5f, 0xe2, 0xf9, 0xdf, 0x8b, 0x96, 0xe4, 0xce, 0xb9, 0x27,
+  0x72, 0xa0, 0x41, 0xdc, 0x0d, 0x3a, 0x12, 0xc5, 0xcc, 0x68, 0xef, 0x6a, 0xf4, 0xf4, 0x48, 0x54,
+  0x38, 0x55, 0xd0, 0xd6, 0x25, 0x0f, 0x41, 0x62, 0x01, 0xb4, 0x1d, 0x92, 0x2f, 0xe1, 0x38, 0x24,
+  0xb6, 0x6d, 0x87, 0xe4, 0xb9, 0x9b, 0x43, 0x56, 0x2a, 0xa9, 0xed, 0x03, 0x6a, 0x6b, 0x39, 0x3e,
+  0x0e, 0xea, 0xad, 0xed, 0xf0, 0xb4, 0x2c, 0xe1, 0x70, 0xbc, 0x1a, 0xdb, 0x0e, 0x2a, 0x17, 0x26,
+  0x1c, 0x9a, 0xea, 0x8e, 0xed, 0xc0, 0xb2, 0x2c, 0x21, 0x58, 0x2c, 0xed, 0x76, 0xa8, 0x18, 0xbb,
+  0x0b, 0xb4, 0x51, 0xb6, 0xcb, 0x18, 0x51, 0x26, 0x01, 0x2b, 0x95, 0xe1, 0x76, 0x2e, 0x2a, 0x40,
+  0x34, 0x4e, 0x96, 0x20, 0x5b, 0x46, 0x94, 0xb5, 0x0d, 0xc0, 0xca, 0x5a, 0x73, 0x1b, 0x3b, 0xb2,
+  0x9f, 0x33, 0xc4, 0xfd, 0x6e, 0x24, 0x1d, 0x99, 0xb3, 0x88, 0xe5, 0xe9, 0x0e, 0x69, 0xa8, 0x9f,
+  0x86, 0x53, 0x6d, 0xbf, 0x0d, 0x52, 0xac, 0x03, 0x90, 0x7d, 0xaa, 0xd7, 0xb7, 0xc1, 0xc9, 0xea,
+  0x1e, 0x00, 0x8b, 0x7a, 0x78, 0x8b, 0xa0, 0x45, 0x7f, 0x05, 0x9a, 0x0a, 0xe6, 0x9d, 0xf0, 0x04,
+  0x41, 0x23, 0xa8, 0xa6, 0xde, 0x02, 0x4b, 0x7d, 0x05, 0xd4, 0x6c, 0x07, 0xd4, 0xac, 0x80, 0x5a,
+  0xec, 0x80, 0x5a, 0x08, 0x28, 0x9a, 0x99, 0xb6, 0xc2, 0x51, 0x2f, 0x41, 0x3e, 0x9e, 0xd5, 0x26,
+  0x0f, 0x9e, 0x78, 0x3a, 0x3c, 0x6b, 0x36, 0xe7, 0x10, 0x4a, 0x19, 0x90, 0xad, 0x70, 0x66, 0x6b,
+  0x54, 0x78, 0x5b, 0x53, 0xa6, 0x00, 0x6f, 0x4b, 0x9d, 0x3c, 0xad, 0x15, 0xef, 0xa2, 0xb6, 0xe6,
+  0x4b, 0xfe, 0xaa, 0xf4, 0x58, 0xae, 0x2f, 0x5a, 0x45, 0x12, 0x6f, 0xd7, 0x40, 0x24, 0x2c, 0x49,
+  0x77, 0x81, 0xc8, 0x17, 0x70, 0x9f, 0x79, 0xbd, 0x56, 0x67, 0x4c, 0xbe, 0x63, 0x64, 0x93, 0x30,
+  0x88, 0xfc, 0x0c, 0x72, 0x33, 0x8b, 0x93, 0x9c, 0xcd, 0x51, 0xb0, 0xef, 0xba, 0xc5, 0xd6, 0x31,
+  0x32, 0xd9, 0x9e, 0xba, 0xcb, 0x77, 0x70, 0xed, 0x89, 0x5b, 0x66, 0xd2, 0xe2, 0x05, 0xea, 0x68,
+  0x07, 0xb3, 0xd8, 0x2f, 0x8d, 0x74, 0xa0, 0xe4, 0x1d, 0x58, 0xf4, 0x88, 0x09, 0x8f, 0xb7, 0xe3,
+  0x62, 0x88, 0xed, 0x19, 0xf8, 0xff, 0xdd, 0x05, 0x44, 0x3d, 0xba, 0x63, 0xc6, 0xac, 0x9c, 0x0d,
+  0xd8, 0xad, 0x77, 0xdc, 0xc9, 0xd8, 0xa2, 0x72, 0xbe, 0xe5, 0x01, 0xda, 0x16, 0xfb, 0x16, 0x5b,
+  0xc0, 0xca, 0x5d, 0x8d, 0xd3, 0xa3, 0xea, 0xd1, 0x8b, 0x6d, 0x79, 0xa6, 0x0a, 0x43, 0x83, 0xe4,
+  0x92, 0x62, 0x9b, 0xe5, 0x8b, 0x35, 0x48, 0x33, 0x3a, 0xe5, 0xa9, 0xa7, 0xbf, 0xd2, 0x32, 0xcd,
+  0x43, 0x4f, 0xdf, 0xb5, 0x98, 0xa8, 0xfa, 0x83, 0x30, 0x3b, 0x6c, 0x54, 0x05, 0x43, 0x23, 0xfd,
+  0xca, 0x05, 0x43, 0x2a, 0xd4, 0x26, 0xcc, 0x55, 0xca, 0x4b, 0xbf, 0x70, 0x03, 0xd2, 0x3e, 0xf0,
+  0xdf, 0xba, 0x19, 0x31, 0x9d, 0x3d, 0xfe, 0xc9, 0x52, 0x57, 0x78, 0xaa, 0xfd, 0x66, 0x4d, 0x8b,
+  0xd4, 0xfc, 0xc7, 0x42, 0xf8, 0x7e, 0xc1, 0x0e, 0xa9, 0xab, 0xbf, 0x29, 0xd2, 0x90, 0x9a, 0x8f,
+  0xdd, 0x10, 0x7b, 0x1d, 0x8c, 0xc5, 0x4f, 0x90, 0x80, 0xe8, 0xed, 0x02, 0xd7, 0x38, 0xff, 0x85,
+  0x28, 0xc8, 0x5f, 0x3b, 0x11, 0x78, 0x02, 0x1f, 0xf0, 0x76, 0xbf, 0x55, 0x07, 0x02, 0x35, 0x67,
+  0xb4, 0xd4, 0x41, 0x1d, 0x97, 0x7c, 0x83, 0x29, 0x5e, 0xa0, 0x9c, 0x36, 0x5e, 0x09, 0xf1, 0xcd,
+  0x50, 0xfe, 0xff, 0x6b, 0x14, 0x5f, 0xbf, 0x84, 0x82, 0x94, 0x5e, 0x4f, 0x22, 0x07, 0xc5, 0xe8,
+  0xb6, 0xca, 0xb7, 0x5a, 0x2f, 0x6f, 0xc0, 0xd6, 0x63, 0xbe, 0x92, 0x27, 0x36, 0x20, 0x6b, 0x49,
+  0xb9, 0x3a, 0xa7, 0x6c, 0x40, 0x36, 0x7c, 0xb4, 0xfa, 0xb8, 0x01, 0xdb, 0xb0, 0x6c, 0xd5, 0x1f,
+  0x6a, 0xb0, 0x7c, 0x6b, 0x98, 0xff, 0xbf, 0x16, 0x01, 0xae, 0xdc, 0xe9, 0x3d, 0x91, 0xb5, 0x7b,
+  0x7b, 0x0d, 0xfd, 0xb4, 0xd7, 0xbd, 0xb4, 0xe4, 0x2c, 0x94, 0x5f, 0x5d, 0x87, 0x8a, 0x97, 0x53,
+  0x1b, 0xd1, 0xb1, 0xb9, 0x90, 0x44, 0xfb, 0xc2, 0xf5, 0xbc, 0x27, 0x0e, 0x3d, 0x1c, 0x9d, 0xf7,
+  0xf0, 0x15, 0x2e, 0x9d, 0x30, 0xc2, 0xff, 0x19, 0xf1, 0xff, 0x01, 0x32, 0xb7, 0xa6, 0xd4, 0x93,
+  0x78, 0x00, 0x00,
+};
+
+#endif
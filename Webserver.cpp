@@ -3,90 +3,187 @@
 //                 also manages the SPIFFS files
 //
 
-#include <ESP8266WebServer.h>
+#include <ESPAsyncTCP.h>
+#include <ESPAsyncWebServer.h>
 #include <ESP8266HTTPClient.h>
 #include <ESP8266httpUpdate.h>
+#include <Updater.h>
 #include <FS.h>
 
 #include "Webserver.h"
 #include "defaults.h"
 #include "Sensor.h"
 #include "DB.h"
+#include "Log.h"
+#include "Diag.h"
+#include "WebUI.h"
 
 
-ESP8266WebServer         server(8080);   // Set the HTTP Server port here
+AsyncWebServer           server(DEFAULT_HTTP_PORT);   // Set the HTTP Server port here
+
+using namespace std::placeholders;
+
+// Served on GET HTTP_OTA_UPDATE_PATH
+static const char _update_form[] PROGMEM =
+  "<html><body><form method='POST' action='" HTTP_OTA_UPDATE_PATH "' enctype='multipart/form-data'>"
+  "<input type='file' name='update'><input type='submit' value='Update'>"
+  "</form></body></html>";
 
 
 Webserver::Webserver() {
   SPIFFS.begin();
-  Serial.println("File System Initialized");
+  LOG_INFO( LOG_WEB, "File system initialized" );
 }
 
 
-void Webserver::begin( Config *config, Sensor *sensor, DB *db ) {
+void Webserver::begin( Config *config, Sensor *sensor, DB *db, Clock *clock, Archive *archive, Network *net, Alerts *alerts, Capture *capture ) {
   _config = config;  // Keep a reference to the config
   _sensor = sensor;  // Keep a reference to the sensor library
   _db     = db;      // Keep a reference to the db library
+  _clock  = clock;   // Keep a reference to the wall clock
+  _archive = archive; // Keep a reference to the archive
+  _net    = net;     // Keep a reference to the network, for power save
+  _alerts = alerts;  // Keep a reference to the alerts
+  _capture = capture; // Keep a reference to the burst capture
 
   // See if we can find the version of the SPIFFS that we're running
   _spiffs_version = get_spiffs_version();
 
-  _fw_check_interval = FW_CHECK_INTERVAL * 1000;
-  _next_fw_check = millis() + _fw_check_interval;
-
-  Serial.println( "[Webserver] HTTP INIT, hostname: " + String( _config->conf.hostname ) + "  port: " + String( _config->conf.http_server_port ) );
-  Serial.println( "SPIFFS Version: " + _spiffs_version );
-  
-
-//  MDNS.begin( conf.hostname );
+  // Index the file system once so requests never have to scan it
+  _assets.build( _spiffs_version );
 
-  // HTTP callbacks bound to class member functions
-  server.on("/",         HTTP_GET,  std::bind(&Webserver::handleWebRequests, this));
-  server.on("/config",   HTTP_GET,  std::bind(&Webserver::jsonConfigData, this));
-  server.on("/network",  HTTP_POST, std::bind(&Webserver::processNetworkSettings, this));
-  server.on("/reset",    HTTP_POST, std::bind(&Webserver::processConfigReset, this));
-  server.on("/sensors",  HTTP_GET,  std::bind(&Webserver::jsonSensorData, this));
-  server.on("/settings", HTTP_POST, std::bind(&Webserver::processSettings, this));
-  server.on("/webupdate", HTTP_POST, std::bind(&Webserver::runWebUpdate, this));
-  server.onNotFound(std::bind( &Webserver::handleWebRequests, this));
+  _delta.begin();
+  _next_fw_check = millis() + update_check_delay();
 
-  // Attach the OTA update service
-  _httpUpdater.setup(&server, HTTP_OTA_UPDATE_PATH, HTTP_AUTH_USER, _config->conf.http_pw);
+  LOG_INFO( LOG_WEB, "HTTP init, hostname: %s  port: %u", _config->conf.hostname, _config->conf.http_server_port );
+  LOG_INFO( LOG_WEB, "SPIFFS version: %s", _spiffs_version.c_str() );
   
+  // Discoverable with the firmware/SPIFFS versions and readings
+  _net->advertise( _sensor, DEFAULT_HTTP_PORT, _spiffs_version );
+
+  // HTTP callbacks bound to class member functions.  These run from the
+  // TCP stack, anything slow or blocking is deferred to loop().
+  server.on("/",         HTTP_GET,  std::bind(&Webserver::handleWebRequests, this, _1));
+  server.on("/alerts",   HTTP_GET,  std::bind(&Webserver::jsonAlertData, this, _1));
+  server.on("/archive",  HTTP_GET,  std::bind(&Webserver::archiveExport, this, _1));
+  server.on("/calibration", HTTP_GET,  std::bind(&Webserver::jsonCalibrationData, this, _1));
+  server.on("/calibration", HTTP_POST, std::bind(&Webserver::processCalibration, this, _1));
+  server.on("/capture",  HTTP_GET,  std::bind(&Webserver::captureExport, this, _1));
+  server.on("/config",   HTTP_GET,  std::bind(&Webserver::jsonConfigData, this, _1));
+  server.on("/debug/crash", HTTP_GET, std::bind(&Webserver::jsonCrashData, this, _1));
+  server.on("/health",   HTTP_GET,  std::bind(&Webserver::jsonHealthData, this, _1));
+  server.on("/log",      HTTP_GET,  std::bind(&Webserver::logLines, this, _1));
+  server.on("/power",    HTTP_GET,  std::bind(&Webserver::jsonPowerData, this, _1));
+  server.on("/network",  HTTP_POST, std::bind(&Webserver::processNetworkSettings, this, _1));
+  server.on("/reset",    HTTP_POST, std::bind(&Webserver::processConfigReset, this, _1));
+  server.on("/sensors",  HTTP_GET,  std::bind(&Webserver::jsonSensorData, this, _1));
+  server.on("/settings", HTTP_POST, std::bind(&Webserver::processSettings, this, _1));
+  server.on("/webupdate", HTTP_POST, std::bind(&Webserver::runWebUpdate, this, _1));
+  server.onNotFound(std::bind( &Webserver::handleWebRequests, this, _1));
+
+  // OTA update service
+  server.on(HTTP_OTA_UPDATE_PATH, HTTP_GET, std::bind(&Webserver::firmwareForm, this, _1));
+  server.on(HTTP_OTA_UPDATE_PATH, HTTP_POST, std::bind(&Webserver::firmwareDone, this, _1),
+            std::bind(&Webserver::firmwareUpload, this, _1, _2, _3, _4, _5, _6));
+
   server.begin();
 }
 
 
 void Webserver::loop() {
-  // Handle any HTTP Requests
-  server.handleClient();
+  // HTTP requests are handled by the async server, only the
+  // work handlers deferred to us is done here.
+
+  if ( _pending_settings ) {
+    // Save the running config.  The subsystems apply the changes
+    // themselves when Config::loop() notifies them.
+    _pending_settings = false;
+    _config->writeConfig();
+  }
+
+  if ( _pending_reset && millis() > _pending_reset_at ) {
+    // Write defaults to the config
+    _config->resetConfig();
+
+    // Restart
+    Log.flush();
+    Diag.mark( DIAG_RESTART );
+    ESP.restart();
+  }
+
+  if ( _pending_restart && millis() > _pending_restart_at ) {
+    LOG_INFO( LOG_WEB, "Firmware updated, restarting..." );
+    Log.flush();
+    Diag.mark( DIAG_RESTART );
+    ESP.restart();
+  }
 
   if (millis() > _next_fw_check) {   // Time to check for updated files
-    _next_fw_check = millis() + _fw_check_interval;
+    check_for_updates();
+    _next_fw_check = millis() + update_check_delay();
+  }
+}
+
+
+// Time until this device's update slot.  With the wall clock the slot is
+// at the same time every day, so restarts don't move it.  Without it the
+// offset is counted from boot, and has to fall before the MAX_RUNTIME
+// restart or the check would never come round.
+unsigned long Webserver::update_check_delay() {
+  if ( !_clock->valid() )
+    return ( _delta.jitter( FW_CHECK_NO_CLOCK ) + 60 ) * 1000UL;
+
+  const uint32_t interval = FW_CHECK_INTERVAL * 1000UL;
+  uint32_t       offset   = _delta.jitter( FW_CHECK_INTERVAL ) * 1000UL;
+  uint32_t       wait     = ( _clock->millis_until( FW_CHECK_INTERVAL ) + offset ) % interval;
+  return ( wait < 1000 ) ? wait + interval : wait;
+}
+
+
+// Manifest driven update of changed files and the firmware.  Servers
+// that don't publish a manifest get the whole-image SPIFFS check.
+void Webserver::check_for_updates() {
+  LOG_INFO( LOG_UPDATE, "Checking for updates" );
+
+  int ret = _delta.check();
+
+  if ( ret & DELTA_NO_MANIFEST ) {
     check_for_spiffs_update();
+    return;
+  }
+
+  if ( ret & DELTA_FILES_UPDATED ) {
+    // The file system changed underneath us, re-index it
+    _spiffs_version = get_spiffs_version();
+    _assets.build( _spiffs_version );
+  }
+
+  if ( ret & DELTA_FW_UPDATED ) {
+    _pending_restart_at = millis() + 1000;
+    _pending_restart    = true;
   }
 }
 
 
 void Webserver::check_for_fwupdate() {
-  Serial.println("[Webserver] checking for Firmware updates");
+  LOG_INFO( LOG_UPDATE, "Checking for firmware updates" );
 
   t_httpUpdate_return ret = ESPhttpUpdate.update(UPDATE_URL, INO_VERSION);
 //  ret = ESPhttpUpdate.updateSpiffs(UPDATE_URL, INO_VERSION);
 
   switch (ret) {
     case HTTP_UPDATE_FAILED:
-      Serial.printf("[Webserver] HTTP update failed.  Error (%d): %s\n", 
+      LOG_ERROR( LOG_UPDATE, "HTTP update failed.  Error (%d): %s",
           ESPhttpUpdate.getLastError(),
           ESPhttpUpdate.getLastErrorString().c_str());
       break;
 
     case HTTP_UPDATE_NO_UPDATES:
-      Serial.println("[Webserver] No remote update found.");
+      LOG_INFO( LOG_UPDATE, "No remote update found" );
       break;
 
     case HTTP_UPDATE_OK:
-      Serial.println("[Webserver] Remote Firmware update succeeded!");
+      LOG_INFO( LOG_UPDATE, "Remote firmware update succeeded" );
       break;
   }
 
@@ -97,12 +194,12 @@ String Webserver::get_spiffs_version() {
   File versionFile = SPIFFS.open("/version.txt", "r");
 
   if (!versionFile) {
-    Serial.println("[Webserver] Failed to open /version.txt, unknown SPIFFS version!");
+    LOG_WARN( LOG_WEB, "Failed to open /version.txt, unknown SPIFFS version" );
     return String("");
   }
 
   if (versionFile.size() > 25) {
-    Serial.println("[Webserver] /version.txt is too large!");
+    LOG_WARN( LOG_WEB, "/version.txt is too large" );
     return String("");
   }
 
@@ -111,109 +208,186 @@ String Webserver::get_spiffs_version() {
 }
 
 void Webserver::check_for_spiffs_update() {
-  Serial.println("[Webserver] checking for SPIFFS updates");
+  LOG_INFO( LOG_UPDATE, "Checking for SPIFFS updates" );
 
   t_httpUpdate_return ret = ESPhttpUpdate.updateSpiffs(UPDATE_URL, String(INO_VERSION) + ":" + _spiffs_version);
 //  ret = ESPhttpUpdate.updateSpiffs(UPDATE_URL, INO_VERSION);
 
   switch (ret) {
     case HTTP_UPDATE_FAILED:
-      Serial.printf("[Webserver] HTTP SPIFFS update failed.  Error (%d): %s\n", 
+      LOG_ERROR( LOG_UPDATE, "HTTP SPIFFS update failed.  Error (%d): %s",
           ESPhttpUpdate.getLastError(),
           ESPhttpUpdate.getLastErrorString().c_str());
       break;
 
     case HTTP_UPDATE_NO_UPDATES:
-      Serial.println("[Webserver] No remote SPIFFS update found.");
+      LOG_INFO( LOG_UPDATE, "No remote SPIFFS update found" );
       break;
 
     case HTTP_UPDATE_OK:
-      Serial.println("[Webserver] Remote SPIFFS update succeeded!");
+      LOG_INFO( LOG_UPDATE, "Remote SPIFFS update succeeded" );
+
+      // The file system changed underneath us, re-index it
+      _spiffs_version = get_spiffs_version();
+      _assets.build( _spiffs_version );
       break;
   }
 
 }
 
 
-void Webserver::handleWebRequests() {
-  Serial.println( "[Webserver] handleWebRequests: " +  server.uri() );
+void Webserver::handleWebRequests( AsyncWebServerRequest *request ) {
+  LOG_DEBUG( LOG_WEB, "handleWebRequests: %s", request->url().c_str() );
 
-  if ( authRequired() ) return;  // Page requires authentication
+  // Someone's using the UI, keep the radio responsive for them
+  _net->wake( NET_WAKE_INTERACTIVE );
 
-  if ( loadFromSpiffs( server.uri() ) ) return;
-  
-  String message = "File Not Detected\n\n";
-  message += "URI: ";
-  message += server.uri();
-  message += "\nMethod: ";
-  message += ( server.method() == HTTP_GET ) ? "GET" : "POST";
-  message += "\nArguments: ";
-  message += server.args();
-  message += "\n";
-  for ( uint8_t i = 0; i < server.args(); i++ ) {
-    message += " NAME:" + server.argName(i) + "\n VALUE:" + server.arg(i) + "\n";
+  // Unknown paths get a 404 straight from the index, without
+  // authenticating or touching the file system.
+  if ( loadFromSpiffs( request, request->url() ) ) return;
+
+  // No UI on SPIFFS (never uploaded, or lost), the built in copy will do
+  if ( request->url() == "/" || request->url() == "/index.html" ) {
+    if ( authRequired( request ) ) return;  // Page requires authentication
+    builtinUI( request );
+    return;
   }
-  server.send( 404, "text/plain", message );
-  Serial.println( message );
+
+  request->send( 404, "text/plain", "File Not Found" );
+}
+
+
+// The page tools/build_ui.py put in WebUI.h, already gzipped
+void Webserver::builtinUI( AsyncWebServerRequest *request ) {
+  if ( request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == WEBUI_ETAG ) {
+    AsyncWebServerResponse *response = request->beginResponse( 304 );
+    response->addHeader( "ETag", WEBUI_ETAG );
+    request->send( response );
+    return;
+  }
+
+  AsyncWebServerResponse *response = request->beginResponse_P( 200, "text/html", WEBUI_GZ, sizeof(WEBUI_GZ) );
+  response->addHeader( "Content-Encoding", "gzip" );
+  response->addHeader( "ETag", WEBUI_ETAG );
+  response->addHeader( "Cache-Control", "no-cache" );
+  request->send( response );
 }
 
 
 // Respond to a web client request
-void Webserver::httpReturn(uint16_t httpcode, String mimetype, String content) {
-  server.sendHeader("Connection", "close");
-  server.sendHeader("Access-Control-Allow-Origin", "*");
-  server.send(httpcode, mimetype, content);
+void Webserver::httpReturn(AsyncWebServerRequest *request, uint16_t httpcode, String mimetype, String content) {
+  AsyncWebServerResponse *response = request->beginResponse(httpcode, mimetype, content);
+  response->addHeader("Connection", "close");
+  response->addHeader("Access-Control-Allow-Origin", "*");
+  request->send(response);
 }
 
 
 // Handle loading a file from the local file system (SPIFFS)
-bool Webserver::loadFromSpiffs( String path ){
-  String dataType = "text/plain";
+// Returns false, without sending anything, if the file isn't in the index.
+// The file is streamed in chunks as the client acknowledges data, so
+// a slow download doesn't hold up other connections.
+bool Webserver::loadFromSpiffs( AsyncWebServerRequest *request, String path ){
+  bool source = false;
+
   if (path.endsWith("/")) path += "index.html";
- 
-  if (path.endsWith(".src")) path = path.substring(0, path.lastIndexOf("."));
-  else if (path.endsWith(".html")) dataType = "text/html";
-  else if (path.endsWith(".htm")) dataType = "text/html";
-  else if (path.endsWith(".css")) dataType = "text/css";
-  else if (path.endsWith(".js")) dataType = "application/javascript";
-  else if (path.endsWith(".png")) dataType = "image/png";
-  else if (path.endsWith(".gif")) dataType = "image/gif";
-  else if (path.endsWith(".jpg")) dataType = "image/jpeg";
-  else if (path.endsWith(".ico")) dataType = "image/x-icon";
-  else if (path.endsWith(".xml")) dataType = "text/xml";
-  else if (path.endsWith(".pdf")) dataType = "application/pdf";
-  else if (path.endsWith(".zip")) dataType = "application/zip";
-
-  Serial.println("[Webserver] loadFromSpiffs path:" + path + " dataType: " + dataType);
-  
-  File dataFile = SPIFFS.open(path.c_str(), "r");
-  if (server.hasArg("download")) dataType = "application/octet-stream";
-  if (server.streamFile(dataFile, dataType) != dataFile.size()) {
-    Serial.println("[Webserver] loadFromSpiffs != dataFile.size()" );
+
+  if (path.endsWith(".src")) {
+    path   = path.substring(0, path.lastIndexOf("."));
+    source = true;
+  }
+
+  const asset *entry = _assets.find( path.c_str() );
+  if ( !entry ) return false;
+
+  if ( authRequired( request ) ) return true;  // Page requires authentication
+
+  // Client already has this version cached
+  char etag[11];
+  sprintf( etag, "\"%08x\"", (unsigned int)entry->etag );
+  if ( request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == etag ) {
+    AsyncWebServerResponse *response = request->beginResponse( 304 );
+    response->addHeader( "ETag", etag );
+    request->send( response );
+    return true;
+  }
+
+  bool download = request->hasParam("download");
+  const char *dataType = _assets.mime( source ? MIME_PLAIN : entry->mime );
+
+  String file_path = path;
+  if ( entry->gzip ) file_path += ".gz";
+
+  LOG_DEBUG( LOG_WEB, "loadFromSpiffs path: %s  dataType: %s", file_path.c_str(), dataType );
+
+  if ( !SPIFFS.exists( file_path ) ) {
+    // Index is stale (file removed since it was built)
+    request->send( 404, "text/plain", "File Not Found" );
+    return true;
   }
- 
-  dataFile.close();
+
+  AsyncWebServerResponse *response = request->beginResponse( SPIFFS, file_path, dataType, download );
+  if ( entry->gzip && !download ) response->addHeader( "Content-Encoding", "gzip" );
+  response->addHeader( "ETag", etag );
+  response->addHeader( "Cache-Control", "no-cache" );
+  request->send( response );
+
   return true;
 }
 
 
 // GET /config
-// Return a JSON string of the current settings
-void Webserver::jsonConfigData() {
-  if ( authRequired() ) return;  // Page requires authentication
+// Return a JSON string (or CBOR) of the current settings
+void Webserver::jsonConfigData( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  if ( wantsCbor( request ) ) {
+    AsyncResponseStream *response = cborResponse( request, CBOR_CONFIG_SIZE );
+    CborWriter           cbor( *response );
+
+    _config->CBOR( cbor, WiFi.macAddress() );
+    cborReturn( request, response, cbor );
+    return;
+  }
     
-  String jsonstr = _config->JSON( String(WiFi.macAddress()) );
-  
-  httpReturn(200, "application/json", jsonstr);
+  // Written straight into the response, no String in between
+  AsyncResponseStream *response = request->beginResponseStream( "application/json", CONFIG_JSON_SIZE );
+  _config->JSON( *response, WiFi.macAddress() );
+  response->addHeader( "Access-Control-Allow-Origin", "*" );
+  request->send( response );
+}
+
+
+// Hand each posted field to the config by name, the table in Config
+// decides what it is and whether it's valid.  A form is taken whole or
+// not at all: on a rejected field the config is put back as it was
+// and the client gets a 400 naming it.
+bool Webserver::bindForm( AsyncWebServerRequest *request, byte form ) {
+  Config::snapshot *before = new Config::snapshot;   // Too big for the TCP stack
+  bool              ok     = true;
+
+  _config->save( *before );
+
+  for ( size_t i = 0; i < request->params() && ok; i++ ) {
+    AsyncWebParameter *param = request->getParam( i );
+    if ( _config->set( param->name().c_str(), param->value().c_str(), form ) ) continue;
 
+    LOG_WARN( LOG_WEB, "Rejected %s", param->name().c_str() );
+    _config->restore( *before );
+    httpReturn( request, 400, "text/plain", String("Bad value for ") + param->name() );
+    ok = false;
+  }
+
+  delete before;
+  return ok;
 }
 
-bool Webserver::authRequired() {
+bool Webserver::authRequired( AsyncWebServerRequest *request ) {
   // TEST_MODE disabled authentication
   if ( TEST_MODE ) return false;
 
-  if ( !server.authenticate( HTTP_AUTH_USER, _config->conf.http_pw ) ) {
-    server.requestAuthentication( DIGEST_AUTH, auth_realm, auth_fail_response );
+  if ( !request->authenticate( HTTP_AUTH_USER, _config->conf.http_pw ) ) {
+    request->requestAuthentication( auth_realm, true );
     return true;
   }
   return false;
@@ -221,101 +395,376 @@ bool Webserver::authRequired() {
 
 
 
+// GET /archive
+// Stream an archive tier (website/archive.py decodes it).  The file is
+// read a piece at a time as the client takes it.
+void Webserver::archiveExport( AsyncWebServerRequest *request ) {
+  int tier = request->hasArg("tier") ? request->arg("tier").toInt() : ARCHIVE_TIER_RAW;
+  if ( tier < 0 || tier >= ARCHIVE_TIERS ) {
+    httpReturn( request, 400, "text/plain", "Unknown tier" );
+    return;
+  }
+
+  Archive *archive = _archive;
+  AsyncWebServerResponse *response = request->beginResponse( "application/octet-stream", archive->size( tier ),
+    [archive, tier]( uint8_t *buffer, size_t maxLen, size_t index ) -> size_t {
+      return archive->read( tier, buffer, maxLen, index );
+    });
+  response->addHeader( "Content-Disposition", "attachment; filename=archive" + String(tier) + ".rrd" );
+  response->addHeader( "Access-Control-Allow-Origin", "*" );
+  request->send( response );
+}
+
+
+// GET /capture
+// The last burst capture (website/capture.py decodes it), or with
+// ?status the trigger state and counters.  The window is copied into
+// the response here, a capture starting mid-download can't change it.
+void Webserver::captureExport( AsyncWebServerRequest *request ) {
+  if ( request->hasArg("status") ) {
+    httpReturn( request, 200, "application/json", _capture->JSON() );
+    return;
+  }
+
+  size_t size = _capture->size();
+  if ( size == 0 ) {
+    httpReturn( request, 404, "text/plain", "No capture" );
+    return;
+  }
+
+  AsyncResponseStream *response = request->beginResponseStream( "application/octet-stream", size );
+  response->write( _capture->data(), size );
+  response->addHeader( "Content-Disposition", "attachment; filename=capture" + String( _capture->seq() ) + ".bin" );
+  response->addHeader( "Access-Control-Allow-Origin", "*" );
+  request->send( response );
+}
+
+
+// GET /log
+// Recent log lines as text.  Pass the X-Log-Next header of the last
+// response back as ?since= to get only what was written after it.
+void Webserver::logLines( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  uint32_t since = request->hasArg("since") ? strtoul( request->arg("since").c_str(), NULL, 10 ) : 0;
+  uint32_t next;
+
+  AsyncWebServerResponse *response = request->beginResponse( 200, "text/plain", Log.lines( since, next ) );
+  response->addHeader( "X-Log-Next", String( next ) );
+  response->addHeader( "Cache-Control", "no-cache" );
+  request->send( response );
+}
+
+
+// GET /power
+// Radio power save state with its estimated current and reply
+// latency, and how the DB batching is doing, for tuning the two
+void Webserver::jsonPowerData( AsyncWebServerRequest *request ) {
+  httpReturn( request, 200, "application/json",
+              "{\"radio\": " + _net->powerJSON() + ", \"db\": " + _db->statsJSON() + "}" );
+}
+
+
+// GET /alerts
+// Alert rules with where each stands, and the webhook's counters
+void Webserver::jsonAlertData( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  httpReturn( request, 200, "application/json", _alerts->JSON() );
+}
+
+
+// GET /calibration
+// Each channel's table with the current raw reading and what it
+// calibrates to
+void Webserver::jsonCalibrationData( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  httpReturn( request, 200, "application/json", _sensor->calibrationJSON() );
+}
+
+
+// GET /debug/crash
+// Why the last boot ended (reset reason, the part of loop() it was in,
+// exception registers and stack) and heap low points by subsystem
+void Webserver::jsonCrashData( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  httpReturn( request, 200, "application/json", Diag.JSON() );
+}
+
+
+// GET /health
+// Sensor health: failure rate, rejected readings, resets and the
+// current (adaptive) poll interval
+void Webserver::jsonHealthData( AsyncWebServerRequest *request ) {
+  httpReturn( request, 200, "application/json", _sensor->healthJSON() );
+}
+
+
 // GET /sensors
-// Return Sensor Values in a JSON string
-void Webserver::jsonSensorData() {
-  String jsonstr = "{\"hum\": " + String(_sensor->get_humidity()) + 
-                   ", \"hidx\": " + String(_sensor->get_hindex()) + 
-                   ", \"temp\": " + String(_sensor->get_temp()) +
-                   ", \"analog\": " + String(_sensor->get_analog()) +
-                   ", \"pressure\": " + String(_sensor->get_pressure()) + "}";
-  httpReturn(200, "application/json", jsonstr);
+// Return Sensor Values in a JSON string, or as CBOR for pollers
+// that ask for it (Accept: application/cbor or ?fmt=cbor)
+void Webserver::jsonSensorData( AsyncWebServerRequest *request ) {
+  _net->wake( NET_WAKE_INTERACTIVE );
+
+  if ( wantsCbor( request ) ) {
+    const sensor_sample &sample   = _sensor->get_sample();
+    AsyncResponseStream *response = cborResponse( request, CBOR_SENSORS_SIZE );
+    CborWriter           cbor( *response );
+
+    // Only the derived metrics that are enabled are included
+    byte extra = 0;
+    if ( sample.derived & DERIVED_DEWPOINT )     extra++;
+    if ( sample.derived & DERIVED_ABS_HUMIDITY ) extra++;
+    if ( sample.derived & DERIVED_VPD )          extra++;
+
+    // Readings are fixed point, value * SENSOR_FIXED_SCALE
+    cbor.map( 7 + extra );
+    cbor.uint( SENSOR_KEY_SEQ );       cbor.uint( sample.seq );
+    cbor.uint( SENSOR_KEY_TIMESTAMP ); cbor.uint( sample.timestamp );
+    cbor.uint( SENSOR_KEY_TEMP );      cbor.fixed( sample.temp, sample.valid );
+    cbor.uint( SENSOR_KEY_HUMIDITY );  cbor.fixed( sample.humidity, sample.valid );
+    cbor.uint( SENSOR_KEY_HINDEX );    cbor.fixed( sample.hindex, sample.valid && ( sample.derived & DERIVED_HINDEX ) );
+    cbor.uint( SENSOR_KEY_ANALOG );    cbor.fixed( sample.analog, sample.analog_valid );
+    cbor.uint( SENSOR_KEY_PRESSURE );  cbor.fixed( sample.pressure, sample.analog_valid );
+
+    if ( sample.derived & DERIVED_DEWPOINT )     { cbor.uint( SENSOR_KEY_DEWPOINT ); cbor.fixed( sample.dewpoint, sample.valid ); }
+    if ( sample.derived & DERIVED_ABS_HUMIDITY ) { cbor.uint( SENSOR_KEY_ABS_HUM );  cbor.fixed( sample.abs_humidity, sample.valid ); }
+    if ( sample.derived & DERIVED_VPD )          { cbor.uint( SENSOR_KEY_VPD );      cbor.fixed( sample.vpd, sample.valid ); }
+
+    cborReturn( request, response, cbor );
+    return;
+  }
+
+  // Polled by every open UI, so built in place in one allocation
+  String jsonstr;
+  jsonstr.reserve( 160 );
+  jsonstr += "{\"hum\": ";        jsonstr += _sensor->get_humidity();
+  jsonstr += ", \"hidx\": ";      jsonstr += _sensor->get_hindex();
+  jsonstr += ", \"temp\": ";      jsonstr += _sensor->get_temp();
+  jsonstr += ", \"analog\": ";    jsonstr += _sensor->get_analog();
+  jsonstr += ", \"pressure\": ";  jsonstr += _sensor->get_pressure();
+
+  const sensor_sample &sample = _sensor->get_sample();
+  char buf[16];
+  if ( sample.valid ) {
+    if ( sample.derived & DERIVED_DEWPOINT )     { jsonstr += ", \"dewpt\": ";  jsonstr += Sensor::format_fixed( sample.dewpoint, buf ); }
+    if ( sample.derived & DERIVED_ABS_HUMIDITY ) { jsonstr += ", \"abshum\": "; jsonstr += Sensor::format_fixed( sample.abs_humidity, buf ); }
+    if ( sample.derived & DERIVED_VPD )          { jsonstr += ", \"vpd\": ";    jsonstr += Sensor::format_fixed( sample.vpd, buf ); }
+  }
+  jsonstr += "}";
+  httpReturn(request, 200, "application/json", jsonstr);
 }
 
 
+// True if the client asked for the binary (CBOR) representation
+bool Webserver::wantsCbor( AsyncWebServerRequest *request ) {
+  if ( request->hasParam("fmt") && request->getParam("fmt")->value() == "cbor" )
+    return true;
 
-// POST /reset
-void Webserver::processConfigReset() {
-  if ( authRequired() ) return;  // Page requires authentication
+  if ( request->hasHeader("Accept") && request->getHeader("Accept")->value().indexOf( CBOR_MIME ) >= 0 )
+    return true;
+
+  return false;
+}
+
+
+// CBOR is encoded straight into the response, not through a buffer
+// on the handler's stack
+AsyncResponseStream* Webserver::cborResponse( AsyncWebServerRequest *request, size_t size ) {
+  AsyncResponseStream *response = request->beginResponseStream( CBOR_MIME, size );
+  response->addHeader( "Access-Control-Allow-Origin", "*" );
+  response->addHeader( "Vary", "Accept" );
+  return response;
+}
 
-  // Delay to give the user a chance to pull the plug
-  for (int x=5; x>0; x--) {
-    Serial.println("[RESET REQUEST] Clearing config in " + String(x) + "...Reset to stop");
-    delay(1000);
+void Webserver::cborReturn( AsyncWebServerRequest *request, AsyncResponseStream *response, CborWriter &cbor ) {
+  if ( cbor.overflow() ) {
+    delete response;
+    httpReturn( request, 500, "text/plain", "CBOR Buffer Overflow" );
+    return;
   }
 
-  // Write defaults to the config
-  _config->resetConfig();
-  
-  httpReturn(200, "application/json", "{\"status\": \"ok\"}");
+  request->send( response );
+}
+
+
 
-  // Restart
-  ESP.restart();
+// POST /reset
+void Webserver::processConfigReset( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  // Give the user a chance to pull the plug, loop() does the actual reset
+  LOG_WARN( LOG_WEB, "Reset request, clearing config in 5...Reset to stop" );
+  _pending_reset_at = millis() + 5000;
+  _pending_reset    = true;
+
+  httpReturn(request, 200, "application/json", "{\"status\": \"ok\"}");
 }
 
 
 // POST /settings
-void Webserver::processSettings() {
-  if ( authRequired() ) return;  // Page requires authentication
+void Webserver::processSettings( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
 
-  // Update config with values from form
-  if ( server.hasArg("db_type") )        _config->set( CONFIG_DB_TYPE,         server.arg("db_type") );
-  if ( server.hasArg("db_host") )        _config->set( CONFIG_DB_HOST,         server.arg("db_host") );
-  if ( server.hasArg("db_port") )        _config->set( CONFIG_DB_PORT,         server.arg("db_port") );
-  if ( server.hasArg("db_name") )        _config->set( CONFIG_DB_NAME,         server.arg("db_name") );
-  if ( server.hasArg("db_measurement") ) _config->set( CONFIG_DB_MEASUREMENT,  server.arg("db_measurement") );
-  if ( server.hasArg("location") )       _config->set( CONFIG_LOCATION,        server.arg("location") );
-  if ( server.hasArg("interval") )       _config->set( CONFIG_SAMPLE_INTERVAL, server.arg("interval") );
+  // Update config with the fields posted, straight from the request
+  if ( !bindForm( request, CONFIG_FORM_SETTINGS ) ) return;
 
-  if ( server.hasArg("http_pw") )        _config->set( CONFIG_HTTP_PW,         server.arg("http_pw") );
-  if ( server.hasArg("t_offset") )       _config->set( CONFIG_T_OFFSET,        server.arg("t_offset") );
+  // Saving the config happens in loop()
+  _pending_settings = true;
 
-  _config->writeConfig();
+  // Success to the client.
+  httpReturn(request, 200, "application/json", "{\"status\": \"ok\"}");
 
-  // Tell the DB to re-init with new settings
-  _db->begin( _config, _sensor );
-  // TODO: move this into the db class
-//  send_to_db_interval = _config->conf.sample_interval * 1000;
-//  next_send_to_db = millis() + send_to_db_interval;
+}
 
-  // Success to the client.
-  httpReturn(200, "application/json", "{\"status\": \"ok\"}");
 
+// POST /calibration
+// Whole tables as cal_t, cal_h, cal_p ("raw:value,.."), and/or a
+// reference probe's reading as ref_t, ref_h, ref_p, which becomes a
+// point at the current raw reading.  A batch of units next to one
+// probe can be done without touching the tables by hand.
+void Webserver::processCalibration( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  static const char *refs[ CAL_CHANNELS ] = { "ref_t", "ref_h", "ref_p" };
+
+  // Check every reference before changing anything
+  int32_t raws[ CAL_CHANNELS ], values[ CAL_CHANNELS ];
+  bool    update[ CAL_CHANNELS ] = {};
+  for ( byte ch = 0; ch < CAL_CHANNELS; ch++ ) {
+    if ( !request->hasArg( refs[ch] ) ) continue;
+
+    String      arg = request->arg( refs[ch] );
+    const char *p   = arg.c_str();
+    int32_t     raw, value;
+    if ( !Sensor::parse_fixed( p, value ) || *p != '\0' ) {
+      httpReturn( request, 400, "text/plain", String("Bad value for ") + refs[ch] );
+      return;
+    }
+    if ( !_sensor->get_raw( ch, raw ) ) {
+      httpReturn( request, 400, "text/plain", String("No reading yet for ") + refs[ch] );
+      return;
+    }
+
+    raws[ch]   = raw;
+    values[ch] = value;
+    update[ch] = true;
+  }
+
+  if ( !bindForm( request, CONFIG_FORM_CALIBRATION ) ) return;
+
+  // A reference goes onto the table as posted with it
+  for ( byte ch = 0; ch < CAL_CHANNELS; ch++ ) {
+    if ( !update[ch] ) continue;
+    LOG_INFO( LOG_WEB, "Calibration point for %s", Calibration::channel_name( ch ) );
+
+    cal_table table = _config->conf.cal[ ch ];
+    Calibration::add_point( table, raws[ch], values[ch] );
+    _config->set( CONFIG_CAL_TEMP + ch, Calibration::format( table ).c_str() );
+  }
+
+  // Saving the config happens in loop()
+  _pending_settings = true;
+
+  httpReturn( request, 200, "application/json", "{\"status\": \"ok\"}" );
 }
 
 
 // POST /network
-void Webserver::processNetworkSettings() {
-  if ( authRequired() ) return;  // Page requires authentication
+void Webserver::processNetworkSettings( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
 
-  if (server.args() < 2) {
-    httpReturn(400, "text/html", "Missing Data");
+  if (request->args() < 2) {
+    httpReturn(request, 400, "text/html", "Missing Data");
     return;
   }
 
-  // Update config with values from form
-  _config->set( CONFIG_SSID, server.arg("ssid") );
-  _config->set( CONFIG_HOSTNAME, server.arg("hostname") );
-
-  // Only change the wifi password if one was passed
-  if ( server.arg("wifi_pw").length() > 0 )
-    _config->set( CONFIG_WIFI_PW, server.arg("wifi_pw") );
+  // Update config with values from form.  The wifi password is only
+  // changed if one was passed.
+  if ( !bindForm( request, CONFIG_FORM_NETWORK ) ) return;
 
   // Success to the client.
-  httpReturn( 200, "application/json", "{\"status\": \"ok\"}" );
+  httpReturn( request, 200, "application/json", "{\"status\": \"ok\"}" );
 
-  // Save the running config
-  _config->writeConfig();
+  // Saved in loop(), Network reconnects when it's told about the change
+  _pending_settings = true;
+}
+
+void Webserver::runWebUpdate( AsyncWebServerRequest *request ) {
+}
 
-  // Wait a bit before disconnecting/reconnecting
-  delay(2000);
 
-  // Disconnect the wifi and re-run the setup routine
-  WiFi.disconnect( true );
-  setup();
+// GET /firmware
+void Webserver::firmwareForm( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  request->send_P( 200, "text/html", _update_form );
 }
 
-void Webserver::runWebUpdate() {
+
+// POST /firmware, called once the upload is complete
+void Webserver::firmwareDone( AsyncWebServerRequest *request ) {
+  if ( authRequired( request ) ) return;  // Page requires authentication
+
+  // Only an image that was written and verified to the end
+  bool ok = _upload_ok && !Update.hasError() && Update.isFinished();
+  _upload_ok = false;
+
+  if ( !ok ) {
+    httpReturn( request, 500, "text/plain", "Update Failed" );
+    return;
+  }
+
+  httpReturn( request, 200, "text/plain", "Update Success! Rebooting..." );
+
+  // Restart once the response has gone out
+  _pending_restart_at = millis() + 1000;
+  _pending_restart    = true;
 }
 
 
+// POST /firmware, called for every chunk of the uploaded image
+void Webserver::firmwareUpload( AsyncWebServerRequest *request, String filename, size_t index,
+                                uint8_t *data, size_t len, bool final ) {
+  if ( index == 0 ) {
+    if ( !TEST_MODE && !request->authenticate( HTTP_AUTH_USER, _config->conf.http_pw ) ) return;
+
+    // An upload that was dropped part way never got to its end()
+    if ( _uploading || Update.isRunning() ) {
+      LOG_WARN( LOG_UPDATE, "Abandoning an unfinished firmware upload" );
+      Update.end();
+    }
+
+    LOG_INFO( LOG_UPDATE, "Firmware upload: %s", filename.c_str() );
+    _uploading = true;
+    _upload_ok = false;
+
+    uint32_t max_size = ( ESP.getFreeSketchSpace() - 0x1000 ) & 0xFFFFF000;
+    Update.runAsync( true );
+    if ( !Update.begin( max_size ) ) {
+      LOG_ERROR( LOG_UPDATE, "Update.begin failed: %u", Update.getError() );
+      _uploading = false;
+      return;
+    }
+  }
+
+  if ( !_uploading ) return;
+
+  if ( Update.write( data, len ) != len ) {
+    LOG_ERROR( LOG_UPDATE, "Firmware upload failed at %u bytes: %u", index, Update.getError() );
+    Update.end();
+    _uploading = false;
+    return;
+  }
+
+  if ( final ) {
+    _uploading = false;
+    _upload_ok = Update.end( true );
+    if ( _upload_ok )
+      LOG_INFO( LOG_UPDATE, "Firmware upload complete: %u bytes", index + len );
+    else
+      LOG_ERROR( LOG_UPDATE, "Firmware upload failed: %u", Update.getError() );
+  }
+}
@@ -6,15 +6,39 @@
 #ifndef Webserver_h
 #define Webserver_h
 
-#include <ESP8266HTTPUpdateServer.h>
+#include <ESPAsyncWebServer.h>
 #include <ESP8266HTTPClient.h>
 
 #include "defaults.h"
 #include "Config.h"
 #include "Sensor.h"
 #include "DB.h"
+#include "Network.h"
+#include "Clock.h"
+#include "Archive.h"
+#include "Alerts.h"
+#include "Capture.h"
+#include "AssetIndex.h"
+#include "DeltaUpdate.h"
+#include "Cbor.h"
 
-#define FW_CHECK_INTERVAL 60*60*24
+#define FW_CHECK_INTERVAL 60*60*24    // Seconds, each device checks at its own offset in the day
+#define FW_CHECK_NO_CLOCK ( MAX_RUNTIME / 1000 / 4 * 3 )  // Seconds, the spread without the clock: inside one run
+#define CBOR_SENSORS_SIZE 64     // Response buffers for the CBOR replies, grown if need be
+#define CBOR_CONFIG_SIZE  512
+#define CONFIG_JSON_SIZE  1024   // Response buffer for /config
+
+// Keys of the /sensors CBOR map
+#define SENSOR_KEY_SEQ        0
+#define SENSOR_KEY_TIMESTAMP  1
+#define SENSOR_KEY_TEMP       2
+#define SENSOR_KEY_HUMIDITY   3
+#define SENSOR_KEY_HINDEX     4
+#define SENSOR_KEY_ANALOG     5
+#define SENSOR_KEY_PRESSURE   6
+#define SENSOR_KEY_DEWPOINT   7
+#define SENSOR_KEY_ABS_HUM    8
+#define SENSOR_KEY_VPD        9
 
 
 //
@@ -24,38 +48,71 @@ class Webserver
   public:
     Webserver();
 
-    void begin( Config *config, Sensor *sensor, DB *db );
+    void begin( Config *config, Sensor *sensor, DB *db, Clock *clock, Archive *archive, Network *net, Alerts *alerts, Capture *capture );
     void loop();
-    bool loadFromSpiffs( String path );
+    bool loadFromSpiffs( AsyncWebServerRequest *request, String path );
+    void builtinUI( AsyncWebServerRequest *request );
 
     
   private:
     Config                   *_config;
     Sensor                   *_sensor;
     DB                       *_db;
-    ESP8266HTTPUpdateServer  _httpUpdater;  // OTA Update Service
+    Clock                    *_clock;
+    Archive                  *_archive;
+    Network                  *_net;
+    Alerts                   *_alerts;
+    Capture                  *_capture;
     HTTPClient               _client;
+    AssetIndex               _assets;       // Index of the files in SPIFFS
+    DeltaUpdate              _delta;
 
     const char* auth_realm    = "ESP8266 TempSensor";
     String auth_fail_response = "Authentication Failed";
 
     String _spiffs_version  = "";
-    int _fw_check_interval  = FW_CHECK_INTERVAL * 1000;
-    int _next_fw_check      = _fw_check_interval;
-    unsigned long _last_fw_check = 0;
-
-    bool authRequired();
-    void handleWebRequests();
-    void httpReturn(uint16_t httpcode, String mimetype, String content);
-    void jsonConfigData();
-    void jsonSensorData();
-    void processConfigReset();
-    void processSettings();
-    void processNetworkSettings();
+    unsigned long _next_fw_check = 0;
+
+    // Work requested by a handler that loop() has to carry out
+    bool _uploading          = false;
+    bool _upload_ok          = false;   // The last upload was written and verified
+    bool _pending_settings   = false;
+    bool _pending_reset      = false;
+    bool _pending_restart    = false;
+    unsigned long _pending_reset_at   = 0;
+    unsigned long _pending_restart_at = 0;
+
+    bool authRequired( AsyncWebServerRequest *request );
+    void handleWebRequests( AsyncWebServerRequest *request );
+    void httpReturn(AsyncWebServerRequest *request, uint16_t httpcode, String mimetype, String content);
+    bool wantsCbor( AsyncWebServerRequest *request );
+    AsyncResponseStream* cborResponse( AsyncWebServerRequest *request, size_t size );
+    void cborReturn( AsyncWebServerRequest *request, AsyncResponseStream *response, CborWriter &cbor );
+    void jsonAlertData( AsyncWebServerRequest *request );
+    void jsonCalibrationData( AsyncWebServerRequest *request );
+    void jsonConfigData( AsyncWebServerRequest *request );
+    void jsonSensorData( AsyncWebServerRequest *request );
+    void archiveExport( AsyncWebServerRequest *request );
+    void captureExport( AsyncWebServerRequest *request );
+    void logLines( AsyncWebServerRequest *request );
+    void jsonPowerData( AsyncWebServerRequest *request );
+    void jsonHealthData( AsyncWebServerRequest *request );
+    void jsonCrashData( AsyncWebServerRequest *request );
+    void processConfigReset( AsyncWebServerRequest *request );
+    void processSettings( AsyncWebServerRequest *request );
+    void processCalibration( AsyncWebServerRequest *request );
+    bool bindForm( AsyncWebServerRequest *request, byte form );
+    void processNetworkSettings( AsyncWebServerRequest *request );
+    void firmwareForm( AsyncWebServerRequest *request );
+    void firmwareDone( AsyncWebServerRequest *request );
+    void firmwareUpload( AsyncWebServerRequest *request, String filename, size_t index,
+                         uint8_t *data, size_t len, bool final );
     String get_spiffs_version();
     void check_for_fwupdate();
     void check_for_spiffs_update();
-    void runWebUpdate();
+    void check_for_updates();
+    unsigned long update_check_delay();
+    void runWebUpdate( AsyncWebServerRequest *request );
 };
 
 #endif
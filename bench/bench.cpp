@@ -0,0 +1,167 @@
+//
+// bench.cpp - Host benchmarks of the per-sample and per-request hot
+//             paths, run on the firmware's own code.  One JSON line per
+//             benchmark: time, heap allocations and bytes asked for,
+//             each per operation.
+//
+//   make run               all of them
+//   make run ONLY=urlencode
+//
+
+#include <chrono>
+#include <string>
+
+#include "Arduino.h"
+#include "Host.h"
+#include "FS.h"
+#include "ESPAsyncWebServer.h"
+
+#include "Config.h"
+#include "DB.h"
+#include "Derived.h"
+#include "AssetIndex.h"
+#include "Sensor.h"
+#include "Webserver.h"
+
+#define BENCH_TIME_NS  200000000ULL    // Each benchmark runs about this long
+
+extern Config         config;
+extern DB             db;
+extern Sensor         sensor;
+extern AsyncWebServer server;
+
+void setup();
+
+static const char *only = nullptr;
+
+// Keeps a result alive without the compiler seeing what's done with it
+static inline void keep( const void *p ) {
+  asm volatile( "" : : "g"( p ) : "memory" );
+}
+
+static uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+// Sized from a trial run to take about BENCH_TIME_NS
+template<typename F>
+static void bench( const char *name, F op ) {
+  if ( only && strcmp( only, name ) != 0 ) return;
+
+  op();   // Warm up, and anything done once is out of the way
+
+  uint64_t iterations = 1;
+  for ( ;; ) {
+    uint64_t start = now_ns();
+    for ( uint64_t i = 0; i < iterations; i++ ) op();
+    uint64_t took = now_ns() - start;
+    if ( took > BENCH_TIME_NS / 10 ) {
+      iterations = iterations * BENCH_TIME_NS / took + 1;
+      break;
+    }
+    iterations *= 10;
+  }
+
+  host::heap_stats before = host::heap;
+  uint64_t         start  = now_ns();
+  for ( uint64_t i = 0; i < iterations; i++ ) op();
+  uint64_t         took   = now_ns() - start;
+
+  printf( "{\"bench\": \"%s\", \"iterations\": %llu, \"ns_op\": %.1f, \"allocs_op\": %.2f, \"bytes_op\": %.1f}\n",
+          name, (unsigned long long)iterations, (double)took / iterations,
+          (double)( host::heap.allocs - before.allocs ) / iterations,
+          (double)( host::heap.bytes - before.bytes ) / iterations );
+  fflush( stdout );
+}
+
+// A small site, in the shapes the index sees on the device
+static void make_assets() {
+  static const char *files[] = {
+    "/index.html.gz", "/about.html", "/version.txt", "/css/style.css.gz", "/js/app.js.gz",
+    "/js/chart.min.js.gz", "/img/logo.png", "/img/icon.gif", "/favicon.ico", "/manifest.xml",
+    "/docs/manual.pdf", "/fonts/icons.woff"
+  };
+  for ( const char *name : files ) {
+    File f = SPIFFS.open( name, "w" );
+    f.print( name );
+    f.close();
+  }
+}
+
+// The request the server would hand the handler, parsed once
+static AsyncWebServerRequest* request( const char *text ) {
+  AsyncWebServerRequest *r   = new AsyncWebServerRequest();
+  std::string            raw = text;
+  r->parse( raw, &server );
+  return r;
+}
+
+// Run the handler and take the whole response out, as the server would
+static size_t serve( AsyncWebServerRequest *r ) {
+  static uint8_t buf[ 2920 ];
+  size_t         total = 0;
+
+  server.dispatch( r );
+  AsyncWebServerResponse *response = r->response();
+  total += response->head().length();
+  for ( size_t n; ( n = response->body( buf, sizeof(buf) ) ) != 0 && n != RESPONSE_TRY_AGAIN; ) total += n;
+  r->clearResponse();
+  return total;
+}
+
+int main( int argc, char **argv ) {
+  if ( argc > 1 ) only = argv[1];
+
+  host::quiet = true;
+  host::virtual_clock( 1000000 );
+
+  SPIFFS.begin();
+  make_assets();
+  setup();
+
+  // A few reads so there's a sample to serve
+  for ( int i = 0; i < 5; i++ ) {
+    host::advance( 10000000 );
+    sensor.loop();
+  }
+
+  const String plain   = "ambient";
+  const String special = "back porch, \"north\" = 1";
+  const String query   = "temp=72.50&loc=back porch/north&note=a+b=c";
+
+  bench( "influx_escape_plain",   [&] { String s = db.influx_escape( plain ); keep( &s ); } );
+  bench( "influx_escape_special", [&] { String s = db.influx_escape( special ); keep( &s ); } );
+  bench( "urlencode",             [&] { String s = db.urlencode( query ); keep( &s ); } );
+
+  String mac = WiFi.macAddress();
+  bench( "config_json", [&] {
+    AsyncResponseStream out( "application/json", CONFIG_JSON_SIZE );
+    config.JSON( out, mac );
+    keep( &out );
+  });
+
+  AssetIndex assets;
+  assets.build( "bench" );
+  static const char *paths[] = { "/index.html", "/js/app.js", "/img/logo.png", "/missing.html" };
+  size_t next = 0;
+  bench( "asset_mime", [&] {
+    const asset *a    = assets.find( paths[ next++ & 3 ] );
+    const char  *mime = assets.mime( a ? a->mime : MIME_PLAIN );
+    keep( mime );
+  });
+
+  AsyncWebServerRequest *sensors = request( "GET /sensors HTTP/1.1\r\nHost: bench\r\n\r\n" );
+  bench( "json_sensor_data", [&] { size_t n = serve( sensors ); keep( &n ); } );
+  delete sensors;
+
+  int32_t t = 7250;
+  bench( "derived_compute", [&] {
+    derived_metrics out;
+    Derived::compute( t, 4550, DERIVED_ALL, out );
+    t = ( t >= 11000 ) ? 3000 : t + 37;   // Across the table and outside it
+    keep( &out );
+  });
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+//
+// Arduino.h - Host shim for the parts of the ESP8266 Arduino core the
+//             firmware uses, so the real sources build and run on Linux
+//             for bench/ and tests/.  Hooks for driving it are in Host.h.
+//
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using std::min;
+using std::max;
+using std::isnan;
+using std::isinf;
+#endif
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+// Flash strings are plain memory here
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define PSTR(s)            (s)
+#define F(s)               (s)
+#define FPSTR(p)           (p)
+#define PGM_P              const char *
+
+#define pgm_read_byte(p)   (*(const uint8_t *)(p))
+#define pgm_read_word(p)   (*(const uint16_t *)(p))
+#define pgm_read_dword(p)  (*(const uint32_t *)(p))
+#define pgm_read_ptr(p)    (*(void * const *)(p))
+#define memcpy_P           memcpy
+#define memcmp_P           memcmp
+#define strcpy_P           strcpy
+#define strncpy_P          strncpy
+#define strcmp_P           strcmp
+#define strncmp_P          strncmp
+#define strlen_P           strlen
+#define strcasecmp_P       strcasecmp
+#define sprintf_P          sprintf
+#define snprintf_P         snprintf
+#define vsnprintf_P        vsnprintf
+
+#define constrain(amt, low, high)  ( (amt) < (low) ? (low) : ( (amt) > (high) ? (high) : (amt) ) )
+
+#define LOW          0
+#define HIGH         1
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+// NodeMCU pin names
+#define D0   16
+#define D1   5
+#define D2   4
+#define D3   0
+#define D4   2
+#define D5   14
+#define D6   12
+#define D7   13
+#define D8   15
+#define A0   17
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+unsigned long millis();
+unsigned long micros();
+void     delay( unsigned long ms );
+void     delayMicroseconds( unsigned int us );
+void     yield();
+
+void     pinMode( uint8_t pin, uint8_t mode );
+void     digitalWrite( uint8_t pin, uint8_t value );
+int      digitalRead( uint8_t pin );
+int      analogRead( uint8_t pin );
+
+char*    itoa( int value, char *buf, int base );
+char*    ltoa( long value, char *buf, int base );
+char*    utoa( unsigned int value, char *buf, int base );
+char*    ultoa( unsigned long value, char *buf, int base );
+char*    dtostrf( double value, signed char width, unsigned char prec, char *buf );
+
+#ifdef __cplusplus
+}
+
+long random( long howbig );
+long random( long howsmall, long howbig );
+void randomSeed( unsigned long seed );
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+#endif
+
+#endif
@@ -0,0 +1,28 @@
+//
+// DHT.cpp - Host shim of the Adafruit DHT library
+//
+
+#include "DHT.h"
+#include "Host.h"
+
+// A steady room when nothing's hooked in
+static bool reading( float &temp_f, float &humidity ) {
+  if ( host::dht ) return host::dht( temp_f, humidity );
+  temp_f   = 72.5f;
+  humidity = 45.0f;
+  return true;
+}
+
+float DHT::readTemperature( bool S, bool force ) {
+  (void)force;
+  float temp_f, humidity;
+  if ( !reading( temp_f, humidity ) ) return NAN;
+  return S ? temp_f : ( temp_f - 32 ) / 1.8f;
+}
+
+float DHT::readHumidity( bool force ) {
+  (void)force;
+  float temp_f, humidity;
+  if ( !reading( temp_f, humidity ) ) return NAN;
+  return humidity;
+}
@@ -0,0 +1,29 @@
+//
+// DHT.h - Host shim of the Adafruit DHT library, readings come from
+//         the host::dht hook
+//
+
+#ifndef DHT_h
+#define DHT_h
+
+#include "Arduino.h"
+
+#define DHT11 11
+#define DHT21 21
+#define DHT22 22
+
+class DHT
+{
+  public:
+    DHT( uint8_t pin, uint8_t type, uint8_t count = 6 ) : _pin( pin ), _type( type ) { (void)count; }
+
+    void  begin( uint8_t usec = 55 )        { (void)usec; }
+    float readTemperature( bool S = false, bool force = false );
+    float readHumidity( bool force = false );
+
+  private:
+    uint8_t _pin;
+    uint8_t _type;
+};
+
+#endif
@@ -0,0 +1,36 @@
+//
+// EEPROM.cpp - Host shim of the flash backed EEPROM
+//
+
+#include <stdio.h>
+
+#include "EEPROM.h"
+#include "Host.h"
+
+EEPROMClass EEPROM;
+
+
+// Erased flash reads as 0xff
+void EEPROMClass::begin( size_t size ) {
+  _data.assign( size, 0xff );
+
+  if ( host::eeprom_file.empty() ) return;
+  FILE *f = fopen( host::eeprom_file.c_str(), "rb" );
+  if ( !f ) return;
+  fread( _data.data(), 1, size, f );
+  fclose( f );
+}
+
+bool EEPROMClass::commit() {
+  if ( host::eeprom_file.empty() ) return true;
+  FILE *f = fopen( host::eeprom_file.c_str(), "wb" );
+  if ( !f ) return false;
+  bool ok = fwrite( _data.data(), 1, _data.size(), f ) == _data.size();
+  return fclose( f ) == 0 && ok;
+}
+
+bool EEPROMClass::end() {
+  bool ok = commit();
+  _data.clear();
+  return ok;
+}
@@ -0,0 +1,41 @@
+//
+// EEPROM.h - Host shim of the flash backed EEPROM, saved to
+//            host::eeprom_file on commit() when that's set
+//
+
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+class EEPROMClass
+{
+  public:
+    void    begin( size_t size );
+    bool    commit();
+    bool    end();
+    uint8_t read( int address )                 { return address < (int)_data.size() ? _data[ address ] : 0; }
+    void    write( int address, uint8_t value ) { if ( address < (int)_data.size() ) _data[ address ] = value; }
+    size_t  length()                            { return _data.size(); }
+    uint8_t* getDataPtr()                       { return _data.data(); }
+
+    template <typename T> T& get( int address, T &t ) {
+      if ( address + sizeof(T) <= _data.size() ) memcpy( (void *)&t, _data.data() + address, sizeof(T) );
+      return t;
+    }
+
+    template <typename T> const T& put( int address, const T &t ) {
+      if ( address + sizeof(T) <= _data.size() ) memcpy( _data.data() + address, (const void *)&t, sizeof(T) );
+      return t;
+    }
+
+  private:
+    std::vector<uint8_t> _data;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,251 @@
+//
+// ESP8266HTTPClient.cpp - Host shim of HTTPClient
+//
+
+#include <strings.h>
+#include <unistd.h>
+
+#include "ESP8266HTTPClient.h"
+#include "Host.h"
+
+
+HTTPClient::HTTPClient() {
+}
+
+HTTPClient::~HTTPClient() {
+  if ( _client ) _client->stop();
+}
+
+
+// scheme://host[:port]/path
+bool HTTPClient::parse( const String &url ) {
+  std::string u = url.c_str();
+  size_t      at = u.find( "://" );
+  if ( at == std::string::npos ) return false;
+
+  std::string scheme = u.substr( 0, at );
+  if ( scheme != "http" && scheme != "https" ) return false;
+  _https = ( scheme == "https" );
+  _port  = _https ? 443 : 80;
+
+  u = u.substr( at + 3 );
+  size_t slash = u.find( '/' );
+  _uri  = ( slash == std::string::npos ) ? "/" : u.substr( slash );
+  _host = u.substr( 0, slash );
+
+  size_t colon = _host.find( ':' );
+  if ( colon != std::string::npos ) {
+    _port = atoi( _host.c_str() + colon + 1 );
+    _host = _host.substr( 0, colon );
+  }
+  return !_host.empty();
+}
+
+bool HTTPClient::begin( WiFiClient &client, const String &url ) {
+  if ( _client && _client != &client ) _client->stop();
+  _client  = &client;
+  _headers.clear();
+  return parse( url );
+}
+
+bool HTTPClient::begin( const String &url ) {
+  if ( !parse( url ) || _https ) return false;
+  return begin( _own, url );
+}
+
+// The connection is kept if it can be reused, the headers are not
+void HTTPClient::end() {
+  if ( _client && !( _reuse && _can_reuse ) ) _client->stop();
+  _headers.clear();
+  _size = -1;
+}
+
+bool HTTPClient::connected() {
+  return _client && _client->connected();
+}
+
+void HTTPClient::addHeader( const String &name, const String &value ) {
+  _headers += std::string( name.c_str() ) + ": " + value.c_str() + "\r\n";
+}
+
+void HTTPClient::collectHeaders( const char *headerKeys[], const size_t headerKeysCount ) {
+  _collect.clear();
+  for ( size_t i = 0; i < headerKeysCount; i++ )
+    _collect.push_back( { headerKeys[i], "" } );
+}
+
+String HTTPClient::header( const char *name ) {
+  for ( const header_value &h : _collect )
+    if ( strcasecmp( h.name.c_str(), name ) == 0 ) return String( h.value.c_str() );
+  return String();
+}
+
+bool HTTPClient::hasHeader( const char *name ) {
+  return header( name ).length() > 0;
+}
+
+
+// An open connection is reused, after dropping whatever's left of the
+// last response
+bool HTTPClient::connect() {
+  if ( !_client ) return false;
+
+  if ( _reuse && _can_reuse && _client->connected() ) {
+    uint8_t buf[ 256 ];
+    while ( _client->available() > 0 ) _client->read( buf, sizeof(buf) );
+    return true;
+  }
+
+  _client->setTimeout( _timeout );
+  return _client->connect( _host.c_str(), _port );
+}
+
+int HTTPClient::GET() {
+  return sendRequest( "GET" );
+}
+
+int HTTPClient::POST( const uint8_t *payload, size_t size ) {
+  return sendRequest( "POST", payload ? payload : (const uint8_t *)"", size );
+}
+
+int HTTPClient::sendRequest( const char *type, const uint8_t *payload, size_t size ) {
+  if ( !connect() ) return HTTPC_ERROR_CONNECTION_FAILED;
+
+  std::string request = std::string( type ) + " " + _uri + " HTTP/1.1\r\n" +
+                        "Host: " + _host + ( _port == ( _https ? 443 : 80 ) ? "" : ":" + std::to_string( _port ) ) + "\r\n" +
+                        "User-Agent: " + _agent + "\r\n" +
+                        "Connection: " + ( _reuse ? "keep-alive" : "close" ) + "\r\n" +
+                        "Accept-Encoding: identity;q=1,chunked;q=0.1,*;q=0\r\n" + _headers;
+  if ( payload ) request += "Content-Length: " + std::to_string( size ) + "\r\n";
+  request += "\r\n";
+
+  if ( _client->write( (const uint8_t *)request.data(), request.size() ) != request.size() ) {
+    _client->stop();
+    return HTTPC_ERROR_SEND_HEADER_FAILED;
+  }
+  if ( payload && size && _client->write( payload, size ) != size ) {
+    _client->stop();
+    return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+  }
+
+  return response();
+}
+
+bool HTTPClient::readLine( std::string &line ) {
+  unsigned long start = millis();
+  line.clear();
+
+  while ( millis() - start < _timeout ) {
+    int c = _client->read();
+    if ( c < 0 ) {
+      if ( !_client->connected() ) return false;
+      // The server answers in real time, so under the virtual clock the
+      // timeout mustn't run out faster than the wall clock
+      if ( host::is_virtual_clock() ) usleep( 1000 );
+      delay( 1 );
+      continue;
+    }
+    if ( c == '\n' ) {
+      if ( !line.empty() && line.back() == '\r' ) line.pop_back();
+      return true;
+    }
+    line += (char)c;
+  }
+  return false;
+}
+
+int HTTPClient::response() {
+  std::string line;
+  int         code = 0;
+
+  _size      = -1;
+  _chunked   = false;
+  _can_reuse = _reuse;
+  for ( header_value &h : _collect ) h.value.clear();
+
+  // Interim 1xx responses are skipped
+  do {
+    if ( !readLine( line ) ) {
+      _client->stop();
+      return _client->connected() ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST;
+    }
+    if ( line.compare( 0, 5, "HTTP/" ) != 0 ) {
+      _client->stop();
+      return HTTPC_ERROR_NO_HTTP_SERVER;
+    }
+    code = atoi( line.c_str() + line.find( ' ' ) + 1 );
+    if ( line.compare( 0, 8, "HTTP/1.0" ) == 0 ) _can_reuse = false;
+
+    while ( readLine( line ) && !line.empty() ) {
+      size_t colon = line.find( ':' );
+      if ( colon == std::string::npos ) continue;
+
+      std::string name  = line.substr( 0, colon );
+      std::string value = line.substr( colon + 1 );
+      value.erase( 0, value.find_first_not_of( ' ' ) );
+
+      if      ( strcasecmp( name.c_str(), "Content-Length" ) == 0 )    _size    = atoi( value.c_str() );
+      else if ( strcasecmp( name.c_str(), "Transfer-Encoding" ) == 0 ) _chunked = strcasecmp( value.c_str(), "chunked" ) == 0;
+      else if ( strcasecmp( name.c_str(), "Connection" ) == 0 && strcasecmp( value.c_str(), "close" ) == 0 ) _can_reuse = false;
+
+      for ( header_value &h : _collect )
+        if ( strcasecmp( h.name.c_str(), name.c_str() ) == 0 ) h.value = value;
+    }
+  } while ( code >= 100 && code < 200 );
+
+  // No body without saying so
+  if ( code == 204 || code == 304 ) _size = 0;
+  return code;
+}
+
+String HTTPClient::getString() {
+  String out;
+  if ( !_client ) return out;
+
+  if ( _chunked ) {
+    std::string line;
+    while ( readLine( line ) ) {
+      size_t len = strtoul( line.c_str(), nullptr, 16 );
+      if ( len == 0 ) {
+        readLine( line );
+        break;
+      }
+      std::string chunk( len, '\0' );
+      if ( _client->readBytes( (uint8_t *)&chunk[0], len ) != len ) break;
+      out.concat( chunk.data(), len );
+      readLine( line );
+    }
+    return out;
+  }
+
+  if ( _size > 0 ) out.reserve( _size );
+
+  uint8_t buf[ 512 ];
+  int     left = _size;
+  while ( left != 0 ) {
+    size_t want = ( left < 0 || left > (int)sizeof(buf) ) ? sizeof(buf) : left;
+    size_t n    = _client->readBytes( buf, want );
+    if ( n == 0 ) break;
+    out.concat( (const char *)buf, n );
+    if ( left > 0 ) left -= n;
+  }
+  if ( _size < 0 ) _can_reuse = false;   // Read to the close
+  return out;
+}
+
+String HTTPClient::errorToString( int error ) {
+  switch ( error ) {
+    case HTTPC_ERROR_CONNECTION_FAILED:   return String( "connection failed" );
+    case HTTPC_ERROR_SEND_HEADER_FAILED:  return String( "send header failed" );
+    case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return String( "send payload failed" );
+    case HTTPC_ERROR_NOT_CONNECTED:       return String( "not connected" );
+    case HTTPC_ERROR_CONNECTION_LOST:     return String( "connection lost" );
+    case HTTPC_ERROR_NO_STREAM:           return String( "no stream" );
+    case HTTPC_ERROR_NO_HTTP_SERVER:      return String( "no HTTP server" );
+    case HTTPC_ERROR_TOO_LESS_RAM:        return String( "too less ram" );
+    case HTTPC_ERROR_ENCODING:            return String( "Transfer-Encoding not supported" );
+    case HTTPC_ERROR_STREAM_WRITE:        return String( "Stream write error" );
+    case HTTPC_ERROR_READ_TIMEOUT:        return String( "read Timeout" );
+    default:                              return String();
+  }
+}
@@ -0,0 +1,105 @@
+//
+// ESP8266HTTPClient.h - Host shim of HTTPClient over the shim's
+//                       WiFiClient, so the firmware's requests reach
+//                       real (stub) servers
+//
+
+#ifndef ESP8266HTTPClient_h
+#define ESP8266HTTPClient_h
+
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "ESP8266WiFi.h"
+
+#define HTTPCLIENT_DEFAULT_TCP_TIMEOUT  5000
+
+#define HTTPC_ERROR_CONNECTION_FAILED   (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_NO_STREAM           (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER      (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM        (-8)
+#define HTTPC_ERROR_ENCODING            (-9)
+#define HTTPC_ERROR_STREAM_WRITE        (-10)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+typedef enum {
+  HTTP_CODE_OK                    = 200,
+  HTTP_CODE_CREATED               = 201,
+  HTTP_CODE_ACCEPTED              = 202,
+  HTTP_CODE_NO_CONTENT            = 204,
+  HTTP_CODE_MOVED_PERMANENTLY     = 301,
+  HTTP_CODE_FOUND                 = 302,
+  HTTP_CODE_NOT_MODIFIED          = 304,
+  HTTP_CODE_BAD_REQUEST           = 400,
+  HTTP_CODE_UNAUTHORIZED          = 401,
+  HTTP_CODE_FORBIDDEN             = 403,
+  HTTP_CODE_NOT_FOUND             = 404,
+  HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+  HTTP_CODE_SERVICE_UNAVAILABLE   = 503
+} t_http_codes;
+
+
+class HTTPClient
+{
+  public:
+    HTTPClient();
+    ~HTTPClient();
+
+    bool begin( WiFiClient &client, const String &url );
+    bool begin( const String &url );            // Older cores, with a client of its own
+    void end();
+    bool connected();
+
+    void setReuse( bool reuse )                 { _reuse = reuse; }
+    void setTimeout( uint16_t timeout )         { _timeout = timeout; }
+    void setUserAgent( const String &agent )    { _agent = agent.c_str(); }
+    void addHeader( const String &name, const String &value );
+    void collectHeaders( const char *headerKeys[], const size_t headerKeysCount );
+    String header( const char *name );
+    bool   hasHeader( const char *name );
+
+    int GET();
+    int POST( const uint8_t *payload, size_t size );
+    int POST( const String &payload )           { return POST( (const uint8_t *)payload.c_str(), payload.length() ); }
+    int sendRequest( const char *type, const uint8_t *payload = nullptr, size_t size = 0 );
+
+    int         getSize()                       { return _size; }
+    WiFiClient& getStream()                     { return *_client; }
+    WiFiClient* getStreamPtr()                  { return _client; }
+    String      getString();
+
+    static String errorToString( int error );
+
+  private:
+    struct header_value {
+      std::string name;
+      std::string value;
+    };
+
+    WiFiClient               *_client  = nullptr;
+    WiFiClient                _own;
+    std::string               _host;
+    uint16_t                  _port    = 80;
+    std::string               _uri;
+    bool                      _https   = false;
+    bool                      _reuse   = true;
+    bool                      _can_reuse = false;
+    uint16_t                  _timeout = HTTPCLIENT_DEFAULT_TCP_TIMEOUT;
+    std::string               _agent   = "ESP8266HTTPClient";
+    std::string               _headers;          // Request headers, ready to send
+    std::vector<header_value> _collect;          // Response headers asked for
+    int                       _size    = -1;
+    bool                      _chunked = false;
+
+    bool parse( const String &url );
+    bool connect();
+    int  response();
+    bool readLine( std::string &line );
+};
+
+#endif
@@ -0,0 +1,139 @@
+//
+// ESP8266WiFi.h - Host shim of the WiFi station and WiFiClient.  The
+//                 station joins straight away on the host's network;
+//                 clients are plain TCP sockets.
+//
+
+#ifndef ESP8266WiFi_h
+#define ESP8266WiFi_h
+
+#include <stdint.h>
+#include <string>
+#include <memory>
+
+#include "Arduino.h"
+
+typedef enum {
+  WL_IDLE_STATUS     = 0,
+  WL_NO_SSID_AVAIL   = 1,
+  WL_SCAN_COMPLETED  = 2,
+  WL_CONNECTED       = 3,
+  WL_CONNECT_FAILED  = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED    = 6
+} wl_status_t;
+
+typedef enum {
+  WIFI_OFF   = 0,
+  WIFI_STA   = 1,
+  WIFI_AP    = 2,
+  WIFI_AP_STA = 3
+} WiFiMode_t;
+
+typedef enum {
+  WIFI_NONE_SLEEP  = 0,
+  WIFI_LIGHT_SLEEP = 1,
+  WIFI_MODEM_SLEEP = 2
+} WiFiSleepType_t;
+
+
+class IPAddress
+{
+  public:
+    IPAddress() : _address( 0 ) {}
+    IPAddress( uint8_t a, uint8_t b, uint8_t c, uint8_t d ) : _address( a | ( b << 8 ) | ( c << 16 ) | ( (uint32_t)d << 24 ) ) {}
+    IPAddress( uint32_t address ) : _address( address ) {}
+
+    operator uint32_t() const           { return _address; }
+    uint8_t operator[]( int i ) const   { return _address >> ( i * 8 ); }
+    bool    isSet() const               { return _address != 0; }
+    bool    fromString( const char *address );
+    String  toString() const;
+
+  private:
+    uint32_t _address;   // Network order, first octet lowest
+};
+
+
+// A TCP connection.  Copies share it, as on the ESP.
+class WiFiClient : public Stream
+{
+  public:
+    WiFiClient();
+    virtual ~WiFiClient();
+
+    virtual int     connect( IPAddress ip, uint16_t port );
+    virtual int     connect( const char *host, uint16_t port );
+    int             connect( const String &host, uint16_t port ) { return connect( host.c_str(), port ); }
+    virtual uint8_t connected();
+    virtual void    stop();
+
+    size_t write( uint8_t c ) override                            { return write( &c, 1 ); }
+    size_t write( const uint8_t *buffer, size_t size ) override;
+    int    available() override;
+    int    read() override;
+    int    read( uint8_t *buffer, size_t size );
+    int    peek() override;
+    void   flush() override {}
+    size_t readBytes( uint8_t *buffer, size_t length ) override;
+
+    void   setNoDelay( bool ) {}
+    operator bool()                                               { return connected(); }
+
+    using Print::write;
+    using Stream::readBytes;
+
+    struct socket;
+
+  protected:
+    std::shared_ptr<socket> _sock;
+
+    // The transport under the buffering: a secure client swaps these
+    virtual bool    open( uint32_t address, uint16_t port, const char *host );
+    virtual ssize_t send_some( const uint8_t *data, size_t len );   // -1 error, 0 would block
+    virtual ssize_t recv_some( uint8_t *data, size_t len );         // -1 would block, 0 closed
+
+    bool fill();                                                    // Take what's waiting, false if closed
+    int  fd() const;                                                // The socket, -1 if none
+};
+
+
+class ESP8266WiFiClass
+{
+  public:
+    bool        mode( WiFiMode_t mode )    { _mode = mode; if ( !( mode & WIFI_STA ) ) _joined = false; return true; }
+    WiFiMode_t  getMode()                  { return _mode; }
+
+    wl_status_t begin( const char *ssid, const char *passphrase = nullptr );
+    bool        disconnect( bool wifioff = false );
+    wl_status_t status()                   { return _joined ? WL_CONNECTED : WL_DISCONNECTED; }
+    bool        isConnected()              { return _joined; }
+    bool        softAP( const char *ssid, const char *passphrase = nullptr );
+
+    IPAddress   localIP()                  { return IPAddress( 127, 0, 0, 1 ); }
+    IPAddress   softAPIP()                 { return IPAddress( 192, 168, 4, 1 ); }
+    String      macAddress();
+    String      SSID()                     { return String( _ssid.c_str() ); }
+    int32_t     RSSI()                     { return -55; }
+    String      hostname()                 { return String( _hostname.c_str() ); }
+    bool        hostname( const char *name ) { _hostname = name; return true; }
+    bool        hostname( const String &name ) { return hostname( name.c_str() ); }
+
+    bool            setSleepMode( WiFiSleepType_t type, uint8_t listenInterval = 0 );
+    WiFiSleepType_t getSleepMode()         { return _sleep; }
+    void            setAutoReconnect( bool ) {}
+    void            persistent( bool ) {}
+
+    int hostByName( const char *name, IPAddress &result );
+
+  private:
+    WiFiMode_t      _mode   = WIFI_OFF;
+    bool            _joined = false;
+    WiFiSleepType_t _sleep  = WIFI_NONE_SLEEP;
+    std::string     _ssid;
+    std::string     _hostname;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,7 @@
+//
+// ESP8266httpUpdate.cpp - Host shim of ESPhttpUpdate
+//
+
+#include "ESP8266httpUpdate.h"
+
+ESP8266HTTPUpdate ESPhttpUpdate;
@@ -0,0 +1,37 @@
+//
+// ESP8266httpUpdate.h - Host shim of ESPhttpUpdate.  The firmware's own
+//                       DeltaUpdate does the real work; the whole-image
+//                       path always finds nothing to do.
+//
+
+#ifndef ESP8266httpUpdate_h
+#define ESP8266httpUpdate_h
+
+#include "Arduino.h"
+
+enum HTTPUpdateResult {
+  HTTP_UPDATE_FAILED,
+  HTTP_UPDATE_NO_UPDATES,
+  HTTP_UPDATE_OK
+};
+typedef HTTPUpdateResult t_httpUpdate_return;
+
+class ESP8266HTTPUpdate
+{
+  public:
+    t_httpUpdate_return update( const String &url, const String &currentVersion = "" ) {
+      (void)url; (void)currentVersion;
+      return HTTP_UPDATE_NO_UPDATES;
+    }
+    t_httpUpdate_return updateSpiffs( const String &url, const String &currentVersion = "" ) {
+      (void)url; (void)currentVersion;
+      return HTTP_UPDATE_NO_UPDATES;
+    }
+
+    int    getLastError()                       { return 0; }
+    String getLastErrorString()                 { return String(); }
+};
+
+extern ESP8266HTTPUpdate ESPhttpUpdate;
+
+#endif
@@ -0,0 +1,37 @@
+//
+// ESP8266mDNS.cpp - Host shim of the LEA mDNS responder
+//
+
+#include "ESP8266mDNS.h"
+
+MDNSResponder MDNS;
+
+MDNSResponder::hMDNSService MDNSResponder::addService( const char *name, const char *service,
+                                                       const char *protocol, uint16_t port ) {
+  (void)name;
+  if ( _services.capacity() == 0 ) _services.reserve( 8 );   // Handles are pointers into this
+  if ( _services.size() == _services.capacity() ) return nullptr;
+  _services.push_back( { service, protocol, port, nullptr, {} } );
+  return &_services.back();
+}
+
+bool MDNSResponder::setDynamicServiceTxtCallback( const hMDNSService service,
+                                                  MDNSDynamicServiceTxtCallbackFunc callback ) {
+  if ( !service ) return false;
+  ( (record *)service )->txt_callback = callback;
+  return true;
+}
+
+bool MDNSResponder::addDynamicServiceTxt( const hMDNSService service, const char *key, const char *value ) {
+  if ( !service ) return false;
+  ( (record *)service )->txt.push_back( std::string( key ) + "=" + value );
+  return true;
+}
+
+bool MDNSResponder::announce() {
+  for ( record &r : _services ) {
+    r.txt.clear();
+    if ( r.txt_callback ) r.txt_callback( &r );
+  }
+  return true;
+}
@@ -0,0 +1,54 @@
+//
+// ESP8266mDNS.h - Host shim of the LEA mDNS responder.  Nothing goes on
+//                 the network; announce() runs the TXT callbacks so the
+//                 firmware builds its records as it would.
+//
+
+#ifndef ESP8266mDNS_h
+#define ESP8266mDNS_h
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+class MDNSResponder
+{
+  public:
+    typedef const void* hMDNSService;
+    typedef std::function<void(const hMDNSService)> MDNSDynamicServiceTxtCallbackFunc;
+
+    bool begin( const char *hostname )                    { _hostname = hostname; return !_hostname.empty(); }
+    bool setHostname( const char *hostname )              { _hostname = hostname; return true; }
+    bool update()                                         { return true; }
+    bool announce();
+    void notifyAPChange()                                 { announce(); }
+
+    hMDNSService addService( const char *name, const char *service, const char *protocol, uint16_t port );
+    bool         addService( const char *service, const char *protocol, uint16_t port ) {
+      return addService( nullptr, service, protocol, port ) != nullptr;
+    }
+    bool setDynamicServiceTxtCallback( const hMDNSService service, MDNSDynamicServiceTxtCallbackFunc callback );
+
+    bool addDynamicServiceTxt( const hMDNSService service, const char *key, const char *value );
+    bool addDynamicServiceTxt( const hMDNSService service, const char *key, uint32_t value ) {
+      return addDynamicServiceTxt( service, key, String( value ).c_str() );
+    }
+
+  private:
+    struct record {
+      std::string                       service;
+      std::string                       protocol;
+      uint16_t                          port;
+      MDNSDynamicServiceTxtCallbackFunc txt_callback;
+      std::vector<std::string>          txt;
+    };
+
+    std::string         _hostname;
+    std::vector<record> _services;
+};
+
+extern MDNSResponder MDNS;
+
+#endif
@@ -0,0 +1,9 @@
+//
+// ESPAsyncTCP.h - Host shim, the async server in ESPAsyncWebServer.h
+//                 carries its own sockets
+//
+
+#ifndef ESPAsyncTCP_h
+#define ESPAsyncTCP_h
+
+#endif
@@ -0,0 +1,789 @@
+//
+// ESPAsyncWebServer.cpp - Host shim of the async web server
+//
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "ESPAsyncWebServer.h"
+#include "MD5Builder.h"
+#include "base64.h"
+#include "Host.h"
+
+#define HEAD_LIMIT     8192     // Largest request head taken
+#define SEND_WINDOW    2920     // Sent per connection per poll, two segments as lwIP would
+#define LISTEN_BACKLOG 16
+
+
+//
+// Responses
+
+static const char* status_text( int code ) {
+  switch ( code ) {
+    case 100: return "Continue";
+    case 200: return "OK";
+    case 201: return "Created";
+    case 202: return "Accepted";
+    case 204: return "No Content";
+    case 206: return "Partial Content";
+    case 301: return "Moved Permanently";
+    case 302: return "Found";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 413: return "Request Entity Too Large";
+    case 500: return "Internal Server Error";
+    case 501: return "Not Implemented";
+    case 503: return "Service Unavailable";
+    default:  return "";
+  }
+}
+
+AsyncWebServerResponse::AsyncWebServerResponse( int code, const String &contentType )
+  : _code( code ), _contentType( contentType ) {
+}
+
+void AsyncWebServerResponse::addHeader( const String &name, const String &value ) {
+  _headers.emplace_back( name, value );
+}
+
+String AsyncWebServerResponse::head( bool chunked_ok ) {
+  start();
+  if ( !_sendContentLength && chunked_ok ) _chunked = true;
+
+  char   line[ 64 ];
+  String out;
+  snprintf( line, sizeof(line), "HTTP/1.%d %d %s\r\n", chunked_ok ? 1 : 0, _code, status_text( _code ) );
+  out += line;
+
+  if ( _sendContentLength ) out += "Content-Length: " + String( (unsigned long)_contentLength ) + "\r\n";
+  if ( _contentType.length() ) out += "Content-Type: " + _contentType + "\r\n";
+  for ( const AsyncWebHeader &h : _headers ) out += h.name() + ": " + h.value() + "\r\n";
+  out += "Accept-Ranges: none\r\n";
+  if ( _chunked ) out += "Transfer-Encoding: chunked\r\n";
+  out += "\r\n";
+  return out;
+}
+
+// A fixed length body ends at its length; a chunked one at an empty
+// fill, with each piece framed.  A filler with nothing for us yet just
+// holds the connection, as on the ESP.
+size_t AsyncWebServerResponse::body( uint8_t *buffer, size_t maxLen ) {
+  if ( _finished ) return 0;
+
+  if ( !_sendContentLength ) {
+    if ( maxLen < 16 ) return RESPONSE_TRY_AGAIN;
+
+    const size_t frame = 10;                 // Room for "xxxxxxxx\r\n"
+    size_t n = fill( buffer + frame, maxLen - frame - 2, _sent );
+    if ( n == RESPONSE_TRY_AGAIN ) return n;
+
+    if ( !_chunked ) {                       // HTTP/1.0, the close ends it
+      if ( n == 0 ) _finished = true;
+      memmove( buffer, buffer + frame, n );
+      _sent += n;
+      return n;
+    }
+    if ( n == 0 ) {
+      _finished = true;
+      memcpy( buffer, "0\r\n\r\n", 5 );
+      return 5;
+    }
+
+    char   size[ frame + 1 ];
+    size_t h = snprintf( size, sizeof(size), "%x\r\n", (unsigned)n );
+    memmove( buffer + h, buffer + frame, n );
+    memcpy( buffer, size, h );
+    memcpy( buffer + h + n, "\r\n", 2 );
+    _sent += n;
+    return h + n + 2;
+  }
+
+  size_t want = _contentLength - _sent;
+  if ( want > maxLen ) want = maxLen;
+  if ( want == 0 ) {
+    _finished = true;
+    return 0;
+  }
+
+  size_t n = fill( buffer, want, _sent );
+  if ( n == RESPONSE_TRY_AGAIN || n == 0 ) return RESPONSE_TRY_AGAIN;
+  if ( n > want ) n = want;
+
+  _sent += n;
+  if ( _sent == _contentLength ) _finished = true;
+  return n;
+}
+
+
+namespace {
+
+class BasicResponse : public AsyncWebServerResponse
+{
+  public:
+    BasicResponse( int code, const String &contentType, const String &content )
+      : AsyncWebServerResponse( code, contentType ), _content( content ) {
+      _contentLength = _content.length();
+      if ( _contentLength && !_contentType.length() ) _contentType = "text/plain";
+    }
+
+  protected:
+    size_t fill( uint8_t *buffer, size_t maxLen, size_t index ) override {
+      size_t n = _content.length() - index;
+      if ( n > maxLen ) n = maxLen;
+      memcpy( buffer, _content.c_str() + index, n );
+      return n;
+    }
+
+  private:
+    String _content;
+};
+
+class ProgmemResponse : public AsyncWebServerResponse
+{
+  public:
+    ProgmemResponse( int code, const String &contentType, const uint8_t *content, size_t len )
+      : AsyncWebServerResponse( code, contentType ), _content( content ) {
+      _contentLength = len;
+    }
+
+  protected:
+    size_t fill( uint8_t *buffer, size_t maxLen, size_t index ) override {
+      memcpy_P( buffer, _content + index, maxLen );
+      return maxLen;
+    }
+
+  private:
+    const uint8_t *_content;
+};
+
+class FileResponse : public AsyncWebServerResponse
+{
+  public:
+    FileResponse( FS &fs, const String &path, const String &contentType, bool download )
+      : AsyncWebServerResponse( 200, contentType ) {
+      String file = path;
+      if ( !download && !fs.exists( file ) && fs.exists( file + ".gz" ) ) {
+        file += ".gz";
+        addHeader( "Content-Encoding", "gzip" );
+      }
+      _content       = fs.open( file, "r" );
+      _contentLength = _content ? _content.size() : 0;
+      if ( !_contentType.length() ) _contentType = "text/plain";
+
+      String name = path.substring( path.lastIndexOf( '/' ) + 1 );
+      addHeader( "Content-Disposition", ( download ? "attachment; filename=\"" : "inline; filename=\"" ) + name + "\"" );
+    }
+    ~FileResponse() { if ( _content ) _content.close(); }
+
+    bool sourceValid() const override { return (bool)_content; }
+
+  protected:
+    size_t fill( uint8_t *buffer, size_t maxLen, size_t index ) override {
+      (void)index;
+      return _content.read( buffer, maxLen );
+    }
+
+  private:
+    File _content;
+};
+
+class CallbackResponse : public AsyncWebServerResponse
+{
+  public:
+    CallbackResponse( const String &contentType, size_t len, AwsResponseFiller callback, bool chunked )
+      : AsyncWebServerResponse( 200, contentType ), _callback( callback ) {
+      _contentLength     = len;
+      _sendContentLength = !chunked && len;
+    }
+
+    bool sourceValid() const override { return (bool)_callback; }
+
+  protected:
+    size_t fill( uint8_t *buffer, size_t maxLen, size_t index ) override {
+      return _callback( buffer, maxLen, index );
+    }
+
+  private:
+    AwsResponseFiller _callback;
+};
+
+}
+
+
+AsyncResponseStream::AsyncResponseStream( const String &contentType, size_t bufferSize )
+  : AsyncWebServerResponse( 200, contentType ) {
+  _buf  = (char *)host::heap_realloc( nullptr, bufferSize ? bufferSize : 1 );
+  _size = bufferSize;
+}
+
+AsyncResponseStream::~AsyncResponseStream() {
+  host::heap_free( _buf );
+}
+
+size_t AsyncResponseStream::write( const uint8_t *data, size_t len ) {
+  if ( _used + len > _size ) {
+    char *grown = (char *)host::heap_realloc( _buf, _used + len );
+    if ( !grown ) return 0;
+    _buf  = grown;
+    _size = _used + len;
+  }
+  memcpy( _buf + _used, data, len );
+  _used += len;
+  return len;
+}
+
+void AsyncResponseStream::start() {
+  _contentLength = _used;
+}
+
+size_t AsyncResponseStream::fill( uint8_t *buffer, size_t maxLen, size_t index ) {
+  memcpy( buffer, _buf + index, maxLen );
+  return maxLen;
+}
+
+
+//
+// Requests
+
+AsyncWebServerRequest::AsyncWebServerRequest() {
+}
+
+AsyncWebServerRequest::~AsyncWebServerRequest() {
+  delete _response;
+}
+
+static int from_hex( char c ) {
+  if ( c >= '0' && c <= '9' ) return c - '0';
+  if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+  if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+  return -1;
+}
+
+static String url_decode( const std::string &text, bool plus ) {
+  std::string out;
+  out.reserve( text.size() );
+
+  for ( size_t i = 0; i < text.size(); i++ ) {
+    char c = text[i];
+    if ( c == '+' && plus ) c = ' ';
+    else if ( c == '%' && i + 2 < text.size() && from_hex( text[i + 1] ) >= 0 && from_hex( text[i + 2] ) >= 0 ) {
+      c  = (char)( from_hex( text[i + 1] ) << 4 | from_hex( text[i + 2] ) );
+      i += 2;
+    }
+    out += c;
+  }
+  return String( out.c_str() );
+}
+
+// name=value&... into params
+void AsyncWebServerRequest::query( const std::string &text, bool form ) {
+  size_t at = 0;
+  while ( at < text.size() ) {
+    size_t end = text.find( '&', at );
+    if ( end == std::string::npos ) end = text.size();
+
+    std::string pair = text.substr( at, end - at );
+    size_t      eq   = pair.find( '=' );
+    if ( !pair.empty() ) {
+      if ( eq == std::string::npos ) _params.emplace_back( url_decode( pair, true ), String(), form );
+      else _params.emplace_back( url_decode( pair.substr( 0, eq ), true ), url_decode( pair.substr( eq + 1 ), true ), form );
+    }
+    at = end + 1;
+  }
+}
+
+static std::string disposition( const std::string &headers, const char *key ) {
+  std::string find = std::string( key ) + "=\"";
+  size_t      at   = headers.find( find );
+  if ( at == std::string::npos ) return std::string();
+  at += find.size();
+  return headers.substr( at, headers.find( '"', at ) - at );
+}
+
+// Fields become form params, files go to the upload handler in one piece
+void AsyncWebServerRequest::multipart() {
+  std::string delimiter = std::string( "--" ) + _boundary.c_str();
+  size_t      at        = _body.find( delimiter );
+
+  while ( at != std::string::npos ) {
+    at += delimiter.size();
+    if ( _body.compare( at, 2, "--" ) == 0 ) break;
+    at += 2;                                          // CRLF
+
+    size_t head_end = _body.find( "\r\n\r\n", at );
+    if ( head_end == std::string::npos ) break;
+    std::string headers = _body.substr( at, head_end - at );
+
+    size_t data = head_end + 4;
+    size_t next = _body.find( "\r\n" + delimiter, data );
+    if ( next == std::string::npos ) break;
+
+    std::string name     = disposition( headers, "name" );
+    std::string filename = disposition( headers, "filename" );
+    size_t      len      = next - data;
+
+    if ( headers.find( "filename=" ) != std::string::npos ) {
+      _params.emplace_back( String( name.c_str() ), String( filename.c_str() ), true, true, len );
+      if ( _upload ) _upload( this, String( filename.c_str() ), 0, (uint8_t *)&_body[ data ], len, true );
+    } else {
+      _params.emplace_back( String( name.c_str() ), String( _body.substr( data, len ).c_str() ), true );
+    }
+    at = next + 2;
+  }
+}
+
+bool AsyncWebServerRequest::parse( std::string &data, AsyncWebServer *server ) {
+  if ( _state == PARSE_HEAD ) {
+    size_t end = data.find( "\r\n\r\n" );
+    if ( end == std::string::npos ) {
+      if ( data.size() > HEAD_LIMIT ) _method = 0, _state = PARSE_DONE;
+      return _state == PARSE_DONE;
+    }
+
+    std::string head = data.substr( 0, end + 2 );
+    data.erase( 0, end + 4 );
+
+    size_t      eol  = head.find( "\r\n" );
+    std::string line = head.substr( 0, eol );
+    size_t      sp1  = line.find( ' ' ), sp2 = line.rfind( ' ' );
+    if ( sp1 == std::string::npos || sp2 == sp1 ) {
+      _state = PARSE_DONE;
+      return true;
+    }
+
+    std::string method = line.substr( 0, sp1 );
+    std::string target = line.substr( sp1 + 1, sp2 - sp1 - 1 );
+    _http11 = line.compare( sp2 + 1, std::string::npos, "HTTP/1.1" ) == 0;
+
+    static const struct { const char *name; WebRequestMethod method; } methods[] = {
+      { "GET", HTTP_GET }, { "POST", HTTP_POST }, { "DELETE", HTTP_DELETE }, { "PUT", HTTP_PUT },
+      { "PATCH", HTTP_PATCH }, { "HEAD", HTTP_HEAD }, { "OPTIONS", HTTP_OPTIONS } };
+    for ( const auto &m : methods )
+      if ( method == m.name ) _method = m.method;
+
+    size_t q = target.find( '?' );
+    _url = url_decode( target.substr( 0, q ), false );
+    if ( q != std::string::npos ) query( target.substr( q + 1 ), false );
+
+    for ( size_t at = eol + 2; at < head.size(); ) {
+      size_t      next  = head.find( "\r\n", at );
+      std::string h     = head.substr( at, next - at );
+      size_t      colon = h.find( ':' );
+      at = next + 2;
+      if ( colon == std::string::npos ) continue;
+
+      std::string value = h.substr( colon + 1 );
+      value.erase( 0, value.find_first_not_of( ' ' ) );
+      _headers.emplace_back( String( h.substr( 0, colon ).c_str() ), String( value.c_str() ) );
+    }
+
+    if ( AsyncWebHeader *h = getHeader( "Content-Length" ) ) _contentLength = h->value().toInt();
+    if ( AsyncWebHeader *h = getHeader( "Content-Type" ) ) {
+      String type = h->value();
+      int    semi = type.indexOf( ';' );
+      _contentType = semi < 0 ? type : type.substring( 0, semi );
+      int    b    = type.indexOf( "boundary=" );
+      if ( b >= 0 ) {
+        _boundary = type.substring( b + 9 );
+        _boundary.replace( "\"", "" );
+      }
+    }
+
+    if ( server ) {
+      const AsyncCallbackWebHandler *handler = server->handler( this );
+      if ( handler ) _upload = handler->_onUpload;
+    }
+    _state = _contentLength ? PARSE_BODY : PARSE_DONE;
+  }
+
+  if ( _state == PARSE_BODY ) {
+    size_t take = _contentLength - _body.size();
+    if ( take > data.size() ) take = data.size();
+    _body.append( data, 0, take );
+    data.erase( 0, take );
+    if ( _body.size() < _contentLength ) return false;
+
+    if ( _contentType == "application/x-www-form-urlencoded" ) query( _body, true );
+    else if ( _contentType == "multipart/form-data" )          multipart();
+    _state = PARSE_DONE;
+  }
+
+  return _state == PARSE_DONE;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam( size_t num ) {
+  return num < _params.size() ? &_params[ num ] : nullptr;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam( const String &name, bool post, bool file ) {
+  for ( AsyncWebParameter &p : _params )
+    if ( p.name() == name && p.isPost() == post && p.isFile() == file ) return &p;
+  return nullptr;
+}
+
+bool AsyncWebServerRequest::hasParam( const String &name, bool post, bool file ) {
+  return getParam( name, post, file ) != nullptr;
+}
+
+bool AsyncWebServerRequest::hasArg( const char *name ) const {
+  for ( const AsyncWebParameter &p : _params )
+    if ( p.name() == name ) return true;
+  return false;
+}
+
+const String& AsyncWebServerRequest::arg( const String &name ) const {
+  static const String empty;
+  for ( const AsyncWebParameter &p : _params )
+    if ( p.name() == name ) return p.value();
+  return empty;
+}
+
+bool AsyncWebServerRequest::hasHeader( const String &name ) const {
+  for ( const AsyncWebHeader &h : _headers )
+    if ( h.name().equalsIgnoreCase( name ) ) return true;
+  return false;
+}
+
+AsyncWebHeader* AsyncWebServerRequest::getHeader( const String &name ) {
+  for ( AsyncWebHeader &h : _headers )
+    if ( h.name().equalsIgnoreCase( name ) ) return &h;
+  return nullptr;
+}
+
+
+//
+// Authentication, Basic or Digest as the library checks them
+
+static String md5( const String &text ) {
+  MD5Builder hash;
+  hash.begin();
+  hash.add( text );
+  hash.calculate();
+  return hash.toString();
+}
+
+static String digest_field( const String &header, const char *key ) {
+  String find = String( key ) + "=";
+  int    at   = 0;
+
+  // Keys are matched at the start or after a comma
+  while ( ( at = header.indexOf( find, at ) ) >= 0 ) {
+    if ( at == 0 || header[ at - 1 ] == ' ' || header[ at - 1 ] == ',' ) break;
+    at++;
+  }
+  if ( at < 0 ) return String();
+
+  at += find.length();
+  if ( header[ at ] == '"' ) return header.substring( at + 1, header.indexOf( '"', at + 1 ) );
+
+  int end = header.indexOf( ',', at );
+  return header.substring( at, end < 0 ? header.length() : end );
+}
+
+static const char* method_name( WebRequestMethodComposite method ) {
+  switch ( method ) {
+    case HTTP_GET:     return "GET";
+    case HTTP_POST:    return "POST";
+    case HTTP_DELETE:  return "DELETE";
+    case HTTP_PUT:     return "PUT";
+    case HTTP_PATCH:   return "PATCH";
+    case HTTP_HEAD:    return "HEAD";
+    case HTTP_OPTIONS: return "OPTIONS";
+    default:           return "";
+  }
+}
+
+bool AsyncWebServerRequest::authenticate( const char *username, const char *password, const char *realm, bool passwordIsHash ) {
+  AsyncWebHeader *h = getHeader( "Authorization" );
+  if ( !h ) return false;
+
+  const String &auth = h->value();
+  if ( auth.startsWith( "Basic " ) ) {
+    String pair = String( username ) + ":" + password;
+    return auth.substring( 6 ) == base64::encode( (const uint8_t *)pair.c_str(), pair.length(), false );
+  }
+
+  if ( !auth.startsWith( "Digest " ) ) return false;
+
+  String header = auth.substring( 7 );
+  if ( digest_field( header, "username" ) != username ) return false;
+
+  String their_realm = digest_field( header, "realm" );
+  if ( realm && their_realm != realm ) return false;
+
+  String ha1 = passwordIsHash ? String( password ) : md5( String( username ) + ":" + their_realm + ":" + password );
+  String ha2 = md5( String( method_name( _method ) ) + ":" + digest_field( header, "uri" ) );
+  String qop = digest_field( header, "qop" );
+
+  String expect = qop.length()
+    ? md5( ha1 + ":" + digest_field( header, "nonce" ) + ":" + digest_field( header, "nc" ) + ":" +
+           digest_field( header, "cnonce" ) + ":" + qop + ":" + ha2 )
+    : md5( ha1 + ":" + digest_field( header, "nonce" ) + ":" + ha2 );
+  return expect == digest_field( header, "response" );
+}
+
+static String random_hex() {
+  char buf[ 33 ];
+  for ( int i = 0; i < 4; i++ ) sprintf( buf + i * 8, "%08x", (unsigned)ESP.random() );
+  return String( buf );
+}
+
+void AsyncWebServerRequest::requestAuthentication( const char *realm, bool isDigest ) {
+  AsyncWebServerResponse *r = beginResponse( 401 );
+  String                  name = realm ? realm : "Login Required";
+
+  if ( isDigest )
+    r->addHeader( "WWW-Authenticate", "Digest realm=\"" + name + "\", qop=\"auth\", nonce=\"" + random_hex() +
+                                      "\", opaque=\"" + random_hex() + "\"" );
+  else
+    r->addHeader( "WWW-Authenticate", "Basic realm=\"" + name + "\"" );
+  send( r );
+}
+
+
+//
+// Sending
+
+void AsyncWebServerRequest::send( AsyncWebServerResponse *response ) {
+  delete _response;
+  _response = response;
+
+  if ( _response && !_response->sourceValid() ) {
+    delete _response;
+    _response = new BasicResponse( 500, String(), String() );
+  }
+}
+
+void AsyncWebServerRequest::clearResponse() {
+  delete _response;
+  _response = nullptr;
+}
+
+void AsyncWebServerRequest::send( int code, const String &contentType, const String &content ) {
+  send( beginResponse( code, contentType, content ) );
+}
+
+void AsyncWebServerRequest::send_P( int code, const String &contentType, const uint8_t *content, size_t len ) {
+  send( beginResponse_P( code, contentType, content, len ) );
+}
+
+void AsyncWebServerRequest::send_P( int code, const String &contentType, const char *content ) {
+  send( beginResponse_P( code, contentType, content ) );
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse( int code, const String &contentType, const String &content ) {
+  return new BasicResponse( code, contentType, content );
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse( FS &fs, const String &path, const String &contentType, bool download ) {
+  return new FileResponse( fs, path, contentType, download );
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse( const String &contentType, size_t len, AwsResponseFiller callback ) {
+  return new CallbackResponse( contentType, len, callback, false );
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P( int code, const String &contentType, const uint8_t *content, size_t len ) {
+  return new ProgmemResponse( code, contentType, content, len );
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P( int code, const String &contentType, const char *content ) {
+  return beginResponse_P( code, contentType, (const uint8_t *)content, strlen_P( content ) );
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse( const String &contentType, AwsResponseFiller callback ) {
+  return new CallbackResponse( contentType, 0, callback, true );
+}
+
+AsyncResponseStream* AsyncWebServerRequest::beginResponseStream( const String &contentType, size_t bufferSize ) {
+  return new AsyncResponseStream( contentType, bufferSize );
+}
+
+
+//
+// Server
+
+struct AsyncWebServer::connection {
+  int                                    fd = -1;
+  std::string                            in;
+  std::string                            out;
+  size_t                                 out_at = 0;
+  std::unique_ptr<AsyncWebServerRequest> request;
+  bool                                   dispatched = false;
+  bool                                   head_sent  = false;
+
+  ~connection() { if ( fd >= 0 ) ::close( fd ); }
+};
+
+bool AsyncCallbackWebHandler::canHandle( AsyncWebServerRequest *request ) const {
+  if ( !( _method & request->method() ) ) return false;
+
+  const String &url = request->url();
+  if ( _uri.endsWith( "*" ) ) return url.startsWith( _uri.substring( 0, _uri.length() - 1 ) );
+  return _uri.length() && ( url == _uri || url.startsWith( _uri + "/" ) );
+}
+
+AsyncWebServer::AsyncWebServer( uint16_t port ) : _port( port ) {
+}
+
+AsyncWebServer::~AsyncWebServer() {
+  end();
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on( const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                                             ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody ) {
+  _handlers.emplace_back( new AsyncCallbackWebHandler( uri, method, onRequest, onUpload, onBody ) );
+  return *_handlers.back();
+}
+
+const AsyncCallbackWebHandler* AsyncWebServer::handler( AsyncWebServerRequest *request ) const {
+  for ( const auto &h : _handlers )
+    if ( h->canHandle( request ) ) return h.get();
+  return nullptr;
+}
+
+void AsyncWebServer::dispatch( AsyncWebServerRequest *request ) {
+  if ( request->method() == 0 ) {
+    request->send( 400 );
+    return;
+  }
+
+  const AsyncCallbackWebHandler *h = handler( request );
+  if ( h && h->_onRequest ) h->_onRequest( request );
+  else if ( _notFound )     _notFound( request );
+  else                      request->send( 404 );
+}
+
+void AsyncWebServer::begin() {
+  if ( _listen >= 0 ) return;
+
+  uint16_t port = host::http_port ? host::http_port : _port;
+  _listen = ::socket( AF_INET, SOCK_STREAM, 0 );
+
+  int one = 1;
+  setsockopt( _listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one) );
+
+  struct sockaddr_in addr = {};
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons( port );
+  addr.sin_addr.s_addr = htonl( INADDR_ANY );
+
+  if ( bind( _listen, (struct sockaddr *)&addr, sizeof(addr) ) != 0 || listen( _listen, LISTEN_BACKLOG ) != 0 ) {
+    fprintf( stderr, "AsyncWebServer: can't listen on port %u: %s\n", port, strerror( errno ) );
+    ::close( _listen );
+    _listen = -1;
+    return;
+  }
+  fcntl( _listen, F_SETFL, O_NONBLOCK );
+
+  // Served alongside whatever else waits in delay()
+  std::function<void(unsigned long)> before = host::poller;
+  host::poller = [this, before]( unsigned long ms ) {
+    if ( before ) before( 0 );
+    poll( ms );
+  };
+}
+
+void AsyncWebServer::end() {
+  _connections.clear();
+  if ( _listen >= 0 ) ::close( _listen );
+  _listen = -1;
+}
+
+// Fill and send what the connection has room for, false once it's done
+bool AsyncWebServer::serve( connection &c ) {
+  AsyncWebServerResponse *response = c.request->response();
+
+  if ( c.out_at == c.out.size() ) {
+    c.out.clear();
+    c.out_at = 0;
+
+    if ( !c.head_sent ) {
+      c.out      = response->head( c.request->_http11 ).c_str();
+      c.head_sent = true;
+    }
+
+    if ( !response->finished() && c.out.size() < SEND_WINDOW ) {
+      size_t  room = SEND_WINDOW - c.out.size();
+      uint8_t buf[ SEND_WINDOW ];
+      size_t  n    = response->body( buf, room );
+      if ( n != RESPONSE_TRY_AGAIN ) c.out.append( (const char *)buf, n );
+    }
+  }
+
+  while ( c.out_at < c.out.size() ) {
+    ssize_t n = ::send( c.fd, c.out.data() + c.out_at, c.out.size() - c.out_at, MSG_NOSIGNAL );
+    if ( n < 0 ) return errno == EAGAIN || errno == EWOULDBLOCK;
+    c.out_at += n;
+  }
+
+  return !response->finished();
+}
+
+void AsyncWebServer::poll( unsigned long ms ) {
+  if ( _listen < 0 ) return;
+
+  // Anything with data to go makes this a quick look
+  bool busy = false;
+  for ( auto &c : _connections )
+    if ( c->dispatched && c->request->response() && !c->request->response()->finished() ) busy = true;
+
+  std::vector<struct pollfd> fds;
+  fds.push_back( { _listen, POLLIN, 0 } );
+  for ( auto &c : _connections )
+    fds.push_back( { c->fd, (short)( POLLIN | ( c->out_at < c->out.size() ? POLLOUT : 0 ) ), 0 } );
+
+  if ( ::poll( fds.data(), fds.size(), busy ? 0 : (int)( ms > 50 ? 50 : ms ) ) < 0 ) return;
+
+  for ( size_t i = 0; i < _connections.size(); ) {
+    connection &c = *_connections[i];
+    short       revents = fds[ i + 1 ].revents;
+    bool        keep = true;
+
+    if ( revents & ( POLLIN | POLLHUP | POLLERR ) ) {
+      char    buf[ 2048 ];
+      ssize_t n;
+      while ( ( n = ::recv( c.fd, buf, sizeof(buf), 0 ) ) > 0 )
+        c.in.append( buf, n );
+      if ( n == 0 || ( n < 0 && errno != EAGAIN && errno != EWOULDBLOCK ) ) keep = false;
+    }
+
+    if ( keep && !c.dispatched && c.request->parse( c.in, this ) ) {
+      c.dispatched = true;
+      dispatch( c.request.get() );
+    }
+
+    if ( keep && c.dispatched && c.request->response() ) keep = serve( c );
+
+    if ( keep ) {
+      i++;
+      continue;
+    }
+    if ( c.dispatched && c.request->response() ) shutdown( c.fd, SHUT_WR );
+    _connections.erase( _connections.begin() + i );
+    fds.erase( fds.begin() + i + 1 );
+  }
+
+  if ( fds[0].revents & POLLIN ) {
+    int fd;
+    while ( ( fd = accept4( _listen, nullptr, nullptr, SOCK_NONBLOCK ) ) >= 0 ) {
+      int one = 1;
+      setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one) );
+
+      std::unique_ptr<connection> c( new connection() );
+      c->fd      = fd;
+      c->request.reset( new AsyncWebServerRequest() );
+      _connections.push_back( std::move( c ) );
+    }
+  }
+}
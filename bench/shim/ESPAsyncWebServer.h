@@ -0,0 +1,262 @@
+//
+// ESPAsyncWebServer.h - Host shim of the async web server.  Requests
+//                       are served from host::poller, as the ESP serves
+//                       them from the TCP stack: the handler runs when
+//                       the request is in, the response goes out a
+//                       window at a time and the connection closes.
+//
+
+#ifndef ESPAsyncWebServer_h
+#define ESPAsyncWebServer_h
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "FS.h"
+
+#define RESPONSE_TRY_AGAIN  0xFFFFFFFF
+
+typedef enum {
+  HTTP_GET     = 0b00000001,
+  HTTP_POST    = 0b00000010,
+  HTTP_DELETE  = 0b00000100,
+  HTTP_PUT     = 0b00001000,
+  HTTP_PATCH   = 0b00010000,
+  HTTP_HEAD    = 0b00100000,
+  HTTP_OPTIONS = 0b01000000,
+  HTTP_ANY     = 0b01111111
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+class AsyncWebServerResponse;
+
+typedef std::function<size_t(uint8_t *buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, const String &filename, size_t index,
+                           uint8_t *data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, uint8_t *data, size_t len,
+                           size_t index, size_t total)> ArBodyHandlerFunction;
+
+
+class AsyncWebParameter
+{
+  public:
+    AsyncWebParameter( const String &name, const String &value, bool form = false, bool file = false, size_t size = 0 )
+      : _name( name ), _value( value ), _size( size ), _isForm( form ), _isFile( file ) {}
+
+    const String& name() const   { return _name; }
+    const String& value() const  { return _value; }
+    size_t        size() const   { return _size; }
+    bool          isPost() const { return _isForm; }
+    bool          isFile() const { return _isFile; }
+
+  private:
+    String _name;
+    String _value;
+    size_t _size;
+    bool   _isForm;
+    bool   _isFile;
+};
+
+
+class AsyncWebHeader
+{
+  public:
+    AsyncWebHeader( const String &name, const String &value ) : _name( name ), _value( value ) {}
+
+    const String& name() const   { return _name; }
+    const String& value() const  { return _value; }
+
+  private:
+    String _name;
+    String _value;
+};
+
+
+class AsyncWebServerResponse
+{
+  public:
+    AsyncWebServerResponse( int code = 200, const String &contentType = String() );
+    virtual ~AsyncWebServerResponse() {}
+
+    void setCode( int code )                           { _code = code; }
+    void setContentLength( size_t len )                { _contentLength = len; }
+    void setContentType( const String &type )          { _contentType = type; }
+    void addHeader( const String &name, const String &value );
+
+    int  code() const                                  { return _code; }
+
+    // Host: the status line and headers, then the body a piece at a
+    // time, as the connection has room for it
+    String head( bool chunked_ok = true );
+    size_t body( uint8_t *buffer, size_t maxLen );     // RESPONSE_TRY_AGAIN to wait, 0 when done
+    bool   finished() const                            { return _finished; }
+    virtual bool sourceValid() const                   { return true; }
+
+  protected:
+    int                         _code;
+    String                      _contentType;
+    size_t                      _contentLength = 0;
+    bool                        _sendContentLength = true;
+    bool                        _chunked = false;
+    std::vector<AsyncWebHeader> _headers;
+    size_t                      _sent = 0;             // Body bytes so far
+    bool                        _finished = false;
+
+    virtual void   start() {}                          // Just before the head goes out
+    virtual size_t fill( uint8_t *buffer, size_t maxLen, size_t index ) = 0;
+};
+
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print
+{
+  public:
+    AsyncResponseStream( const String &contentType, size_t bufferSize );
+    ~AsyncResponseStream();
+
+    size_t write( uint8_t c ) override                          { return write( &c, 1 ); }
+    size_t write( const uint8_t *data, size_t len ) override;
+    using Print::write;
+
+  protected:
+    void   start() override;
+    size_t fill( uint8_t *buffer, size_t maxLen, size_t index ) override;
+
+  private:
+    char   *_buf  = nullptr;       // The core's cbuf: sized once, grown on demand
+    size_t  _size = 0;
+    size_t  _used = 0;
+};
+
+
+class AsyncWebServerRequest
+{
+  public:
+    AsyncWebServerRequest();
+    ~AsyncWebServerRequest();
+
+    // Host: read a raw request, true once it's all in (false and an
+    // empty method on a bad one)
+    bool parse( std::string &data, AsyncWebServer *server );
+
+    const String&             url() const                  { return _url; }
+    WebRequestMethodComposite method() const               { return _method; }
+    const String&             contentType() const          { return _contentType; }
+
+    size_t             params() const                      { return _params.size(); }
+    AsyncWebParameter* getParam( size_t num );
+    AsyncWebParameter* getParam( const String &name, bool post = false, bool file = false );
+    bool               hasParam( const String &name, bool post = false, bool file = false );
+
+    size_t        args() const                             { return params(); }
+    bool          hasArg( const char *name ) const;
+    const String& arg( const String &name ) const;
+
+    size_t          headers() const                        { return _headers.size(); }
+    bool            hasHeader( const String &name ) const;
+    AsyncWebHeader* getHeader( const String &name );
+
+    bool authenticate( const char *username, const char *password, const char *realm = nullptr, bool passwordIsHash = false );
+    void requestAuthentication( const char *realm = nullptr, bool isDigest = true );
+
+    void send( AsyncWebServerResponse *response );
+    void send( int code, const String &contentType = String(), const String &content = String() );
+    void send_P( int code, const String &contentType, const uint8_t *content, size_t len );
+    void send_P( int code, const String &contentType, const char *content );
+
+    AsyncWebServerResponse* beginResponse( int code, const String &contentType = String(), const String &content = String() );
+    AsyncWebServerResponse* beginResponse( FS &fs, const String &path, const String &contentType = String(), bool download = false );
+    AsyncWebServerResponse* beginResponse( const String &contentType, size_t len, AwsResponseFiller callback );
+    AsyncWebServerResponse* beginResponse_P( int code, const String &contentType, const uint8_t *content, size_t len );
+    AsyncWebServerResponse* beginResponse_P( int code, const String &contentType, const char *content );
+    AsyncWebServerResponse* beginChunkedResponse( const String &contentType, AwsResponseFiller callback );
+    AsyncResponseStream*    beginResponseStream( const String &contentType, size_t bufferSize = 1460 );
+
+    // Host: what the handler sent, if anything yet
+    AsyncWebServerResponse* response()                     { return _response; }
+    void                    clearResponse();
+
+  private:
+    friend class AsyncWebServer;
+
+    enum { PARSE_HEAD, PARSE_BODY, PARSE_DONE } _state = PARSE_HEAD;
+
+    WebRequestMethodComposite       _method = 0;
+    String                          _url;
+    bool                            _http11 = true;
+    String                          _contentType;
+    String                          _boundary;
+    size_t                          _contentLength = 0;
+    std::vector<AsyncWebParameter>  _params;
+    std::vector<AsyncWebHeader>     _headers;
+    AsyncWebServerResponse         *_response = nullptr;
+    std::string                     _body;
+    ArUploadHandlerFunction         _upload;
+
+    void query( const std::string &text, bool form );
+    void multipart();
+};
+
+
+class AsyncCallbackWebHandler
+{
+  public:
+    AsyncCallbackWebHandler( const String &uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                             ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody )
+      : _uri( uri ), _method( method ), _onRequest( onRequest ), _onUpload( onUpload ), _onBody( onBody ) {}
+
+    bool canHandle( AsyncWebServerRequest *request ) const;
+
+  private:
+    friend class AsyncWebServer;
+    friend class AsyncWebServerRequest;
+
+    String                    _uri;
+    WebRequestMethodComposite _method;
+    ArRequestHandlerFunction  _onRequest;
+    ArUploadHandlerFunction   _onUpload;
+    ArBodyHandlerFunction     _onBody;
+};
+
+
+class AsyncWebServer
+{
+  public:
+    AsyncWebServer( uint16_t port );
+    ~AsyncWebServer();
+
+    void begin();
+    void end();
+
+    AsyncCallbackWebHandler& on( const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                                 ArUploadHandlerFunction onUpload = nullptr, ArBodyHandlerFunction onBody = nullptr );
+    AsyncCallbackWebHandler& on( const char *uri, ArRequestHandlerFunction onRequest ) {
+      return on( uri, HTTP_ANY, onRequest );
+    }
+    void onNotFound( ArRequestHandlerFunction fn )          { _notFound = fn; }
+
+    // Host: run the handler for a parsed request, as the server would
+    void dispatch( AsyncWebServerRequest *request );
+    uint16_t port() const                                   { return _port; }
+
+  private:
+    friend class AsyncWebServerRequest;
+    struct connection;
+
+    uint16_t                                              _port;
+    int                                                   _listen = -1;
+    std::vector<std::unique_ptr<AsyncCallbackWebHandler>> _handlers;
+    ArRequestHandlerFunction                              _notFound;
+    std::vector<std::unique_ptr<connection>>              _connections;
+
+    const AsyncCallbackWebHandler* handler( AsyncWebServerRequest *request ) const;
+    void poll( unsigned long ms );
+    bool serve( connection &c );
+};
+
+#endif
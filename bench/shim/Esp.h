@@ -0,0 +1,45 @@
+//
+// Esp.h - Host shim of the ESP object: heap figures, RTC user memory
+//         (kept for the life of the process, as across a soft restart),
+//         the running sketch and flash reads
+//
+
+#ifndef Esp_h
+#define Esp_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "WString.h"
+
+struct rst_info;
+
+class EspClass
+{
+  public:
+    uint32_t  getFreeHeap();
+    uint32_t  getMaxFreeBlockSize();
+    uint8_t   getHeapFragmentation();
+    uint32_t  getChipId();
+    uint8_t   getCpuFreqMHz()          { return 80; }
+    uint32_t  getCycleCount();
+    uint32_t  getFlashChipSize()       { return 4 * 1024 * 1024; }
+    uint32_t  random();
+
+    struct rst_info* getResetInfoPtr();
+    String    getResetReason();
+    void      restart();
+    void      reset()                  { restart(); }
+
+    bool      rtcUserMemoryRead( uint32_t offset, uint32_t *data, size_t size );
+    bool      rtcUserMemoryWrite( uint32_t offset, uint32_t *data, size_t size );
+
+    uint32_t  getSketchSize();
+    String    getSketchMD5();
+    uint32_t  getFreeSketchSpace();
+    bool      flashRead( uint32_t offset, uint32_t *data, size_t size );
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,240 @@
+//
+// FS.cpp - Host shim of SPIFFS, kept in a directory
+//
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FS.h"
+#include "Host.h"
+
+fs::FS SPIFFS;
+
+namespace fs {
+
+struct FileImpl {
+  FILE        *fp;
+  std::string  name;
+
+  ~FileImpl() { if ( fp ) fclose( fp ); }
+};
+
+
+static std::string host_path( const char *path ) {
+  return host::spiffs_root + ( path[0] == '/' ? "" : "/" ) + path;
+}
+
+static bool valid_name( const char *path ) {
+  return path && path[0] && strlen( path ) < SPIFFS_OBJ_NAME_LEN;
+}
+
+// SPIFFS has no directories, the host needs them for names with slashes
+static void make_parents( const std::string &path ) {
+  for ( size_t at = host::spiffs_root.size() + 1; ( at = path.find( '/', at ) ) != std::string::npos; at++ )
+    mkdir( path.substr( 0, at ).c_str(), 0755 );
+}
+
+static void list( const std::string &dir, const std::string &prefix, std::vector<std::string> &names ) {
+  DIR *d = opendir( dir.c_str() );
+  if ( !d ) return;
+
+  struct dirent *e;
+  while ( ( e = readdir( d ) ) ) {
+    if ( e->d_name[0] == '.' ) continue;
+
+    std::string name = prefix + "/" + e->d_name;
+    std::string path = dir + "/" + e->d_name;
+    struct stat st;
+    if ( stat( path.c_str(), &st ) != 0 ) continue;
+
+    if ( S_ISDIR( st.st_mode ) ) list( path, name, names );
+    else                         names.push_back( name );
+  }
+  closedir( d );
+}
+
+
+//
+// File
+
+size_t File::write( uint8_t c ) {
+  return write( &c, 1 );
+}
+
+size_t File::write( const uint8_t *buffer, size_t size ) {
+  if ( !_impl ) return 0;
+  return fwrite( buffer, 1, size, _impl->fp );
+}
+
+int File::available() {
+  if ( !_impl ) return 0;
+  return size() - position();
+}
+
+int File::read() {
+  uint8_t c;
+  return read( &c, 1 ) == 1 ? c : -1;
+}
+
+int File::peek() {
+  if ( !_impl ) return -1;
+  int c = fgetc( _impl->fp );
+  if ( c >= 0 ) ungetc( c, _impl->fp );
+  return c;
+}
+
+void File::flush() {
+  if ( _impl ) fflush( _impl->fp );
+}
+
+size_t File::read( uint8_t *buffer, size_t size ) {
+  if ( !_impl ) return 0;
+  return fread( buffer, 1, size, _impl->fp );
+}
+
+// Whatever's left, in one go
+String File::readString() {
+  String out;
+  int    left = available();
+  if ( left <= 0 ) return out;
+
+  out.reserve( left );
+  char buf[ 256 ];
+  size_t n;
+  while ( ( n = read( (uint8_t *)buf, sizeof(buf) ) ) > 0 ) out.concat( buf, n );
+  return out;
+}
+
+bool File::seek( uint32_t pos, SeekMode mode ) {
+  if ( !_impl ) return false;
+  return fseek( _impl->fp, pos, mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END ) == 0;
+}
+
+size_t File::position() const {
+  return _impl ? ftell( _impl->fp ) : 0;
+}
+
+size_t File::size() const {
+  if ( !_impl ) return 0;
+  fflush( _impl->fp );
+  struct stat st;
+  return fstat( fileno( _impl->fp ), &st ) == 0 ? st.st_size : 0;
+}
+
+void File::close() {
+  _impl.reset();
+}
+
+const char* File::name() const {
+  return _impl ? _impl->name.c_str() : "";
+}
+
+File::operator bool() const {
+  return (bool)_impl;
+}
+
+
+//
+// Dir
+
+bool Dir::next() {
+  if ( _next >= _names.size() ) return false;
+  _next++;
+  return true;
+}
+
+String Dir::fileName() {
+  return _next ? String( _names[ _next - 1 ].c_str() ) : String();
+}
+
+size_t Dir::fileSize() {
+  struct stat st;
+  if ( !_next || stat( host_path( _names[ _next - 1 ].c_str() ).c_str(), &st ) != 0 ) return 0;
+  return st.st_size;
+}
+
+File Dir::openFile( const char *mode ) {
+  return _next ? SPIFFS.open( _names[ _next - 1 ].c_str(), mode ) : File();
+}
+
+
+//
+// FS
+
+bool FS::begin() {
+  mkdir( host::spiffs_root.c_str(), 0755 );
+  return true;
+}
+
+bool FS::format() {
+  Dir dir = openDir( "/" );
+  while ( dir.next() ) remove( dir.fileName() );
+  return true;
+}
+
+bool FS::info( FSInfo &info ) {
+  size_t used = 0;
+  Dir    dir  = openDir( "/" );
+  while ( dir.next() ) used += ( dir.fileSize() + 255 ) & ~255;
+
+  info.totalBytes    = host::spiffs_size;
+  info.usedBytes     = used;
+  info.blockSize     = 8192;
+  info.pageSize      = 256;
+  info.maxOpenFiles  = 5;
+  info.maxPathLength = SPIFFS_OBJ_NAME_LEN;
+  return true;
+}
+
+// "r", "r+", "w", "w+", "a", "a+" as fopen.  Opening to write creates
+// the file, reading one that isn't there gives a File that's false.
+File FS::open( const char *path, const char *mode ) {
+  if ( !valid_name( path ) ) return File();
+
+  std::string full = host_path( path );
+  if ( mode[0] != 'r' ) make_parents( full );
+
+  // SPIFFS "r+" can't grow past the end, but it can open for update
+  FILE *fp = fopen( full.c_str(), mode[0] == 'r' && mode[1] == '+' ? "r+b" :
+                                   mode[0] == 'r' ? "rb" :
+                                   mode[0] == 'w' ? ( mode[1] == '+' ? "w+b" : "wb" ) :
+                                                    ( mode[1] == '+' ? "a+b" : "ab" ) );
+  if ( !fp ) return File();
+
+  auto impl  = std::make_shared<FileImpl>();
+  impl->fp   = fp;
+  impl->name = path;
+  return File( impl );
+}
+
+bool FS::exists( const char *path ) {
+  struct stat st;
+  return valid_name( path ) && stat( host_path( path ).c_str(), &st ) == 0 && S_ISREG( st.st_mode );
+}
+
+bool FS::remove( const char *path ) {
+  return valid_name( path ) && unlink( host_path( path ).c_str() ) == 0;
+}
+
+// Fails if the new name is taken, like SPIFFS
+bool FS::rename( const char *from, const char *to ) {
+  if ( !valid_name( from ) || !valid_name( to ) || exists( to ) || !exists( from ) ) return false;
+
+  std::string dest = host_path( to );
+  make_parents( dest );
+  return ::rename( host_path( from ).c_str(), dest.c_str() ) == 0;
+}
+
+// Every file whose name starts with path
+Dir FS::openDir( const char *path ) {
+  std::vector<std::string> all, names;
+  list( host::spiffs_root, "", all );
+
+  for ( const std::string &name : all )
+    if ( name.compare( 0, strlen( path ), path ) == 0 ) names.push_back( name );
+  return Dir( names );
+}
+
+}
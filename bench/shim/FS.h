@@ -0,0 +1,118 @@
+//
+// FS.h - Host shim of SPIFFS, kept in a directory (host::spiffs_root).
+//        Names are flat with slashes in them, as on SPIFFS, and limited
+//        to its 31 characters.
+//
+
+#ifndef FS_h
+#define FS_h
+
+#include <stdio.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+#define SPIFFS_OBJ_NAME_LEN  32
+
+namespace fs {
+
+enum SeekMode {
+  SeekSet = 0,
+  SeekCur = 1,
+  SeekEnd = 2
+};
+
+struct FSInfo {
+  size_t totalBytes;
+  size_t usedBytes;
+  size_t blockSize;
+  size_t pageSize;
+  size_t maxOpenFiles;
+  size_t maxPathLength;
+};
+
+struct FileImpl;
+
+class File : public Stream
+{
+  public:
+    File() {}
+    File( std::shared_ptr<FileImpl> impl ) : _impl( impl ) {}
+
+    size_t write( uint8_t c ) override;
+    size_t write( const uint8_t *buffer, size_t size ) override;
+    int    available() override;
+    int    read() override;
+    int    peek() override;
+    void   flush() override;
+    size_t read( uint8_t *buffer, size_t size );
+    size_t readBytes( uint8_t *buffer, size_t length ) override { return read( buffer, length ); }
+    String readString();
+
+    bool   seek( uint32_t pos, SeekMode mode );
+    bool   seek( uint32_t pos ) { return seek( pos, SeekSet ); }
+    size_t position() const;
+    size_t size() const;
+    void   close();
+    const char* name() const;
+    operator bool() const;
+
+    using Print::write;
+    using Stream::readBytes;
+
+  private:
+    std::shared_ptr<FileImpl> _impl;
+};
+
+class Dir
+{
+  public:
+    Dir() {}
+    Dir( const std::vector<std::string> &names ) : _names( names ) {}
+
+    bool   next();
+    String fileName();
+    size_t fileSize();
+    File   openFile( const char *mode );
+
+  private:
+    std::vector<std::string> _names;
+    size_t                   _next = 0;
+};
+
+class FS
+{
+  public:
+    bool begin();
+    void end() {}
+    bool format();
+    bool info( FSInfo &info );
+
+    File open( const char *path, const char *mode );
+    File open( const String &path, const char *mode ) { return open( path.c_str(), mode ); }
+    bool exists( const char *path );
+    bool exists( const String &path )                { return exists( path.c_str() ); }
+    bool remove( const char *path );
+    bool remove( const String &path )                { return remove( path.c_str() ); }
+    bool rename( const char *from, const char *to );
+    bool rename( const String &from, const String &to ) { return rename( from.c_str(), to.c_str() ); }
+    Dir  openDir( const char *path );
+    Dir  openDir( const String &path )               { return openDir( path.c_str() ); }
+};
+
+}
+
+using fs::FS;
+using fs::File;
+using fs::Dir;
+using fs::FSInfo;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+extern fs::FS SPIFFS;
+
+#endif
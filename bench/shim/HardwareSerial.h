@@ -0,0 +1,33 @@
+//
+// HardwareSerial.h - Host shim of the UART, Serial goes to stderr so
+//                    stdout is left to whatever drives the firmware
+//
+
+#ifndef HardwareSerial_h
+#define HardwareSerial_h
+
+#include "Stream.h"
+
+#define SERIAL_TX_FIFO  128   // The UART's, Log only ever writes what fits
+
+class HardwareSerial : public Stream
+{
+  public:
+    void   begin( unsigned long baud ) { (void)baud; }
+    void   end() {}
+
+    size_t write( uint8_t c ) override;
+    size_t write( const uint8_t *buffer, size_t size ) override;
+    int    availableForWrite() override { return SERIAL_TX_FIFO; }
+    void   flush() override;
+
+    int    available() override { return 0; }
+    int    read() override      { return -1; }
+    int    peek() override      { return -1; }
+
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,417 @@
+//
+// Host.cpp - Host shim of the ESP8266 core: time, pins, the ESP object,
+//            Serial, and the heap accounting behind String and new
+//
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <new>
+#include <random>
+
+#include <openssl/evp.h>
+
+#include "Arduino.h"
+#include "Host.h"
+#include "user_interface.h"
+#include "umm_malloc/umm_malloc.h"
+
+#define HOST_HEAP_FREE   40000      // Roughly what the firmware has after boot
+#define RTC_USER_WORDS   128        // RTC user memory, 512 bytes
+
+
+namespace host {
+  heap_stats heap = { 0, 0, 0, HOST_HEAP_FREE };
+
+  std::function<void(unsigned long)>             poller;
+  std::function<int(uint8_t)>                    analog;
+  std::function<bool(float &, float &)>          dht;
+  std::function<void()>                          restart;
+
+  // Set up ahead of the firmware's globals, which use them
+  std::string mac         __attribute__(( init_priority( 101 ) )) = "5C:CF:7F:00:00:01";
+  bool        ntp         = true;
+  std::string spiffs_root __attribute__(( init_priority( 101 ) )) = "spiffs";
+  std::string eeprom_file __attribute__(( init_priority( 101 ) ));
+  std::string sketch_file __attribute__(( init_priority( 101 ) ));
+  size_t      spiffs_size = 1024 * 1024;
+  uint16_t    http_port   = 0;
+  bool        quiet       = false;
+
+  static bool     _virtual    = false;
+  static uint64_t _virtual_us = 0;
+  static uint64_t _start_ns   = 0;
+  static bool     _polling    = false;
+  static std::string _resolve __attribute__(( init_priority( 101 ) )) = "pool.ntp.org=127.0.0.1";   // WiFiUDP answers SNTP itself
+}
+
+
+//
+// Heap
+
+static void heap_taken( void *ptr ) {
+  host::heap.allocs++;
+  host::heap.live += malloc_usable_size( ptr );
+
+  int64_t free = HOST_HEAP_FREE - host::heap.live;
+  if ( free < host::heap.low ) host::heap.low = free;
+}
+
+void* host::heap_realloc( void *ptr, size_t size ) {
+  if ( ptr ) heap.live -= malloc_usable_size( ptr );
+  void *p = realloc( ptr, size );
+  heap.bytes += size;
+  if ( p ) heap_taken( p );
+  return p;
+}
+
+void host::heap_free( void *ptr ) {
+  if ( !ptr ) return;
+  heap.live -= malloc_usable_size( ptr );
+  free( ptr );
+}
+
+void* operator new( size_t size ) {
+  void *p = malloc( size ? size : 1 );
+  if ( !p ) throw std::bad_alloc();
+  host::heap.bytes += size;
+  heap_taken( p );
+  return p;
+}
+
+void* operator new[]( size_t size )                      { return operator new( size ); }
+void  operator delete( void *ptr ) noexcept              { host::heap_free( ptr ); }
+void  operator delete[]( void *ptr ) noexcept            { host::heap_free( ptr ); }
+void  operator delete( void *ptr, size_t ) noexcept      { host::heap_free( ptr ); }
+void  operator delete[]( void *ptr, size_t ) noexcept    { host::heap_free( ptr ); }
+
+extern "C" uint32_t umm_free_heap_size_min() {
+  return host::heap.low;
+}
+
+extern "C" uint32_t umm_free_heap_size_min_reset() {
+  host::heap.low = HOST_HEAP_FREE - host::heap.live;
+  return host::heap.low;
+}
+
+
+//
+// Settings
+
+bool host::resolve( const char *name, uint32_t &address, uint16_t *port ) {
+  size_t len = strlen( name );
+  size_t at  = 0;
+
+  while ( at < _resolve.size() ) {
+    size_t end = _resolve.find( ',', at );
+    if ( end == std::string::npos ) end = _resolve.size();
+
+    std::string entry = _resolve.substr( at, end - at );
+    size_t      eq    = entry.find( '=' );
+    if ( eq == len && entry.compare( 0, len, name ) == 0 ) {
+      unsigned a, b, c, d, p;
+      int      n = sscanf( entry.c_str() + eq + 1, "%u.%u.%u.%u:%u", &a, &b, &c, &d, &p );
+      if ( n < 4 ) return false;
+      address = a | ( b << 8 ) | ( c << 16 ) | ( d << 24 );
+      if ( n == 5 && port ) *port = p;
+      return true;
+    }
+    at = end + 1;
+  }
+  return false;
+}
+
+// Before any of the firmware's constructors, Config's reads the EEPROM
+namespace host {
+static void configure() {
+  const char *v;
+
+  if ( ( v = getenv( "HOST_MAC" ) ) )        mac         = v;
+  if ( ( v = getenv( "HOST_RESOLVE" ) ) )    _resolve   += std::string( "," ) + v;
+  if ( ( v = getenv( "HOST_NTP" ) ) )        ntp         = atoi( v ) != 0;
+  if ( ( v = getenv( "HOST_SPIFFS" ) ) )     spiffs_root = v;
+  if ( ( v = getenv( "HOST_EEPROM" ) ) )     eeprom_file = v;
+  if ( ( v = getenv( "HOST_SKETCH" ) ) )     sketch_file = v;
+  if ( ( v = getenv( "HOST_HTTP_PORT" ) ) )  http_port   = atoi( v );
+  if ( ( v = getenv( "HOST_QUIET" ) ) )      quiet       = atoi( v ) != 0;
+}
+}
+
+static struct configured {
+  configured() { host::configure(); }
+} _configured __attribute__(( init_priority( 102 ) ));
+
+
+//
+// Time
+
+static uint64_t monotonic_ns() {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void host::virtual_clock( uint64_t start_us ) {
+  _virtual    = true;
+  _virtual_us = start_us;
+}
+
+bool host::is_virtual_clock() {
+  return _virtual;
+}
+
+void host::advance( uint64_t us ) {
+  _virtual_us += us;
+}
+
+uint64_t host::now_us() {
+  if ( _virtual ) return _virtual_us;
+  if ( _start_ns == 0 ) _start_ns = monotonic_ns();
+  return ( monotonic_ns() - _start_ns ) / 1000;
+}
+
+// The poller isn't run from inside itself, a handler that waits just waits
+static void idle( unsigned long ms ) {
+  if ( host::poller && !host::_polling ) {
+    host::_polling = true;
+    host::poller( host::_virtual ? 0 : ms );
+    host::_polling = false;
+    return;
+  }
+  if ( !host::_virtual && ms ) usleep( ms * 1000 );
+}
+
+extern "C" {
+
+unsigned long millis() { return host::now_us() / 1000; }
+unsigned long micros() { return host::now_us(); }
+
+void delay( unsigned long ms ) {
+  if ( host::_virtual ) {
+    host::_virtual_us += ms * 1000ULL;
+    idle( 0 );
+    return;
+  }
+
+  // The poller can return early, keep at it for the whole delay
+  uint64_t until = host::now_us() + ms * 1000ULL;
+  do {
+    uint64_t now = host::now_us();
+    idle( now < until ? ( until - now + 999 ) / 1000 : 0 );
+  } while ( host::now_us() < until );
+}
+
+void delayMicroseconds( unsigned int us ) {
+  if ( host::_virtual ) host::_virtual_us += us;
+  else                  usleep( us );
+}
+
+void yield() {
+  idle( 0 );
+}
+
+
+//
+// Pins
+
+void pinMode( uint8_t, uint8_t )      {}
+void digitalWrite( uint8_t, uint8_t ) {}
+int  digitalRead( uint8_t )           { return LOW; }
+
+int analogRead( uint8_t pin ) {
+  return host::analog ? host::analog( pin ) : 300;
+}
+
+
+//
+// Number formatting from the core's stdlib_noniso
+
+static char* to_base( unsigned long long value, char *buf, int base, bool negative ) {
+  char  tmp[ 66 ];
+  char *p = tmp;
+
+  if ( base < 2 || base > 36 ) base = 10;
+  do {
+    int digit = value % base;
+    *p++  = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    value /= base;
+  } while ( value );
+
+  char *out = buf;
+  if ( negative ) *out++ = '-';
+  while ( p > tmp ) *out++ = *--p;
+  *out = '\0';
+  return buf;
+}
+
+char* itoa( int value, char *buf, int base ) {
+  if ( base == 10 && value < 0 ) return to_base( -(long long)value, buf, base, true );
+  return to_base( (unsigned int)value, buf, base, false );
+}
+
+char* ltoa( long value, char *buf, int base ) {
+  if ( base == 10 && value < 0 ) return to_base( -(long long)value, buf, base, true );
+  return to_base( (unsigned long)value, buf, base, false );
+}
+
+char* utoa( unsigned int value, char *buf, int base )   { return to_base( value, buf, base, false ); }
+char* ultoa( unsigned long value, char *buf, int base ) { return to_base( value, buf, base, false ); }
+
+// The core writes "nan" and "inf" without a sign or padding
+char* dtostrf( double value, signed char width, unsigned char prec, char *buf ) {
+  if ( isnan( value ) ) { strcpy( buf, "nan" ); return buf; }
+  if ( isinf( value ) ) { strcpy( buf, value < 0 ? "-inf" : "inf" ); return buf; }
+  sprintf( buf, "%*.*f", width, prec, value );
+  return buf;
+}
+
+}
+
+
+static std::mt19937 _random;
+
+long random( long howbig ) {
+  if ( howbig <= 0 ) return 0;
+  return _random() % howbig;
+}
+
+long random( long howsmall, long howbig ) {
+  if ( howsmall >= howbig ) return howsmall;
+  return howsmall + random( howbig - howsmall );
+}
+
+void randomSeed( unsigned long seed ) {
+  _random.seed( seed );
+}
+
+
+//
+// Serial
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write( uint8_t c ) {
+  if ( !host::quiet ) fputc( c, stderr );
+  return 1;
+}
+
+size_t HardwareSerial::write( const uint8_t *buffer, size_t size ) {
+  if ( !host::quiet ) fwrite( buffer, 1, size, stderr );
+  return size;
+}
+
+void HardwareSerial::flush() {
+  fflush( stderr );
+}
+
+
+//
+// ESP
+
+EspClass ESP;
+
+static uint32_t        _rtc[ RTC_USER_WORDS ];
+static struct rst_info _reset = { REASON_DEFAULT_RST, 0, 0, 0, 0, 0, 0 };
+
+uint32_t EspClass::getFreeHeap() {
+  int64_t free = HOST_HEAP_FREE - host::heap.live;
+  return free > 0 ? free : 0;
+}
+
+// No fragmentation to speak of in a host heap
+uint32_t EspClass::getMaxFreeBlockSize()  { return getFreeHeap(); }
+uint8_t  EspClass::getHeapFragmentation() { return 0; }
+
+uint32_t EspClass::getChipId() {
+  unsigned a, b, c;
+  if ( sscanf( host::mac.c_str() + 9, "%x:%x:%x", &a, &b, &c ) != 3 ) return 0;
+  return ( a << 16 ) | ( b << 8 ) | c;
+}
+
+// At 80 MHz
+uint32_t EspClass::getCycleCount() {
+  return host::now_us() * 80;
+}
+
+uint32_t EspClass::random() {
+  return _random();
+}
+
+struct rst_info* EspClass::getResetInfoPtr() {
+  return &_reset;
+}
+
+String EspClass::getResetReason() {
+  return String( "Power on" );
+}
+
+void EspClass::restart() {
+  fflush( stderr );
+  if ( host::restart ) host::restart();
+  exit( 0 );
+}
+
+// 4 byte blocks, as the SDK's system_rtc_mem_read/write
+bool EspClass::rtcUserMemoryRead( uint32_t offset, uint32_t *data, size_t size ) {
+  if ( offset * 4 + size > sizeof(_rtc) || ( size & 3 ) ) return false;
+  memcpy( data, _rtc + offset, size );
+  return true;
+}
+
+bool EspClass::rtcUserMemoryWrite( uint32_t offset, uint32_t *data, size_t size ) {
+  if ( offset * 4 + size > sizeof(_rtc) || ( size & 3 ) ) return false;
+  memcpy( _rtc + offset, data, size );
+  return true;
+}
+
+
+// The running firmware is the host binary, or HOST_SKETCH
+static FILE* sketch() {
+  static FILE *f = fopen( host::sketch_file.empty() ? "/proc/self/exe" : host::sketch_file.c_str(), "rb" );
+  return f;
+}
+
+uint32_t EspClass::getSketchSize() {
+  FILE *f = sketch();
+  if ( !f || fseek( f, 0, SEEK_END ) != 0 ) return 0;
+  return ftell( f );
+}
+
+String EspClass::getSketchMD5() {
+  static String md5;
+  if ( md5.length() > 0 ) return md5;
+
+  FILE *f = sketch();
+  if ( !f ) return md5;
+
+  EVP_MD_CTX   *ctx = EVP_MD_CTX_new();
+  unsigned char buf[ 4096 ], digest[ 16 ];
+  size_t        n;
+
+  EVP_DigestInit_ex( ctx, EVP_md5(), nullptr );
+  fseek( f, 0, SEEK_SET );
+  while ( ( n = fread( buf, 1, sizeof(buf), f ) ) > 0 )
+    EVP_DigestUpdate( ctx, buf, n );
+  EVP_DigestFinal_ex( ctx, digest, nullptr );
+  EVP_MD_CTX_free( ctx );
+
+  char hex[ 33 ];
+  for ( int i = 0; i < 16; i++ ) sprintf( hex + i * 2, "%02x", digest[i] );
+  md5 = hex;
+  return md5;
+}
+
+// As on a 4M flash with 1M of SPIFFS
+uint32_t EspClass::getFreeSketchSpace() {
+  uint32_t size = getSketchSize();
+  return size < 1024 * 1024 ? ( 1024 * 1024 - size ) & ~0xfff : 0;
+}
+
+bool EspClass::flashRead( uint32_t offset, uint32_t *data, size_t size ) {
+  FILE *f = sketch();
+  if ( !f || fseek( f, offset, SEEK_SET ) != 0 ) return false;
+  memset( data, 0xff, size );
+  fread( data, 1, size, f );
+  return true;
+}
@@ -0,0 +1,76 @@
+//
+// Host.h - What the shims take from the test or bench driving them:
+//          the clock, sensor inputs, where SPIFFS and EEPROM live, and
+//          the heap accounting bench/ reports.  The HOST_* settings
+//          are read from the environment before the firmware's globals
+//          are constructed.
+//
+
+#ifndef Host_h
+#define Host_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <string>
+
+namespace host {
+
+  // Heap use through String and new.  free is what getFreeHeap()
+  // reports, the ESP's free heap after boot less what's live.
+  struct heap_stats {
+    uint64_t allocs;             // malloc/realloc calls
+    uint64_t bytes;              // Bytes asked for by them
+    int64_t  live;               // Bytes held now
+    int64_t  low;                // Least free seen, for umm_free_heap_size_min()
+  };
+  extern heap_stats heap;
+
+  void* heap_realloc( void *ptr, size_t size );
+  void  heap_free( void *ptr );
+
+  // millis()/micros() follow the real clock, unless a test switches
+  // to a virtual one that only moves in delay() and advance()
+  void     virtual_clock( uint64_t start_us = 0 );
+  bool     is_virtual_clock();
+  void     advance( uint64_t us );
+  uint64_t now_us();
+
+  // Run while the firmware waits in delay()/yield(), the way the SDK
+  // runs the TCP stack.  Gets the ms it may block for, 0 - just poll.
+  extern std::function<void(unsigned long)> poller;
+
+  // Sensor inputs.  dht returns false for a failed read.
+  extern std::function<int(uint8_t pin)>                    analog;
+  extern std::function<bool(float &temp_f, float &humidity)> dht;
+
+  // Network identity and name lookups: HOST_MAC, and HOST_RESOLVE as
+  // "name=address[:port],...", e.g. to point UPDATE_SERVER at a local
+  // stub.  A port given there is used in place of the one connected to.
+  extern std::string mac;
+  bool resolve( const char *name, uint32_t &address, uint16_t *port = nullptr );
+
+  // The SNTP server answers with the host's time unless this is off
+  extern bool ntp;
+
+  // HOST_SPIFFS, the directory SPIFFS lives in, and HOST_EEPROM, the
+  // file the EEPROM is saved to (memory only if empty)
+  extern std::string spiffs_root;
+  extern std::string eeprom_file;
+
+  // HOST_SKETCH, the image ESP reports running and patches copy from,
+  // the host binary if empty
+  extern std::string sketch_file;
+  extern size_t      spiffs_size;
+
+  // HOST_HTTP_PORT, the web server's port if not the firmware's
+  extern uint16_t http_port;
+
+  // HOST_QUIET=1, serial output is dropped
+  extern bool quiet;
+
+  // Called by ESP.restart(), which exits if it returns
+  extern std::function<void()> restart;
+}
+
+#endif
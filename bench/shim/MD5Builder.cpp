@@ -0,0 +1,52 @@
+//
+// MD5Builder.cpp - Host shim of the core's MD5Builder on OpenSSL
+//
+
+#include <openssl/evp.h>
+
+#include "MD5Builder.h"
+
+MD5Builder::MD5Builder() {
+  memset( _digest, 0, sizeof(_digest) );
+}
+
+MD5Builder::~MD5Builder() {
+  if ( _ctx ) EVP_MD_CTX_free( (EVP_MD_CTX *)_ctx );
+}
+
+void MD5Builder::begin() {
+  if ( !_ctx ) _ctx = EVP_MD_CTX_new();
+  EVP_DigestInit_ex( (EVP_MD_CTX *)_ctx, EVP_md5(), nullptr );
+  memset( _digest, 0, sizeof(_digest) );
+}
+
+void MD5Builder::add( const uint8_t *data, uint16_t len ) {
+  EVP_DigestUpdate( (EVP_MD_CTX *)_ctx, data, len );
+}
+
+bool MD5Builder::addStream( Stream &stream, const size_t maxLen ) {
+  uint8_t buf[ 512 ];
+  size_t  left = maxLen;
+
+  while ( left > 0 ) {
+    size_t n = stream.readBytes( buf, left < sizeof(buf) ? left : sizeof(buf) );
+    if ( n == 0 ) return false;
+    add( buf, n );
+    left -= n;
+  }
+  return true;
+}
+
+void MD5Builder::calculate() {
+  EVP_DigestFinal_ex( (EVP_MD_CTX *)_ctx, _digest, nullptr );
+}
+
+void MD5Builder::getChars( char *output ) {
+  for ( int i = 0; i < 16; i++ ) sprintf( output + i * 2, "%02x", _digest[i] );
+}
+
+String MD5Builder::toString() {
+  char out[33];
+  getChars( out );
+  return String( out );
+}
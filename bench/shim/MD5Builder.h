@@ -0,0 +1,31 @@
+//
+// MD5Builder.h - Host shim of the core's MD5Builder on OpenSSL
+//
+
+#ifndef MD5Builder_h
+#define MD5Builder_h
+
+#include "Arduino.h"
+
+class MD5Builder
+{
+  public:
+    MD5Builder();
+    ~MD5Builder();
+
+    void   begin();
+    void   add( const uint8_t *data, uint16_t len );
+    void   add( const char *data )             { add( (const uint8_t *)data, strlen( data ) ); }
+    void   add( const String &data )           { add( (const uint8_t *)data.c_str(), data.length() ); }
+    bool   addStream( Stream &stream, const size_t maxLen );
+    void   calculate();
+    void   getBytes( uint8_t *output )         { memcpy( output, _digest, 16 ); }
+    void   getChars( char *output );
+    String toString();
+
+  private:
+    void    *_ctx = nullptr;
+    uint8_t  _digest[16];
+};
+
+#endif
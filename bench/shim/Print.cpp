@@ -0,0 +1,100 @@
+//
+// Print.cpp - Host shim of the Arduino Print and Stream interfaces
+//
+
+#include "Arduino.h"
+
+
+size_t Print::write( const uint8_t *buffer, size_t size ) {
+  size_t n = 0;
+  while ( size-- && write( *buffer++ ) ) n++;
+  return n;
+}
+
+size_t Print::printf( const char *format, ... ) {
+  char    buf[ 256 ];
+  va_list args;
+
+  va_start( args, format );
+  int len = vsnprintf( buf, sizeof(buf), format, args );
+  va_end( args );
+  if ( len < 0 ) return 0;
+  if ( (size_t)len < sizeof(buf) ) return write( (const uint8_t *)buf, len );
+
+  char *big = (char *)malloc( len + 1 );
+  if ( !big ) return 0;
+  va_start( args, format );
+  vsnprintf( big, len + 1, format, args );
+  va_end( args );
+  size_t n = write( (const uint8_t *)big, len );
+  free( big );
+  return n;
+}
+
+size_t Print::print( long value, int base ) {
+  char buf[ 66 ];
+  return write( ltoa( value, buf, base ) );
+}
+
+size_t Print::print( unsigned long value, int base ) {
+  char buf[ 65 ];
+  return write( ultoa( value, buf, base ) );
+}
+
+size_t Print::print( long long value, int base ) {
+  char buf[ 24 ];
+  if ( base != 10 ) return print( (unsigned long long)value, base );
+  snprintf( buf, sizeof(buf), "%lld", value );
+  return write( buf );
+}
+
+size_t Print::print( unsigned long long value, int base ) {
+  char buf[ 24 ];
+  snprintf( buf, sizeof(buf), base == 16 ? "%llx" : base == 8 ? "%llo" : "%llu", value );
+  return write( buf );
+}
+
+// As the core's printFloat(), which gives up past 32 bits
+size_t Print::print( double value, int digits ) {
+  char buf[ 48 ];
+  if ( isnan( value ) )                               return write( "nan" );
+  if ( isinf( value ) )                               return write( "inf" );
+  if ( value > 4294967040.0 || value < -4294967040.0 ) return write( "ovf" );
+  snprintf( buf, sizeof(buf), "%.*f", digits, value );
+  return write( buf );
+}
+
+
+int Stream::timedRead() {
+  unsigned long start = millis();
+  do {
+    int c = read();
+    if ( c >= 0 ) return c;
+    yield();
+  } while ( millis() - start < _timeout );
+  return -1;
+}
+
+size_t Stream::readBytes( uint8_t *buffer, size_t length ) {
+  size_t n = 0;
+  while ( n < length ) {
+    int c = timedRead();
+    if ( c < 0 ) break;
+    buffer[ n++ ] = c;
+  }
+  return n;
+}
+
+String Stream::readString() {
+  String out;
+  int    c;
+  while ( ( c = timedRead() ) >= 0 ) out += (char)c;
+  return out;
+}
+
+String Stream::readStringUntil( char terminator ) {
+  String out;
+  int    c;
+  while ( ( c = timedRead() ) >= 0 && c != terminator ) out += (char)c;
+  return out;
+}
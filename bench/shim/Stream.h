@@ -0,0 +1,32 @@
+//
+// Stream.h - Host shim of the Arduino Stream interface
+//
+
+#ifndef Stream_h
+#define Stream_h
+
+#include "Print.h"
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    // Blocks up to the timeout for data, like the core
+    virtual size_t readBytes( uint8_t *buffer, size_t length );
+    size_t readBytes( char *buffer, size_t length ) { return readBytes( (uint8_t *)buffer, length ); }
+    String readString();
+    String readStringUntil( char terminator );
+
+    void          setTimeout( unsigned long timeout ) { _timeout = timeout; }
+    unsigned long getTimeout() const                  { return _timeout; }
+
+  protected:
+    unsigned long _timeout = 1000;
+
+    int timedRead();
+};
+
+#endif
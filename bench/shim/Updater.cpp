@@ -0,0 +1,81 @@
+//
+// Updater.cpp - Host shim of the core's Update
+//
+
+#include "Updater.h"
+
+UpdaterClass Update;
+
+bool UpdaterClass::begin( size_t size, int command ) {
+  (void)command;
+  _error    = UPDATE_ERROR_OK;
+  _progress = 0;
+  _md5      = String();
+
+  if ( size == 0 ) {
+    _error = UPDATE_ERROR_SIZE;
+    return false;
+  }
+  if ( size > ESP.getFreeSketchSpace() && command == U_FLASH ) {
+    _error = UPDATE_ERROR_SPACE;
+    return false;
+  }
+
+  _size    = size;
+  _running = true;
+  _hash.begin();
+  return true;
+}
+
+bool UpdaterClass::setMD5( const char *expected_md5 ) {
+  if ( strlen( expected_md5 ) != 32 ) return false;
+  _md5 = expected_md5;
+  _md5.toLowerCase();
+  return true;
+}
+
+size_t UpdaterClass::write( uint8_t *data, size_t len ) {
+  if ( !_running || hasError() ) return 0;
+  if ( _progress + len > _size ) {
+    _error = UPDATE_ERROR_SPACE;
+    return 0;
+  }
+  _hash.add( data, len );
+  _progress += len;
+  return len;
+}
+
+bool UpdaterClass::end( bool evenIfRemaining ) {
+  if ( !_running ) {
+    if ( !hasError() ) _error = UPDATE_ERROR_NO_DATA;
+    return false;
+  }
+  _running = false;
+  if ( hasError() ) return false;
+
+  if ( _progress < _size && !evenIfRemaining ) {
+    _error = UPDATE_ERROR_SIZE;
+    return false;
+  }
+  if ( evenIfRemaining ) _size = _progress;
+
+  _hash.calculate();
+  if ( _md5.length() && _hash.toString() != _md5 ) {
+    _error = UPDATE_ERROR_MD5;
+    return false;
+  }
+  return true;
+}
+
+void UpdaterClass::printError( Print &out ) {
+  switch ( _error ) {
+    case UPDATE_ERROR_OK:      out.println( "No Error" ); break;
+    case UPDATE_ERROR_WRITE:   out.println( "Flash Write Failed" ); break;
+    case UPDATE_ERROR_SPACE:   out.println( "Not Enough Space" ); break;
+    case UPDATE_ERROR_SIZE:    out.println( "Bad Size Given" ); break;
+    case UPDATE_ERROR_STREAM:  out.println( "Stream Read Timeout" ); break;
+    case UPDATE_ERROR_MD5:     out.println( "MD5 Check Failed" ); break;
+    case UPDATE_ERROR_NO_DATA: out.println( "No data supplied" ); break;
+    default:                   out.println( "UNKNOWN" ); break;
+  }
+}
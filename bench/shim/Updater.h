@@ -0,0 +1,51 @@
+//
+// Updater.h - Host shim of the core's Update.  Nothing is flashed: the
+//             image is only counted and hashed, end() checks both.
+//
+
+#ifndef Updater_h
+#define Updater_h
+
+#include "Arduino.h"
+#include "MD5Builder.h"
+
+#define UPDATE_ERROR_OK            (0)
+#define UPDATE_ERROR_WRITE         (1)
+#define UPDATE_ERROR_SPACE         (4)
+#define UPDATE_ERROR_SIZE          (5)
+#define UPDATE_ERROR_STREAM        (6)
+#define UPDATE_ERROR_MD5           (7)
+#define UPDATE_ERROR_NO_DATA       (9)
+
+#define U_FLASH   0
+#define U_FS      100
+
+class UpdaterClass
+{
+  public:
+    bool   begin( size_t size, int command = U_FLASH );
+    bool   setMD5( const char *expected_md5 );
+    size_t write( uint8_t *data, size_t len );
+    bool   end( bool evenIfRemaining = false );
+    void   runAsync( bool async )                { (void)async; }
+
+    bool    hasError()                           { return _error != UPDATE_ERROR_OK; }
+    uint8_t getError()                           { return _error; }
+    void    printError( Print &out );
+    bool    isRunning()                          { return _running; }
+    bool    isFinished()                         { return _progress == _size; }
+    size_t  size()                               { return _size; }
+    size_t  progress()                           { return _progress; }
+
+  private:
+    bool       _running  = false;
+    uint8_t    _error    = UPDATE_ERROR_OK;
+    size_t     _size     = 0;
+    size_t     _progress = 0;
+    String     _md5;
+    MD5Builder _hash;
+};
+
+extern UpdaterClass Update;
+
+#endif
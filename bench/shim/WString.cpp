@@ -0,0 +1,413 @@
+//
+// WString.cpp - Host shim of the ESP8266 core's String
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <strings.h>
+
+#include "Arduino.h"
+#include "Host.h"
+
+
+String::String( const char *cstr ) {
+  init();
+  if ( cstr ) copy( cstr, strlen( cstr ) );
+}
+
+String::String( const char *cstr, unsigned int length ) {
+  init();
+  if ( cstr ) copy( cstr, length );
+}
+
+String::String( const String &str ) {
+  init();
+  copy( str.buffer(), str._len );
+}
+
+String::String( String &&rval ) noexcept {
+  init();
+  move( rval );
+}
+
+String::String( char c ) {
+  init();
+  copy( &c, 1 );
+}
+
+String::String( unsigned char value, unsigned char base ) {
+  char buf[ 9 ];
+  init();
+  utoa( value, buf, base );
+  copy( buf, strlen( buf ) );
+}
+
+String::String( int value, unsigned char base ) {
+  char buf[ 34 ];
+  init();
+  itoa( value, buf, base );
+  copy( buf, strlen( buf ) );
+}
+
+String::String( unsigned int value, unsigned char base ) {
+  char buf[ 33 ];
+  init();
+  utoa( value, buf, base );
+  copy( buf, strlen( buf ) );
+}
+
+String::String( long value, unsigned char base ) {
+  char buf[ 66 ];
+  init();
+  ltoa( value, buf, base );
+  copy( buf, strlen( buf ) );
+}
+
+String::String( unsigned long value, unsigned char base ) {
+  char buf[ 65 ];
+  init();
+  ultoa( value, buf, base );
+  copy( buf, strlen( buf ) );
+}
+
+String::String( long long value ) {
+  char buf[ 24 ];
+  init();
+  copy( buf, snprintf( buf, sizeof(buf), "%lld", value ) );
+}
+
+String::String( unsigned long long value ) {
+  char buf[ 24 ];
+  init();
+  copy( buf, snprintf( buf, sizeof(buf), "%llu", value ) );
+}
+
+String::String( float value, unsigned char decimalPlaces ) {
+  char buf[ 33 ];
+  init();
+  dtostrf( value, decimalPlaces + 2, decimalPlaces, buf );
+  copy( buf, strlen( buf ) );
+}
+
+String::String( double value, unsigned char decimalPlaces ) {
+  char buf[ 33 ];
+  init();
+  dtostrf( value, decimalPlaces + 2, decimalPlaces, buf );
+  copy( buf, strlen( buf ) );
+}
+
+String::~String() {
+  if ( !_sso ) host::heap_free( _ptr );
+}
+
+
+// Inline when it fits, otherwise a heap block of the size asked for
+// rounded up to 16, as the core does.  There's no doubling, a String
+// grown a piece at a time is reallocated every time.
+bool String::changeBuffer( unsigned int maxStrLen ) {
+  if ( maxStrLen <= SSO_CAPACITY ) {
+    if ( !_sso ) {
+      char *old = _ptr;
+      memcpy( _inline, old, _len + 1 );
+      host::heap_free( old );
+      _ptr = nullptr;
+      _cap = 0;
+      _sso = true;
+    }
+    return true;
+  }
+
+  size_t size = ( maxStrLen + 16 ) & ~0xf;
+  char  *buf  = (char *)host::heap_realloc( _sso ? nullptr : _ptr, size );
+  if ( !buf ) return false;
+
+  if ( _sso ) memcpy( buf, _inline, _len + 1 );
+  _ptr = buf;
+  _cap = size - 1;
+  _sso = false;
+  return true;
+}
+
+
+bool String::reserve( unsigned int size ) {
+  if ( capacity() >= size ) return true;
+  return changeBuffer( size );
+}
+
+
+String& String::copy( const char *cstr, unsigned int length ) {
+  if ( !reserve( length ) ) {
+    _len = 0;
+    wbuffer()[0] = '\0';
+    return *this;
+  }
+  _len = length;
+  memmove( wbuffer(), cstr, length );
+  wbuffer()[ length ] = '\0';
+  return *this;
+}
+
+
+void String::move( String &rhs ) noexcept {
+  if ( !_sso ) host::heap_free( _ptr );
+
+  _len = rhs._len;
+  _cap = rhs._cap;
+  _sso = rhs._sso;
+  _ptr = rhs._ptr;
+  memcpy( _inline, rhs._inline, sizeof(_inline) );
+  rhs.init();
+}
+
+
+String& String::operator=( const String &rhs ) {
+  if ( this != &rhs ) copy( rhs.buffer(), rhs._len );
+  return *this;
+}
+
+String& String::operator=( String &&rval ) noexcept {
+  if ( this != &rval ) move( rval );
+  return *this;
+}
+
+String& String::operator=( const char *cstr ) {
+  if ( cstr ) copy( cstr, strlen( cstr ) );
+  else        { _len = 0; wbuffer()[0] = '\0'; }
+  return *this;
+}
+
+String& String::operator=( char c ) {
+  return copy( &c, 1 );
+}
+
+
+bool String::concat( const char *cstr, unsigned int length ) {
+  if ( !cstr ) return false;
+  if ( length == 0 ) return true;
+
+  // Appending a piece of ourselves survives the realloc
+  if ( cstr >= buffer() && cstr < buffer() + _len ) {
+    String piece( cstr, length );
+    return concat( piece.c_str(), length );
+  }
+
+  if ( !reserve( _len + length ) ) return false;
+  memcpy( wbuffer() + _len, cstr, length );
+  _len += length;
+  wbuffer()[ _len ] = '\0';
+  return true;
+}
+
+bool String::concat( const char *cstr ) {
+  return cstr ? concat( cstr, strlen( cstr ) ) : false;
+}
+
+bool String::concat( unsigned char value ) {
+  char buf[ 4 ];
+  return concat( buf, snprintf( buf, sizeof(buf), "%u", value ) );
+}
+
+bool String::concat( int value ) {
+  char buf[ 12 ];
+  return concat( buf, snprintf( buf, sizeof(buf), "%d", value ) );
+}
+
+bool String::concat( unsigned int value ) {
+  char buf[ 11 ];
+  return concat( buf, snprintf( buf, sizeof(buf), "%u", value ) );
+}
+
+bool String::concat( long value ) {
+  char buf[ 21 ];
+  return concat( buf, snprintf( buf, sizeof(buf), "%ld", value ) );
+}
+
+bool String::concat( unsigned long value ) {
+  char buf[ 21 ];
+  return concat( buf, snprintf( buf, sizeof(buf), "%lu", value ) );
+}
+
+bool String::concat( long long value ) {
+  char buf[ 21 ];
+  return concat( buf, snprintf( buf, sizeof(buf), "%lld", value ) );
+}
+
+bool String::concat( unsigned long long value ) {
+  char buf[ 21 ];
+  return concat( buf, snprintf( buf, sizeof(buf), "%llu", value ) );
+}
+
+bool String::concat( float value ) {
+  char buf[ 20 ];
+  return concat( dtostrf( value, 4, 2, buf ) );
+}
+
+bool String::concat( double value ) {
+  char buf[ 20 ];
+  return concat( dtostrf( value, 4, 2, buf ) );
+}
+
+
+int String::compareTo( const String &s ) const {
+  return strcmp( buffer(), s.buffer() );
+}
+
+bool String::equals( const String &s ) const {
+  return _len == s._len && memcmp( buffer(), s.buffer(), _len ) == 0;
+}
+
+bool String::equals( const char *cstr ) const {
+  if ( !cstr ) return _len == 0;
+  return strcmp( buffer(), cstr ) == 0;
+}
+
+bool String::equalsIgnoreCase( const String &s ) const {
+  return _len == s._len && strcasecmp( buffer(), s.buffer() ) == 0;
+}
+
+bool String::startsWith( const String &prefix ) const {
+  return startsWith( prefix, 0 );
+}
+
+bool String::startsWith( const String &prefix, unsigned int offset ) const {
+  if ( offset > _len || prefix._len > _len - offset ) return false;
+  return memcmp( buffer() + offset, prefix.buffer(), prefix._len ) == 0;
+}
+
+bool String::endsWith( const String &suffix ) const {
+  if ( suffix._len > _len ) return false;
+  return memcmp( buffer() + _len - suffix._len, suffix.buffer(), suffix._len ) == 0;
+}
+
+
+char String::charAt( unsigned int index ) const {
+  return operator[]( index );
+}
+
+void String::setCharAt( unsigned int index, char c ) {
+  if ( index < _len ) wbuffer()[ index ] = c;
+}
+
+char String::operator[]( unsigned int index ) const {
+  return index < _len ? buffer()[ index ] : '\0';
+}
+
+char& String::operator[]( unsigned int index ) {
+  static char dummy;
+  if ( index >= _len ) {
+    dummy = '\0';
+    return dummy;
+  }
+  return wbuffer()[ index ];
+}
+
+void String::getBytes( unsigned char *buf, unsigned int bufsize, unsigned int index ) const {
+  if ( !bufsize || !buf ) return;
+  if ( index >= _len ) {
+    buf[0] = '\0';
+    return;
+  }
+  unsigned int n = bufsize - 1;
+  if ( n > _len - index ) n = _len - index;
+  memcpy( buf, buffer() + index, n );
+  buf[ n ] = '\0';
+}
+
+
+int String::indexOf( char ch, unsigned int fromIndex ) const {
+  if ( fromIndex >= _len ) return -1;
+  const char *p = (const char *)memchr( buffer() + fromIndex, ch, _len - fromIndex );
+  return p ? p - buffer() : -1;
+}
+
+int String::indexOf( const char *str, unsigned int fromIndex ) const {
+  if ( fromIndex > _len ) return -1;
+  const char *p = strstr( buffer() + fromIndex, str );
+  return p ? p - buffer() : -1;
+}
+
+int String::lastIndexOf( char ch ) const {
+  return _len ? lastIndexOf( ch, _len - 1 ) : -1;
+}
+
+int String::lastIndexOf( char ch, unsigned int fromIndex ) const {
+  if ( fromIndex >= _len ) return -1;
+  for ( int i = fromIndex; i >= 0; i-- )
+    if ( buffer()[i] == ch ) return i;
+  return -1;
+}
+
+int String::lastIndexOf( const String &str ) const {
+  if ( str._len == 0 || str._len > _len ) return -1;
+  for ( int i = _len - str._len; i >= 0; i-- )
+    if ( memcmp( buffer() + i, str.buffer(), str._len ) == 0 ) return i;
+  return -1;
+}
+
+
+String String::substring( unsigned int left, unsigned int right ) const {
+  if ( left > right ) std::swap( left, right );
+  if ( left >= _len ) return String();
+  if ( right > _len ) right = _len;
+  return String( buffer() + left, right - left );
+}
+
+
+void String::replace( char find, char replace ) {
+  for ( char *p = wbuffer(); *p; p++ )
+    if ( *p == find ) *p = replace;
+}
+
+void String::replace( const String &find, const String &replace ) {
+  if ( _len == 0 || find._len == 0 ) return;
+
+  String out;
+  int    from = 0, at;
+  while ( ( at = indexOf( find, from ) ) >= 0 ) {
+    out.concat( buffer() + from, at - from );
+    out.concat( replace );
+    from = at + find._len;
+  }
+  if ( from == 0 ) return;
+  out.concat( buffer() + from, _len - from );
+  *this = std::move( out );
+}
+
+void String::remove( unsigned int index ) {
+  remove( index, (unsigned int)-1 );
+}
+
+void String::remove( unsigned int index, unsigned int count ) {
+  if ( index >= _len ) return;
+  if ( count > _len - index ) count = _len - index;
+  char *buf = wbuffer();
+  memmove( buf + index, buf + index + count, _len - index - count );
+  _len -= count;
+  buf[ _len ] = '\0';
+}
+
+void String::toLowerCase() {
+  for ( char *p = wbuffer(); *p; p++ ) *p = tolower( (unsigned char)*p );
+}
+
+void String::toUpperCase() {
+  for ( char *p = wbuffer(); *p; p++ ) *p = toupper( (unsigned char)*p );
+}
+
+void String::trim() {
+  if ( _len == 0 ) return;
+  char *buf   = wbuffer();
+  char *begin = buf;
+  while ( isspace( (unsigned char)*begin ) ) begin++;
+  char *end = buf + _len - 1;
+  while ( end >= begin && isspace( (unsigned char)*end ) ) end--;
+  _len = end + 1 - begin;
+  if ( begin > buf ) memmove( buf, begin, _len );
+  buf[ _len ] = '\0';
+}
+
+
+long   String::toInt() const    { return atol( buffer() ); }
+float  String::toFloat() const  { return atof( buffer() ); }
+double String::toDouble() const { return atof( buffer() ); }
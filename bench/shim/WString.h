@@ -0,0 +1,141 @@
+//
+// WString.h - Host shim of the ESP8266 core's String.  Buffers are
+//             managed the way the core does it (short strings inline,
+//             heap blocks rounded up to 16 bytes, grown to the exact
+//             size asked for) so the allocation counts bench/ reports
+//             are the device's.
+//
+
+#ifndef WString_h
+#define WString_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <utility>
+
+class String
+{
+  public:
+    String()                                  { init(); }
+    String( const char *cstr );
+    String( const char *cstr, unsigned int length );
+    String( const String &str );
+    String( String &&rval ) noexcept;
+    explicit String( char c );
+    explicit String( unsigned char value, unsigned char base = 10 );
+    explicit String( int value, unsigned char base = 10 );
+    explicit String( unsigned int value, unsigned char base = 10 );
+    explicit String( long value, unsigned char base = 10 );
+    explicit String( unsigned long value, unsigned char base = 10 );
+    explicit String( long long value );
+    explicit String( unsigned long long value );
+    explicit String( float value, unsigned char decimalPlaces = 2 );
+    explicit String( double value, unsigned char decimalPlaces = 2 );
+    ~String();
+
+    String& operator=( const String &rhs );
+    String& operator=( String &&rval ) noexcept;
+    String& operator=( const char *cstr );
+    String& operator=( char c );
+
+    bool         reserve( unsigned int size );
+    unsigned int length() const               { return _len; }
+    unsigned int capacity() const             { return _sso ? SSO_CAPACITY : _cap; }
+    bool         isEmpty() const              { return _len == 0; }
+    const char*  c_str() const                { return buffer(); }
+    char*        begin()                      { return wbuffer(); }
+    char*        end()                        { return wbuffer() + _len; }
+    const char*  begin() const                { return buffer(); }
+    const char*  end() const                  { return buffer() + _len; }
+
+    bool concat( const String &str )          { return concat( str.buffer(), str._len ); }
+    bool concat( const char *cstr );
+    bool concat( const char *cstr, unsigned int length );
+    bool concat( char c )                     { return concat( &c, 1 ); }
+    bool concat( unsigned char value );
+    bool concat( int value );
+    bool concat( unsigned int value );
+    bool concat( long value );
+    bool concat( unsigned long value );
+    bool concat( long long value );
+    bool concat( unsigned long long value );
+    bool concat( float value );
+    bool concat( double value );
+
+    template <typename T> String& operator+=( const T &rhs ) { concat( rhs ); return *this; }
+
+    int  compareTo( const String &s ) const;
+    bool equals( const String &s ) const;
+    bool equals( const char *cstr ) const;
+    bool equalsIgnoreCase( const String &s ) const;
+    bool startsWith( const String &prefix ) const;
+    bool startsWith( const String &prefix, unsigned int offset ) const;
+    bool endsWith( const String &suffix ) const;
+
+    bool operator==( const String &rhs ) const { return equals( rhs ); }
+    bool operator==( const char *cstr ) const  { return equals( cstr ); }
+    bool operator!=( const String &rhs ) const { return !equals( rhs ); }
+    bool operator!=( const char *cstr ) const  { return !equals( cstr ); }
+    bool operator<( const String &rhs ) const  { return compareTo( rhs ) < 0; }
+    bool operator>( const String &rhs ) const  { return compareTo( rhs ) > 0; }
+
+    char  charAt( unsigned int index ) const;
+    void  setCharAt( unsigned int index, char c );
+    char  operator[]( unsigned int index ) const;
+    char& operator[]( unsigned int index );
+    void  getBytes( unsigned char *buf, unsigned int bufsize, unsigned int index = 0 ) const;
+    void  toCharArray( char *buf, unsigned int bufsize, unsigned int index = 0 ) const
+            { getBytes( (unsigned char *)buf, bufsize, index ); }
+
+    int indexOf( char ch, unsigned int fromIndex = 0 ) const;
+    int indexOf( const char *str, unsigned int fromIndex = 0 ) const;
+    int indexOf( const String &str, unsigned int fromIndex = 0 ) const { return indexOf( str.c_str(), fromIndex ); }
+    int lastIndexOf( char ch ) const;
+    int lastIndexOf( char ch, unsigned int fromIndex ) const;
+    int lastIndexOf( const String &str ) const;
+
+    String substring( unsigned int beginIndex ) const { return substring( beginIndex, _len ); }
+    String substring( unsigned int beginIndex, unsigned int endIndex ) const;
+
+    void replace( char find, char replace );
+    void replace( const String &find, const String &replace );
+    void remove( unsigned int index );
+    void remove( unsigned int index, unsigned int count );
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long   toInt() const;
+    float  toFloat() const;
+    double toDouble() const;
+
+  private:
+    // The core keeps up to this many characters in the object itself
+    enum { SSO_CAPACITY = 10 };
+
+    char         *_ptr;
+    unsigned int  _cap;
+    unsigned int  _len;
+    bool          _sso;
+    char          _inline[ SSO_CAPACITY + 1 ];
+
+    void        init()                        { _ptr = nullptr; _cap = 0; _len = 0; _sso = true; _inline[0] = '\0'; }
+    const char* buffer() const                { return _sso ? _inline : _ptr; }
+    char*       wbuffer()                     { return _sso ? _inline : _ptr; }
+    bool        changeBuffer( unsigned int maxStrLen );
+    String&     copy( const char *cstr, unsigned int length );
+    void        move( String &rhs ) noexcept;
+};
+
+
+// a + b, reusing a's buffer when it's a temporary
+template <typename T> inline String operator+( const String &lhs, const T &rhs ) { String s( lhs ); s.concat( rhs ); return s; }
+template <typename T> inline String operator+( String &&lhs, const T &rhs )      { lhs.concat( rhs ); return std::move( lhs ); }
+inline String operator+( const char *lhs, const String &rhs )                    { String s( lhs ); s.concat( rhs ); return s; }
+inline String operator+( char lhs, const String &rhs )                           { String s( lhs ); s.concat( rhs ); return s; }
+
+inline bool operator==( const char *lhs, const String &rhs ) { return rhs.equals( lhs ); }
+inline bool operator!=( const char *lhs, const String &rhs ) { return !rhs.equals( lhs ); }
+
+#endif
@@ -0,0 +1,260 @@
+//
+// WiFiClient.cpp - Host shim of the WiFi station and WiFiClient
+//
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "ESP8266WiFi.h"
+#include "Host.h"
+
+#define CONNECT_TIMEOUT  5000   // ms
+
+ESP8266WiFiClass WiFi;
+
+
+struct WiFiClient::socket {
+  int         fd     = -1;
+  std::string rx;                // Received, not read yet
+  size_t      rx_at  = 0;
+  bool        closed = false;    // By the other end
+
+  ~socket() { if ( fd >= 0 ) ::close( fd ); }
+};
+
+
+//
+// IPAddress
+
+bool IPAddress::fromString( const char *address ) {
+  struct in_addr in;
+  if ( inet_pton( AF_INET, address, &in ) != 1 ) return false;
+  _address = in.s_addr;
+  return true;
+}
+
+String IPAddress::toString() const {
+  char buf[ 16 ];
+  snprintf( buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3] );
+  return String( buf );
+}
+
+
+//
+// WiFi
+
+wl_status_t ESP8266WiFiClass::begin( const char *ssid, const char *passphrase ) {
+  (void)passphrase;
+  _ssid   = ssid ? ssid : "";
+  _joined = ( _mode & WIFI_STA ) != 0;
+  return status();
+}
+
+bool ESP8266WiFiClass::disconnect( bool wifioff ) {
+  _joined = false;
+  if ( wifioff ) _mode = WIFI_OFF;
+  return true;
+}
+
+bool ESP8266WiFiClass::softAP( const char *ssid, const char *passphrase ) {
+  (void)ssid;
+  (void)passphrase;
+  _mode = (WiFiMode_t)( _mode | WIFI_AP );
+  return true;
+}
+
+String ESP8266WiFiClass::macAddress() {
+  return String( host::mac.c_str() );
+}
+
+bool ESP8266WiFiClass::setSleepMode( WiFiSleepType_t type, uint8_t listenInterval ) {
+  (void)listenInterval;
+  _sleep = type;
+  return true;
+}
+
+// HOST_RESOLVE first, so stubs can stand in for real servers
+int ESP8266WiFiClass::hostByName( const char *name, IPAddress &result ) {
+  uint32_t address;
+  if ( host::resolve( name, address ) ) {
+    result = IPAddress( address );
+    return 1;
+  }
+  if ( result.fromString( name ) ) return 1;
+
+  struct addrinfo hints = {}, *info;
+  hints.ai_family = AF_INET;
+  if ( getaddrinfo( name, nullptr, &hints, &info ) != 0 ) return 0;
+  result = IPAddress( ( (struct sockaddr_in *)info->ai_addr )->sin_addr.s_addr );
+  freeaddrinfo( info );
+  return 1;
+}
+
+
+//
+// WiFiClient
+
+WiFiClient::WiFiClient() {
+}
+
+WiFiClient::~WiFiClient() {
+}
+
+int WiFiClient::connect( IPAddress ip, uint16_t port ) {
+  stop();
+  return open( ip, port, nullptr );
+}
+
+int WiFiClient::connect( const char *host, uint16_t port ) {
+  IPAddress ip;
+  uint32_t  address;
+  stop();
+  if ( host::resolve( host, address, &port ) ) return open( address, port, host );
+  if ( !WiFi.hostByName( host, ip ) ) return 0;
+  return open( ip, port, host );
+}
+
+bool WiFiClient::open( uint32_t address, uint16_t port, const char *host ) {
+  (void)host;
+
+  int fd = ::socket( AF_INET, SOCK_STREAM, 0 );
+  if ( fd < 0 ) return false;
+
+  auto sock = std::make_shared<socket>();
+  sock->fd = fd;
+
+  struct sockaddr_in addr = {};
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons( port );
+  addr.sin_addr.s_addr = address;
+
+  fcntl( fd, F_SETFL, O_NONBLOCK );
+  if ( ::connect( fd, (struct sockaddr *)&addr, sizeof(addr) ) != 0 ) {
+    if ( errno != EINPROGRESS ) return false;
+
+    struct pollfd p = { fd, POLLOUT, 0 };
+    int       error = 0;
+    socklen_t len   = sizeof(error);
+    if ( poll( &p, 1, CONNECT_TIMEOUT ) != 1 ||
+         getsockopt( fd, SOL_SOCKET, SO_ERROR, &error, &len ) != 0 || error != 0 ) return false;
+  }
+
+  int one = 1;
+  setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one) );
+
+  _sock = sock;
+  return true;
+}
+
+int WiFiClient::fd() const {
+  return _sock ? _sock->fd : -1;
+}
+
+void WiFiClient::stop() {
+  _sock.reset();
+}
+
+ssize_t WiFiClient::send_some( const uint8_t *data, size_t len ) {
+  ssize_t n = ::send( _sock->fd, data, len, MSG_NOSIGNAL );
+  if ( n < 0 ) return ( errno == EAGAIN || errno == EWOULDBLOCK ) ? 0 : -1;
+  return n;
+}
+
+ssize_t WiFiClient::recv_some( uint8_t *data, size_t len ) {
+  ssize_t n = ::recv( _sock->fd, data, len, 0 );
+  if ( n < 0 ) return ( errno == EAGAIN || errno == EWOULDBLOCK ) ? -1 : 0;
+  return n;
+}
+
+bool WiFiClient::fill() {
+  if ( !_sock ) return false;
+  if ( _sock->closed ) return false;
+
+  if ( _sock->rx_at == _sock->rx.size() ) {
+    _sock->rx.clear();
+    _sock->rx_at = 0;
+  }
+
+  uint8_t buf[ 2048 ];
+  ssize_t n;
+  while ( ( n = recv_some( buf, sizeof(buf) ) ) > 0 )
+    _sock->rx.append( (const char *)buf, n );
+
+  if ( n == 0 ) _sock->closed = true;
+  return !_sock->closed;
+}
+
+// Blocks until it's all gone or the timeout passes without progress
+size_t WiFiClient::write( const uint8_t *buffer, size_t size ) {
+  size_t sent = 0;
+
+  while ( _sock && sent < size ) {
+    ssize_t n = send_some( buffer + sent, size - sent );
+    if ( n < 0 ) break;
+    if ( n > 0 ) {
+      sent += n;
+      continue;
+    }
+
+    struct pollfd p = { _sock->fd, POLLOUT, 0 };
+    if ( poll( &p, 1, _timeout ) != 1 ) break;
+  }
+  return sent;
+}
+
+int WiFiClient::available() {
+  if ( !_sock ) return 0;
+  fill();
+  return _sock->rx.size() - _sock->rx_at;
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read( &c, 1 ) == 1 ? c : -1;
+}
+
+int WiFiClient::read( uint8_t *buffer, size_t size ) {
+  size_t avail = available();
+  if ( avail == 0 ) return -1;
+  if ( size > avail ) size = avail;
+  memcpy( buffer, _sock->rx.data() + _sock->rx_at, size );
+  _sock->rx_at += size;
+  return size;
+}
+
+int WiFiClient::peek() {
+  if ( available() == 0 ) return -1;
+  return (uint8_t)_sock->rx[ _sock->rx_at ];
+}
+
+size_t WiFiClient::readBytes( uint8_t *buffer, size_t length ) {
+  size_t        got   = 0;
+  unsigned long start = millis();
+
+  while ( got < length && _sock ) {
+    int n = read( buffer + got, length - got );
+    if ( n > 0 ) {
+      got += n;
+      continue;
+    }
+    if ( _sock->closed || millis() - start >= _timeout ) break;
+
+    struct pollfd p = { _sock->fd, POLLIN, 0 };
+    poll( &p, 1, 10 );
+  }
+  return got;
+}
+
+// Still true while there's data to read after the other end closed
+uint8_t WiFiClient::connected() {
+  if ( !_sock ) return 0;
+  fill();
+  return _sock->rx_at < _sock->rx.size() || !_sock->closed;
+}
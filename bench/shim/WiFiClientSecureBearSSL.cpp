@@ -0,0 +1,268 @@
+//
+// WiFiClientSecureBearSSL.cpp - Host shim of the BearSSL client on OpenSSL
+//
+
+#include <ctype.h>
+#include <poll.h>
+
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include "WiFiClientSecureBearSSL.h"
+
+#define HANDSHAKE_TIMEOUT  10000   // ms
+
+// What BearSSL takes from the heap for a connection, for the heap
+// figures: the record buffers, each with room for a record's header
+// and MAC, and roughly the engine and certificate contexts
+#define BEARSSL_RX_OVERHEAD  325
+#define BEARSSL_TX_OVERHEAD  85
+#define BEARSSL_CONTEXTS     3500
+
+namespace BearSSL {
+
+struct WiFiClientSecure::tls {
+  SSL_CTX *ctx = nullptr;
+  SSL     *ssl = nullptr;
+  std::vector<uint8_t> memory;          // Stands in for BearSSL's
+
+  ~tls() {
+    if ( ssl ) SSL_free( ssl );
+    if ( ctx ) SSL_CTX_free( ctx );
+  }
+};
+
+
+//
+// X509List
+
+X509List::~X509List() {
+  for ( void *cert : _certs ) X509_free( (X509 *)cert );
+}
+
+bool X509List::append( const char *pem ) {
+  BIO   *bio   = BIO_new_mem_buf( pem, -1 );
+  size_t count = _certs.size();
+  X509  *cert;
+
+  while ( ( cert = PEM_read_bio_X509( bio, nullptr, nullptr, nullptr ) ) )
+    _certs.push_back( cert );
+
+  BIO_free( bio );
+  ERR_clear_error();
+  return _certs.size() > count;
+}
+
+
+//
+// Session
+
+Session& Session::operator=( Session &&other ) {
+  if ( this != &other ) {
+    set( nullptr );
+    _session       = other._session;
+    other._session = nullptr;
+  }
+  return *this;
+}
+
+Session::~Session() {
+  set( nullptr );
+}
+
+void Session::set( void *session ) {
+  if ( _session ) SSL_SESSION_free( (SSL_SESSION *)_session );
+  _session = session;
+}
+
+
+//
+// WiFiClientSecure
+
+WiFiClientSecure::WiFiClientSecure() {
+  memset( _fingerprint, 0, sizeof(_fingerprint) );
+}
+
+WiFiClientSecure::~WiFiClientSecure() {
+  stop();
+}
+
+bool WiFiClientSecure::setFingerprint( const uint8_t fingerprint[20] ) {
+  memcpy( _fingerprint, fingerprint, sizeof(_fingerprint) );
+  _pinned = true;
+  return true;
+}
+
+// Hex pairs, spaces and colons between them ignored
+bool WiFiClientSecure::setFingerprint( const char *fingerprint ) {
+  uint8_t parsed[20];
+  int     n = 0;
+
+  for ( const char *p = fingerprint; *p; ) {
+    if ( *p == ' ' || *p == ':' ) { p++; continue; }
+    if ( n == 20 || !isxdigit( (unsigned char)p[0] ) || !isxdigit( (unsigned char)p[1] ) ) return false;
+
+    unsigned byte;
+    sscanf( p, "%2x", &byte );
+    parsed[ n++ ] = byte;
+    p += 2;
+  }
+  if ( n != 20 ) return false;
+  return setFingerprint( parsed );
+}
+
+void WiFiClientSecure::fail( int code, const char *text ) {
+  _error = code;
+  snprintf( _error_text, sizeof(_error_text), "%s", text );
+}
+
+int WiFiClientSecure::getLastSSLError( char *dest, size_t len ) {
+  if ( dest && len ) snprintf( dest, len, "%s", _error_text );
+  return _error;
+}
+
+// Wait for the socket to be ready for what OpenSSL asked for
+static bool wait_for( int fd, SSL *ssl, int ret, int timeout ) {
+  int   error = SSL_get_error( ssl, ret );
+  short events;
+
+  if      ( error == SSL_ERROR_WANT_READ )  events = POLLIN;
+  else if ( error == SSL_ERROR_WANT_WRITE ) events = POLLOUT;
+  else return false;
+
+  struct pollfd p = { fd, events, 0 };
+  return poll( &p, 1, timeout ) == 1;
+}
+
+static int mfln_mode( int size ) {
+  return size <= 512 ? TLSEXT_max_fragment_length_512 : size <= 1024 ? TLSEXT_max_fragment_length_1024 :
+         size <= 2048 ? TLSEXT_max_fragment_length_2048 : size <= 4096 ? TLSEXT_max_fragment_length_4096 :
+         TLSEXT_max_fragment_length_DISABLED;
+}
+
+bool WiFiClientSecure::open( uint32_t address, uint16_t port, const char *host ) {
+  _error = 0;
+  _error_text[0] = '\0';
+
+  if ( !_insecure && !_pinned && !( _anchors && _anchors->getCount() ) ) {
+    fail( -1, "No fingerprint or trust anchors" );
+    return false;
+  }
+
+  if ( !WiFiClient::open( address, port, host ) ) {
+    fail( -2, "Can't connect" );
+    return false;
+  }
+
+  auto state = std::make_shared<tls>();
+  state->memory.resize( _rx_size + BEARSSL_RX_OVERHEAD + _tx_size + BEARSSL_TX_OVERHEAD + BEARSSL_CONTEXTS );
+  state->ctx = SSL_CTX_new( TLS_client_method() );
+  SSL_CTX_set_min_proto_version( state->ctx, TLS1_2_VERSION );
+  SSL_CTX_set_max_proto_version( state->ctx, TLS1_2_VERSION );
+
+  if ( !_insecure && !_pinned ) {
+    X509_STORE *store = SSL_CTX_get_cert_store( state->ctx );
+    for ( void *cert : _anchors->certs() ) X509_STORE_add_cert( store, (X509 *)cert );
+    SSL_CTX_set_verify( state->ctx, SSL_VERIFY_PEER, nullptr );
+  }
+
+  state->ssl = SSL_new( state->ctx );
+  SSL_set_fd( state->ssl, fd() );
+  if ( host ) {
+    SSL_set_tlsext_host_name( state->ssl, host );
+    if ( !_insecure && !_pinned ) SSL_set1_host( state->ssl, host );
+  }
+  if ( _now ) X509_VERIFY_PARAM_set_time( SSL_get0_param( state->ssl ), _now );
+
+  // BearSSL asks for a smaller record size when its buffer is smaller
+  int mode = mfln_mode( _rx_size );
+  if ( mode != TLSEXT_max_fragment_length_DISABLED ) SSL_set_tlsext_max_fragment_length( state->ssl, mode );
+
+  if ( _session && _session->get() ) SSL_set_session( state->ssl, (SSL_SESSION *)_session->get() );
+
+  int fd  = SSL_get_fd( state->ssl );
+  int ret;
+  while ( ( ret = SSL_connect( state->ssl ) ) != 1 ) {
+    if ( !wait_for( fd, state->ssl, ret, HANDSHAKE_TIMEOUT ) ) {
+      long verify = SSL_get_verify_result( state->ssl );
+      if ( verify != X509_V_OK ) fail( 296, X509_verify_cert_error_string( verify ) );
+      else                       fail( -3, ERR_reason_error_string( ERR_get_error() ) ?: "Handshake failed" );
+      ERR_clear_error();
+      WiFiClient::stop();
+      return false;
+    }
+  }
+
+  if ( _pinned ) {
+    X509         *cert = SSL_get1_peer_certificate( state->ssl );
+    unsigned char digest[ EVP_MAX_MD_SIZE ];
+    unsigned int  len  = 0;
+
+    bool match = cert && X509_digest( cert, EVP_sha1(), digest, &len ) && len == 20 &&
+                 memcmp( digest, _fingerprint, 20 ) == 0;
+    X509_free( cert );
+    if ( !match ) {
+      fail( 296, "Certificate fingerprint doesn't match" );
+      WiFiClient::stop();
+      return false;
+    }
+  }
+
+  if ( _session ) _session->set( SSL_get1_session( state->ssl ) );
+
+  _tls = state;
+  return true;
+}
+
+uint8_t WiFiClientSecure::connected() {
+  return _tls ? WiFiClient::connected() : 0;
+}
+
+void WiFiClientSecure::stop() {
+  if ( _tls && _sock ) SSL_shutdown( _tls->ssl );
+  _tls.reset();
+  WiFiClient::stop();
+}
+
+ssize_t WiFiClientSecure::send_some( const uint8_t *data, size_t len ) {
+  if ( !_tls ) return -1;
+  int n = SSL_write( _tls->ssl, data, len );
+  if ( n > 0 ) return n;
+
+  int error = SSL_get_error( _tls->ssl, n );
+  ERR_clear_error();
+  return ( error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE ) ? 0 : -1;
+}
+
+ssize_t WiFiClientSecure::recv_some( uint8_t *data, size_t len ) {
+  if ( !_tls ) return 0;
+  int n = SSL_read( _tls->ssl, data, len );
+  if ( n > 0 ) return n;
+
+  int error = SSL_get_error( _tls->ssl, n );
+  ERR_clear_error();
+  return ( error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE ) ? -1 : 0;
+}
+
+
+// A throwaway handshake asking for len byte records, true if the
+// server agreed
+bool WiFiClientSecure::probeMaxFragmentLength( const char *host, uint16_t port, uint16_t len ) {
+  WiFiClientSecure probe;
+  probe.setInsecure();
+  probe.setBufferSizes( len, len );
+  if ( !probe.connect( host, port ) ) return false;
+
+  SSL_SESSION *session = SSL_get_session( probe._tls->ssl );
+  bool         agreed  = session && SSL_SESSION_get_max_fragment_length( session ) == mfln_mode( len );
+  probe.stop();
+  return agreed;
+}
+
+bool WiFiClientSecure::probeMaxFragmentLength( IPAddress ip, uint16_t port, uint16_t len ) {
+  return probeMaxFragmentLength( ip.toString().c_str(), port, len );
+}
+
+}
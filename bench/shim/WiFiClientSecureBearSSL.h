@@ -0,0 +1,101 @@
+//
+// WiFiClientSecureBearSSL.h - Host shim of the BearSSL client on
+//                             OpenSSL.  Held to what BearSSL does:
+//                             TLS 1.2, max fragment length asked for
+//                             when the receive buffer is small, and
+//                             either a SHA-1 fingerprint pin or trust
+//                             anchors with the name checked.
+//
+
+#ifndef WiFiClientSecureBearSSL_h
+#define WiFiClientSecureBearSSL_h
+
+#include <time.h>
+#include <memory>
+#include <vector>
+
+#include "ESP8266WiFi.h"
+
+namespace BearSSL {
+
+class X509List
+{
+  public:
+    X509List() {}
+    X509List( const char *pem )           { append( pem ); }
+    ~X509List();
+
+    bool   append( const char *pem );
+    size_t getCount() const               { return _certs.size(); }
+
+    const std::vector<void *>& certs() const { return _certs; }
+
+  private:
+    std::vector<void *> _certs;           // X509 *
+};
+
+
+class Session
+{
+  public:
+    Session() {}
+    Session( const Session & ) = delete;
+    Session& operator=( Session &&other );
+    ~Session();
+
+    void* get() const                     { return _session; }
+    void  set( void *session );           // Takes a reference
+
+  private:
+    void *_session = nullptr;             // SSL_SESSION *
+};
+
+
+class WiFiClientSecure : public WiFiClient
+{
+  public:
+    WiFiClientSecure();
+    ~WiFiClientSecure() override;
+
+    void setInsecure()                    { _insecure = true; }
+    bool setFingerprint( const uint8_t fingerprint[20] );
+    bool setFingerprint( const char *fingerprint );
+    void setTrustAnchors( const X509List *anchors ) { _anchors = anchors; }
+    void setSession( Session *session )   { _session = session; }
+    void setBufferSizes( int recv, int xmit ) { _rx_size = recv; _tx_size = xmit; }
+    void setX509Time( time_t now )        { _now = now; }
+
+    uint8_t connected() override;
+    void    stop() override;
+    int     getLastSSLError( char *dest = nullptr, size_t len = 0 );
+
+    // Whether the server takes a max fragment length of len
+    static bool probeMaxFragmentLength( const char *host, uint16_t port, uint16_t len );
+    static bool probeMaxFragmentLength( IPAddress ip, uint16_t port, uint16_t len );
+
+    struct tls;
+
+  protected:
+    bool    open( uint32_t address, uint16_t port, const char *host ) override;
+    ssize_t send_some( const uint8_t *data, size_t len ) override;
+    ssize_t recv_some( uint8_t *data, size_t len ) override;
+
+  private:
+    std::shared_ptr<tls> _tls;
+    bool            _insecure       = false;
+    bool            _pinned         = false;
+    uint8_t         _fingerprint[20];
+    const X509List *_anchors        = nullptr;
+    Session        *_session        = nullptr;
+    int             _rx_size        = 16384;
+    int             _tx_size        = 512;
+    time_t          _now            = 0;
+    int             _error          = 0;
+    char            _error_text[ 96 ] = "";
+
+    void fail( int code, const char *text );
+};
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+//
+// WiFiUdp.cpp - Host shim of WiFiUDP, answering SNTP requests
+//
+
+#include <sys/time.h>
+
+#include "WiFiUdp.h"
+#include "Host.h"
+
+#define NTP_PACKET   48
+#define NTP_EPOCH    2208988800UL   // 1900 to 1970
+
+
+int WiFiUDP::beginPacket( IPAddress ip, uint16_t port ) {
+  (void)ip;
+  _to = port;
+  _tx.clear();
+  return 1;
+}
+
+int WiFiUDP::beginPacket( const char *host, uint16_t port ) {
+  (void)host;
+  return beginPacket( IPAddress(), port );
+}
+
+size_t WiFiUDP::write( const uint8_t *buffer, size_t size ) {
+  _tx.append( (const char *)buffer, size );
+  return size;
+}
+
+// A client request gets a server reply, stamped with the host's time
+int WiFiUDP::endPacket() {
+  if ( _to != 123 || !host::ntp || _tx.size() < NTP_PACKET || ( _tx[0] & 0x07 ) != 3 ) return 1;
+
+  struct timeval tv;
+  gettimeofday( &tv, nullptr );
+  uint32_t secs = tv.tv_sec + NTP_EPOCH;
+  uint32_t frac = ( (uint64_t)tv.tv_usec << 32 ) / 1000000;
+
+  std::string reply( NTP_PACKET, '\0' );
+  reply[0] = 0x24;                  // LI 0, version 4, mode 4 (server)
+  reply[1] = 2;                     // Stratum
+  for ( int i = 0; i < 4; i++ ) {
+    reply[ 40 + i ] = secs >> ( 24 - i * 8 );
+    reply[ 44 + i ] = frac >> ( 24 - i * 8 );
+  }
+  _pending = reply;
+  return 1;
+}
+
+int WiFiUDP::parsePacket() {
+  if ( _pending.empty() ) return 0;
+  _rx    = _pending;
+  _rx_at = 0;
+  _pending.clear();
+  return _rx.size();
+}
+
+int WiFiUDP::read() {
+  return _rx_at < _rx.size() ? (uint8_t)_rx[ _rx_at++ ] : -1;
+}
+
+int WiFiUDP::read( uint8_t *buffer, size_t len ) {
+  size_t n = _rx.size() - _rx_at;
+  if ( n > len ) n = len;
+  memcpy( buffer, _rx.data() + _rx_at, n );
+  _rx_at += n;
+  return n;
+}
+
+int WiFiUDP::peek() {
+  return _rx_at < _rx.size() ? (uint8_t)_rx[ _rx_at ] : -1;
+}
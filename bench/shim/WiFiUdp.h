@@ -0,0 +1,44 @@
+//
+// WiFiUdp.h - Host shim of WiFiUDP, only as far as SNTP needs: a
+//             request sent to port 123 is answered with the host's time
+//             (unless host::ntp is off)
+//
+
+#ifndef WiFiUdp_h
+#define WiFiUdp_h
+
+#include <string>
+
+#include "ESP8266WiFi.h"
+
+class WiFiUDP : public Stream
+{
+  public:
+    uint8_t begin( uint16_t port )                { _port = port; return 1; }
+    void    stop()                                { _port = 0; }
+
+    int     beginPacket( IPAddress ip, uint16_t port );
+    int     beginPacket( const char *host, uint16_t port );
+    size_t  write( uint8_t c ) override           { return write( &c, 1 ); }
+    size_t  write( const uint8_t *buffer, size_t size ) override;
+    int     endPacket();
+
+    int     parsePacket();
+    int     available() override                  { return _rx.size() - _rx_at; }
+    int     read() override;
+    int     read( uint8_t *buffer, size_t len );
+    int     peek() override;
+    void    flush() override                      { _rx_at = _rx.size(); }
+
+    using Print::write;
+
+  private:
+    uint16_t    _port = 0;
+    uint16_t    _to   = 0;        // Port of the packet being written
+    std::string _tx;
+    std::string _pending;         // Next packet to arrive
+    std::string _rx;              // The one parsePacket() took
+    size_t      _rx_at = 0;
+};
+
+#endif
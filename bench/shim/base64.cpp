@@ -0,0 +1,35 @@
+//
+// base64.cpp - Host shim of the core's base64 encoder.  Like the core,
+//              a newline goes after every 72 characters when asked for.
+//
+
+#include "base64.h"
+
+String base64::encode( const uint8_t *data, size_t length, bool doNewLines ) {
+  static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  size_t size = ( length + 2 ) / 3 * 4;
+  if ( doNewLines ) size += size / 72;
+
+  String out;
+  if ( !out.reserve( size ) ) return String( "-FAIL-" );
+
+  size_t line = 0;
+  for ( size_t i = 0; i < length; i += 3 ) {
+    uint32_t v = (uint32_t)data[i] << 16;
+    if ( i + 1 < length ) v |= (uint32_t)data[i + 1] << 8;
+    if ( i + 2 < length ) v |= data[i + 2];
+
+    char quad[5] = { table[ ( v >> 18 ) & 63 ], table[ ( v >> 12 ) & 63 ],
+                     i + 1 < length ? table[ ( v >> 6 ) & 63 ] : '=',
+                     i + 2 < length ? table[ v & 63 ] : '=', '\0' };
+    out += quad;
+
+    line += 4;
+    if ( doNewLines && line == 72 ) {
+      out += '\n';
+      line = 0;
+    }
+  }
+  return out;
+}
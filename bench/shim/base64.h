@@ -0,0 +1,19 @@
+//
+// base64.h - Host shim of the core's base64 encoder
+//
+
+#ifndef base64_h
+#define base64_h
+
+#include "Arduino.h"
+
+class base64
+{
+  public:
+    static String encode( const uint8_t *data, size_t length, bool doNewLines = true );
+    static String encode( const String &text, bool doNewLines = true ) {
+      return encode( (const uint8_t *)text.c_str(), text.length(), doNewLines );
+    }
+};
+
+#endif
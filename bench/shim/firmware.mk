@@ -0,0 +1,37 @@
+#
+# firmware.mk - Builds the firmware's own sources, the sketch included,
+#               for the host against the shims in this directory.
+#               Included by bench/Makefile and tests/Makefile, which set
+#               BUILD and add their own mains.
+#
+
+SHIM     := $(patsubst %/,%,$(dir $(lastword $(MAKEFILE_LIST))))
+FIRMWARE := $(SHIM)/../..
+
+CXX      ?= g++
+# size_t and pointers are 32 bits on the ESP, the firmware's printf
+# formats and address casts are right there
+CXXFLAGS += -std=gnu++17 -O2 -g -Wall -Wno-unused-function -Wno-sign-compare \
+            -Wno-format -Wno-int-to-pointer-cast -I$(SHIM) -I$(FIRMWARE)
+LDLIBS   += -lssl -lcrypto
+
+FW_SRCS   := $(wildcard $(FIRMWARE)/*.cpp)
+SHIM_SRCS := $(filter-out $(SHIM)/main.cpp, $(wildcard $(SHIM)/*.cpp))
+SKETCH    := $(wildcard $(FIRMWARE)/*.ino)
+
+FW_OBJS   := $(patsubst $(FIRMWARE)/%.cpp, $(BUILD)/fw/%.o, $(FW_SRCS)) $(BUILD)/fw/sketch.o
+SHIM_OBJS := $(patsubst $(SHIM)/%.cpp, $(BUILD)/shim/%.o, $(SHIM_SRCS))
+HOST_MAIN := $(BUILD)/shim/main.o
+
+$(BUILD)/fw/%.o: $(FIRMWARE)/%.cpp $(wildcard $(FIRMWARE)/*.h) $(wildcard $(SHIM)/*.h)
+	@mkdir -p $(dir $@)
+	$(CXX) $(CXXFLAGS) -c $< -o $@
+
+# The IDE's .ino handling: C++ with Arduino.h first
+$(BUILD)/fw/sketch.o: $(SKETCH) $(wildcard $(FIRMWARE)/*.h) $(wildcard $(SHIM)/*.h)
+	@mkdir -p $(dir $@)
+	$(CXX) $(CXXFLAGS) -x c++ -include Arduino.h -c $< -o $@
+
+$(BUILD)/shim/%.o: $(SHIM)/%.cpp $(wildcard $(SHIM)/*.h)
+	@mkdir -p $(dir $@)
+	$(CXX) $(CXXFLAGS) -c $< -o $@
@@ -0,0 +1,17 @@
+//
+// main.cpp - Runs the sketch on the host: setup() once, then loop()
+//            for ever, the web server and SNTP served from its delays.
+//            HOST_* settings are in Host.h.
+//
+
+#include "Arduino.h"
+#include "Host.h"
+
+void setup();
+void loop();
+
+int main() {
+
+  setup();
+  for ( ;; ) loop();
+}
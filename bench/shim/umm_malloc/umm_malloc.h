@@ -0,0 +1,24 @@
+//
+// umm_malloc.h - Host shim of the heap low water mark
+//
+
+#ifndef umm_malloc_h
+#define umm_malloc_h
+
+#include <stdint.h>
+
+// On by default in the core
+#define UMM_STATS
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t umm_free_heap_size_min();
+uint32_t umm_free_heap_size_min_reset();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,34 @@
+//
+// user_interface.h - Host shim of the SDK's reset info
+//
+
+#ifndef user_interface_h
+#define user_interface_h
+
+#include <stdint.h>
+
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+
+enum rst_reason {
+  REASON_DEFAULT_RST      = 0,   // Power on
+  REASON_WDT_RST          = 1,   // Hardware watchdog
+  REASON_EXCEPTION_RST    = 2,
+  REASON_SOFT_WDT_RST     = 3,
+  REASON_SOFT_RESTART     = 4,   // ESP.restart()
+  REASON_DEEP_SLEEP_AWAKE = 5,
+  REASON_EXT_SYS_RST      = 6
+};
+
+struct rst_info {
+  uint32 reason;
+  uint32 exccause;
+  uint32 epc1;
+  uint32 epc2;
+  uint32 epc3;
+  uint32 excvaddr;
+  uint32 depc;
+};
+
+#endif
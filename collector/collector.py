@@ -0,0 +1,521 @@
+"""
+collector.py - Gateway between a fleet of sensors and InfluxDB
+
+Sensors point their db_host/db_port here instead of at InfluxDB.  Their
+writes (InfluxDB 1.x /write and 2.x /api/v2/write, gzipped or not) are
+taken over keep-alive connections, merged per series and timestamp,
+deduplicated, and forwarded upstream as large gzipped batches.
+
+Points for the same target (path, query and Authorization) are merged:
+a point with the same series and timestamp as one already buffered has
+its fields folded into it, and a point that was already forwarded
+(a sensor retrying a write) is dropped.  Unstamped points are stamped
+on arrival.
+
+When more than --max-pending points are waiting on the upstream,
+writes are refused with 503 and a Retry-After.  Sensors keep their
+batch on a 5xx and try again at their next flush, so nothing is lost
+while InfluxDB is slow or down.
+
+Units without DB support can be polled instead: --poll names a JSON
+list of devices whose /sensors endpoint is read every --poll-interval
+seconds, e.g.
+    [{"url": "http://10.0.0.21:8080", "host": "esp-dht-3",
+      "location": "garage", "target": "/write?db=temp"}]
+
+With --tls-cert/--tls-key sensors can write over HTTPS (db_tls).  Pin
+them to the cert with its SHA-1 fingerprint:
+    openssl x509 -noout -fingerprint -sha1 -in cert.pem
+OpenSSL honours the sensors' max fragment length request and resumes
+their sessions, so only a sensor's first connection pays for a full
+handshake.
+
+GET /stats returns the collector's counters.
+
+Usage:
+    python collector.py --upstream http://influxdb:8086 [--listen 0.0.0.0:8086]
+                        [--token TOKEN] [--poll devices.json]
+                        [--tls-cert cert.pem --tls-key key.pem]
+"""
+
+import argparse
+import asyncio
+import gzip
+import http.client
+import json
+import re
+import ssl
+import sys
+import threading
+import time
+import urllib.parse
+
+FLUSH_LINES      = 5000      # Points per upstream write..
+FLUSH_SECONDS    = 10        # ..or the oldest point has waited this long
+MAX_PENDING      = 200000    # Points buffered before writes get a 503
+DEDUP_SECONDS    = 3600      # How long forwarded points are remembered
+MAX_BODY         = 8 << 20   # Largest request body accepted
+KEEPALIVE        = 75        # Seconds an idle connection is kept open
+UPSTREAM_WORKERS = 4         # Concurrent upstream writes
+RETRY_MAX        = 60        # Longest backoff between upstream retries, seconds
+
+PRECISION = {"s": 1, "ms": 1000, "u": 10**6, "us": 10**6, "ns": 10**9}
+
+STATUS = {200: "OK", 204: "No Content", 400: "Bad Request", 404: "Not Found",
+          405: "Method Not Allowed", 413: "Payload Too Large", 503: "Service Unavailable"}
+
+
+def log(msg):
+    print("%s %s" % (time.strftime("%H:%M:%S"), msg), flush=True)
+
+
+#
+# Line protocol
+#
+
+def split_unescaped(text, sep, limit=-1):
+    """Split on sep outside of backslash escapes and double quotes"""
+    parts  = []
+    start  = 0
+    quoted = False
+    i      = 0
+
+    while i < len(text):
+        c = text[i]
+        if c == "\\":
+            i += 2
+            continue
+        if c == '"':
+            quoted = not quoted
+        elif c == sep and not quoted and limit != 0:
+            parts.append(text[start:i])
+            start  = i + 1
+            limit -= 1
+        i += 1
+
+    parts.append(text[start:])
+    return parts
+
+
+def parse_line(line):
+    """(series, {field: raw value}, timestamp or None), None if unusable"""
+    parts = split_unescaped(line, " ")
+    if len(parts) not in (2, 3) or not parts[0] or not parts[1]:
+        return None
+
+    fields = {}
+    for field in split_unescaped(parts[1], ","):
+        kv = split_unescaped(field, "=", 1)
+        if len(kv) != 2 or not kv[0]:
+            return None
+        fields[kv[0]] = kv[1]
+
+    timestamp = None
+    if len(parts) == 3:
+        if not re.match(r"^-?\d+$", parts[2]):
+            return None
+        timestamp = int(parts[2])
+
+    return parts[0], fields, timestamp
+
+
+def format_line(series, fields, timestamp):
+    return "%s %s %d" % (series, ",".join("%s=%s" % kv for kv in fields.items()), timestamp)
+
+
+#
+# Merging and forwarding
+#
+
+class Batch:
+    """Points waiting to go to one upstream target, keyed by (series, timestamp)"""
+
+    def __init__(self):
+        self.points  = {}
+        self.started = time.monotonic()
+
+
+class Collector:
+    def __init__(self, upstream, token=None, max_pending=MAX_PENDING):
+        url = urllib.parse.urlsplit(upstream)
+        self.upstream    = (url.scheme, url.netloc)
+        self.token       = token
+        self.max_pending = max_pending
+
+        self.batches  = {}      # target -> Batch
+        self.sending  = 0       # Points in writes that haven't finished
+        self.seen     = {}      # (target, series, timestamp) -> when it was sent upstream
+        self.retry_at = 0
+        self.backoff  = 1
+        self.local    = threading.local()
+        self.workers  = asyncio.Semaphore(UPSTREAM_WORKERS)
+
+        self.stats = dict.fromkeys(["requests", "connections", "points", "merged", "duplicates",
+                                    "invalid", "rejected", "forwarded", "writes",
+                                    "upstream_errors", "dropped", "polls", "poll_errors"], 0)
+
+    @property
+    def pending(self):
+        return sum(len(b.points) for b in self.batches.values()) + self.sending
+
+    def busy(self):
+        return self.pending >= self.max_pending
+
+    def add(self, target, body, precision="ns"):
+        """Merge line protocol into the target's batch, returns the number of bad lines"""
+        batch   = self.batches.setdefault(target, Batch())
+        arrived = int(time.time() * PRECISION.get(precision, 10**9))
+        invalid = 0
+
+        for line in body.splitlines():
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+
+            point = parse_line(line)
+            if not point:
+                invalid += 1
+                continue
+
+            series, fields, timestamp = point
+            if timestamp is None:
+                timestamp = arrived
+            self.stats["points"] += 1
+
+            key = (series, timestamp)
+            if (target,) + key in self.seen:
+                self.stats["duplicates"] += 1
+            elif key in batch.points:
+                batch.points[key].update(fields)
+                self.stats["merged"] += 1
+            else:
+                batch.points[key] = fields
+
+        self.stats["invalid"] += invalid
+        return invalid
+
+    async def run(self):
+        """Send batches that are big enough or old enough"""
+        while True:
+            await asyncio.sleep(0.5)
+            now = time.monotonic()
+
+            if now >= self.retry_at:
+                for target, batch in list(self.batches.items()):
+                    if batch.points and ( len(batch.points) >= FLUSH_LINES or now - batch.started >= FLUSH_SECONDS ):
+                        del self.batches[target]
+
+                        # Retries that arrive while the write is in flight are duplicates too
+                        sent = time.time()
+                        for series, timestamp in batch.points:
+                            self.seen[(target, series, timestamp)] = sent
+
+                        asyncio.ensure_future(self.forward(target, batch))
+
+            # Forget forwarded points once a retry of them is unlikely
+            cutoff = time.time() - DEDUP_SECONDS
+            if len(self.seen) > 0 and next(iter(self.seen.values())) < cutoff:
+                self.seen = {k: t for k, t in self.seen.items() if t >= cutoff}
+
+    async def forward(self, target, batch):
+        points = list(batch.points.items())
+        self.sending += len(points)
+
+        try:
+            async with self.workers:
+                for i in range(0, len(points), FLUSH_LINES):
+                    chunk = points[i:i + FLUSH_LINES]
+                    body  = "\n".join(format_line(s, f, t) for (s, t), f in chunk).encode()
+                    status = await asyncio.to_thread(self.post, target, gzip.compress(body, 6))
+
+                    if 200 <= status < 300:
+                        self.stats["forwarded"] += len(chunk)
+                        self.stats["writes"]    += 1
+                        self.backoff = 1
+
+                    elif 400 <= status < 500 and status not in (408, 429):
+                        # InfluxDB won't take these however often they're sent
+                        log("upstream refused %d points (%d), dropping them" % (len(chunk), status))
+                        self.stats["dropped"] += len(chunk)
+
+                    else:
+                        # Put what's left back and hold off everyone for a while
+                        self.stats["upstream_errors"] += 1
+                        log("upstream write failed (%d), retrying in %ds" % (status, self.backoff))
+                        self.retry_at = time.monotonic() + self.backoff
+                        self.backoff  = min(self.backoff * 2, RETRY_MAX)
+
+                        retry = self.batches.setdefault(target, Batch())
+                        for key, fields in points[i:]:
+                            retry.points.setdefault(key, {}).update(fields)
+                            self.seen.pop((target,) + key, None)
+                        break
+        finally:
+            self.sending -= len(points)
+
+    def post(self, target, body):
+        """Blocking upstream write, one kept-alive connection per worker thread"""
+        path, auth = target
+        headers = {"Content-Type": "text/plain; charset=utf-8", "Content-Encoding": "gzip"}
+        if self.token:
+            headers["Authorization"] = "Token " + self.token
+        elif auth:
+            headers["Authorization"] = auth
+
+        for attempt in (1, 2):
+            conn = getattr(self.local, "conn", None)
+            if conn is None:
+                cls  = http.client.HTTPSConnection if self.upstream[0] == "https" else http.client.HTTPConnection
+                conn = self.local.conn = cls(self.upstream[1], timeout=30)
+            try:
+                conn.request("POST", path, body, headers)
+                response = conn.getresponse()
+                response.read()
+                return response.status
+            except (OSError, http.client.HTTPException):
+                # A stale keep-alive connection gets one fresh try
+                conn.close()
+                self.local.conn = None
+        return 0
+
+
+#
+# Sensor facing HTTP server
+#
+
+def write_target(path):
+    """(upstream path, precision) for a write, None if it isn't one"""
+    url = urllib.parse.urlsplit(path)
+    if url.path not in ("/write", "/api/v2/write"):
+        return None
+
+    query = urllib.parse.parse_qsl(url.query)
+    precision = dict(query).get("precision", "ns")
+    return url.path + "?" + urllib.parse.urlencode(sorted(query)), precision
+
+
+async def read_body(reader, headers):
+    if headers.get("transfer-encoding", "").lower() == "chunked":
+        body = b""
+        while True:
+            size = int((await reader.readline()).split(b";")[0], 16)
+            if size == 0:
+                await reader.readline()
+                return body
+            body += await reader.readexactly(size)
+            await reader.readline()
+            if len(body) > MAX_BODY:
+                raise ValueError("body too large")
+
+    length = int(headers.get("content-length", 0))
+    if length > MAX_BODY:
+        raise ValueError("body too large")
+    return await reader.readexactly(length) if length else b""
+
+
+def respond(writer, status, body=b"", headers=None, close=False):
+    lines = ["HTTP/1.1 %d %s" % (status, STATUS.get(status, "")),
+             "Content-Length: %d" % len(body),
+             "Connection: %s" % ("close" if close else "keep-alive")]
+    for name, value in (headers or {}).items():
+        lines.append("%s: %s" % (name, value))
+    writer.write(("\r\n".join(lines) + "\r\n\r\n").encode() + body)
+
+
+async def serve(collector, reader, writer):
+    collector.stats["connections"] += 1
+    try:
+        while True:
+            try:
+                request = await asyncio.wait_for(reader.readline(), KEEPALIVE)
+            except asyncio.TimeoutError:
+                return
+            if not request:
+                return
+
+            parts = request.decode("latin-1").split()
+            if len(parts) != 3:
+                respond(writer, 400, close=True)
+                return
+            method, path, version = parts
+
+            headers = {}
+            while True:
+                line = await reader.readline()
+                if line in (b"\r\n", b"\n", b""):
+                    break
+                name, _, value = line.decode("latin-1").partition(":")
+                headers[name.strip().lower()] = value.strip()
+
+            close = headers.get("connection", "").lower() == "close" or version == "HTTP/1.0"
+
+            try:
+                body = await read_body(reader, headers)
+            except ValueError:
+                respond(writer, 413, close=True)
+                return
+
+            collector.stats["requests"] += 1
+            status, content, extra = handle(collector, method, path, headers, body)
+            respond(writer, status, content, extra, close)
+            await writer.drain()
+
+            if close:
+                return
+    except (ConnectionError, asyncio.IncompleteReadError):
+        pass
+    finally:
+        writer.close()
+
+
+def handle(collector, method, path, headers, body):
+    """(status, body, headers) for one request"""
+    if path in ("/ping", "/health"):
+        return 204, b"", {}
+
+    if path == "/stats":
+        stats = dict(collector.stats, pending=collector.pending, targets=len(collector.batches))
+        return 200, json.dumps(stats).encode(), {"Content-Type": "application/json"}
+
+    target = write_target(path)
+    if not target:
+        return 404, b"", {}
+    if method != "POST":
+        return 405, b"", {}
+
+    # Back-pressure: the sensor keeps its batch and tries again later
+    if collector.busy():
+        collector.stats["rejected"] += 1
+        return 503, b"", {"Retry-After": str(FLUSH_SECONDS)}
+
+    try:
+        if headers.get("content-encoding", "").lower() == "gzip":
+            body = gzip.decompress(body)
+        text = body.decode("utf-8")
+    except (OSError, EOFError, UnicodeDecodeError):
+        return 400, b'{"error": "unreadable body"}', {"Content-Type": "application/json"}
+
+    upstream_path, precision = target
+    invalid = collector.add((upstream_path, headers.get("authorization")), text, precision)
+    if invalid:
+        return 400, json.dumps({"error": "%d invalid lines" % invalid}).encode(), {"Content-Type": "application/json"}
+
+    return 204, b"", {}
+
+
+#
+# Legacy units without DB support
+#
+
+def escape(text):
+    return re.sub(r"([, =])", r"\\\1", str(text))
+
+
+def sensor_line(device, reading, timestamp):
+    """Line protocol for a /sensors reading, matching what DB sends"""
+    tags = "%s,host=%s,location=%s" % (escape(device.get("measurement", "ambient")),
+                                       escape(device["host"]), escape(device.get("location", "unknown")))
+    names = {"temp": "temperature", "hum": "humidity", "hidx": "heat_index",
+             "dewpt": "dew_point", "abshum": "abs_humidity", "vpd": "vpd"}
+
+    fields = ["%s=%s" % (names[k], reading[k]) for k in names if isinstance(reading.get(k), (int, float))]
+    lines  = ["%s %s %d" % (tags, ",".join(fields), timestamp)] if fields else []
+
+    if isinstance(reading.get("analog"), (int, float)) and isinstance(reading.get("pressure"), (int, float)):
+        lines.append("analog,host=%s,location=%s analog=%s,pressure=%s %d" % (
+            escape(device["host"]), escape(device.get("location", "unknown")),
+            reading["analog"], reading["pressure"], timestamp))
+
+    return "\n".join(lines)
+
+
+async def fetch_sensors(url, timeout=5):
+    url    = urllib.parse.urlsplit(url)
+    reader, writer = await asyncio.wait_for(asyncio.open_connection(url.hostname, url.port or 80), timeout)
+    try:
+        writer.write(("GET /sensors HTTP/1.1\r\nHost: %s\r\nAccept: application/json\r\n"
+                      "Connection: close\r\n\r\n" % url.netloc).encode())
+        response = await asyncio.wait_for(reader.read(), timeout)
+    finally:
+        writer.close()
+
+    head, _, body = response.partition(b"\r\n\r\n")
+    if not head.startswith(b"HTTP/1.") or head.split()[1] != b"200":
+        raise ValueError(head.split(b"\r\n")[0])
+
+    # The firmware prints unreadable values as nan
+    return json.loads(re.sub(rb"\bnan\b", b"null", body))
+
+
+async def poll(collector, devices, interval):
+    """Read every device's /sensors once per interval, on the interval boundary"""
+    limit = asyncio.Semaphore(200)
+
+    async def one(device, timestamp):
+        async with limit:
+            try:
+                reading = await fetch_sensors(device["url"])
+            except (OSError, ValueError, asyncio.TimeoutError) as e:
+                collector.stats["poll_errors"] += 1
+                log("poll %s failed: %s" % (device["url"], e))
+                return
+
+        collector.stats["polls"] += 1
+        lines = sensor_line(device, reading, timestamp)
+        if lines:
+            collector.add((device.get("target", "/write?db=temp"), None), lines, "s")
+
+    while True:
+        await asyncio.sleep(interval - time.time() % interval)
+        if not collector.busy():
+            timestamp = int(time.time()) // interval * interval
+            await asyncio.gather(*(one(device, timestamp) for device in devices))
+
+
+async def start(args):
+    collector = Collector(args.upstream, args.token, args.max_pending)
+
+    host, _, port = args.listen.rpartition(":")
+    context = None
+    if args.tls_cert:
+        context = ssl.create_default_context(ssl.Purpose.CLIENT_AUTH)
+        context.load_cert_chain(args.tls_cert, args.tls_key)
+
+    server = await asyncio.start_server(lambda r, w: serve(collector, r, w), host or None, int(port),
+                                        backlog=1024, ssl=context)
+    log("listening on %s%s, forwarding to %s" % (args.listen, " (tls)" if context else "", args.upstream))
+
+    tasks = [collector.run()]
+    if args.poll:
+        with open(args.poll) as f:
+            devices = json.load(f)
+        log("polling %d legacy devices every %ds" % (len(devices), args.poll_interval))
+        tasks.append(poll(collector, devices, args.poll_interval))
+
+    async with server:
+        await asyncio.gather(server.serve_forever(), *tasks)
+
+
+def main(args):
+    parser = argparse.ArgumentParser(description="Batch sensor writes on their way to InfluxDB")
+    parser.add_argument("--upstream", required=True, help="InfluxDB base URL, e.g. http://influxdb:8086")
+    parser.add_argument("--listen", default="0.0.0.0:8086", help="address:port sensors write to")
+    parser.add_argument("--token", help="InfluxDB 2.x token, replaces the ones sensors send")
+    parser.add_argument("--max-pending", type=int, default=MAX_PENDING, help="points buffered before writes get a 503")
+    parser.add_argument("--poll", help="JSON list of legacy devices to poll")
+    parser.add_argument("--poll-interval", type=int, default=60, help="seconds between polls")
+    parser.add_argument("--tls-cert", help="PEM certificate (chain) to serve HTTPS with")
+    parser.add_argument("--tls-key", help="PEM private key for --tls-cert")
+    args = parser.parse_args(args)
+    if bool(args.tls_cert) != bool(args.tls_key):
+        parser.error("--tls-cert and --tls-key go together")
+
+    try:
+        asyncio.run(start(args))
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
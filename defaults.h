@@ -1,6 +1,7 @@
 #define INO_VERSION       "0.5.0"
 #define TEST_MODE         0   // turns off authentication for local dev
-#define UPDATE_URL        "http://heatstroke.axcella.com:5000/update"
+#define UPDATE_SERVER     "http://heatstroke.axcella.com:5000"
+#define UPDATE_URL        UPDATE_SERVER "/update"
 
 // DHT22 Globals
 #define DHTPWR   D3
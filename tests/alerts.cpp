@@ -0,0 +1,101 @@
+//
+// alerts.cpp - Replays a temperature and humidity trace through the
+//              sketch on the virtual clock, with the alert rules and
+//              webhook given
+//
+//   alerts <webhook url> <rules> <sample interval> [<seconds> <rules>]... < trace
+//
+// The trace is "<seconds> <temp F> <humidity %>" lines, each reading
+// held until the next line's time; the run ends at the last one.  The
+// rules are set again to each of the later ones at its time.  Each
+// time the webhook takes an event the time is printed, "sent <ms> <n>",
+// so the test can put its events on the trace's clock.  Webhook POSTs
+// are real connections, but the virtual clock doesn't move during them.
+//
+
+#include <stdio.h>
+#include <vector>
+
+#include "Arduino.h"
+#include "Host.h"
+#include "Config.h"
+#include "Alerts.h"
+
+#define STEP_MS  100      // Virtual time between passes of loop()
+
+extern Config config;
+extern Alerts alerts;
+
+void setup();
+void loop();
+
+struct reading {
+  unsigned long at;       // ms
+  float         temp_f;
+  float         humidity;
+};
+
+// Webhook events taken so far, from /alerts
+static uint32_t sent() {
+  String json = alerts.JSON();
+  int    at   = json.indexOf( "\"sent\": " );
+  return at < 0 ? 0 : atol( json.c_str() + at + 8 );
+}
+
+int main( int argc, char **argv ) {
+  if ( argc < 4 || argc % 2 != 0 ) {
+    fprintf( stderr, "usage: alerts <webhook url> <rules> <sample interval> [<seconds> <rules>]... < trace\n" );
+    return 2;
+  }
+
+  std::vector<reading> trace;
+  reading r;
+  double  secs;
+  while ( scanf( "%lf %f %f", &secs, &r.temp_f, &r.humidity ) == 3 ) {
+    r.at = secs * 1000;
+    trace.push_back( r );
+  }
+  if ( trace.empty() ) return 2;
+
+  size_t next = 0;
+  host::virtual_clock( 0 );
+  host::dht = [&]( float &temp_f, float &humidity ) {
+    while ( next + 1 < trace.size() && trace[ next + 1 ].at <= millis() ) next++;
+    temp_f   = trace[ next ].temp_f;
+    humidity = trace[ next ].humidity;
+    return true;
+  };
+
+  setup();
+  if ( !config.set( CONFIG_ALERT_URL, argv[1] ) || !config.set( CONFIG_ALERT_RULES, argv[2] ) ||
+       !config.set( CONFIG_SAMPLE_INTERVAL, argv[3] ) ) {
+    fprintf( stderr, "bad settings\n" );
+    return 2;
+  }
+  config.loop();
+
+  uint32_t reported = 0;
+  int      change   = 4;
+  while ( millis() < trace.back().at ) {
+    if ( change < argc && millis() >= atof( argv[ change ] ) * 1000 ) {
+      if ( !config.set( CONFIG_ALERT_RULES, argv[ change + 1 ] ) ) {
+        fprintf( stderr, "bad rules: %s\n", argv[ change + 1 ] );
+        return 2;
+      }
+      change += 2;
+    }
+
+    loop();
+
+    uint32_t n = sent();
+    if ( n != reported ) {
+      reported = n;
+      printf( "sent %lu %u\n", millis(), n );
+      fflush( stdout );
+    }
+    host::advance( STEP_MS * 1000 );
+  }
+
+  printf( "%s\n", alerts.JSON().c_str() );
+  return 0;
+}
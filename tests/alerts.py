@@ -0,0 +1,145 @@
+"""
+alerts.py - Alert traces replayed against a local webhook stub
+
+The alerts driver runs the sketch on a trace covering each kind of rule:
+
+  t>95/1     a step over the threshold, then readings flapping across
+             it that the hysteresis has to hold through, then clear
+  h+10       humidity ramping faster than 10 %/min
+  t<50@60    a dip too short to count, then one that lasts
+
+The stub refuses the first POST, so that event has to come again with
+the same id.  Each rule has to fire and clear exactly once, in order,
+and every threshold alert has to reach the webhook within a poll
+interval of the trace crossing it (plus the confirmation of a step).
+
+Then again with the rules edited while they're active: one that only
+moves carries on without firing again, and one that's dropped is
+cleared straight away.
+"""
+
+import http.server
+import json
+import sys
+import threading
+
+from host import check, driver, free_port, result
+
+RULES    = "t>95/1,h+10,t<50@60"
+INTERVAL = 10             # Sample interval, the slowest the sensor polls
+CONFIRM  = 3              # Seconds to confirm a step change, SENSOR_RETRY_DELAY
+RETRY    = 5              # ALERT_RETRY_MIN
+
+
+def trace():
+    """[(seconds, temp F, humidity %)], one a second"""
+    lines = []
+    for t in range(1200):
+        temp = 75.0
+        if 180 <= t < 300:
+            temp = 96.0
+        elif 300 <= t < 420:
+            temp = 95.5 if (t // 4) % 2 else 94.5       # Never back under 94
+        elif 780 <= t < 820 or 900 <= t < 1000:
+            temp = 45.0
+
+        hum = 45.0
+        if 540 <= t < 600:
+            hum = 45.0 + (t - 540) * 40 / 60.0          # 40 %/min
+        elif 600 <= t < 720:
+            hum = 85.0
+
+        lines.append((t, temp, hum))
+    return lines
+
+
+# When each threshold event should happen: (rule, state, trace second)
+EXPECTED = [("t>95.00/1.00", "firing", 180), ("t>95.00/1.00", "cleared", 420),
+            ("h+10.00", "firing", None), ("h+10.00", "cleared", None),
+            ("t<50.00@60", "firing", 960), ("t<50.00@60", "cleared", 1000)]
+
+# (trace second, rules), while t>95/1 and then h+10 are active
+CHANGES = [(240, "h+10,t>95/1"), (620, "t>95/1")]
+EDITED  = [("t>95.00/1.00", "firing"), ("t>95.00/1.00", "cleared"), ("h+10.00", "firing"), ("h+10.00", "cleared")]
+
+
+class Webhook(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    events  = []          # Taken, in order
+    refused = []
+
+    def do_POST(self):
+        event = json.loads(self.rfile.read(int(self.headers["Content-Length"])))
+        status = 204
+        if not self.refused:
+            self.refused.append(event)
+            status = 500
+        else:
+            self.events.append(event)
+
+        self.send_response(status)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def log_message(self, *args):
+        pass
+
+
+def replay(build, rules, changes=()):
+    """({event number: trace second it was sent}, final /alerts)"""
+    Webhook.events, Webhook.refused = [], []
+    port   = free_port()
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", port), Webhook)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+
+    # Without the wall clock polls are timed from boot, not lined up
+    # with the host's time, so every replay comes out the same
+    args = ["http://127.0.0.1:%d/hook" % port, rules, str(INTERVAL)]
+    for at, edited in changes:
+        args += [str(at), edited]
+    text = "\n".join("%d %.2f %.2f" % line for line in trace()) + "\n"
+    out  = driver(build, "alerts", args, text, dict(HOST_NTP="0"))
+    server.shutdown()
+
+    sent = {int(n): int(ms) / 1000 for _, ms, n in (line.split() for line in out if line.startswith("sent "))}
+    return sent, json.loads(out[-1])
+
+
+def main(build):
+    sent, stats = replay(build, RULES)
+
+    got = [(e["rule"], e["state"]) for e in Webhook.events]
+    check(got == [(rule, state) for rule, state, _ in EXPECTED], "events: %s" % got)
+    check(len({e["id"] for e in Webhook.events}) == len(EXPECTED), "ids repeat: %s" % Webhook.events)
+    check(Webhook.refused[0]["id"] == Webhook.events[0]["id"] and Webhook.events[0]["try"] == 2,
+          "refused event not retried as is: %s %s" % (Webhook.refused, Webhook.events[0]))
+
+    latencies = []
+    for n, (rule, state, at) in enumerate(EXPECTED, 1):
+        if at is None:
+            continue
+        # A duration is counted from the poll that first sees the
+        # condition, and is up at the first poll after it's run out
+        limit   = INTERVAL + CONFIRM + (INTERVAL if "@" in rule and state == "firing" else 0)
+        latency = sent[n] - at - (RETRY if n == 1 else 0)
+        latencies.append(latency)
+        check(0 <= latency <= limit, "%s %s %.1f s after the trace crossed" % (rule, state, latency))
+
+    result("alerts", events=len(Webhook.events), refused=len(Webhook.refused), sent=stats["sent"],
+           failed=stats["failed"], latency_max_s=round(max(latencies), 1),
+           latency_avg_s=round(sum(latencies) / len(latencies), 1))
+
+    # Edited rules
+    sent, stats = replay(build, RULES, CHANGES)
+    got = [(e["rule"], e["state"]) for e in Webhook.events]
+    check(got == EDITED, "edited rules, events: %s" % got)
+    check(Webhook.events[1]["value"] < 95 and sent[2] - EXPECTED[1][2] <= INTERVAL + CONFIRM,
+          "moved rule didn't carry on: %s" % Webhook.events[1])
+    dropped = sent[4] - CHANGES[1][0]
+    check(0 <= dropped <= 1, "dropped rule cleared %.1f s after the edit" % dropped)
+
+    result("alerts_edited", events=len(Webhook.events), changes=len(CHANGES), dropped_clear_s=round(dropped, 1))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
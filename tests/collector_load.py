@@ -0,0 +1,186 @@
+"""
+collector_load.py - Thousands of devices writing through collector/
+
+The collector runs as it would in front of InfluxDB, with a local stub
+as its upstream.  Every device keeps one connection open and writes a
+few gzipped batches, some to 1.x and some to 2.x with a token, and
+resends a few it already got a 204 for, as a sensor does when the reply
+is lost.  Everything has to reach the upstream exactly once, in far
+fewer, gzipped writes.
+
+Then again with the upstream refusing its first writes and a small
+--max-pending: the devices get 503s and retry, and still nothing is
+lost or doubled.
+"""
+
+import asyncio
+import gzip
+import json
+import os
+import random
+import subprocess
+import sys
+import time
+import urllib.request
+
+from host import check, free_port, percentile, result
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "collector"))
+from collector import parse_line
+
+COLLECTOR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "collector", "collector.py")
+
+DEVICES  = 2000
+BATCHES  = 5              # Per device
+SAMPLES  = 3              # Per batch, two points each
+RESEND   = 0.05           # Of accepted batches sent again
+TOKEN    = "fleet-token"
+
+
+class Upstream:
+    """InfluxDB stand-in, refuses its first `fail` writes with a 503"""
+
+    def __init__(self, fail=0):
+        self.fail   = fail
+        self.writes = []        # (path, authorization, gzipped, lines)
+
+    async def serve(self, reader, writer):
+        while True:
+            request = await reader.readline()
+            if not request:
+                break
+            headers = {}
+            while True:
+                line = await reader.readline()
+                if line in (b"\r\n", b""):
+                    break
+                name, _, value = line.decode().partition(":")
+                headers[name.strip().lower()] = value.strip()
+            body = await reader.readexactly(int(headers["content-length"]))
+
+            if self.fail > 0:
+                self.fail -= 1
+                writer.write(b"HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n")
+            else:
+                gzipped = headers.get("content-encoding") == "gzip"
+                text    = (gzip.decompress(body) if gzipped else body).decode()
+                self.writes.append((request.split()[1].decode(), headers.get("authorization"), gzipped,
+                                    text.splitlines()))
+                writer.write(b"HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n")
+            await writer.drain()
+        writer.close()
+
+
+async def device(n, port, statuses, times):
+    v2   = n % 2 == 1
+    path = "/api/v2/write?org=farm&bucket=sensors&precision=s" if v2 else "/write?db=temp&precision=s"
+    auth = "Authorization: Token %s\r\n" % TOKEN if v2 else ""
+
+    await asyncio.sleep(random.random() * 2)        # Don't all connect in the same instant
+    reader, writer = await asyncio.open_connection("127.0.0.1", port)
+
+    for b in range(BATCHES):
+        lines = []
+        for s in range(SAMPLES):
+            at = 1700000000 + (b * SAMPLES + s) * 60
+            lines.append("ambient,host=esp-%d,location=lab temperature=%.2f,humidity=45.00 %d" %
+                         (n, 70 + random.random(), at))
+            lines.append("analog,host=esp-%d,location=lab analog=1.00 %d" % (n, at))
+        body = gzip.compress("\n".join(lines).encode())
+
+        while True:
+            started = time.time()
+            writer.write(("POST %s HTTP/1.1\r\nHost: collector\r\n%sContent-Encoding: gzip\r\n"
+                          "Content-Length: %d\r\n\r\n" % (path, auth, len(body))).encode() + body)
+            await writer.drain()
+            status = int((await reader.readline()).split()[1])
+            while (await reader.readline()) not in (b"\r\n", b""):
+                pass
+            times.append(time.time() - started)
+            statuses[status] = statuses.get(status, 0) + 1
+
+            if status == 204 and random.random() >= RESEND:
+                break
+            if status != 204:
+                await asyncio.sleep(1 + random.random() * 2)      # Kept for the next flush
+        await asyncio.sleep(random.random() * 0.5)
+
+    writer.close()
+
+
+def stats(port):
+    with urllib.request.urlopen("http://127.0.0.1:%d/stats" % port, timeout=10) as r:
+        return json.loads(r.read())
+
+
+async def fleet(name, fail=0, max_pending=None):
+    upstream = Upstream(fail)
+    up_port  = free_port()
+    server   = await asyncio.start_server(upstream.serve, "127.0.0.1", up_port)
+
+    port = free_port()
+    args = [sys.executable, COLLECTOR, "--upstream", "http://127.0.0.1:%d" % up_port,
+            "--listen", "127.0.0.1:%d" % port]
+    if max_pending:
+        args += ["--max-pending", str(max_pending)]
+    proc = subprocess.Popen(args, stdout=subprocess.DEVNULL)
+
+    try:
+        deadline = time.time() + 10
+        while True:
+            try:
+                _, probe = await asyncio.open_connection("127.0.0.1", port)
+                probe.close()
+                break
+            except OSError:
+                check(time.time() < deadline and proc.poll() is None, "collector never started")
+                await asyncio.sleep(0.1)
+
+        statuses, times = {}, []
+        started = time.time()
+        await asyncio.gather(*(device(n, port, statuses, times) for n in range(DEVICES)))
+        took = time.time() - started
+
+        # Everything buffered goes up within a flush, plus any backoff
+        deadline = time.time() + 60
+        while True:
+            counters = await asyncio.to_thread(stats, port)
+            if counters["pending"] == 0 or time.time() > deadline:
+                break
+            await asyncio.sleep(0.5)
+    finally:
+        proc.terminate()
+        proc.wait()
+        await asyncio.sleep(0.2)        # Its upstream connections see EOF
+        server.close()
+
+    expected = DEVICES * BATCHES * SAMPLES * 2
+    points   = [(path, auth, parse_line(line)) for path, auth, _, lines in upstream.writes for line in lines]
+    unique   = {(path, series, timestamp) for path, _, (series, _, timestamp) in points}
+
+    result(name, devices=DEVICES, requests=sum(statuses.values()), statuses=statuses,
+           requests_per_s=round(sum(statuses.values()) / took), p99_ms=round(percentile(times, 99) * 1000, 1),
+           points=expected, upstream_writes=len(upstream.writes),
+           points_per_write=round(len(points) / max(1, len(upstream.writes))),
+           duplicates=counters["duplicates"], rejected=counters["rejected"])
+
+    check(len(points) == expected and len(unique) == expected,
+          "%s: %d points upstream, %d unique, %d sent" % (name, len(points), len(unique), expected))
+    check(all(gzipped for _, _, gzipped, _ in upstream.writes), "%s: an upstream write wasn't gzipped" % name)
+    check(all((auth == "Token " + TOKEN) == path.startswith("/api/v2/") for path, auth, _ in points),
+          "%s: 1.x and 2.x points mixed up" % name)
+    check(len(upstream.writes) * 100 <= sum(statuses.values()), "%s: %d upstream writes for %d requests" %
+          (name, len(upstream.writes), sum(statuses.values())))
+    return statuses, counters
+
+
+def main(build):
+    statuses, counters = asyncio.run(fleet("collector_load"))
+    check(set(statuses) == {204} and counters["duplicates"] > 0, "resent batches: %s %s" % (statuses, counters))
+
+    statuses, counters = asyncio.run(fleet("collector_backpressure", fail=3, max_pending=20000))
+    check(statuses.get(503, 0) > 0 and counters["upstream_errors"] == 3, "no back-pressure: %s %s" % (statuses, counters))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
@@ -0,0 +1,112 @@
+"""
+db_gzip.py - DB writes against a stub InfluxDB that decompresses and
+             validates them
+
+The firmware is pointed at a local stub for InfluxDB 1.x and 2.x, with
+and without gzip, and batching a few samples per write.  Every body the
+stub takes has to be well formed line protocol, gzipped exactly when
+Content-Encoding says so, with the 2.x org, bucket and token and
+precision=s.  What gzip saves is reported.
+"""
+
+import gzip
+import http.server
+import os
+import re
+import sys
+import threading
+import time
+import urllib.parse
+
+from host import Firmware, check, free_port, result
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "collector"))
+from collector import parse_line
+
+ORG, BUCKET, TOKEN = "farm", "sensors", "s3cret-token"
+WRITES  = 3              # Writes with readings taken from each setup
+TIMEOUT = 60             # Seconds to wait for them; the first poll can
+                         # be SENSOR_POLL_INTERVAL in, and then every 2s
+
+# Field values: floats, integers, strings and booleans
+VALUE = re.compile(r'^(-?[0-9]+(\.[0-9]+)?i?|"([^"\\]|\\.)*"|true|false)$')
+
+
+class Stub(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    writes = []
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers["Content-Length"]))
+        self.writes.append((self.path, dict(self.headers), body))
+        self.send_response(204)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def log_message(self, *args):
+        pass
+
+
+def validate(setup, path, headers, body):
+    url   = urllib.parse.urlparse(path)
+    query = urllib.parse.parse_qs(url.query)
+    check(query.get("precision") == ["s"], "%s: precision in %s" % (setup, path))
+
+    if setup["db_type"] == 3:
+        check(url.path == "/api/v2/write", "%s: path %s" % (setup, path))
+        check(query.get("org") == [ORG] and query.get("bucket") == [BUCKET], "%s: %s" % (setup, path))
+        check(headers.get("Authorization") == "Token " + TOKEN, "%s: no token" % setup)
+    else:
+        check(url.path == "/write" and query.get("db") == ["temp"], "%s: path %s" % (setup, path))
+
+    gzipped = headers.get("Content-Encoding") == "gzip"
+    check(gzipped == bool(setup["db_gzip"]), "%s: Content-Encoding %s" % (setup, headers.get("Content-Encoding")))
+
+    text = gzip.decompress(body).decode() if gzipped else body.decode()
+    lines = text.strip().split("\n")
+    for line in lines:
+        point = parse_line(line)
+        check(point and all(VALUE.match(v) for v in point[1].values()), "%s: bad line %r" % (setup, line))
+        check(point[2] is None or 10**9 < point[2] < 10**10, "%s: timestamp not in seconds %r" % (setup, line))
+    return text, len(body)
+
+
+def readings(setup):
+    """Writes so far carrying a sensor reading (the shim's DHT)"""
+    return sum("temperature=72.50" in validate(setup, *write)[0] for write in list(Stub.writes))
+
+
+def main(build):
+    port   = free_port()
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", port), Stub)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+
+    setups = [dict(db_type=1, db_gzip=0), dict(db_type=1, db_gzip=1),
+              dict(db_type=3, db_gzip=0), dict(db_type=3, db_gzip=1)]
+    sizes  = {}
+
+    for setup in setups:
+        Stub.writes = []
+        with Firmware(build, env=dict(HOST_RESOLVE="influx.test=127.0.0.1")) as fw:
+            fw.settings(db_host="influx.test", db_port=port, db_name="temp", db_org=ORG, db_bucket=BUCKET,
+                        db_token=TOKEN, interval=2, db_flush=2, **setup)
+
+            deadline = time.time() + TIMEOUT
+            while readings(setup) < WRITES and time.time() < deadline:
+                time.sleep(0.2)
+
+        check(readings(setup) >= WRITES, "%s: %d writes with readings in %d s" % (setup, readings(setup), TIMEOUT))
+        for path, headers, body in Stub.writes:
+            text, sent = validate(setup, path, headers, body)
+            sizes.setdefault(setup["db_gzip"], []).append((len(text), sent))
+
+    server.shutdown()
+
+    text  = sum(t for t, _ in sizes[1])
+    sent  = sum(s for _, s in sizes[1])
+    result("db_gzip", setups=len(setups), writes=sum(len(v) for v in sizes.values()),
+           gzip_text_bytes=text, gzip_sent_bytes=sent, gzip_ratio=round(sent / text, 2))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
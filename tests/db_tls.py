@@ -0,0 +1,148 @@
+"""
+db_tls.py - DB writes over TLS to a local stub, pinned by fingerprint
+
+A certificate is made for the run, and the stub serves HTTPS with it,
+closing connections that sit idle for a second, so each send has to
+connect again.  With the right SHA-1 pin the writes arrive, the
+reconnections resume the session rather than doing a full handshake,
+and max fragment length is agreed.  The handshake times the firmware
+reports are passed on, and the heap it reports a handshake taking at
+its peak has to cover the agreed buffers.  With a wrong pin nothing is
+sent.
+"""
+
+import hashlib
+import http.server
+import json
+import os
+import shutil
+import ssl
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+from host import Firmware, check, free_port, result
+
+WRITES  = 4              # With readings, from the pinned setup
+TIMEOUT = 60             # Seconds to wait for them
+REFUSED = 15             # Seconds a wrong pin is given to send anything
+
+
+class Stub(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    timeout = 1             # Idle keep-alive connections are closed
+    connections = []        # session_reused, one per connection
+    writes      = []        # Bodies
+
+    def setup(self):
+        super().setup()
+        self.connections.append(self.connection.session_reused)
+
+    def do_POST(self):
+        self.writes.append(self.rfile.read(int(self.headers["Content-Length"])).decode())
+        self.send_response(204)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def log_message(self, *args):
+        pass
+
+
+class Server(http.server.ThreadingHTTPServer):
+    def shutdown_request(self, request):
+        # With a close_notify, as InfluxDB does.  A bare close would end
+        # the session, and nothing after it could resume.
+        try:
+            request.settimeout(1)
+            request.unwrap()
+        except OSError:
+            pass
+        super().shutdown_request(request)
+
+
+def certificate(dir):
+    """(cert, key, SHA-1 fingerprint) for influx.test"""
+    cert, key = os.path.join(dir, "cert.pem"), os.path.join(dir, "key.pem")
+    subprocess.run(["openssl", "req", "-x509", "-newkey", "ec", "-pkeyopt", "ec_paramgen_curve:prime256v1",
+                    "-nodes", "-keyout", key, "-out", cert, "-days", "2", "-subj", "/CN=influx.test",
+                    "-addext", "subjectAltName=DNS:influx.test"], check=True, capture_output=True)
+    with open(cert) as f:
+        der = ssl.PEM_cert_to_DER_cert(f.read())
+    return cert, key, ":".join("%02X" % b for b in hashlib.sha1(der).digest())
+
+
+def sensor_writes():
+    return sum("temperature=72.50" in body for body in list(Stub.writes))
+
+
+def firmware(build, port, fingerprint):
+    fw = Firmware(build, env=dict(HOST_RESOLVE="influx.test=127.0.0.1"))
+    fw.start()
+    fw.settings(db_host="influx.test", db_port=port, db_name="temp", db_tls=1, db_fingerprint=fingerprint,
+                interval=2, db_flush=1)
+    return fw
+
+
+def tls_stats(fw):
+    status, body, _ = fw.get("/power")
+    check(status == 200, "/power answered %d" % status)
+    return json.loads(body)["db"].get("tls")
+
+
+def main(build):
+    dir = tempfile.mkdtemp(prefix="tls-")
+    try:
+        run(build, dir)
+    finally:
+        shutil.rmtree(dir, ignore_errors=True)
+
+
+def run(build, dir):
+    cert, key, fingerprint = certificate(dir)
+
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    context.load_cert_chain(cert, key)
+    port   = free_port()
+    server = Server(("127.0.0.1", port), Stub)
+    server.socket = context.wrap_socket(server.socket, server_side=True)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+
+    # Pinned to the stub's certificate
+    fw = firmware(build, port, fingerprint)
+    try:
+        deadline = time.time() + TIMEOUT
+        while sensor_writes() < WRITES and time.time() < deadline:
+            time.sleep(0.2)
+        tls = tls_stats(fw)
+    finally:
+        fw.stop()
+
+    connections, resumed = len(Stub.connections), sum(Stub.connections)
+    result("db_tls", writes=len(Stub.writes), connections=connections, resumed=resumed, **tls)
+
+    check(sensor_writes() >= WRITES, "%d writes with readings in %d s" % (sensor_writes(), TIMEOUT))
+    check(connections > WRITES and resumed >= connections - 2,
+          "%d of %d connections resumed" % (resumed, connections))   # All but the MFLN probe and the first
+    check(tls["mfln"] == 512, "max fragment length not agreed: %s" % tls)
+    check(tls["pinned"] == "fingerprint" and tls["handshakes"] >= WRITES, "tls: %s" % tls)
+    check(tls["heap_used"] > 2 * tls["mfln"], "handshake heap not measured: %s" % tls)
+
+    # Pinned to some other certificate
+    Stub.connections, Stub.writes = [], []
+    fw = firmware(build, port, "00:" * 19 + "00")
+    try:
+        time.sleep(REFUSED)
+        tls = tls_stats(fw)
+    finally:
+        fw.stop()
+
+    result("db_tls_wrong_pin", writes=len(Stub.writes), handshakes=tls["handshakes"])
+    check(len(Stub.writes) == 0 and tls["handshakes"] == 0, "sent with the wrong pin: %s" % tls)
+
+    server.shutdown()
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
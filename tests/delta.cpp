@@ -0,0 +1,55 @@
+//
+// delta.cpp - Runs DeltaUpdate against an update server, a step for
+//             each line of stdin, so the test can change the server's
+//             site between them
+//
+//   check          DeltaUpdate::check(), prints "check <result> <Update error>"
+//   boot           A new DeltaUpdate, as after a restart: only the
+//                  manifest ETag in RTC memory carries over
+//   etag <path>    The ETag the web server would send for a file,
+//                  prints "etag <path> <etag>"
+//
+// UPDATE_SERVER is pointed at the server with HOST_RESOLVE, and the
+// running firmware, the one patches copy from, is HOST_SKETCH.
+//
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "Arduino.h"
+#include "Host.h"
+#include "AssetIndex.h"
+#include "DeltaUpdate.h"
+#include "Updater.h"
+
+int main() {
+  std::unique_ptr<DeltaUpdate> delta( new DeltaUpdate );
+  std::string                  step;
+
+  delta->begin();
+  while ( std::getline( std::cin, step ) ) {
+    if ( step == "check" ) {
+      int result = delta->check();
+      printf( "check %d %u\n", result, Update.getError() );
+
+    } else if ( step == "boot" ) {
+      delta.reset( new DeltaUpdate );
+      delta->begin();
+      printf( "boot\n" );
+
+    } else if ( step.compare( 0, 5, "etag " ) == 0 ) {
+      AssetIndex   assets;
+      const char  *path = step.c_str() + 5;
+      assets.build( "delta" );
+      const asset *entry = assets.find( path );
+      printf( "etag %s %u\n", path, entry ? entry->etag : 0 );
+
+    } else {
+      fprintf( stderr, "unknown step: %s\n", step.c_str() );
+      return 2;
+    }
+    fflush( stdout );
+  }
+  return 0;
+}
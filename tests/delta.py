@@ -0,0 +1,218 @@
+"""
+delta.py - DeltaUpdate on the host build against website/web.py
+
+The delta driver runs the firmware's update check against web.py on a
+temporary site, with a small image standing in for the running
+firmware.  The device starts with one file the same as the site's, one
+changed without changing size, one the site dropped, and its own CA
+certificate and archive.  Through the checks:
+
+  1. Only the changed file is fetched and gets a new ETag, the dropped
+     one is removed, the device's own are kept, and the firmware comes
+     as a patch that passes Update.end()'s MD5 check.
+  2. Checking again is a bodyless 304, and after a restart still is:
+     the manifest ETag comes back out of RTC memory.
+  3. A new build the server has no patch for: the patch is a 404 and
+     the full image is downloaded instead.  Corrupted on the way, it
+     fails the MD5 check; as served, it passes.
+"""
+
+import hashlib
+import logging
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import threading
+
+from werkzeug.serving import make_server
+
+from host import check, free_port, result
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "website"))
+import web
+
+SERVER    = "heatstroke.axcella.com"     # UPDATE_SERVER
+IMAGE     = 200000                       # Bytes of firmware
+RESULT_FILES, RESULT_FW, RESULT_FAILED = 0x01, 0x02, 0x04
+UPDATE_ERROR_MD5 = 7
+
+
+class Recorder:
+    """web.app, noting every request as (path, If-None-Match, status,
+    body bytes).  Firmware images can be corrupted on the way."""
+
+    def __init__(self, app):
+        self.app      = app
+        self.requests = []
+        self.corrupt  = False
+
+    def __call__(self, environ, start_response):
+        status = []
+
+        def start(line, headers, exc_info=None):
+            status.append(int(line.split()[0]))
+            return start_response(line, headers, exc_info)
+
+        answer = self.app(environ, start)
+        body   = b"".join(answer)
+        if hasattr(answer, "close"):
+            answer.close()
+
+        path = environ["PATH_INFO"]
+        if self.corrupt and path.startswith("/firmware/") and body:
+            body = bytes([body[0] ^ 0xFF]) + body[1:]
+
+        self.requests.append((path, environ.get("HTTP_IF_NONE_MATCH"), status[0], len(body)))
+        return [body]
+
+    def take(self):
+        requests, self.requests = self.requests, []
+        return requests
+
+
+class Device:
+    def __init__(self, build, spiffs, sketch, port):
+        env = dict(os.environ, HOST_QUIET="1", HOST_SPIFFS=spiffs, HOST_SKETCH=sketch,
+                   HOST_RESOLVE="%s=127.0.0.1:%d" % (SERVER, port))
+        self.proc = subprocess.Popen([os.path.join(build, "delta")], env=env, stdin=subprocess.PIPE,
+                                     stdout=subprocess.PIPE, text=True)
+
+    def step(self, line):
+        self.proc.stdin.write(line + "\n")
+        self.proc.stdin.flush()
+        out = self.proc.stdout.readline().split()
+        check(len(out) > 0, "driver exited on %s" % line)
+        return out
+
+    def check_update(self):
+        """(result bits, Update error)"""
+        _, bits, error = self.step("check")
+        return int(bits), int(error)
+
+    def etag(self, path):
+        return self.step("etag " + path)[2]
+
+    def stop(self):
+        self.proc.stdin.close()
+        self.proc.wait()
+
+
+def write(path, data):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "wb") as f:
+        f.write(data)
+
+
+def read(path):
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def edited(image):
+    """A new build: most of the old one, moved about a little"""
+    return image[:50000] + os.urandom(2000) + image[52000:150000] + os.urandom(3000) + image[150000:]
+
+
+def fetched(requests, prefix):
+    return [(path, status) for path, _, status, _ in requests if path.startswith(prefix)]
+
+
+def main(build):
+    dir = tempfile.mkdtemp(prefix="delta-")
+    try:
+        run(build, dir)
+    finally:
+        shutil.rmtree(dir, ignore_errors=True)
+
+
+def run(build, dir):
+    web.DATA_DIR     = os.path.join(dir, "site", "data")
+    web.FIRMWARE_DIR = os.path.join(dir, "site", "firmware")
+    web.ROLLOUT_FILE = os.path.join(dir, "site", "rollout.json")
+    web.REPORTS_FILE = os.path.join(dir, "site", "reports.json")
+    spiffs = os.path.join(dir, "spiffs")
+    sketch = os.path.join(dir, "running.bin")
+
+    # The site, and a device that's a little behind it
+    index, app = os.urandom(3000), os.urandom(20000)
+    write(os.path.join(web.DATA_DIR, "index.html"), index)
+    write(os.path.join(web.DATA_DIR, "js/app.js"), app)
+    write(os.path.join(spiffs, "index.html"), index)
+    write(os.path.join(spiffs, "js/app.js"), os.urandom(len(app)))
+    write(os.path.join(spiffs, "old.css"), os.urandom(500))
+    write(os.path.join(spiffs, "ca.pem"), b"-----BEGIN CERTIFICATE-----\n")
+    write(os.path.join(spiffs, "archive/0.rrd"), os.urandom(1000))
+
+    running = os.urandom(IMAGE)
+    patched = edited(running)
+    write(sketch, running)
+    write(os.path.join(web.FIRMWARE_DIR, "1.0.0.bin"), running)
+    write(os.path.join(web.FIRMWARE_DIR, "1.0.1.bin"), patched)
+
+    logging.getLogger("werkzeug").setLevel(logging.ERROR)
+    recorder = Recorder(web.app)
+    port     = free_port()
+    server   = make_server("127.0.0.1", port, recorder, threaded=True)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+
+    device = Device(build, spiffs, sketch, port)
+    try:
+        # 1. Changed files and a patch
+        before = device.etag("/js/app.js")
+        bits, error = device.check_update()
+        requests = recorder.take()
+        manifest_etag = '"%s"' % hashlib.md5(
+            (web.delta.build_manifest(web.DATA_DIR, web.build_path("1.0.1"), "1.0.1") +
+             hashlib.md5(running).hexdigest()).encode()).hexdigest()
+
+        check(bits == RESULT_FILES | RESULT_FW and error == 0, "first check: %d, Update error %d" % (bits, error))
+        check(fetched(requests, "/files/") == [("/files/js/app.js", 200)], "fetched: %s" % requests)
+        check(read(os.path.join(spiffs, "js/app.js")) == app, "js/app.js not updated")
+        check(device.etag("/js/app.js") != before, "js/app.js kept its ETag")
+        check(not os.path.exists(os.path.join(spiffs, "old.css")), "old.css not removed")
+        check(os.path.exists(os.path.join(spiffs, "ca.pem")) and os.path.exists(os.path.join(spiffs, "archive/0.rrd")),
+              "the device's own files were removed")
+        patch = [size for path, _, status, size in requests if path.startswith("/patch/") and status == 200]
+        check(len(patch) == 1 and not fetched(requests, "/firmware/"), "firmware not patched: %s" % requests)
+        result("delta_patch", files=1, removed=1, patch_bytes=patch[0], image_bytes=len(patched))
+        check(patch[0] < len(patched) / 10, "patch of %d bytes" % patch[0])
+
+        # 2. Unchanged, then unchanged after a restart
+        for step in ("check", "boot"):
+            if step == "boot":
+                device.step("boot")
+            bits, error = device.check_update()
+            requests = recorder.take()
+            check(bits == 0 and requests == [("/manifest", manifest_etag, 304, 0)],
+                  "after a %s: %d, %s" % (step, bits, requests))
+        result("delta_unchanged", requests=1, status=304, body_bytes=0)
+
+        # 3. No patch from a build the server doesn't have
+        os.remove(os.path.join(web.FIRMWARE_DIR, "1.0.0.bin"))
+        shutil.rmtree(os.path.join(web.FIRMWARE_DIR, "patches"))
+        full = edited(patched)
+        write(os.path.join(web.FIRMWARE_DIR, "1.0.2.bin"), full)
+        digest = hashlib.md5(full).hexdigest()
+
+        recorder.corrupt = True
+        bits, error = device.check_update()
+        requests = recorder.take()
+        check(bits & RESULT_FAILED and error == UPDATE_ERROR_MD5, "corrupted image: %d, Update error %d" % (bits, error))
+
+        recorder.corrupt = False
+        bits, error = device.check_update()
+        requests = recorder.take()
+        check(bits == RESULT_FW and error == 0, "full image: %d, Update error %d" % (bits, error))
+        check(fetched(requests, "/patch/") == [("/patch/%s/%s" % (hashlib.md5(running).hexdigest(), digest), 404)] and
+              fetched(requests, "/firmware/") == [("/firmware/%s.bin" % digest, 200)],
+              "no fallback to the full image: %s" % requests)
+        result("delta_full_image", image_bytes=len(full), corrupted="md5")
+    finally:
+        device.stop()
+        server.shutdown()
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
@@ -0,0 +1,165 @@
+//
+// derived.cpp - Derived's fixed-point metrics against the float formulas
+//               they're tabled from, and what each costs per call
+//
+// Sweeps temperature and humidity, then prints one JSON line per metric:
+// the worst and mean error against the float reference, and cycles per
+// call for both.  The float side runs on the host's FPU, so it's a floor
+// for what soft-float costs on the ESP8266, not an estimate of it.
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <chrono>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+#include "Arduino.h"
+#include "Derived.h"
+
+#define TIMED_CALLS  2000000
+
+// Keeps a result alive without the compiler seeing what's done with it
+static inline void keep( const void *p ) {
+  asm volatile( "" : : "g"( p ) : "memory" );
+}
+
+// Cycles where the CPU counts them, otherwise ns
+static uint64_t ticks() {
+#if defined( __x86_64__ ) || defined( __i386__ )
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch() ).count();
+#endif
+}
+
+
+//
+// The float references: DHT::computeHeatIndex() and the Magnus formula
+
+static double ref_heat_index( double t, double rh ) {
+  double hi = 0.5 * ( t + 61.0 + ( ( t - 68.0 ) * 1.2 ) + ( rh * 0.094 ) );
+  if ( hi <= 79 ) return hi;
+
+  hi = -42.379 + 2.04901523 * t + 10.14333127 * rh - 0.22475541 * t * rh -
+       0.00683783 * t * t - 0.05481717 * rh * rh + 0.00122874 * t * t * rh +
+       0.00085282 * t * rh * rh - 0.00000199 * t * t * rh * rh;
+
+  if ( rh < 13 && t >= 80 && t <= 112 )
+    hi -= ( ( 13 - rh ) * 0.25 ) * sqrt( ( 17 - fabs( t - 95 ) ) * 0.05882 );
+  else if ( rh > 85 && t >= 80 && t <= 87 )
+    hi += ( ( rh - 85 ) * 0.1 ) * ( ( 87 - t ) * 0.2 );
+  return hi;
+}
+
+static double ref_sat_vapor_pressure( double c ) {
+  return 611.2 * exp( 17.62 * c / ( 243.12 + c ) );       // Pa
+}
+
+static double ref_dew_point( double c, double rh ) {
+  double g = log( rh / 100 ) + 17.62 * c / ( 243.12 + c );
+  return 243.12 * g / ( 17.62 - g );                        // C
+}
+
+static double ref_abs_humidity( double c, double rh ) {
+  return ref_sat_vapor_pressure( c ) * rh / 100 / ( 461.5 * ( c + 273.15 ) ) * 1000;   // g/m^3
+}
+
+static double ref_vpd( double c, double rh ) {
+  return ref_sat_vapor_pressure( c ) * ( 1 - rh / 100 ) / 1000;                      // kPa
+}
+
+
+//
+// One metric: the fixed-point call and its reference, both in the units
+// Derived reports (F for the temperatures)
+
+struct metric {
+  const char *name;
+  int32_t   ( *fixed )( int32_t temp_f, int32_t humidity );
+  double    ( *ref )( double temp_f, double rh );
+  int         min_f, max_f;     // Range swept, F
+  double      floor;            // Reference values below it aren't compared
+};
+
+static const metric metrics[] = {
+  { "hindex",
+    []( int32_t f, int32_t h ) { return Derived::heat_index( f, h ); },
+    []( double f, double rh ) { return ref_heat_index( f, rh ); },
+    0, 130, -INFINITY },
+  { "dewpoint",
+    []( int32_t f, int32_t h ) { return Derived::c_to_f( Derived::dew_point( Derived::f_to_c( f ), h ) ); },
+    []( double f, double rh ) { return ref_dew_point( ( f - 32 ) / 1.8, rh ) * 1.8 + 32; },
+    -30, 130, DERIVED_ES_MIN_C * 1.8 + 32 },
+  { "abs_humidity",
+    []( int32_t f, int32_t h ) { return Derived::abs_humidity( Derived::f_to_c( f ), h ); },
+    []( double f, double rh ) { return ref_abs_humidity( ( f - 32 ) / 1.8, rh ); },
+    -30, 130, -INFINITY },
+  { "vpd",
+    []( int32_t f, int32_t h ) { return Derived::vpd( Derived::f_to_c( f ), h ); },
+    []( double f, double rh ) { return ref_vpd( ( f - 32 ) / 1.8, rh ); },
+    -30, 130, -INFINITY },
+};
+
+
+// Worst and mean error, every 0.1F and 0.5%RH.  Dew points below the
+// table's -40C are clamped by design, so aren't compared.
+static void accuracy( const metric &m, double &worst, double &mean, double &worst_f, double &worst_rh ) {
+  double sum   = 0;
+  long   count = 0;
+  worst = 0;
+
+  for ( int32_t f = m.min_f * 100; f <= m.max_f * 100; f += 10 ) {
+    for ( int32_t h = 50; h <= 10000; h += 50 ) {
+      double ref = m.ref( f / 100.0, h / 100.0 );
+      if ( ref < m.floor ) continue;
+
+      double err = fabs( m.fixed( f, h ) / 100.0 - ref );
+      sum += err;
+      count++;
+      if ( err > worst ) { worst = err; worst_f = f / 100.0; worst_rh = h / 100.0; }
+    }
+  }
+  mean = sum / count;
+}
+
+
+// Cycles per call, over the same spread of inputs for both
+static void cost( const metric &m, double &fixed, double &ref ) {
+  int32_t f = m.min_f * 100, h = 500;
+  uint64_t start = ticks();
+  for ( long i = 0; i < TIMED_CALLS; i++ ) {
+    int32_t v = m.fixed( f, h );
+    keep( &v );
+    f = ( f >= m.max_f * 100 ) ? m.min_f * 100 : f + 37;
+    h = ( h >= 10000 ) ? 500 : h + 13;
+  }
+  fixed = (double)( ticks() - start ) / TIMED_CALLS;
+
+  f = m.min_f * 100; h = 500;
+  start = ticks();
+  for ( long i = 0; i < TIMED_CALLS; i++ ) {
+    double v = m.ref( f / 100.0, h / 100.0 );
+    keep( &v );
+    f = ( f >= m.max_f * 100 ) ? m.min_f * 100 : f + 37;
+    h = ( h >= 10000 ) ? 500 : h + 13;
+  }
+  ref = (double)( ticks() - start ) / TIMED_CALLS;
+}
+
+
+int main() {
+  for ( const metric &m : metrics ) {
+    double worst, mean, worst_f = 0, worst_rh = 0, fixed, ref;
+    accuracy( m, worst, mean, worst_f, worst_rh );
+    cost( m, fixed, ref );
+
+    printf( "{\"metric\": \"%s\", \"max_err\": %.3f, \"mean_err\": %.4f, \"worst_at\": [%.1f, %.1f], "
+            "\"fixed_cycles\": %.1f, \"float_cycles\": %.1f}\n",
+            m.name, worst, mean, worst_f, worst_rh, fixed, ref );
+  }
+  return 0;
+}
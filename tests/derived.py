@@ -0,0 +1,32 @@
+"""
+derived.py - Derived's fixed-point metrics against the float reference
+
+Runs the derived driver, which sweeps temperature and humidity through
+each metric and times both sides.  Every metric has to stay within a
+bound of the float formula it was tabled from; the cycle counts are
+reported for comparison with the ESP8266's soft-float.
+"""
+
+import json
+import sys
+
+from host import check, driver, result
+
+# Worst error allowed, in the units reported: F, F, g/m^3, kPa
+LIMITS = dict(hindex=0.5, dewpoint=0.25, abs_humidity=0.1, vpd=0.03)
+
+
+def main(build):
+    out = driver(build, "derived")
+
+    metrics = [json.loads(line) for line in out]
+    check(sorted(m["metric"] for m in metrics) == sorted(LIMITS), "metrics: %s" % out)
+
+    for m in metrics:
+        result("derived_" + m["metric"], limit=LIMITS[m["metric"]], **{k: v for k, v in m.items() if k != "metric"})
+    for m in metrics:
+        check(m["max_err"] <= LIMITS[m["metric"]], "%s off by %s at %s" % (m["metric"], m["max_err"], m["worst_at"]))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
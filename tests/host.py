@@ -0,0 +1,132 @@
+"""
+host.py - The firmware's host build, run for a test
+
+Each Firmware starts with an empty SPIFFS (plus the files given) and
+EEPROM, serves HTTP on a free port, and stops with the test.  Settings
+go through the same POST forms the UI uses, with the default password.
+"""
+
+import json
+import os
+import shutil
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.error
+import urllib.parse
+import urllib.request
+
+HTTP_USER = "admin"
+HTTP_PW   = "admin"     # DEFAULT_HTTP_PW
+
+
+def free_port():
+    with socket.socket() as s:
+        s.bind(("127.0.0.1", 0))
+        return s.getsockname()[1]
+
+
+def percentile(values, pct):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * pct / 100))]
+
+
+def result(name, **values):
+    """One JSON line per test, like bench/"""
+    print(json.dumps(dict(test=name, **values)), flush=True)
+
+
+def check(ok, what):
+    if not ok:
+        print("FAIL: " + what, file=sys.stderr, flush=True)
+        sys.exit(1)
+
+
+def driver(build, name, args=(), input="", env=None):
+    """Runs a driver quietly on its own empty SPIFFS, returns its output lines"""
+    spiffs = tempfile.mkdtemp(prefix="spiffs-")
+    try:
+        env = dict(os.environ, HOST_QUIET="1", HOST_SPIFFS=spiffs, **(env or {}))
+        out = subprocess.run([os.path.join(build, name)] + list(args), input=input.encode(), env=env,
+                             stdout=subprocess.PIPE, timeout=300, check=True)
+        return out.stdout.decode().splitlines()
+    finally:
+        shutil.rmtree(spiffs, ignore_errors=True)
+
+
+class Firmware:
+    def __init__(self, build, files=None, env=None, log=None):
+        self.binary = os.path.join(build, "firmware")
+        self.dir    = tempfile.mkdtemp(prefix="fw-")
+        self.spiffs = os.path.join(self.dir, "spiffs")
+        self.port   = free_port()
+
+        os.makedirs(self.spiffs)
+        for name, data in (files or {}).items():
+            path = os.path.join(self.spiffs, name.lstrip("/"))
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            with open(path, "wb") as f:
+                f.write(data)
+
+        self.env = dict(os.environ, HOST_SPIFFS=self.spiffs, HOST_EEPROM=os.path.join(self.dir, "eeprom"),
+                        HOST_HTTP_PORT=str(self.port), HOST_QUIET="0" if log else "1")
+        self.env.update(env or {})
+        self.log  = log
+        self.proc = None
+
+        passwords = urllib.request.HTTPPasswordMgrWithDefaultRealm()
+        passwords.add_password(None, self.url("/"), HTTP_USER, HTTP_PW)
+        self.opener = urllib.request.build_opener(urllib.request.HTTPDigestAuthHandler(passwords))
+
+    def __enter__(self):
+        self.start()
+        return self
+
+    def __exit__(self, *exc):
+        self.stop()
+
+    def url(self, path):
+        return "http://127.0.0.1:%d%s" % (self.port, path)
+
+    def start(self):
+        out = open(self.log, "w") if self.log else subprocess.DEVNULL
+        self.proc = subprocess.Popen([self.binary], env=self.env, stdout=subprocess.DEVNULL, stderr=out)
+
+        deadline = time.time() + 10
+        while time.time() < deadline:
+            check(self.proc.poll() is None, "firmware exited with %s" % self.proc.returncode)
+            try:
+                socket.create_connection(("127.0.0.1", self.port), timeout=1).close()
+                return
+            except OSError:
+                time.sleep(0.05)
+        check(False, "firmware never started serving")
+
+    def stop(self):
+        if self.proc and self.proc.poll() is None:
+            self.proc.terminate()
+            self.proc.wait()
+        shutil.rmtree(self.dir, ignore_errors=True)
+
+    def get(self, path, timeout=10):
+        """(status, body, seconds)"""
+        started = time.time()
+        try:
+            with self.opener.open(self.url(path), timeout=timeout) as r:
+                return r.status, r.read(), time.time() - started
+        except urllib.error.HTTPError as e:
+            return e.code, e.read(), time.time() - started
+
+    def post(self, path, **fields):
+        data = urllib.parse.urlencode(fields).encode()
+        try:
+            with self.opener.open(self.url(path), data=data, timeout=10) as r:
+                return r.status, r.read()
+        except urllib.error.HTTPError as e:
+            return e.code, e.read()
+
+    def settings(self, **fields):
+        status, body = self.post("/settings", **fields)
+        check(status == 200, "settings %s: %s %s" % (fields, status, body))
@@ -0,0 +1,26 @@
+//
+// rollout.cpp - Each device's update check slot, from its MAC address
+//
+// Reads one MAC per line and prints the offsets DeltaUpdate::jitter()
+// gives it, in seconds: into the day with the wall clock, and from boot
+// without it.
+//
+
+#include <iostream>
+#include <string>
+
+#include "Arduino.h"
+#include "Host.h"
+#include "DeltaUpdate.h"
+#include "Webserver.h"
+
+int main() {
+  DeltaUpdate delta;
+  std::string mac;
+
+  while ( std::getline( std::cin, mac ) ) {
+    host::mac = mac;
+    printf( "%s %u %u\n", mac.c_str(), delta.jitter( FW_CHECK_INTERVAL ), delta.jitter( FW_CHECK_NO_CLOCK ) );
+  }
+  return 0;
+}
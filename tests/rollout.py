@@ -0,0 +1,187 @@
+"""
+rollout.py - 1,000 devices checking in with website/web.py during a
+             staged rollout
+
+The fleet's check slots come from the firmware's own jitter (the rollout
+driver) and have to spread across the day, and across a run without the
+clock.  Then every device checks /manifest at once, the worst case after
+a power event, through three rounds:
+
+  1. No ETags yet: a 10% cohort is offered the new build, the rest stay
+     on stable.
+  2. Half the cohort took it, a few failed and reported so, holding the
+     rollout.  Everyone sends the ETag it has: only the devices whose
+     answer changed get a body, the rest a bodyless 304.
+  3. Nothing has changed, so the whole fleet gets 304s.
+"""
+
+import hashlib
+import logging
+import os
+import shutil
+import sys
+import tempfile
+import threading
+import time
+import urllib.error
+import urllib.request
+from concurrent.futures import ThreadPoolExecutor
+
+from werkzeug.serving import make_server
+
+from host import check, driver, free_port, percentile, result
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "website"))
+import web
+
+DEVICES     = 1000
+CONCURRENT  = 50          # Connections open at once
+STABLE, NEW = "0.5.0", "0.5.1"
+PERCENT     = 10
+FAILURES    = 3           # Reported by the cohort, holds the rollout
+PEAK_LIMIT  = 0.05        # Of the fleet checking in the same minute
+
+
+def slots(build, macs):
+    """{mac: (seconds into the day, seconds from boot without the clock)}"""
+    out = driver(build, "rollout", input="\n".join(macs))
+    return {mac: (int(day), int(boot)) for mac, day, boot in (line.split() for line in out)}
+
+
+def peak_per_minute(offsets):
+    minutes = {}
+    for offset in offsets:
+        minutes[offset // 60] = minutes.get(offset // 60, 0) + 1
+    return max(minutes.values())
+
+
+class Device:
+    def __init__(self, n, md5):
+        self.mac  = "5C:CF:7F:%02X:%02X:%02X" % (n >> 16, (n >> 8) & 0xFF, n & 0xFF)
+        self.md5  = md5         # Of the build it runs
+        self.etag = None        # Of the last manifest it took
+        self.manifest = ""      # Its body
+
+    def check(self, port):
+        """(status, body bytes, seconds)"""
+        request = urllib.request.Request("http://127.0.0.1:%d/manifest?version=%s&md5=%s&mac=%s" %
+                                         (port, STABLE, self.md5, self.mac))
+        if self.etag:
+            request.add_header("If-None-Match", self.etag)
+
+        started = time.time()
+        try:
+            with urllib.request.urlopen(request, timeout=30) as r:
+                body = r.read()
+                self.etag     = r.headers["ETag"]
+                self.manifest = body.decode()
+                return r.status, len(body), time.time() - started
+        except urllib.error.HTTPError as e:
+            return e.code, len(e.read()), time.time() - started
+
+    def offered(self):
+        return "fw %s " % NEW in self.manifest
+
+
+def fleet_round(port, devices):
+    started = time.time()
+    with ThreadPoolExecutor(CONCURRENT) as pool:
+        answers = list(pool.map(lambda d: d.check(port), devices))
+    took = time.time() - started
+
+    statuses = {}
+    for status, _, _ in answers:
+        statuses[status] = statuses.get(status, 0) + 1
+    times = [seconds for _, _, seconds in answers]
+    return dict(statuses=statuses, body_bytes=sum(size for _, size, _ in answers),
+                per_s=round(len(devices) / took), p50_ms=round(percentile(times, 50) * 1000, 1),
+                p99_ms=round(percentile(times, 99) * 1000, 1))
+
+
+def report(port, device, outcome):
+    request = urllib.request.Request("http://127.0.0.1:%d/report?mac=%s&version=%s&result=%s" %
+                                     (port, device.mac, NEW, outcome), data=b"")
+    with urllib.request.urlopen(request, timeout=10) as r:
+        check(r.status == 200, "report answered %d" % r.status)
+
+
+def main(build):
+    site = tempfile.mkdtemp(prefix="site-")
+    try:
+        run(build, site)
+    finally:
+        shutil.rmtree(site, ignore_errors=True)
+
+
+def run(build, site):
+    # A small data directory and two builds
+    web.DATA_DIR     = os.path.join(site, "data")
+    web.FIRMWARE_DIR = os.path.join(site, "firmware")
+    web.ROLLOUT_FILE = os.path.join(site, "rollout.json")
+    web.REPORTS_FILE = os.path.join(site, "reports.json")
+    os.makedirs(os.path.join(web.DATA_DIR, "js"))
+    os.makedirs(web.FIRMWARE_DIR)
+    for name, size in (("index.html", 3000), ("js/app.js", 20000), ("version.txt", 8)):
+        with open(os.path.join(web.DATA_DIR, name), "wb") as f:
+            f.write(os.urandom(size))
+    for version in (STABLE, NEW):
+        with open(os.path.join(web.FIRMWARE_DIR, version + ".bin"), "wb") as f:
+            f.write(os.urandom(300000))
+    with open(web.ROLLOUT_FILE, "w") as f:
+        f.write('{"version": "%s", "stable": "%s", "percent": %d, "hold_failures": %d}' %
+                (NEW, STABLE, PERCENT, FAILURES))
+
+    stable_md5 = hashlib.md5(open(os.path.join(web.FIRMWARE_DIR, STABLE + ".bin"), "rb").read()).hexdigest()
+    new_md5    = hashlib.md5(open(os.path.join(web.FIRMWARE_DIR, NEW + ".bin"), "rb").read()).hexdigest()
+    devices    = [Device(n, stable_md5) for n in range(DEVICES)]
+
+    # Check slots
+    offsets = slots(build, [d.mac for d in devices])
+    day     = [offsets[d.mac][0] for d in devices]
+    boot    = [offsets[d.mac][1] for d in devices]
+    result("rollout_slots", devices=DEVICES, day_peak_per_min=peak_per_minute(day),
+           no_clock_peak_per_min=peak_per_minute(boot), day_distinct=len(set(day)))
+    check(peak_per_minute(day) <= DEVICES * PEAK_LIMIT, "day slots bunch up: %d in a minute" % peak_per_minute(day))
+    check(peak_per_minute(boot) <= DEVICES * PEAK_LIMIT, "no-clock slots bunch up: %d in a minute" % peak_per_minute(boot))
+
+    logging.getLogger("werkzeug").setLevel(logging.ERROR)
+    port   = free_port()
+    server = make_server("127.0.0.1", port, web.app, threaded=True)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+
+    # 1. First contact
+    first  = fleet_round(port, devices)
+    cohort = [d for d in devices if d.offered()]
+    result("rollout_first", devices=DEVICES, cohort=len(cohort), **first)
+    check(first["statuses"] == {200: DEVICES}, "first round: %s" % first["statuses"])
+    check(all(d.offered() == (web.bucket(d.mac) < PERCENT) for d in devices), "cohort isn't the rollout buckets")
+    check(DEVICES * PERCENT / 200 < len(cohort) < DEVICES * PERCENT / 50, "cohort of %d" % len(cohort))
+
+    # Half the cohort updates, a few of the rest fail and hold the rollout
+    updated = cohort[: len(cohort) // 2]
+    failed  = cohort[len(cohort) // 2:][:FAILURES]
+    for d in updated:
+        d.md5 = new_md5
+        report(port, d, "ok")
+    for d in failed:
+        report(port, d, "failed")
+
+    # 2. Only the cohort's answers changed
+    second  = fleet_round(port, devices)
+    changed = len(cohort) - len(updated)      # Held, back to stable
+    result("rollout_held", devices=DEVICES, updated=len(updated), failed=len(failed), **second)
+    check(second["statuses"] == {200: len(updated) + changed, 304: DEVICES - len(updated) - changed},
+          "second round: %s" % second["statuses"])
+    check(all(d.offered() for d in updated), "a device that took the build was moved off it")
+    check(not any(d.offered() for d in cohort[len(updated):]), "the held rollout still offered")
+
+    # 3. Steady state
+    third = fleet_round(port, devices)
+    result("rollout_steady", devices=DEVICES, first_body_bytes=first["body_bytes"], **third)
+    check(third["statuses"] == {304: DEVICES} and third["body_bytes"] == 0, "third round: %s" % third)
+
+    server.shutdown()
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
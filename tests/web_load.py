@@ -0,0 +1,84 @@
+"""
+web_load.py - /sensors latency while a large static file is downloaded
+
+Slow clients pull a 512 KB file from SPIFFS, a window at a time, while
+/sensors is requested over and over.  The async server interleaves
+them, so /sensors shouldn't wait on the downloads: p99 under load is
+held to a bound, and the downloads have to arrive whole.
+"""
+
+import base64
+import os
+import socket
+import sys
+import threading
+import time
+
+from host import HTTP_PW, HTTP_USER, Firmware, check, percentile, result
+
+REQUESTS  = 200
+CLIENTS   = 2             # Downloads running at once
+FILE_SIZE = 512 * 1024
+READ_SIZE = 2048          # Taken every READ_PAUSE, ~200 KB/s
+READ_PAUSE = 0.01
+P99_LIMIT = 0.250         # Seconds
+
+
+def download(port, path, done):
+    s = socket.create_connection(("127.0.0.1", port))
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4096)
+    auth = base64.b64encode(("%s:%s" % (HTTP_USER, HTTP_PW)).encode()).decode()
+    s.sendall(("GET %s HTTP/1.1\r\nHost: x\r\nAuthorization: Basic %s\r\n\r\n" % (path, auth)).encode())
+
+    data = b""
+    while True:
+        chunk = s.recv(READ_SIZE)
+        if not chunk:
+            break
+        data += chunk
+        time.sleep(READ_PAUSE)
+    s.close()
+
+    head, _, body = data.partition(b"\r\n\r\n")
+    done.append((head.split(b" ")[1], len(body)))
+
+
+def latencies(fw, count):
+    times = []
+    for _ in range(count):
+        status, _, seconds = fw.get("/sensors")
+        check(status == 200, "/sensors answered %d" % status)
+        times.append(seconds)
+    return times
+
+
+def main(build):
+    big = os.urandom(FILE_SIZE)
+
+    with Firmware(build, files={"/js/big.js": big}) as fw:
+        idle = latencies(fw, REQUESTS)
+
+        done    = []
+        threads = [threading.Thread(target=download, args=(fw.port, "/js/big.js", done)) for _ in range(CLIENTS)]
+        for t in threads:
+            t.start()
+        time.sleep(0.2)
+
+        loaded = latencies(fw, REQUESTS)
+        during = len(done) == 0      # The downloads outlasted the measurement
+
+        for t in threads:
+            t.join()
+
+    check(during, "downloads finished before /sensors was measured")
+    check(all(status == b"200" and size == FILE_SIZE for status, size in done), "downloads: %s" % done)
+
+    result("web_load", requests=REQUESTS, clients=CLIENTS, file_kb=FILE_SIZE // 1024,
+           idle_p50_ms=round(percentile(idle, 50) * 1000, 1), idle_p99_ms=round(percentile(idle, 99) * 1000, 1),
+           p50_ms=round(percentile(loaded, 50) * 1000, 1), p99_ms=round(percentile(loaded, 99) * 1000, 1))
+
+    check(percentile(loaded, 99) < P99_LIMIT, "p99 %.0f ms under load" % (percentile(loaded, 99) * 1000))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
@@ -0,0 +1,164 @@
+"""
+build_ui.py - Bundle the web UI in ui/ into a single gzipped page
+
+The stylesheet, scripts and favicon are inlined into index.html,
+everything is minified and the page is gzipped into
+data/index.html.gz, so the browser loads the UI in one request.  The
+same bytes go into WebUI.h as a PROGMEM fallback for when SPIFFS
+doesn't have the page, with a content hash ETag.
+
+Run after changing anything in ui/, and commit the outputs:
+    python tools/build_ui.py [--check]
+
+--check only reports whether the outputs are up to date.
+"""
+
+import base64
+import gzip
+import hashlib
+import os
+import re
+import struct
+import sys
+
+ROOT   = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+UI     = os.path.join(ROOT, "ui")
+PAGE   = os.path.join(ROOT, "data", "index.html.gz")
+HEADER = os.path.join(ROOT, "WebUI.h")
+
+FAVICON_SIZE = 16       # Only this size is kept from favicon.ico
+
+
+def read(path):
+    with open(os.path.join(UI, path), encoding="utf-8") as f:
+        return f.read()
+
+
+def minify_css(css):
+    css = re.sub(r"/\*.*?\*/", "", css, flags=re.S)
+    css = re.sub(r"\s+", " ", css)
+    css = re.sub(r"\s*([{};,>])\s*", r"\1", css)
+    css = re.sub(r":\s+", ":", css)
+    css = css.replace(";}", "}")
+    return css.strip()
+
+
+def minify_js(js):
+    """Comments and indentation only.  Line breaks are kept, so
+    automatic semicolon insertion works out the same."""
+    out = []
+    i   = 0
+    while i < len(js):
+        c = js[i]
+        if c in "\"'`":
+            end = i + 1
+            while end < len(js) and js[end] != c:
+                end += 2 if js[end] == "\\" else 1
+            out.append(js[i:end + 1])
+            i = end + 1
+        elif js.startswith("//", i):
+            i = js.find("\n", i)
+            i = len(js) if i < 0 else i
+        elif js.startswith("/*", i):
+            i = js.index("*/", i) + 2
+        else:
+            out.append(c)
+            i += 1
+
+    lines = (line.strip() for line in "".join(out).splitlines())
+    return "\n".join(line for line in lines if line)
+
+
+def minify_html(html):
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    lines = (line.strip() for line in html.splitlines())
+    return "\n".join(line for line in lines if line)
+
+
+def favicon():
+    """The 16x16 image out of favicon.ico, as a one image .ico"""
+    with open(os.path.join(UI, "favicon.ico"), "rb") as f:
+        ico = f.read()
+
+    _, _, count = struct.unpack_from("<HHH", ico)
+    for n in range(count):
+        entry = struct.unpack_from("<BBBBHHII", ico, 6 + 16 * n)
+        width, size, offset = entry[0], entry[6], entry[7]
+        if width == FAVICON_SIZE:
+            image = ico[offset:offset + size]
+            return struct.pack("<HHH", 0, 1, 1) + struct.pack("<BBBBHHII", *entry[:6], size, 22) + image
+
+    raise ValueError("favicon.ico has no %dx%d image" % (FAVICON_SIZE, FAVICON_SIZE))
+
+
+def bundle():
+    html = read("index.html")
+
+    def style(match):
+        return "<style>%s</style>" % minify_css(read(match.group(1)))
+
+    def script(match):
+        # "</" would end the inline script early
+        return "<script>%s</script>" % minify_js(read(match.group(1))).replace("</", "<\\/")
+
+    html = re.sub(r'<link rel="stylesheet" href="([^"]+)"\s*/?>', style, html)
+    html = re.sub(r'<script src="([^"]+)"[^>]*></script>', script, html)
+
+    icon = '<link rel="icon" href="data:image/x-icon;base64,%s">' % base64.b64encode(favicon()).decode()
+    html = html.replace("</head>", icon + "</head>", 1)
+
+    return minify_html(html).encode("utf-8")
+
+
+def header(page, etag):
+    rows = []
+    for i in range(0, len(page), 16):
+        rows.append("  " + " ".join("0x%02x," % b for b in page[i:i + 16]))
+
+    return ("//\n"
+            "// WebUI.h - The web UI as served from data/index.html.gz, for when\n"
+            "//           SPIFFS doesn't have it.  Generated by tools/build_ui.py\n"
+            "//           from ui/, don't edit.\n"
+            "//\n"
+            "\n"
+            "#ifndef WebUI_h\n"
+            "#define WebUI_h\n"
+            "\n"
+            "#define WEBUI_ETAG  \"\\\"%s\\\"\"\n"
+            "\n"
+            "static const uint8_t WEBUI_GZ[] PROGMEM = {\n"
+            "%s\n"
+            "};\n"
+            "\n"
+            "#endif\n") % (etag, "\n".join(rows))
+
+
+def main(args):
+    html = bundle()
+
+    # mtime 0 so the same sources always give the same bytes (and ETag)
+    page = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(page).hexdigest()[:8]
+    code = header(page, etag)
+
+    sources = sum(os.path.getsize(os.path.join(dirpath, name))
+                  for dirpath, _, names in os.walk(UI) for name in names)
+    print("ui/ %d bytes -> %d minified -> %d gzipped, etag %s" % (sources, len(html), len(page), etag))
+
+    if "--check" in args:
+        with open(PAGE, "rb") as f:
+            current = f.read() == page
+        with open(HEADER, encoding="utf-8") as f:
+            current = current and f.read() == code
+        print("up to date" if current else "out of date, run tools/build_ui.py")
+        return 0 if current else 1
+
+    with open(PAGE, "wb") as f:
+        f.write(page)
+    with open(HEADER, "w", encoding="utf-8") as f:
+        f.write(code)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,362 @@
+usehost = "";
+
+// Small stand-ins for the bits of jQuery this page used
+function $(selector) {
+    return document.querySelector(selector);
+}
+
+function $all(selector) {
+    return Array.prototype.slice.call(document.querySelectorAll(selector));
+}
+
+function setValue(selector, value) {
+    $all(selector).forEach(function(el) { el.value = value; });
+}
+
+function getValue(selector) {
+    var el = $(selector);
+    return el ? el.value : "";
+}
+
+function setHTML(selector, html) {
+    $all(selector).forEach(function(el) { el.innerHTML = html; });
+}
+
+function showParent(selector, show) {
+    $all(selector).forEach(function(el) { el.parentNode.style.display = show ? '' : 'none'; });
+}
+
+function onClick(selector, handler) {
+    $all(selector).forEach(function(el) { el.addEventListener('click', handler); });
+}
+
+// GET JSON, or POST a form
+function request(path, form) {
+    var options = {};
+
+    if (form !== undefined) {
+        options.method = "POST";
+        options.body = new URLSearchParams(form);
+    }
+
+    return fetch(usehost + path, options).then(function(response) {
+        if (!response.ok)
+            throw new Error(response.status);
+        return form === undefined ? response.json() : response.text();
+    });
+}
+
+// Buttons read "Saving..." and are disabled until the request is done
+function busy(selector, text) {
+    var button = $(selector);
+    if (!button) return function() {};
+
+    var origtext = button.innerHTML;
+    button.disabled = true;
+    button.innerHTML = text;
+
+    return function() {
+        button.disabled = false;
+        button.innerHTML = origtext;
+    };
+}
+
+
+function handleNavClick(e) {
+    e.preventDefault();
+    var selectedTab = this.dataset.tab;
+
+    $all('.tabcontent').forEach(function(el) { el.style.display = 'none'; });
+    $('#' + selectedTab).style.display = 'block';
+    $all('nav a').forEach(function(el) { el.classList.remove('active'); });
+    this.classList.add('active');
+    closeAlert();
+}
+
+function handleDBTypeChange(e) {
+    var dbtype = getValue('select[name=db_type]');
+
+    if (dbtype == "2") {    // HTTP
+        showParent('input[name=db_port]', false);
+        showParent('input[name=db_name]', false);
+        showParent('input[name=db_measurement]', false);
+        setHTML('label[for=db_host]', "HTTP URL");
+        $('input[name=db_host]').placeholder = 'url';
+    } else {
+        showParent('input[name=db_port]', true);
+        showParent('input[name=db_name]', true);
+        showParent('input[name=db_measurement]', true);
+        setHTML('label[for=db_host]', "DB Host/IP");
+        $('input[name=db_host]').placeholder = 'Hostname or IP Address';
+    }
+
+    if (dbtype == "3") {    // InfluxDB 2.x
+        showParent('input[name=db_name]', false);
+        showParent('input[name=db_org]', true);
+        showParent('input[name=db_bucket]', true);
+        showParent('input[name=db_token]', true);
+    } else {
+        showParent('input[name=db_org]', false);
+        showParent('input[name=db_bucket]', false);
+        showParent('input[name=db_token]', false);
+    }
+}
+
+
+function displayAlert(msg) {
+    console.log('[alert] ' + msg);
+    setHTML('#alert p', msg);
+    $('#alert').style.display = 'block';
+}
+
+function closeAlert() {
+    $('#alert').style.display = 'none';
+}
+
+function updateNetworkConfig(data) {
+    if (data.hasOwnProperty('ssid'))
+        setValue('input[name=ssid]', data['ssid']);
+
+    if (data.hasOwnProperty('pw'))
+        $('input[name=wifi_pw]').placeholder = "Saved.  Update to change.";
+
+    // Power save lives on the settings tab
+    if (data.hasOwnProperty('sleep'))
+        setValue('select[name=sleep]', data['sleep']);
+
+    if (data.hasOwnProperty('listen'))
+        setValue('select[name=listen]', data['listen']);
+}
+
+
+function updateSettingsConfig(data) {
+    // Fields shown as they come
+    ['db_type', 'db_name', 'db_host', 'db_port', 'db_measurement', 'db_org', 'db_bucket',
+     'db_gzip', 'db_tls', 'db_fingerprint', 'interval', 'db_flush',
+     'alert_url', 'alert_rules', 'cal_t', 'cal_h', 'cal_p',
+     'capture'].forEach(function(name) {
+        if (data.hasOwnProperty(name))
+            setValue('[name=' + name + ']', data[name]);
+    });
+
+    if (data.hasOwnProperty('db_token') && data['db_token'] == "1")
+        $('input[name=db_token]').placeholder = "Saved.  Update to change.";
+
+    if (data.hasOwnProperty('location')) {
+        setValue('input[name=location]', data['location']);
+        setHTML('.location', data['location']);
+    }
+
+    if (data.hasOwnProperty('derived')) {
+        $all('input[name=derived]').forEach(function(el) {
+            el.checked = (parseInt(data['derived']) & parseInt(el.value)) != 0;
+        });
+    }
+}
+
+
+// Read System Config
+function getConfigData() {
+    request("/config").then(function(data) {
+        console.log(data);
+
+        if (data.hasOwnProperty('hostname')) {
+            setHTML('.conf_hostname', data['hostname']);
+            setValue('input[name=hostname]', data['hostname']);
+        }
+
+        if (data.hasOwnProperty('mac')) {
+            setHTML('.conf_mac', data['mac']);
+            setValue('input[name=mac]', data['mac']);
+        }
+
+        if (data.hasOwnProperty('ino_ver'))
+            setHTML('.conf_ino_ver', data['ino_ver']);
+
+        if (data.hasOwnProperty('net'))
+            updateNetworkConfig(data['net']);
+
+        if (data.hasOwnProperty('db'))
+            updateSettingsConfig(data['db']);
+
+        if (data.hasOwnProperty('alerts'))
+            updateSettingsConfig(data['alerts']);
+
+        if (data.hasOwnProperty('cal'))
+            updateSettingsConfig(data['cal']);
+
+        if (data.hasOwnProperty('capture'))
+            updateSettingsConfig(data['capture']);
+
+        handleDBTypeChange();
+
+    }).catch(function() {
+        displayAlert('Error retrieving config data');
+    });
+}
+
+// Read Sensor Values
+function getSensorReading() {
+    request("/sensors").then(function(data) {
+        console.log(data);
+
+        if (data.hasOwnProperty('temp'))
+            setHTML('.reading-temp', data['temp'] + "&deg;F");
+
+        if (data.hasOwnProperty('hum'))
+            setHTML('.reading-humidity', data['hum'] + "%");
+
+        if (data.hasOwnProperty('hidx'))
+            setHTML('.reading-hidx', data['hidx']);
+
+        setTimeout(getSensorReading, 10000);
+
+    }).catch(function() {
+        displayAlert('Error retrieving sensor readings');
+    });
+}
+
+
+function saveSettings() {
+    var done = busy('#btn_settingsSave', "Saving...");
+
+    // Derived metrics checkboxes make up a bitmask
+    var derived = 0;
+    $all('input[name=derived]:checked').forEach(function(el) {
+        derived |= parseInt(el.value);
+    });
+
+    var data = {
+        db_type: getValue('select[name=db_type]'),
+        db_host: getValue('input[name=db_host]'),
+        db_port: getValue('input[name=db_port]'),
+        db_name: getValue('input[name=db_name]'),
+        db_measurement: getValue('input[name=db_measurement]'),
+        db_org: getValue('input[name=db_org]'),
+        db_bucket: getValue('input[name=db_bucket]'),
+        db_token: getValue('input[name=db_token]'),
+        db_gzip: getValue('select[name=db_gzip]'),
+        db_tls: getValue('select[name=db_tls]'),
+        db_fingerprint: getValue('input[name=db_fingerprint]'),
+        location: getValue('input[name=location]'),
+        interval: getValue('select[name=interval]'),
+        derived: derived,
+        db_flush: getValue('select[name=db_flush]'),
+        sleep: getValue('select[name=sleep]'),
+        listen: getValue('select[name=listen]'),
+        alert_url: getValue('input[name=alert_url]'),
+        alert_rules: getValue('input[name=alert_rules]'),
+        cal_t: getValue('input[name=cal_t]'),
+        cal_h: getValue('input[name=cal_h]'),
+        cal_p: getValue('input[name=cal_p]'),
+        capture: getValue('input[name=capture]'),
+    };
+
+    request("/settings", data).then(function() {
+        done();
+
+        // Reload Data
+        getConfigData();
+    }).catch(function() {
+        done();
+        displayAlert('Error Saving Settings');
+    });
+}
+
+
+function saveSecurity() {
+    // Check that the password fields match
+    if (getValue('input[name=http_pw]') != getValue('input[name=http_pw_confirm]')) {
+        displayAlert('Password fields do not match!');
+        return;
+    }
+
+    var done = busy('#btn_accessSave', "Saving...");
+
+    var data = {
+        http_user: getValue('input[name=http_user]'),
+    };
+
+    // Only send a PW if a new one is set
+    if (getValue('input[name=http_pw]') != "")
+        data['http_pw'] = getValue('input[name=http_pw]');
+
+    request("/settings", data).then(function() {
+        done();
+
+        // Reload Data
+        getConfigData();
+    }).catch(function() {
+        done();
+        displayAlert('Error Saving Settings');
+    });
+}
+
+
+function saveNetwork() {
+    var done = busy('#btn_networkSave', "Saving...");
+
+    var data = {
+        ssid: getValue('input[name=ssid]'),
+        wifi_pw: getValue('input[name=wifi_pw]'),
+        network_type: getValue('select[name=network_type]'),
+        hostname: getValue('input[name=hostname]'),
+    };
+
+    request("/network", data).then(function() {
+        done();
+
+        // Reload Data
+        getConfigData();
+    }).catch(function() {
+        done();
+        displayAlert('Error Saving Network Settings!');
+    });
+}
+
+
+function factoryReset() {
+    var done = busy('#btn_factoryReset', "Requesting Reset...");
+
+    // TODO: Maybe add a confirmation?
+    request("/reset", { reset: 1 }).then(function() {
+        done();
+
+        // Reload Data
+        getConfigData();
+    }).catch(function() {
+        done();
+        displayAlert('Error Requesting Factory Reset');
+    });
+}
+
+// Request an online update start
+function onlineUpdate() {
+    var done = busy('#btn_onlineupdate', "Requesting Update...");
+
+    request("/webupdate", {}).then(function() {
+        displayAlert('Online update requested...');
+    }).catch(function() {
+        done();
+        displayAlert('Error Requesting Online Update');
+    });
+}
+
+
+(function() {
+    onClick('nav a', handleNavClick);
+    $('nav a.default').click();
+
+    // button listeners
+    onClick('#btn_settingsSave', saveSettings);
+    onClick('#btn_networkSave', saveNetwork);
+    onClick('#btn_accessSave', saveSecurity);
+    onClick('#btn_factoryReset', factoryReset);
+    onClick('#btn_onlineupdate', onlineUpdate);
+    onClick('#alert .close', closeAlert);
+
+    $all('select[name=db_type]').forEach(function(el) { el.addEventListener('change', handleDBTypeChange); });
+
+    getConfigData();
+    getSensorReading();
+})();
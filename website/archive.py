@@ -0,0 +1,122 @@
+"""
+archive.py - Decode the on-flash archive exported by a sensor's /archive
+
+Prints CSV, oldest first.  Raw and minute tiers have temp,humidity;
+the hourly tier has min/max/mean of each.  Values are in F and %.
+
+Usage:
+    python archive.py http://<sensor>:8080 [tier]
+    python archive.py <exported file>
+"""
+
+import csv
+import datetime
+import struct
+import sys
+import urllib.request
+
+BLOCK_SIZE = 256
+HEADER     = struct.Struct("<IIHHBBH")     # seq, start, count, bits, tier, fields, interval
+SCALE      = 100                           # Readings are fixed point
+
+COLUMNS = {
+    0: ["temp", "humidity"],
+    1: ["temp", "humidity"],
+    2: ["temp_min", "temp_max", "temp_mean", "hum_min", "hum_max", "hum_mean"],
+}
+
+
+class Bits:
+    def __init__(self, data):
+        self.data = data
+        self.pos  = 0
+
+    def get(self, count):
+        value = 0
+        for _ in range(count):
+            byte  = self.data[self.pos // 8]
+            value = (value << 1) | ((byte >> (7 - self.pos % 8)) & 1)
+            self.pos += 1
+        return value
+
+    def signed(self, count):
+        value = self.get(count)
+        if value & (1 << (count - 1)):
+            value -= 1 << count
+        return value
+
+    def dod(self):
+        prefix = 0
+        while prefix < 4 and self.get(1):
+            prefix += 1
+        width = [0, 7, 12, 20, 32][prefix]
+        return self.signed(width) if width else 0
+
+
+def decode_block(block):
+    seq, start, count, bits, tier, fields, interval = HEADER.unpack_from(block)
+    stream = Bits(block[HEADER.size:])
+
+    ts       = start
+    ts_delta = interval
+    values   = [stream.signed(32) for _ in range(fields)] if count else []
+    deltas   = [0] * fields
+    samples  = []
+
+    for n in range(count):
+        if n > 0:
+            ts_delta += stream.dod()
+            ts       += ts_delta
+            for i in range(fields):
+                deltas[i] += stream.dod()
+                values[i] += deltas[i]
+        samples.append((ts, list(values)))
+
+    if stream.pos != bits:
+        raise ValueError("block %d: decoded %d bits, header says %d" % (seq, stream.pos, bits))
+
+    return seq, tier, samples
+
+
+def decode(data):
+    """(tier, [(timestamp, values)]) from a tier export, oldest first"""
+    blocks = []
+    tier   = None
+
+    for offset in range(0, len(data) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        seq, tier_, samples = decode_block(data[offset:offset + BLOCK_SIZE])
+        if samples:
+            blocks.append((seq, samples))
+            tier = tier_
+
+    samples = []
+    for seq, block in sorted(blocks):
+        samples.extend(block)
+    return tier, samples
+
+
+def main(args):
+    if not args:
+        print(__doc__)
+        return 1
+
+    if args[0].startswith("http"):
+        tier = args[1] if len(args) > 1 else "0"
+        with urllib.request.urlopen("%s/archive?tier=%s" % (args[0].rstrip("/"), tier)) as r:
+            data = r.read()
+    else:
+        with open(args[0], "rb") as f:
+            data = f.read()
+
+    tier, samples = decode(data)
+    out = csv.writer(sys.stdout)
+    out.writerow(["time"] + COLUMNS.get(tier, []))
+    for ts, values in samples:
+        when = datetime.datetime.fromtimestamp(ts, datetime.timezone.utc).strftime("%Y-%m-%dT%H:%M:%SZ")
+        out.writerow([when] + ["%.2f" % (v / SCALE) for v in values])
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
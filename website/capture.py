@@ -0,0 +1,111 @@
+"""
+capture.py - Decode a burst capture from a sensor's /capture, or the
+             base64 wave field of a capture point in the DB
+
+Prints CSV: ms from the trigger, ADC counts and pressure through the
+calibration the capture was taken with.  Samples the loop missed
+show up as jumps in the time column.
+
+Usage:
+    python capture.py http://<sensor>:8080
+    python capture.py <exported file, or base64 text>
+"""
+
+import base64
+import binascii
+import csv
+import datetime
+import struct
+import sys
+import urllib.request
+
+MAGIC      = b"CAP1"
+HEADER     = struct.Struct("<4sIIHHHHiiiic3xB3x5i5i")
+SCALE      = 100                           # Readings are fixed point
+VALUE_MASK = 0x03ff
+GAP_SHIFT  = 10
+
+
+def calibrate(points, raws, values, raw):
+    """Calibration.cpp's apply(), in fixed point"""
+    if points == 0:
+        return raw
+    if points == 1:
+        return raw + values[0] - raws[0]
+
+    i = 0
+    while i + 2 < points and raw > raws[i + 1]:
+        i += 1
+
+    num = (raw - raws[i]) * (values[i + 1] - values[i])
+    den = raws[i + 1] - raws[i]
+    step = (abs(num) + den // 2) // den
+    return values[i] + (step if num >= 0 else -step)
+
+
+def decode(data):
+    """(header dict, [(ms from trigger, counts, pressure)])"""
+    if not data.startswith(MAGIC):
+        try:
+            data = base64.b64decode(data, validate=False)
+        except binascii.Error:
+            pass
+    if not data.startswith(MAGIC):
+        raise ValueError("not a capture")
+
+    fields = HEADER.unpack_from(data)
+    _, seq, timestamp, period_us, count, pre, missed, threshold, value, low, high, kind, points = fields[:13]
+    raws, values = list(fields[13:18]), list(fields[18:23])
+
+    header = {
+        "seq": seq, "timestamp": timestamp, "period_us": period_us, "count": count, "pre": pre,
+        "missed": missed, "trigger": kind.decode() + "%.2f" % (threshold / SCALE),
+        "value": value / SCALE, "low": low / SCALE, "high": high / SCALE,
+    }
+
+    samples = struct.unpack_from("<%dH" % count, data, HEADER.size)
+    periods = 0
+    rows    = []
+    for n, sample in enumerate(samples):
+        if n > 0:
+            periods += 1 + (sample >> GAP_SHIFT)
+        if n == pre:
+            trigger_at = periods
+        counts = sample & VALUE_MASK
+        rows.append((periods, counts, calibrate(points, raws, values, counts * SCALE)))
+
+    rows = [((p - trigger_at) * period_us / 1000.0, c, v) for p, c, v in rows]
+    return header, rows
+
+
+def main(args):
+    if not args:
+        print(__doc__)
+        return 1
+
+    if args[0].startswith("http"):
+        with urllib.request.urlopen("%s/capture" % args[0].rstrip("/")) as r:
+            data = r.read()
+    else:
+        with open(args[0], "rb") as f:
+            data = f.read().strip()
+
+    header, rows = decode(data)
+
+    when = "unknown"
+    if header["timestamp"]:
+        when = datetime.datetime.fromtimestamp(header["timestamp"], datetime.timezone.utc).strftime("%Y-%m-%dT%H:%M:%SZ")
+    print("# capture %d at %s: %s, value %.2f, range %.2f..%.2f, %d periods missed" % (
+        header["seq"], when, header["trigger"], header["value"], header["low"], header["high"], header["missed"]),
+        file=sys.stderr)
+
+    out = csv.writer(sys.stdout)
+    out.writerow(["ms", "counts", "pressure"])
+    for ms, counts, pressure in rows:
+        out.writerow(["%.1f" % ms, counts, "%.2f" % (pressure / SCALE)])
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
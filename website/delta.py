@@ -0,0 +1,219 @@
+"""
+delta.py - Manifests and firmware patches for DeltaUpdate on the sensors
+
+The manifest lists the firmware and every file of the SPIFFS image with
+its size and MD5, so a sensor only downloads what differs from what it
+has.  Firmware patches copy unchanged runs out of the image the sensor
+is running and carry everything else as literal data:
+
+    header  b"ESPD" version(1) new_size(4) new_md5(16)
+    b"C" offset(4) length(4)     copy from the old firmware
+    b"A" length(4) data...       add literal bytes
+    b"E"                         end of patch
+
+Usage:
+    python delta.py manifest <data dir> <firmware.bin> <version>
+    python delta.py diff <old.bin> <new.bin> <out.patch>
+    python delta.py apply <old.bin> <patch> <out.bin>
+"""
+
+import hashlib
+import os
+import struct
+import sys
+
+PATCH_MAGIC   = b"ESPD"
+PATCH_VERSION = 1
+
+BLOCK    = 16      # Bytes hashed to find candidate matches
+MIN_COPY = 24      # Shorter matches cost more as a copy than as literals
+
+
+def md5(data):
+    return hashlib.md5(data).hexdigest()
+
+
+def file_md5(path):
+    with open(path, "rb") as f:
+        return md5(f.read())
+
+
+def spiffs_files(data_dir):
+    """(spiffs path, local path) for every file in the data directory"""
+    for root, dirs, names in os.walk(data_dir):
+        dirs.sort()
+        for name in sorted(names):
+            local = os.path.join(root, name)
+            yield "/" + os.path.relpath(local, data_dir).replace(os.sep, "/"), local
+
+
+def build_manifest(data_dir, firmware=None, version=None):
+    lines = ["# heatstroke manifest"]
+
+    if firmware and os.path.exists(firmware):
+        lines.append("fw %s %d %s" % (version, os.path.getsize(firmware), build_md5(firmware)))
+
+    for path, local in spiffs_files(data_dir):
+        lines.append("file %s %d %s" % (path, os.path.getsize(local), file_md5(local)))
+
+    return "\n".join(lines) + "\n"
+
+
+def make_patch(old, new):
+    # First occurrence of every BLOCK bytes of the old image
+    index = {}
+    for i in range(len(old) - BLOCK + 1):
+        index.setdefault(old[i:i + BLOCK], i)
+
+    out     = [PATCH_MAGIC, struct.pack("<BI", PATCH_VERSION, len(new)), bytes.fromhex(md5(new))]
+    literal = bytearray()
+    last    = None      # Where the previous copy ended in old
+
+    def flush():
+        if literal:
+            out.append(b"A" + struct.pack("<I", len(literal)) + bytes(literal))
+            literal.clear()
+
+    j = 0
+    while j < len(new):
+        best, best_len = None, 0
+
+        # Code that didn't move relative to the last copy is the common case
+        candidates = []
+        if last is not None and last < len(old):
+            candidates.append(last)
+        hit = index.get(new[j:j + BLOCK])
+        if hit is not None:
+            candidates.append(hit)
+
+        for start in candidates:
+            n = 0
+            while start + n < len(old) and j + n < len(new) and old[start + n] == new[j + n]:
+                n += 1
+            if n > best_len:
+                best, best_len = start, n
+
+        if best_len >= MIN_COPY:
+            flush()
+            out.append(b"C" + struct.pack("<II", best, best_len))
+            j   += best_len
+            last = best + best_len
+        else:
+            literal.append(new[j])
+            j += 1
+            if last is not None:
+                last += 1
+
+    flush()
+    out.append(b"E")
+    return b"".join(out)
+
+
+def apply_patch(old, patch):
+    """What the sensor does, for checking patches on the server"""
+    if patch[:4] != PATCH_MAGIC or patch[4] != PATCH_VERSION:
+        raise ValueError("not a patch")
+
+    size, = struct.unpack_from("<I", patch, 5)
+    digest = patch[9:25].hex()
+    new = bytearray()
+    pos = 25
+
+    while True:
+        op = patch[pos:pos + 1]
+        pos += 1
+        if op == b"C":
+            offset, length = struct.unpack_from("<II", patch, pos)
+            pos += 8
+            if offset + length > len(old):
+                raise ValueError("copy outside the old image")
+            new += old[offset:offset + length]
+        elif op == b"A":
+            length, = struct.unpack_from("<I", patch, pos)
+            pos += 4
+            new += patch[pos:pos + length]
+            pos += length
+        elif op == b"E":
+            break
+        else:
+            raise ValueError("bad op %r at %d" % (op, pos - 1))
+
+    if pos != len(patch) or len(new) != size or md5(new) != digest:
+        raise ValueError("patch did not reproduce the image")
+
+    return bytes(new)
+
+
+_build_md5 = {}     # path -> (mtime, md5)
+
+
+def build_md5(path):
+    mtime = os.path.getmtime(path)
+    if _build_md5.get(path, (None,))[0] != mtime:
+        _build_md5[path] = (mtime, file_md5(path))
+    return _build_md5[path][1]
+
+
+def find_build(firmware_dir, digest):
+    """Path of the .bin in firmware_dir with the given MD5, or None"""
+    for name in sorted(os.listdir(firmware_dir)):
+        path = os.path.join(firmware_dir, name)
+        if name.endswith(".bin") and build_md5(path) == digest:
+            return path
+    return None
+
+
+def patch_file(firmware_dir, base_md5, new_md5):
+    """Path of a patch between two builds, made and cached on first use.
+    None if we don't have both builds."""
+    cache = os.path.join(firmware_dir, "patches", "%s-%s.patch" % (base_md5, new_md5))
+    if os.path.exists(cache):
+        return cache
+
+    base, target = find_build(firmware_dir, base_md5), find_build(firmware_dir, new_md5)
+    if base and target:
+        with open(base, "rb") as f:
+            old = f.read()
+        with open(target, "rb") as f:
+            new = f.read()
+
+        patch = make_patch(old, new)
+        apply_patch(old, patch)
+
+        os.makedirs(os.path.dirname(cache), exist_ok=True)
+        with open(cache, "wb") as f:
+            f.write(patch)
+        return cache
+
+    return None
+
+
+def main(args):
+    if len(args) == 4 and args[0] == "manifest":
+        sys.stdout.write(build_manifest(args[1], args[2], args[3]))
+
+    elif len(args) == 4 and args[0] in ("diff", "apply"):
+        with open(args[1], "rb") as f:
+            old = f.read()
+        with open(args[2], "rb") as f:
+            data = f.read()
+
+        if args[0] == "diff":
+            out = make_patch(old, data)
+            apply_patch(old, out)
+            print("%d -> %d bytes patch" % (len(data), len(out)))
+        else:
+            out = apply_patch(old, data)
+
+        with open(args[3], "wb") as f:
+            f.write(out)
+
+    else:
+        print(__doc__)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -1,8 +1,85 @@
-from flask import Flask, render_template, request
+import hashlib
+import json
+import os
+import re
+import threading
+
+from flask import Flask, render_template, request, send_file, send_from_directory, abort
 from pprint import pprint
 
+import delta
+
 app = Flask(__name__)
 
+HERE         = os.path.dirname(os.path.abspath(__file__))
+DATA_DIR     = os.path.join(HERE, "..", "data")     # SPIFFS image contents
+FIRMWARE_DIR = os.path.join(HERE, "firmware")       # <version>.bin, older builds are patch bases
+
+# Staged rollout, e.g.
+#   {"version": "0.5.1", "stable": "0.5.0", "percent": 10, "hold_failures": 3}
+# Devices whose MAC falls in the first `percent` buckets get `version`,
+# the rest stay on `stable`.  The rollout is held (nobody new gets it)
+# once `hold_failures` devices have reported that it failed to apply.
+ROLLOUT_FILE = os.path.join(HERE, "rollout.json")
+REPORTS_FILE = os.path.join(HERE, "reports.json")
+
+reports_lock = threading.Lock()
+
+
+def load_json(path, default):
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except (IOError, ValueError):
+        return default
+
+
+def build_path(version):
+    path = os.path.join(FIRMWARE_DIR, "%s.bin" % version)
+    return path if version and os.path.exists(path) else None
+
+
+def newest_build():
+    if not os.path.isdir(FIRMWARE_DIR):
+        return None
+
+    builds = [name[:-4] for name in os.listdir(FIRMWARE_DIR)
+              if re.match(r"^\d+(\.\d+)*\.bin$", name)]
+    if not builds:
+        return None
+
+    return max(builds, key=lambda v: [int(x) for x in v.split(".")])
+
+
+def bucket(mac):
+    """Stable 0..99 rollout bucket for a device"""
+    return int(hashlib.md5(mac.upper().encode()).hexdigest()[:8], 16) % 100
+
+
+def rollout_held(rollout):
+    with reports_lock:
+        failed = load_json(REPORTS_FILE, {}).get(rollout["version"], {}).get("failed", [])
+    return len(failed) >= rollout.get("hold_failures", 3)
+
+
+def target_version(mac, running_md5):
+    """Firmware version a device should be running, None for no change"""
+    rollout = load_json(ROLLOUT_FILE, None)
+    if not rollout:
+        return newest_build()
+
+    new = build_path(rollout["version"])
+
+    # Devices that already took the new build keep it, even when held
+    if new and delta.build_md5(new) == running_md5:
+        return rollout["version"]
+
+    if new and not rollout_held(rollout) and bucket(mac) < rollout.get("percent", 0):
+        return rollout["version"]
+
+    return rollout.get("stable")
+
+
 @app.route("/")
 def index():
     return render_template("index.html")
@@ -11,6 +88,76 @@ def index():
 @app.route("/update")
 def update():
     print(pprint(request.args))
-    
+
     return "No update available", 304
 
+
+@app.route("/manifest")
+def manifest():
+    app.logger.debug("manifest %s", dict(request.args))
+
+    mac     = request.args.get("mac", "")
+    running = request.args.get("md5", "")
+    version = target_version(mac, running)
+    body    = delta.build_manifest(DATA_DIR, build_path(version), version)
+
+    # Same manifest for the same build means nothing to do, answer with
+    # a bodyless 304 so fleet-wide checks stay cheap.
+    etag = hashlib.md5((body + running).encode()).hexdigest()
+    if request.if_none_match.contains(etag):
+        return "", 304, {"ETag": '"%s"' % etag}
+
+    return body, 200, {"Content-Type": "text/plain", "ETag": '"%s"' % etag}
+
+
+@app.route("/files/<path:path>")
+def files(path):
+    return send_from_directory(DATA_DIR, path)
+
+
+@app.route("/firmware/<digest>.bin")
+def firmware(digest):
+    path = delta.find_build(FIRMWARE_DIR, digest) if os.path.isdir(FIRMWARE_DIR) else None
+    if not path:
+        abort(404)
+
+    return send_file(path, mimetype="application/octet-stream")
+
+
+@app.route("/patch/<base_md5>/<new_md5>")
+def patch(base_md5, new_md5):
+    if not re.match(r"^[0-9a-f]{32}$", base_md5) or not re.match(r"^[0-9a-f]{32}$", new_md5):
+        abort(404)
+    if not os.path.isdir(FIRMWARE_DIR):
+        abort(404)
+
+    patch_path = delta.patch_file(FIRMWARE_DIR, base_md5, new_md5)
+    if not patch_path:
+        abort(404)      # Unknown build, the sensor falls back to the full image
+
+    return send_file(patch_path, mimetype="application/octet-stream")
+
+
+@app.route("/report", methods=["POST"])
+def report():
+    app.logger.debug("report %s", dict(request.args))
+
+    mac     = request.args.get("mac", "")
+    version = request.args.get("version", "")
+    result  = request.args.get("result", "")
+    if not mac or not version or result not in ("ok", "failed"):
+        abort(400)
+
+    # One vote per device, a retrying device doesn't hold a rollout alone
+    with reports_lock:
+        reports = load_json(REPORTS_FILE, {})
+        entry   = reports.setdefault(version, {"ok": [], "failed": []})
+        for key in ("ok", "failed"):
+            if mac in entry[key]:
+                entry[key].remove(mac)
+        entry[result].append(mac)
+
+        with open(REPORTS_FILE, "w") as f:
+            json.dump(reports, f, indent=2)
+
+    return "ok"